@@ -0,0 +1,126 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main.cpp
+ *
+ */
+
+#include <iostream>
+#include <memory>
+
+#include <cpp_utils/event/MultipleEventHandler.hpp>
+#include <cpp_utils/event/SignalEventHandler.hpp>
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/logging/StdLogConsumer.hpp>
+#include <cpp_utils/Log.hpp>
+
+#include <ddspipe_core/configuration/DdsPipeLogConfiguration.hpp>
+
+#include <ddsrecorder_participants/collector/McapCollector.hpp>
+
+#include "user_interface/arguments_configuration.hpp"
+#include "user_interface/CommandlineArgsCollector.hpp"
+#include "user_interface/ProcessReturnCode.hpp"
+
+using namespace eprosima::ddsrecorder::participants;
+using namespace eprosima::ddsrecorder::collector;
+
+int main(
+        int argc,
+        char** argv)
+{
+    // Initialize CommandlineArgsCollector
+    CommandlineArgsCollector commandline_args;
+
+    // Parse arguments
+    ProcessReturnCode arg_parse_result =
+            parse_arguments(argc, argv, commandline_args);
+
+    if (arg_parse_result == ProcessReturnCode::help_argument)
+    {
+        return static_cast<int>(ProcessReturnCode::success);
+    }
+    else if (arg_parse_result == ProcessReturnCode::version_argument)
+    {
+        return static_cast<int>(ProcessReturnCode::success);
+    }
+    else if (arg_parse_result != ProcessReturnCode::success)
+    {
+        return static_cast<int>(arg_parse_result);
+    }
+
+    /////
+    // Logging
+    eprosima::ddspipe::core::DdsPipeLogConfiguration log_configuration;
+    log_configuration.set(commandline_args.log_verbosity);
+    log_configuration.set(commandline_args.log_filter);
+
+    eprosima::utils::Log::ClearConsumers();
+    eprosima::utils::Log::SetVerbosity(log_configuration.verbosity);
+    eprosima::utils::Log::RegisterConsumer(std::make_unique<eprosima::utils::StdLogConsumer>(&log_configuration));
+
+    ProcessReturnCode result = ProcessReturnCode::success;
+
+    // Encapsulating execution in block to erase all memory correctly before closing process
+    try
+    {
+        // Stop collecting on SIGINT or SIGTERM (or once the standard input is closed)
+        auto close_handler = std::make_shared<eprosima::utils::event::MultipleEventHandler>();
+
+        close_handler->register_event_handler<eprosima::utils::event::EventHandler<eprosima::utils::event::Signal>,
+                eprosima::utils::event::Signal>(
+            std::make_unique<eprosima::utils::event::SignalEventHandler<eprosima::utils::event::Signal::sigint>>());     // Add SIGINT
+        close_handler->register_event_handler<eprosima::utils::event::EventHandler<eprosima::utils::event::Signal>,
+                eprosima::utils::event::Signal>(
+            std::make_unique<eprosima::utils::event::SignalEventHandler<eprosima::utils::event::Signal::sigterm>>());    // Add SIGTERM
+
+        /////
+        // Collection
+        McapCollector collector(
+            commandline_args.collector_configuration,
+            [close_handler]()
+            {
+                close_handler->simulate_event_occurred();
+            });
+
+        collector.start();
+
+        logUser(DDSCOLLECTOR_EXECUTION, "DDS Collector running.");
+
+        close_handler->wait_for_event();
+
+        logUser(DDSCOLLECTOR_EXECUTION, "Stopping DDS Collector.");
+
+        collector.stop();
+
+        std::cout << collector.collected_files().size() << " files collected in " <<
+            commandline_args.collector_configuration.output_directory << "." << std::endl;
+    }
+    catch (const eprosima::utils::InitializationException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ERROR,
+                "Error Initializing DDS Collector. Error message:\n " <<
+                e.what());
+        result = ProcessReturnCode::execution_failed;
+    }
+
+    // Force print every log before closing
+    eprosima::utils::Log::Flush();
+
+    // Delete the consumers before closing
+    eprosima::utils::Log::ClearConsumers();
+
+    return static_cast<int>(result);
+}
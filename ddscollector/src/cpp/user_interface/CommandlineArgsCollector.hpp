@@ -0,0 +1,49 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CommandlineArgsCollector.hpp
+ *
+ */
+
+#pragma once
+
+#include <ddspipe_core/configuration/CommandlineArgs.hpp>
+
+#include <ddsrecorder_participants/collector/McapCollectorConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace collector {
+
+/*
+ * Struct to parse the executable arguments
+ */
+struct CommandlineArgsCollector : public ddspipe::core::CommandlineArgs
+{
+    CommandlineArgsCollector()
+    {
+        log_filter[utils::VerbosityKind::Info].set_value("DDSRECORDER", utils::FuzzyLevelValues::fuzzy_level_default);
+        log_filter[utils::VerbosityKind::Warning].set_value("DDSRECORDER",
+                utils::FuzzyLevelValues::fuzzy_level_default);
+        log_filter[utils::VerbosityKind::Error].set_value("", utils::FuzzyLevelValues::fuzzy_level_default);
+    }
+
+    // Where to receive the stream from and where to write the collected files
+    participants::McapCollectorConfiguration collector_configuration{};
+};
+
+} /* namespace collector */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,487 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file arguments_configuration.cpp
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/library/config.h>
+
+#include "arguments_configuration.hpp"
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace collector {
+
+const option::Descriptor usage[] = {
+    {
+        optionIndex::UNKNOWN_OPT,
+        0,
+        "",
+        "",
+        Arg::None,
+        "Usage: DDS Collector [options]\n" \
+        "Collect the MCAP files streamed by eProsima DDS Recorder and write them to disk.\n" \
+        "General options:"
+    },
+
+    ////////////////////
+    // Help options
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\nApplication help and information."
+    },
+
+    {
+        optionIndex::HELP,
+        0,
+        "h",
+        "help",
+        Arg::None,
+        "  -h \t--help\t  \t" \
+        "Print this help message."
+    },
+
+    {
+        optionIndex::VERSION,
+        0,
+        "v",
+        "version",
+        Arg::None,
+        "  -v \t--version\t  \t" \
+        "Print version, branch and commit hash." \
+    },
+
+    ////////////////////
+    // Application options
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\nApplication parameters"
+    },
+
+    {
+        optionIndex::ADDRESS,
+        0,
+        "a",
+        "address",
+        Arg::String,
+        "  -a \t--address\t  \t" \
+        "Address to listen on for the recorder stream over TCP. [Default: 127.0.0.1]."
+    },
+
+    {
+        optionIndex::PORT,
+        0,
+        "p",
+        "port",
+        Arg::Numeric,
+        "  -p \t--port\t  \t" \
+        "TCP port to listen on for the recorder stream. [Default: 9475]."
+    },
+
+    {
+        optionIndex::UNIX_SOCKET,
+        0,
+        "u",
+        "unix",
+        Arg::String,
+        "  -u \t--unix\t  \t" \
+        "Listen on the given Unix domain socket instead of on a TCP port."
+    },
+
+    {
+        optionIndex::STDIN,
+        0,
+        "",
+        "stdin",
+        Arg::None,
+        "  \t--stdin\t  \t" \
+        "Read the recorder stream from the standard input (e.g. piped from a recorder streaming to its standard " \
+        "output) instead of listening on a socket. The collector exits once the input is closed."
+    },
+
+    {
+        optionIndex::OUTPUT_DIRECTORY,
+        0,
+        "o",
+        "output",
+        Arg::String,
+        "  -o \t--output\t  \t" \
+        "Directory where the collected files are written. [Default: .]."
+    },
+
+    {
+        optionIndex::MAX_SIZE,
+        0,
+        "m",
+        "max-size",
+        Arg::String,
+        "  -m \t--max-size\t  \t" \
+        "Max aggregate size of the collected files (e.g. 10GB), removing the oldest ones beyond it. " \
+        "[Default: no limit]."
+    },
+
+    ////////////////////
+    // Debug options
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\nDebug parameters"
+    },
+
+    {
+        optionIndex::ACTIVATE_DEBUG,
+        0,
+        "d",
+        "debug",
+        Arg::None,
+        "  -d \t--debug\t  \t" \
+        "Set log verbosity to Info \t" \
+        "(Using this option with --log-filter and/or --log-verbosity will head to undefined behaviour)."
+    },
+
+    {
+        optionIndex::LOG_FILTER,
+        0,
+        "",
+        "log-filter",
+        Arg::String,
+        "  \t--log-filter\t  \t" \
+        "Set a Regex Filter to filter by category the info and warning log entries. " \
+        "[Default = \"DDSRECORDER\"]. "
+    },
+
+    {
+        optionIndex::LOG_VERBOSITY,
+        0,
+        "",
+        "log-verbosity",
+        Arg::Log_Kind_Correct_Argument,
+        "  \t--log-verbosity\t  \t" \
+        "Set a Log Verbosity Level higher or equal the one given. " \
+        "(Values accepted: \"info\",\"warning\",\"error\" no Case Sensitive) " \
+        "[Default = \"warning\"]. "
+    },
+
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\n"
+    },
+
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+void print_version()
+{
+    std::cout
+        << "DDS Record & Replay "
+        << DDSRECORDER_PARTICIPANTS_VERSION_STRING
+        << "\ncommit hash: "
+        << DDSRECORDER_PARTICIPANTS_COMMIT_HASH
+        << std::endl;
+}
+
+ProcessReturnCode parse_arguments(
+        int argc,
+        char** argv,
+        CommandlineArgsCollector& commandline_args)
+{
+    // Variable to pretty print usage help
+    int columns;
+#if defined(_WIN32)
+    char* buf = nullptr;
+    size_t sz = 0;
+    if (_dupenv_s(&buf, &sz, "COLUMNS") == 0 && buf != nullptr)
+    {
+        columns = std::strtol(buf, nullptr, 10);
+        free(buf);
+    }
+    else
+    {
+        columns = 80;
+    }
+#else
+    columns = getenv("COLUMNS") ? atoi(getenv("COLUMNS")) : 180;
+#endif // if defined(_WIN32)
+
+    // Parse arguments
+    // No required arguments
+    if (argc > 0)
+    {
+        argc -= (argc > 0); // reduce arg count of program name if present
+        argv += (argc > 0); // skip program name argv[0] if present
+
+        option::Stats stats(usage, argc, argv);
+        std::vector<option::Option> options(stats.options_max);
+        std::vector<option::Option> buffer(stats.buffer_max);
+        option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+        // Parsing error
+        if (parse.error())
+        {
+            option::printUsage(fwrite, stdout, usage, columns);
+            return ProcessReturnCode::incorrect_argument;
+        }
+
+        // Adding Help before every other check to show help in case an argument is incorrect
+        if (options[optionIndex::HELP])
+        {
+            option::printUsage(fwrite, stdout, usage, columns);
+            return ProcessReturnCode::help_argument;
+        }
+
+        if (options[optionIndex::VERSION])
+        {
+            print_version();
+            return ProcessReturnCode::version_argument;
+        }
+
+        for (int i = 0; i < parse.optionsCount(); ++i)
+        {
+            option::Option& opt = buffer[i];
+            switch (opt.index())
+            {
+                case optionIndex::ADDRESS:
+                    commandline_args.collector_configuration.address = opt.arg;
+                    break;
+
+                case optionIndex::PORT:
+                {
+                    const auto port = std::stoul(opt.arg);
+
+                    if (port == 0 || port > 65535)
+                    {
+                        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Port " << port << " is out of range.");
+                        return ProcessReturnCode::incorrect_argument;
+                    }
+
+                    commandline_args.collector_configuration.port = static_cast<std::uint16_t>(port);
+                    break;
+                }
+
+                case optionIndex::UNIX_SOCKET:
+                    commandline_args.collector_configuration.kind = participants::McapStreamKind::unix_socket;
+                    commandline_args.collector_configuration.path = opt.arg;
+                    break;
+
+                case optionIndex::STDIN:
+                    commandline_args.collector_configuration.kind = participants::McapStreamKind::pipe;
+                    break;
+
+                case optionIndex::OUTPUT_DIRECTORY:
+                    commandline_args.collector_configuration.output_directory = opt.arg;
+                    break;
+
+                case optionIndex::MAX_SIZE:
+                    try
+                    {
+                        commandline_args.collector_configuration.max_size = utils::to_bytes(opt.arg);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Invalid max size " << opt.arg << ": " << e.what());
+                        return ProcessReturnCode::incorrect_argument;
+                    }
+                    break;
+
+                case optionIndex::ACTIVATE_DEBUG:
+                    commandline_args.log_filter[utils::VerbosityKind::Error].set_value("");
+                    commandline_args.log_filter[utils::VerbosityKind::Warning].set_value("DDSRECORDER");
+                    commandline_args.log_filter[utils::VerbosityKind::Info].set_value("DDSRECORDER");
+                    commandline_args.log_verbosity = utils::VerbosityKind::Info;
+                    break;
+
+                case optionIndex::LOG_FILTER:
+                    commandline_args.log_filter[utils::VerbosityKind::Error].set_value(opt.arg);
+                    commandline_args.log_filter[utils::VerbosityKind::Warning].set_value(opt.arg);
+                    commandline_args.log_filter[utils::VerbosityKind::Info].set_value(opt.arg);
+                    break;
+
+                case optionIndex::LOG_VERBOSITY:
+                    commandline_args.log_verbosity =
+                            utils::VerbosityKind(static_cast<int>(from_string_LogKind(opt.arg)));
+                    break;
+
+                case optionIndex::UNKNOWN_OPT:
+                    EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, opt << " is not a valid argument.");
+                    option::printUsage(fwrite, stdout, usage, columns);
+                    return ProcessReturnCode::incorrect_argument;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        if (parse.nonOptionsCount() > 0)
+        {
+            EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Unexpected argument '" << parse.nonOption(0) << "'.");
+            option::printUsage(fwrite, stdout, usage, columns);
+            return ProcessReturnCode::incorrect_argument;
+        }
+    }
+    else
+    {
+        option::printUsage(fwrite, stdout, usage, columns);
+        return ProcessReturnCode::incorrect_argument;
+    }
+
+    return ProcessReturnCode::success;
+}
+
+option::ArgStatus Arg::Unknown(
+        const option::Option& option,
+        bool msg)
+{
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(
+            DDSCOLLECTOR_ARGS,
+            "Unknown option '" << option << "'. Use -h to see this executable possible arguments.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Required(
+        const option::Option& option,
+        bool msg)
+{
+    if (option.arg != 0 && option.arg[0] != 0)
+    {
+        return option::ARG_OK;
+    }
+
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Option '" << option << "' required.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Numeric(
+        const option::Option& option,
+        bool msg)
+{
+    char* endptr = 0;
+    if (option.arg != 0 && std::strtol(option.arg, &endptr, 10))
+    {
+    }
+    if (endptr != option.arg && *endptr == 0)
+    {
+        return option::ARG_OK;
+    }
+
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Option '" << option << "' requires a numeric argument.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Float(
+        const option::Option& option,
+        bool msg)
+{
+    char* endptr = 0;
+    if (option.arg != 0 && std::strtof(option.arg, &endptr))
+    {
+    }
+    if (endptr != option.arg && *endptr == 0)
+    {
+        return option::ARG_OK;
+    }
+
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Option '" << option << "' requires a float argument.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::String(
+        const option::Option& option,
+        bool msg)
+{
+    if (option.arg != 0)
+    {
+        return option::ARG_OK;
+    }
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Option '" << option << "' requires a text argument.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Log_Kind_Correct_Argument(
+        const option::Option& option,
+        bool msg)
+{
+    return Arg::Valid_Options(string_vector_LogKind(), option, msg);
+}
+
+option::ArgStatus Arg::Valid_Options(
+        const std::vector<std::string>& valid_options,
+        const option::Option& option,
+        bool msg)
+{
+    if (nullptr == option.arg)
+    {
+        if (msg)
+        {
+            EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, "Option '" << option.name << "' requires a text argument.");
+        }
+        return option::ARG_ILLEGAL;
+    }
+
+    if (std::find(valid_options.begin(), valid_options.end(), std::string(option.arg)) != valid_options.end())
+    {
+        return option::ARG_OK;
+    }
+    else if (msg)
+    {
+        utils::Formatter error_msg;
+        error_msg << "Option '" << option.name << "' requires a one of this values: {";
+        for (const auto& valid_option : valid_options)
+        {
+            error_msg << "\"" << valid_option << "\";";
+        }
+        error_msg << "}.";
+
+        EPROSIMA_LOG_ERROR(DDSCOLLECTOR_ARGS, error_msg);
+    }
+
+    return option::ARG_ILLEGAL;
+}
+
+std::ostream& operator <<(
+        std::ostream& output,
+        const option::Option& option)
+{
+    output << std::string(option.name, option.name + option.namelen);
+    return output;
+}
+
+} /* namespace collector */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
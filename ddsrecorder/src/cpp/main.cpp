@@ -17,6 +17,9 @@
  *
  */
 
+#include <fstream>
+#include <sstream>
+
 #include <nlohmann/json.hpp>
 
 #include <cpp_utils/event/FileWatcherHandler.hpp>
@@ -53,6 +56,7 @@ using json = nlohmann::json;
 
 const std::string NEXT_STATE_TAG = "next_state";
 const std::string AVOID_OVERWRITING_OUTPUT_TAG = "avoid_overwriting_output";
+const std::string FINALIZED_STATUS_INFO = "FINALIZED";
 
 constexpr auto string_to_command = eprosima::ddsrecorder::recorder::receiver::string_to_enumeration;
 // constexpr auto string_to_state = eprosima::ddsrecorder::recorder::string_to_enumeration;  // TODO: fix compilation error
@@ -155,6 +159,16 @@ void parse_command(
     }
 }
 
+std::string read_configuration_file(
+        const std::string& file_path)
+{
+    std::ifstream file(file_path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    return contents.str();
+}
+
 CommandCode state_to_command(
         const DdsRecorderState& state)
 {
@@ -324,6 +338,23 @@ int main(
             }
             command = state_to_command(initial_state);
 
+            // The recorder is kept alive while STOPPED, so it can be restarted without rebuilding its DDS entities
+            std::unique_ptr<DdsRecorder> recorder;
+            std::unique_ptr<eprosima::utils::event::FileWatcherHandler> file_watcher_handler;
+            std::unique_ptr<eprosima::utils::event::PeriodicEventHandler> periodic_handler;
+
+            // Contents of the configuration file the recorder was created with
+            std::string recorder_configuration_file;
+
+            // Publish a second status once the output file closed on a stop or suspend has been finalized
+            const auto on_finalized = [&receiver](CommandCode state)
+                    {
+                        return [&receiver, state]()
+                               {
+                                   receiver.publish_status(state, state, FINALIZED_STATUS_INFO);
+                               };
+                    };
+
             prev_command = CommandCode::close;
             do
             {
@@ -376,6 +407,12 @@ int main(
                     }
                 }
 
+                // The output file closed on the last stop must be reported as finalized before the new state
+                if (recorder != nullptr)
+                {
+                    recorder->wait_for_finalization();
+                }
+
                 // STOPPED/CLOSED -> RUNNING/PAUSED/SUSPENDED
                 receiver.publish_status(command, prev_command);
 
@@ -400,27 +437,51 @@ int main(
                             " command.");
                 }
 
-                // Reload YAML configuration file, in case it changed during STOPPED state
-                // NOTE: Changes to all (but controller specific) recorder configuration options are taken into account
-                configuration = eprosima::ddsrecorder::yaml::RecorderConfiguration(commandline_args.file_path);
-
-                // Create DDS Recorder
-                auto recorder = std::make_unique<DdsRecorder>(
-                    configuration, initial_state, close_handler, file_tracker);
+                const auto configuration_file = read_configuration_file(commandline_args.file_path);
 
-                // Create File Watcher Handler
-                std::unique_ptr<eprosima::utils::event::FileWatcherHandler> file_watcher_handler;
-                if (commandline_args.file_path != "")
+                if (recorder != nullptr && file_tracker != nullptr && configuration_file == recorder_configuration_file)
                 {
-                    file_watcher_handler = create_filewatcher(recorder, commandline_args.file_path);
-                }
+                    // Hot restart: the configuration did not change during STOPPED state, so keep the DDS entities,
+                    // the discovered types and the schemas, and only open a new output file
+                    logUser(DDSRECORDER_EXECUTION, "Restarting DDS Recorder.");
 
-                // Create Periodic Handler
-                std::unique_ptr<eprosima::utils::event::PeriodicEventHandler> periodic_handler;
-                if (commandline_args.reload_time > 0 && commandline_args.file_path != "")
+                    if (initial_state == DdsRecorderState::RUNNING)
+                    {
+                        recorder->start();
+                    }
+                    else if (initial_state == DdsRecorderState::PAUSED)
+                    {
+                        recorder->pause();
+                    }
+                }
+                else
                 {
-                    periodic_handler = create_periodic_handler(recorder, commandline_args.file_path,
-                                    commandline_args.reload_time);
+                    // Destroy the handlers referencing the previous recorder before the recorder itself
+                    periodic_handler.reset();
+                    file_watcher_handler.reset();
+                    recorder.reset();
+
+                    // Reload YAML configuration file, in case it changed during STOPPED state
+                    // NOTE: Changes to all (but controller specific) recorder configuration options are taken into account
+                    configuration = eprosima::ddsrecorder::yaml::RecorderConfiguration(commandline_args.file_path);
+                    recorder_configuration_file = configuration_file;
+
+                    // Create DDS Recorder
+                    recorder = std::make_unique<DdsRecorder>(
+                        configuration, initial_state, close_handler, file_tracker);
+
+                    // Create File Watcher Handler
+                    if (commandline_args.file_path != "")
+                    {
+                        file_watcher_handler = create_filewatcher(recorder, commandline_args.file_path);
+                    }
+
+                    // Create Periodic Handler
+                    if (commandline_args.reload_time > 0 && commandline_args.file_path != "")
+                    {
+                        periodic_handler = create_periodic_handler(recorder, commandline_args.file_path,
+                                        commandline_args.reload_time);
+                    }
                 }
 
                 // Use flag to avoid ugly warning (start/pause an already started/paused instance)
@@ -456,14 +517,15 @@ int main(
                             break;
 
                         case CommandCode::suspend:
-                            if (!first_iter)
-                            {
-                                recorder->suspend();
-                            }
+                            // Acknowledge the transition right away, the output file is finalized in the background
                             if (prev_command != CommandCode::suspend)
                             {
                                 receiver.publish_status(CommandCode::suspend, prev_command);
                             }
+                            if (!first_iter)
+                            {
+                                recorder->suspend(on_finalized(CommandCode::suspend));
+                            }
                             break;
 
                         case CommandCode::event:
@@ -531,8 +593,34 @@ int main(
                     first_iter = false;
 
                 } while (command != CommandCode::stop && command != CommandCode::close);
+
+                if (command == CommandCode::stop)
+                {
+                    if (prev_command == CommandCode::suspend)
+                    {
+                        // The output file closed on suspend must be reported as finalized before the new state
+                        recorder->wait_for_finalization();
+                    }
+
+                    // Acknowledge the transition right away, the output file is finalized in the background
+                    receiver.publish_status(CommandCode::stop, prev_command);
+
+                    if (prev_command != CommandCode::suspend)
+                    {
+                        // Close the output file, but keep the recorder alive to restart it faster
+                        recorder->stop(on_finalized(CommandCode::stop));
+                    }
+
+                    prev_command = CommandCode::stop;
+                }
             } while (command != CommandCode::close);
 
+            // Report the output file as finalized before closing
+            if (recorder != nullptr)
+            {
+                recorder->wait_for_finalization();
+            }
+
             // Transition to CLOSED state
             receiver.publish_status(CommandCode::close, prev_command);
         }
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include <filesystem>
+#include <map>
 #include <math.h>
+#include <string>
 
 #include <cpp_utils/exception/InitializationException.hpp>
 #include <cpp_utils/utils.hpp>
@@ -22,6 +24,8 @@
 #include <ddspipe_core/monitoring/producers/TopicsMonitorProducer.hpp>
 #include <ddspipe_core/types/dynamic_types/types.hpp>
 
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+
 #include "DdsRecorder.hpp"
 
 namespace eprosima {
@@ -55,14 +59,28 @@ DdsRecorder::DdsRecorder(
 {
     load_internal_topics_(configuration_);
 
+    // Set where the recorder threads run
+    participants::ThreadPlacement::get_instance().configure(configuration_.thread_placement_configuration);
+
     // Create Discovery Database
     discovery_database_ = std::make_shared<DiscoveryDatabase>();
 
     // Create Payload Pool
-    payload_pool_ = std::make_shared<FastPayloadPool>();
+    if (configuration_.payload_pool_configuration.kind == participants::PayloadPoolKind::slab)
+    {
+        payload_pool_ = std::make_shared<participants::SlabPayloadPool>(configuration_.payload_pool_configuration);
+    }
+    else
+    {
+        payload_pool_ = std::make_shared<FastPayloadPool>();
+    }
 
     // Create Thread Pool
-    thread_pool_ = std::make_shared<SlotThreadPool>(configuration_.n_threads);
+    {
+        // The thread pool threads inherit the placement of the thread creating them
+        participants::ScopedThreadPlacement placement(participants::ThreadKind::workers, "ddsrec.worker");
+        thread_pool_ = std::make_shared<SlotThreadPool>(configuration_.n_threads);
+    }
 
     // Fill MCAP output file settings
     participants::OutputSettings output_settings;
@@ -83,15 +101,37 @@ DdsRecorder::DdsRecorder(
     }
 
     output_settings.extension = ".mcap";
+    output_settings.sink = configuration_.output_sink;
+    output_settings.stream = configuration_.output_stream;
     output_settings.safety_margin = configuration_.safety_margin;
     output_settings.file_rotation = configuration_.output_resource_limits_file_rotation;
     output_settings.max_file_size = configuration_.output_resource_limits_max_file_size;
 
     if (output_settings.max_file_size == 0)
     {
-        output_settings.max_file_size = std::filesystem::space(output_settings.filepath).available;
+        switch (output_settings.sink)
+        {
+            case participants::OutputSinkKind::memory:
+                output_settings.max_file_size = participants::MEMORY_SINK_DEFAULT_MAX_SIZE;
+                break;
+
+            case participants::OutputSinkKind::null:
+                output_settings.max_file_size = participants::UNLIMITED_OUTPUT_SIZE;
+                break;
+
+            case participants::OutputSinkKind::stream:
+                output_settings.max_file_size = participants::STREAM_SINK_DEFAULT_MAX_FILE_SIZE;
+                break;
+
+            default:
+                output_settings.max_file_size = std::filesystem::space(output_settings.filepath).available;
+                break;
+        }
     }
 
+    output_settings.staging_path = configuration_.output_staging_path;
+    output_settings.staging_max_size = configuration_.output_staging_max_size;
+    output_settings.disk_full_forecast = configuration_.output_disk_full_forecast;
     output_settings.max_size = configuration_.output_resource_limits_max_size;
 
     if (output_settings.max_size == 0)
@@ -99,6 +139,44 @@ DdsRecorder::DdsRecorder(
         output_settings.max_size = output_settings.max_file_size;
     }
 
+    if (output_settings.sink != participants::OutputSinkKind::file)
+    {
+        // Keep recording once the resource limits are reached, discarding the oldest files
+        output_settings.file_rotation = true;
+    }
+
+    auto memory_budget = configuration_.memory_budget;
+
+    if (output_settings.sink == participants::OutputSinkKind::stream && memory_budget == 0)
+    {
+        // Bound the samples held in memory while the stream is congested
+        memory_budget = participants::STREAM_SINK_DEFAULT_MEMORY_BUDGET;
+    }
+
+    // Create a participant configuration per extra domain, as a copy of the one of the simple participant
+    std::vector<std::shared_ptr<SimpleParticipantConfiguration>> extra_configurations;
+
+    // The domain of every participant receiving samples, written in the channels of their topics.
+    // NOTE: Only filled when recording several domains, so a single domain recording looks up no domain per sample.
+    std::map<ParticipantId, DomainIdType> participant_domains;
+
+    if (!configuration_.extra_domains.empty())
+    {
+        participant_domains[configuration_.simple_configuration->id] =
+                configuration_.simple_configuration->domain.domain_id;
+    }
+
+    for (const auto& domain : configuration_.extra_domains)
+    {
+        auto extra_configuration = std::make_shared<SimpleParticipantConfiguration>(
+            *configuration_.simple_configuration);
+        extra_configuration->id = configuration_.simple_configuration->id + "_" + std::to_string(domain.domain_id);
+        extra_configuration->domain = domain;
+
+        participant_domains[extra_configuration->id] = domain.domain_id;
+        extra_configurations.push_back(extra_configuration);
+    }
+
     // Create MCAP Handler configuration
     participants::McapHandlerConfiguration handler_config(
         output_settings,
@@ -110,7 +188,17 @@ DdsRecorder::DdsRecorder(
         configuration_.only_with_type,
         configuration_.mcap_writer_options,
         configuration_.record_types,
-        configuration_.ros2_types);
+        configuration_.ros2_types,
+        configuration_.record_statistics,
+        memory_budget,
+        configuration_.lazy_channels,
+        configuration_.types_sidecar,
+        configuration_.log_time_clock_configuration,
+        configuration_.chunking_configuration,
+        configuration_.blobs_configuration,
+        configuration_.ingestion_lanes,
+        configuration_.keyframes,
+        participant_domains);
 
     if (file_tracker == nullptr)
     {
@@ -127,11 +215,28 @@ DdsRecorder::DdsRecorder(
         std::bind(&DdsRecorder::on_disk_full, this));
 
     // Create DynTypes Participant
-    dyn_participant_ = std::make_shared<DynTypesParticipant>(
-        configuration_.simple_configuration,
-        payload_pool_,
-        discovery_database_);
-    dyn_participant_->init();
+    {
+        // The Fast DDS threads inherit the placement of the thread creating them
+        participants::ScopedThreadPlacement placement(participants::ThreadKind::dds, "ddsrec.dds");
+
+        dyn_participant_ = std::make_shared<DynTypesParticipant>(
+            configuration_.simple_configuration,
+            payload_pool_,
+            discovery_database_);
+        dyn_participant_->init();
+
+        // NOTE: The participants of every domain share the payload pool, the discovery database and the handler.
+        for (const auto& extra_configuration : extra_configurations)
+        {
+            auto extra_participant = std::make_shared<DynTypesParticipant>(
+                extra_configuration,
+                payload_pool_,
+                discovery_database_);
+            extra_participant->init();
+
+            extra_dyn_participants_.push_back(extra_participant);
+        }
+    }
 
     // Create Recorder Participant
     recorder_participant_ = std::make_shared<SchemaParticipant>(
@@ -153,13 +258,38 @@ DdsRecorder::DdsRecorder(
         recorder_participant_
         );
 
+    for (const auto& extra_participant : extra_dyn_participants_)
+    {
+        participants_database_->add_participant(
+            extra_participant->id(),
+            extra_participant
+            );
+    }
+
+    if (!extra_dyn_participants_.empty())
+    {
+        // Route the samples of every domain to the recorder participant only, so the domains are not bridged
+        auto& routes = configuration_.ddspipe_configuration.routes.routes;
+        routes[dyn_participant_->id()] = {recorder_participant_->id()};
+
+        for (const auto& extra_participant : extra_dyn_participants_)
+        {
+            routes[extra_participant->id()] = {recorder_participant_->id()};
+        }
+    }
+
     // Create DDS Pipe
-    pipe_ = std::make_unique<DdsPipe>(
-        configuration_.ddspipe_configuration,
-        discovery_database_,
-        payload_pool_,
-        participants_database_,
-        thread_pool_);
+    {
+        // The DDS Pipe enables the thread pool when created
+        participants::ScopedThreadPlacement placement(participants::ThreadKind::workers, "ddsrec.worker");
+
+        pipe_ = std::make_unique<DdsPipe>(
+            configuration_.ddspipe_configuration,
+            discovery_database_,
+            payload_pool_,
+            participants_database_,
+            thread_pool_);
+    }
 
     // Create a Monitor
     auto monitor_configuration = configuration.monitor_configuration;
@@ -174,6 +304,13 @@ DdsRecorder::DdsRecorder(
     {
         monitor_->monitor_topics();
     }
+
+    // Create the metrics exporter
+    if (configuration_.metrics_configuration.enabled)
+    {
+        metrics_exporter_ = std::make_unique<participants::PrometheusExporter>(configuration_.metrics_configuration);
+        metrics_exporter_->start();
+    }
 }
 
 utils::ReturnCode DdsRecorder::reload_configuration(
@@ -181,6 +318,9 @@ utils::ReturnCode DdsRecorder::reload_configuration(
 {
     load_internal_topics_(new_configuration);
 
+    // The participants (and hence their routes) are not reloaded
+    new_configuration.ddspipe_configuration.routes = configuration_.ddspipe_configuration.routes;
+
     // Update the Recorder's configuration
     configuration_ = new_configuration;
 
@@ -197,14 +337,21 @@ void DdsRecorder::pause()
     mcap_handler_->pause();
 }
 
-void DdsRecorder::suspend()
+void DdsRecorder::suspend(
+        const std::function<void()>& on_finalized /* = nullptr */)
+{
+    mcap_handler_->stop(false, on_finalized);
+}
+
+void DdsRecorder::stop(
+        const std::function<void()>& on_finalized /* = nullptr */)
 {
-    mcap_handler_->stop();
+    mcap_handler_->stop(false, on_finalized);
 }
 
-void DdsRecorder::stop()
+void DdsRecorder::wait_for_finalization()
 {
-    mcap_handler_->stop();
+    mcap_handler_->wait_for_finalization();
 }
 
 void DdsRecorder::trigger_event()
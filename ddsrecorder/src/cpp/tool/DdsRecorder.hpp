@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <cpp_utils/event/MultipleEventHandler.hpp>
 #include <cpp_utils/ReturnCode.hpp>
@@ -31,9 +33,11 @@
 #include <ddspipe_participants/participant/dynamic_types/DynTypesParticipant.hpp>
 #include <ddspipe_participants/participant/dynamic_types/SchemaParticipant.hpp>
 
+#include <ddsrecorder_participants/recorder/efficiency/payload/SlabPayloadPool.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapHandler.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/monitoring/DdsRecorderMonitor.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/PrometheusExporter.hpp>
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
 
 #include <ddsrecorder_yaml/recorder/YamlReaderConfiguration.hpp>
@@ -45,7 +49,7 @@ namespace recorder {
 //! State of the DdsRecorder instance
 ENUMERATION_BUILDER(
     DdsRecorderStateCode,
-    STOPPED,                  //! Internal entities are not created and thus no messages are received.
+    STOPPED,                  //! Output file closed. Internal entities may be kept to restart faster, but messages are discarded.
     SUSPENDED,                //! Messages are received (internal entities created) but discarded.
     RUNNING,                  //! Messages are stored in MCAP file.
     PAUSED                    //! Messages are stored in buffer and stored in MCAP file if event triggered.
@@ -109,11 +113,24 @@ public:
     //! Pause recorder (\c mcap_handler_)
     void pause();
 
-    //! Suspend recorder (stop \c mcap_handler_)
-    void suspend();
+    /**
+     * Suspend recorder (stop \c mcap_handler_).
+     *
+     * @param on_finalized: Callback to execute (from another thread) once the output file is closed.
+     */
+    void suspend(
+            const std::function<void()>& on_finalized = nullptr);
 
-    //! Stop recorder (\c mcap_handler_)
-    void stop();
+    /**
+     * Stop recorder (\c mcap_handler_).
+     *
+     * @param on_finalized: Callback to execute (from another thread) once the output file is closed.
+     */
+    void stop(
+            const std::function<void()>& on_finalized = nullptr);
+
+    //! Wait until the output file closed by the last \c stop or \c suspend has been finalized
+    void wait_for_finalization();
 
     //! Trigger event (in \c mcap_handler_)
     void trigger_event();
@@ -155,6 +172,9 @@ protected:
     //! Dynamic Types Participant
     std::shared_ptr<eprosima::ddspipe::participants::DynTypesParticipant> dyn_participant_;
 
+    //! Dynamic Types Participants of the extra domains (one per domain)
+    std::vector<std::shared_ptr<eprosima::ddspipe::participants::DynTypesParticipant>> extra_dyn_participants_;
+
     //! Schema Participant
     std::shared_ptr<eprosima::ddspipe::participants::SchemaParticipant> recorder_participant_;
 
@@ -164,6 +184,9 @@ protected:
     //! Monitor
     std::unique_ptr<ddspipe::core::Monitor> monitor_;
 
+    //! Prometheus metrics exporter
+    std::unique_ptr<participants::PrometheusExporter> metrics_exporter_;
+
     //! Reference to event handler used for thread synchronization in main application
     std::shared_ptr<eprosima::utils::event::MultipleEventHandler> event_handler_;
 };
@@ -12,9 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -33,7 +40,12 @@
 
 #include <cpp_utils/ros2_mangling.hpp>
 
+#include <ddsrecorder_participants/common/mcap/McapBlob.hpp>
+#include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/embedded/EmbeddedRecorder.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
+#include <ddsrecorder_participants/verifier/McapVerifier.hpp>
 #include <ddsrecorder_yaml/recorder/yaml_configuration_tags.hpp>
 #include <ddsrecorder_yaml/recorder/YamlReaderConfiguration.hpp>
 
@@ -71,6 +83,7 @@ namespace test {
 // Publisher
 
 const unsigned int DOMAIN = 222;
+const unsigned int EXTRA_DOMAIN = 223;
 
 const std::string dds_topic_name = "TypeIntrospectionTopic";
 const std::string dds_type_name = "HelloWorld";
@@ -96,7 +109,12 @@ std::unique_ptr<DdsRecorder> create_recorder(
         const int downsampling,
         DdsRecorderState recorder_state = DdsRecorderState::RUNNING,
         const unsigned int event_window = 20,
-        const bool ros2_types = false)
+        const bool ros2_types = false,
+        const bool record_statistics = false,
+        const bool lazy_channels = false,
+        const participants::McapBlobsConfiguration& blobs = {},
+        const participants::OutputSinkKind sink = participants::OutputSinkKind::file,
+        const std::vector<eprosima::ddspipe::core::types::DomainId>& extra_domains = {})
 {
     YAML::Node yml;
 
@@ -110,6 +128,11 @@ std::unique_ptr<DdsRecorder> create_recorder(
     domainId.domain_id = test::DOMAIN;
     configuration.simple_configuration->domain = domainId;
     configuration.ros2_types = ros2_types;
+    configuration.record_statistics = record_statistics;
+    configuration.lazy_channels = lazy_channels;
+    configuration.blobs_configuration = blobs;
+    configuration.output_sink = sink;
+    configuration.extra_domains = extra_domains;
 
     std::shared_ptr<eprosima::ddsrecorder::participants::FileTracker> file_tracker;
 
@@ -196,12 +219,16 @@ eprosima::fastdds::dds::traits<eprosima::fastdds::dds::DynamicData>::ref_type re
         const std::string file_name,
         const unsigned int num_msgs = 1,
         const unsigned int downsampling = 1,
-        const bool ros2_types = false)
+        const bool ros2_types = false,
+        const bool record_statistics = false,
+        const bool lazy_channels = false,
+        const participants::McapBlobsConfiguration& blobs = {})
 {
     eprosima::fastdds::dds::traits<eprosima::fastdds::dds::DynamicData>::ref_type send_data;
     {
         // Create Recorder
-        auto recorder = create_recorder(file_name, downsampling, DdsRecorderState::RUNNING, 20, ros2_types);
+        auto recorder = create_recorder(file_name, downsampling, DdsRecorderState::RUNNING, 20, ros2_types,
+                        record_statistics, lazy_channels, blobs);
 
         // Create Publisher
         ros2_types ? create_publisher(test::ros2_topic_name, test::dds_type_name, test::DOMAIN) : create_publisher(
@@ -433,6 +460,404 @@ TEST(McapFileCreationTest, mcap_data_num_msgs)
 
 }
 
+TEST(McapFileCreationTest, mcap_channel_statistics)
+{
+
+    const std::string file_name = "output_mcap_channel_statistics";
+
+    record(file_name, test::n_msgs, 1, false, true);
+
+    mcap::McapReader mcap_reader;
+    auto status = mcap_reader.open(file_name + ".mcap");
+    ASSERT_TRUE(status.ok());
+
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::ForceScan);
+    ASSERT_TRUE(status.ok());
+
+    const auto channels = mcap_reader.channels();
+    ASSERT_EQ(channels.size(), 1u);
+    const auto channel = channels.begin()->second;
+
+    auto metadatas = mcap_reader.metadata();
+    const std::string statistics_name = eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_METADATA_PREFIX +
+            std::to_string(channel->id);
+    ASSERT_EQ(metadatas.count(statistics_name), 1u);
+
+    auto statistics = metadatas[statistics_name].metadata;
+    mcap_reader.close();
+
+    // Test data
+    ASSERT_EQ(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_TOPIC], test::dds_topic_name);
+    ASSERT_EQ(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_MESSAGES],
+            std::to_string(test::n_msgs));
+    ASSERT_GT(std::stoull(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_BYTES]), 0u);
+    ASSERT_LE(
+        std::stoull(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_MIN_INTER_ARRIVAL]),
+        std::stoull(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_MEAN_INTER_ARRIVAL]));
+    ASSERT_LE(
+        std::stoull(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_MEAN_INTER_ARRIVAL]),
+        std::stoull(statistics[eprosima::ddsrecorder::participants::CHANNEL_STATISTICS_MAX_INTER_ARRIVAL]));
+
+}
+
+TEST(McapFileCreationTest, mcap_lazy_channels)
+{
+
+    const std::string file_name = "output_mcap_lazy_channels";
+
+    record(file_name, test::n_msgs, 1, false, false, true);
+
+    mcap::McapReader mcap_reader;
+    auto status = mcap_reader.open(file_name + ".mcap");
+    ASSERT_TRUE(status.ok());
+
+    // The channels are only written in the data section
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::ForceScan);
+    ASSERT_TRUE(status.ok());
+
+    const auto channels = mcap_reader.channels();
+    ASSERT_EQ(channels.size(), 1u);
+    const auto channel = channels.begin()->second;
+    ASSERT_EQ(channel->topic, test::dds_topic_name);
+    ASSERT_EQ(mcap_reader.schemas().count(channel->schemaId), 1u);
+
+    unsigned int n_received_msgs = 0;
+    auto messages = mcap_reader.readMessages();
+    for (auto it = messages.begin(); it != messages.end(); it++)
+    {
+        ASSERT_EQ(it->channel->id, channel->id);
+        n_received_msgs++;
+    }
+    mcap_reader.close();
+
+    // Test data
+    ASSERT_EQ(test::n_msgs, n_received_msgs);
+
+}
+
+TEST(McapFileCreationTest, mcap_blobs)
+{
+
+    const std::string file_name = "output_mcap_blobs";
+
+    // Write every payload out of the chunks
+    participants::McapBlobsConfiguration blobs;
+    blobs.enabled = true;
+    blobs.threshold = 1;
+    blobs.compression = mcap::Compression::Zstd;
+
+    record(file_name, test::n_msgs, 1, false, false, false, blobs);
+
+    mcap::McapReader mcap_reader;
+    auto status = mcap_reader.open(file_name + ".mcap");
+    ASSERT_TRUE(status.ok());
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan);
+    ASSERT_TRUE(status.ok());
+
+    // Every blob is an attachment
+    ASSERT_EQ(mcap_reader.attachmentIndexes().count(participants::McapBlob::ATTACHMENT_NAME), test::n_msgs);
+
+    // Every message references a blob holding its payload
+    std::unique_ptr<std::FILE, decltype(& std::fclose)> file(std::fopen((file_name + ".mcap").c_str(), "rb"),
+            &std::fclose);
+    ASSERT_TRUE(file != nullptr);
+    mcap::FileReader blobs_source(file.get());
+
+    const std::string message(test::send_message);
+
+    unsigned int n_received_msgs = 0;
+    auto messages = mcap_reader.readMessages();
+    for (auto it = messages.begin(); it != messages.end(); it++)
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+        ASSERT_TRUE(participants::McapBlob::parse_reference(it->message.data, it->message.dataSize, offset, size));
+
+        mcap::ByteArray payload;
+        participants::McapBlob::read(blobs_source, offset, size, payload);
+        ASSERT_EQ(payload.size(), size);
+
+        const std::string payload_str(reinterpret_cast<const char*>(payload.data()), payload.size());
+        ASSERT_NE(payload_str.find(message), std::string::npos);
+
+        n_received_msgs++;
+    }
+    mcap_reader.close();
+
+    // Test data
+    ASSERT_EQ(test::n_msgs, n_received_msgs);
+
+}
+
+TEST(McapFileCreationTest, mcap_blobs_deduplicated)
+{
+
+    const std::string file_name = "output_mcap_blobs_deduplicated";
+
+    // Write every payload out of the chunks, once per distinct payload
+    participants::McapBlobsConfiguration blobs;
+    blobs.enabled = true;
+    blobs.threshold = 1;
+    blobs.deduplicate = true;
+
+    // Every sample sent holds the same payload
+    record(file_name, test::n_msgs, 1, false, false, false, blobs);
+
+    mcap::McapReader mcap_reader;
+    auto status = mcap_reader.open(file_name + ".mcap");
+    ASSERT_TRUE(status.ok());
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan);
+    ASSERT_TRUE(status.ok());
+
+    // The payload is written in a single blob
+    ASSERT_EQ(mcap_reader.attachmentIndexes().count(participants::McapBlob::ATTACHMENT_NAME), 1u);
+
+    // Every message references that blob
+    std::unique_ptr<std::FILE, decltype(& std::fclose)> file(std::fopen((file_name + ".mcap").c_str(), "rb"),
+            &std::fclose);
+    ASSERT_TRUE(file != nullptr);
+    mcap::FileReader blobs_source(file.get());
+
+    const std::string message(test::send_message);
+
+    std::set<std::uint64_t> offsets;
+    unsigned int n_received_msgs = 0;
+    auto messages = mcap_reader.readMessages();
+    for (auto it = messages.begin(); it != messages.end(); it++)
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+        ASSERT_TRUE(participants::McapBlob::parse_reference(it->message.data, it->message.dataSize, offset, size));
+        offsets.insert(offset);
+
+        mcap::ByteArray payload;
+        participants::McapBlob::read(blobs_source, offset, size, payload);
+
+        const std::string payload_str(reinterpret_cast<const char*>(payload.data()), payload.size());
+        ASSERT_NE(payload_str.find(message), std::string::npos);
+
+        n_received_msgs++;
+    }
+    mcap_reader.close();
+
+    // Test data
+    ASSERT_EQ(test::n_msgs, n_received_msgs);
+    ASSERT_EQ(offsets.size(), 1u);
+
+}
+
+TEST(McapFileCreationTest, mcap_embedded_in_memory)
+{
+    // Get the type without creating any DDS entity
+    eprosima::fastdds::dds::TypeSupport type(new HelloWorldPubSubType());
+    type->register_type_object_representation();
+
+    eprosima::fastdds::dds::xtypes::TypeObjectPair dyn_type_objects;
+    ASSERT_EQ(eprosima::fastdds::dds::RETCODE_OK,
+            DomainParticipantFactory::get_instance()->type_object_registry().get_type_objects(
+                test::dds_type_name,
+                dyn_type_objects));
+
+    auto dynamic_type = eprosima::fastdds::dds::DynamicTypeBuilderFactory::get_instance()->create_type_w_type_object(
+        dyn_type_objects.complete_type_object)->build();
+
+    auto dynamic_data = eprosima::fastdds::dds::DynamicDataFactory::get_instance()->create_data(dynamic_type);
+    dynamic_data->set_uint32_value(dynamic_data->get_member_id_by_name("index"), test::index);
+    dynamic_data->set_string_value(dynamic_data->get_member_id_by_name("message"), test::send_message);
+
+    eprosima::fastdds::dds::DynamicPubSubType pubsubType(dynamic_type);
+    const auto size = pubsubType.calculate_serialized_size(
+        &dynamic_data,
+        eprosima::fastdds::dds::DEFAULT_DATA_REPRESENTATION);
+
+    participants::EmbeddedRecorderConfiguration configuration;
+    configuration.sink = participants::OutputSinkKind::memory;
+
+    std::vector<participants::File> files;
+    {
+        participants::EmbeddedRecorder recorder(configuration);
+        recorder.register_type(dynamic_type);
+
+        for (unsigned int i = 0; i < test::n_msgs; i++)
+        {
+            // Serialize the sample straight into a payload of the recorder
+            eprosima::ddspipe::core::types::Payload payload;
+            recorder.reserve_payload(size, payload);
+            ASSERT_TRUE(pubsubType.serialize(&dynamic_data, payload,
+                    eprosima::fastdds::dds::DEFAULT_DATA_REPRESENTATION));
+
+            recorder.write(test::dds_topic_name, test::dds_type_name, payload);
+        }
+
+        recorder.stop();
+        files = recorder.closed_files();
+    }
+
+    // The output file is only kept in memory
+    ASSERT_EQ(files.size(), 1u);
+    ASSERT_TRUE(files[0].contents != nullptr);
+    ASSERT_FALSE(std::filesystem::exists(files[0].name));
+
+    mcap::BufferReader buffer;
+    buffer.reset(files[0].contents->data(), files[0].contents->size(), files[0].contents->size());
+
+    mcap::McapReader mcap_reader;
+    ASSERT_TRUE(mcap_reader.open(buffer).ok());
+
+    unsigned int n_received_msgs = 0;
+    auto messages = mcap_reader.readMessages();
+    for (auto it = messages.begin(); it != messages.end(); it++)
+    {
+        ASSERT_EQ(it->channel->topic, test::dds_topic_name);
+        ASSERT_EQ(it->schema->name, test::dds_type_name);
+        n_received_msgs++;
+    }
+    mcap_reader.close();
+
+    // Test data
+    ASSERT_EQ(test::n_msgs, n_received_msgs);
+}
+
+TEST(McapFileCreationTest, mcap_discard_sink)
+{
+    const std::string file_name = "output_mcap_discard_sink";
+
+    participants::RecorderMetrics::get_instance().reset();
+
+    {
+        auto recorder = create_recorder(file_name, 1, DdsRecorderState::RUNNING, 20, false, false, false, {},
+                        participants::OutputSinkKind::null);
+
+        create_publisher(test::dds_topic_name, test::dds_type_name, test::DOMAIN);
+
+        for (unsigned int i = 0; i < test::n_msgs; i++)
+        {
+            send_sample(test::index);
+        }
+    }
+
+    // The messages go through the whole recording path, but nothing is written to disk
+    const auto metrics = participants::RecorderMetrics::get_instance().snapshot();
+    ASSERT_EQ(metrics.messages_written, test::n_msgs);
+    ASSERT_GT(metrics.bytes_written, 0u);
+    ASSERT_EQ(metrics.files_closed, 1u);
+
+    ASSERT_FALSE(std::filesystem::exists(file_name + ".mcap"));
+    ASSERT_FALSE(std::filesystem::exists(file_name + ".mcap.tmp~"));
+}
+
+TEST(McapFileCreationTest, mcap_multiple_domains)
+{
+    const std::string file_name = "output_mcap_multiple_domains";
+
+    {
+        eprosima::ddspipe::core::types::DomainId extra_domain;
+        extra_domain.domain_id = test::EXTRA_DOMAIN;
+
+        auto recorder = create_recorder(file_name, 1, DdsRecorderState::RUNNING, 20, false, false, false, {},
+                        participants::OutputSinkKind::file, {extra_domain});
+
+        // The same topic is published in both domains
+        for (const auto domain : {test::DOMAIN, test::EXTRA_DOMAIN})
+        {
+            create_publisher(test::dds_topic_name, test::dds_type_name, domain);
+
+            for (unsigned int i = 0; i < test::n_msgs; i++)
+            {
+                send_sample(test::index);
+            }
+        }
+    }
+
+    mcap::McapReader mcap_reader;
+    auto status = mcap_reader.open(file_name + ".mcap");
+    ASSERT_TRUE(status.ok());
+
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::ForceScan);
+    ASSERT_TRUE(status.ok());
+
+    // One channel per domain, told apart by their domain
+    const auto channels = mcap_reader.channels();
+    ASSERT_EQ(channels.size(), 2u);
+
+    std::map<mcap::ChannelId, std::string> channel_domains;
+
+    for (const auto& channel : channels)
+    {
+        ASSERT_EQ(channel.second->topic, test::dds_topic_name);
+        ASSERT_EQ(channel.second->metadata.count(eprosima::ddsrecorder::participants::DOMAIN_ID_METADATA), 1u);
+        channel_domains[channel.first] =
+                channel.second->metadata.at(eprosima::ddsrecorder::participants::DOMAIN_ID_METADATA);
+    }
+
+    ASSERT_EQ(
+        (std::set<std::string>{channel_domains.begin()->second, std::next(channel_domains.begin())->second}),
+        (std::set<std::string>{std::to_string(test::DOMAIN), std::to_string(test::EXTRA_DOMAIN)}));
+
+    std::map<std::string, unsigned int> n_received_msgs;
+    auto messages = mcap_reader.readMessages();
+    for (auto it = messages.begin(); it != messages.end(); it++)
+    {
+        n_received_msgs[channel_domains.at(it->channel->id)]++;
+    }
+    mcap_reader.close();
+
+    // Test data
+    ASSERT_EQ(n_received_msgs[std::to_string(test::DOMAIN)], test::n_msgs);
+    ASSERT_EQ(n_received_msgs[std::to_string(test::EXTRA_DOMAIN)], test::n_msgs);
+}
+
+TEST(McapFileCreationTest, mcap_verify)
+{
+
+    const std::string file_name = "output_mcap_verify";
+
+    record(file_name, test::n_msgs);
+
+    participants::McapVerifierConfiguration configuration;
+    configuration.sampled_messages = test::n_msgs;
+
+    const participants::McapVerifier verifier(configuration);
+
+    // The recorded file is consistent, and its messages are deserialized with the recorded types
+    auto results = verifier.verify({file_name + ".mcap"});
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_TRUE(results[0].ok());
+    ASSERT_GT(results[0].chunks, 0u);
+    ASSERT_EQ(results[0].crc_errors, 0u);
+    ASSERT_EQ(results[0].messages, test::n_msgs);
+    ASSERT_EQ(results[0].topics.count(test::dds_topic_name), 1u);
+
+    const auto& topic = results[0].topics.at(test::dds_topic_name);
+    ASSERT_EQ(topic.messages, test::n_msgs);
+    ASSERT_EQ(topic.sampled, test::n_msgs);
+    ASSERT_EQ(topic.decode_errors, 0u);
+    ASSERT_FALSE(topic.missing_type);
+
+    // Corrupt the last byte of the first chunk
+    mcap::McapReader mcap_reader;
+    auto status = mcap_reader.open(file_name + ".mcap");
+    ASSERT_TRUE(status.ok());
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan);
+    ASSERT_TRUE(status.ok());
+    const auto& chunk_index = mcap_reader.chunkIndexes().front();
+    const auto offset = chunk_index.chunkStartOffset + chunk_index.chunkLength - 1;
+    mcap_reader.close();
+
+    {
+        std::fstream file(file_name + ".mcap", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(offset);
+        const char byte = static_cast<char>(file.get());
+        file.seekp(offset);
+        file.put(static_cast<char>(byte ^ 0xff));
+    }
+
+    results = verifier.verify({file_name + ".mcap"});
+    ASSERT_FALSE(results[0].ok());
+    ASSERT_GT(results[0].crc_errors + results[0].chunk_errors, 0u);
+
+}
+
 TEST(McapFileCreationTest, mcap_data_num_msgs_downsampling)
 {
 
@@ -884,6 +1309,47 @@ TEST(McapFileCreationTest, transition_paused_event_suspend)
 
 }
 
+TEST(McapFileCreationTest, transition_running_stop_finalized)
+{
+    const std::string file_name = "output_transition_running_stop_finalized";
+
+    unsigned int n_data = rand() % 10 + 1;
+    std::atomic<bool> finalized{false};
+
+    // Create Publisher
+    create_publisher(test::dds_topic_name, test::dds_type_name, test::DOMAIN);
+
+    // Create Recorder
+    auto recorder = create_recorder(file_name, 1, DdsRecorderState::RUNNING);
+
+    // Send data
+    for (unsigned int i = 0; i < n_data; i++)
+    {
+        send_sample();
+    }
+
+    recorder->stop([&finalized]()
+            {
+                finalized = true;
+            });
+    recorder->wait_for_finalization();
+
+    ASSERT_TRUE(finalized);
+
+    // The output file is closed while the recorder is still alive
+    mcap::McapReader mcap_reader;
+    auto messages = get_msgs_mcap(file_name, mcap_reader);
+
+    unsigned int n_received_msgs = 0;
+    for (auto it = messages.begin(); it != messages.end(); it++)
+    {
+        n_received_msgs++;
+    }
+    mcap_reader.close();
+
+    ASSERT_EQ(n_received_msgs, n_data);
+}
+
 int main(
         int argc,
         char** argv)
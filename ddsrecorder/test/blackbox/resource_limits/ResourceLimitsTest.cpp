@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <vector>
 
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -30,6 +31,8 @@
 #include <ddspipe_yaml/Yaml.hpp>
 #include <ddspipe_yaml/YamlReader.hpp>
 
+#include <mcap/reader.hpp>
+
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
 #include <ddsrecorder_yaml/recorder/YamlReaderConfiguration.hpp>
 
@@ -179,6 +182,28 @@ protected:
         return is_acceptable;
     }
 
+    std::vector<std::vector<std::byte>> read_payloads_(
+            const std::filesystem::path& file_path)
+    {
+        std::vector<std::vector<std::byte>> payloads;
+
+        mcap::McapReader reader;
+
+        if (!reader.open(file_path.string()).ok())
+        {
+            return payloads;
+        }
+
+        for (const auto& view : reader.readMessages())
+        {
+            payloads.emplace_back(view.message.data, view.message.data + view.message.dataSize);
+        }
+
+        reader.close();
+
+        return payloads;
+    }
+
     DomainParticipant* participant_ = nullptr;
     Publisher* publisher_ = nullptr;
     Topic* topic_ = nullptr;
@@ -387,6 +412,50 @@ TEST_F(ResourceLimitsTest, file_rotation)
     }
 }
 
+/**
+ * @brief Test that the DDS Recorder writes the last sample of a transient-local topic at the start of every new file.
+ *
+ * A writer publishes enough messages to fill the first output file, so the DDS Recorder opens a second one.
+ *
+ * CASES:
+ * - check that the second file starts with the last message of the first file (its keyframe).
+ */
+TEST_F(ResourceLimitsTest, keyframes)
+{
+    const std::string OUTPUT_FILE_NAME = "keyframes_test";
+    const auto OUTPUT_FILE_PATHS = get_output_file_paths_(test::limits::MAX_FILES, OUTPUT_FILE_NAME);
+
+    configuration_->output_resource_limits_max_file_size = test::limits::MAX_FILE_SIZE;
+    configuration_->output_resource_limits_max_size = test::limits::MAX_SIZE;
+    configuration_->keyframes = true;
+
+    // Delete the output files if they exist
+    for (const auto& path : OUTPUT_FILE_PATHS)
+    {
+        ASSERT_TRUE(delete_file_(path));
+    }
+
+    {
+        ddsrecorder::recorder::DdsRecorder recorder(*configuration_,
+                ddsrecorder::recorder::DdsRecorderStateCode::RUNNING, file_tracker_, OUTPUT_FILE_NAME);
+
+        // Send more messages than can be stored in a file with a size of max-file-size
+        publish_msgs_(test::limits::FILE_OVERFLOW_THRESHOLD);
+
+        // Make sure the DDS Recorder has received all the messages
+        ASSERT_EQ(writer_->wait_for_acknowledgments(test::MAX_WAITING_TIME), RETCODE_OK);
+    }
+
+    const auto first_file_payloads = read_payloads_(OUTPUT_FILE_PATHS[0]);
+    const auto second_file_payloads = read_payloads_(OUTPUT_FILE_PATHS[1]);
+
+    ASSERT_FALSE(first_file_payloads.empty());
+    ASSERT_FALSE(second_file_payloads.empty());
+
+    // The keyframe of the topic is the last message written in the first file
+    ASSERT_EQ(second_file_payloads.front(), first_file_payloads.back());
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,179 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapCollector.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ddsrecorder_participants/collector/McapCollectorConfiguration.hpp>
+#include <ddsrecorder_participants/common/mcap/McapStreamFrame.hpp>
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Receives the MCAP files streamed by a DDS Recorder (see \c McapStreamWriter ) and writes them to disk.
+ *
+ * Each file is written as a temporary file, renamed to its name once complete, so a reader never takes a file being
+ * collected. The files are rotated by the recorder; on top of that, the collector removes the oldest collected files
+ * beyond \c max_size .
+ *
+ * A file whose stream is interrupted is kept open, so the recorder resumes it once reconnected. If the recorder
+ * cannot send again every byte the collector missed, the file is abandoned: its temporary file is left as it is.
+ *
+ * A single recorder is served at a time.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapCollector
+{
+public:
+
+    /**
+     * @brief Construct a \c McapCollector .
+     *
+     * @param configuration Where to receive the stream from and where to write the files.
+     * @param on_input_closed Called once the standard input is closed (applies to \c pipe ).
+     */
+    McapCollector(
+            const McapCollectorConfiguration& configuration,
+            std::function<void()> on_input_closed = nullptr);
+
+    //! Stop collecting, abandoning the files not complete yet
+    ~McapCollector();
+
+    /**
+     * @brief Start collecting files in a background thread.
+     *
+     * @throws \c InitializationException if the output directory cannot be created or the socket cannot be created,
+     * bound or listened on.
+     */
+    void start();
+
+    //! Stop collecting, abandoning the files not complete yet
+    void stop() noexcept;
+
+    //! Paths of the files collected (and not removed by the rotation yet), oldest first
+    std::vector<std::string> collected_files() const;
+
+protected:
+
+    //! A file being collected
+    struct File
+    {
+        std::string name;
+        std::ofstream stream;
+        std::uint64_t size{0};
+        bool broken{false};
+    };
+
+    //! Create, bind and listen on the TCP or Unix domain socket
+    void open_socket_();
+
+    //! Close the listening socket (and remove the Unix domain socket file)
+    void close_socket_() noexcept;
+
+    //! Receive the stream (from the standard input or from every accepted connection) until stopped
+    void serve_routine_();
+
+    //! Receive frames from \c fd until it is closed, a frame is corrupted or the collector is stopped
+    void receive_(
+            int fd);
+
+    //! Read \c size bytes from \c fd
+    bool read_(
+            int fd,
+            std::byte* data,
+            std::size_t size) const;
+
+    //! Start (or resume) the file \c file_id named \c name
+    void open_file_(
+            const std::uint64_t file_id,
+            const std::string& name);
+
+    //! Write \c payload at \c offset of the file \c file_id
+    void write_file_(
+            const std::uint64_t file_id,
+            const std::uint64_t offset,
+            const std::vector<std::byte>& payload);
+
+    //! Complete the file \c file_id , of \c size bytes
+    void close_file_(
+            const std::uint64_t file_id,
+            const std::uint64_t size);
+
+    //! Stop writing \c file , leaving its temporary file behind
+    void abandon_file_(
+            File& file,
+            const std::string& reason);
+
+    //! Remove the oldest collected files beyond \c max_size
+    void rotate_nts_();
+
+    //! Path of the file named \c name once complete
+    std::string path_(
+            const std::string& name) const;
+
+    //! Path of the file named \c name while being collected
+    std::string tmp_path_(
+            const std::string& name) const;
+
+    //! The configuration of the collector
+    const McapCollectorConfiguration configuration_;
+
+    //! Called once the standard input is closed
+    std::function<void()> on_input_closed_;
+
+    //! Whether the collector thread must keep running
+    std::atomic<bool> running_{false};
+
+    //! Thread receiving the stream
+    std::thread thread_;
+
+    //! Listening socket (-1 if not open)
+    int listen_fd_{-1};
+
+    //! Files being collected (only accessed by the collector thread)
+    std::map<std::uint64_t, File> files_;
+
+    //! Protects \c collected_ and \c collected_size_
+    mutable std::mutex mutex_;
+
+    //! Path and size of the files collected, oldest first
+    std::deque<std::pair<std::string, std::uint64_t>> collected_;
+
+    //! Aggregate size of the files collected
+    std::uint64_t collected_size_{0};
+
+    //! Time [ms] to wait for new connections or data before checking whether the collector has been stopped
+    static constexpr int POLL_TIMEOUT_MS = 200;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,56 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapCollectorConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <ddsrecorder_participants/recorder/mcap/McapStreamConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Structure encapsulating all of \c McapCollector configuration options.
+ */
+struct McapCollectorConfiguration
+{
+    //! Where to receive the stream from (\c pipe reads the standard input)
+    McapStreamKind kind{McapStreamKind::tcp};
+
+    //! Address to bind the TCP port to (applies to tcp)
+    std::string address{"127.0.0.1"};
+
+    //! TCP port to listen on (applies to tcp)
+    std::uint16_t port{9475};
+
+    //! Path of the Unix domain socket to listen on (applies to unix_socket)
+    std::string path{};
+
+    //! Directory where the collected files are written
+    std::string output_directory{"."};
+
+    //! Max aggregate size of the collected files, removing the oldest ones beyond it (0 for no limit)
+    std::uint64_t max_size{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,89 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file Crc32.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * CRC-32 (IEEE 802.3, reflected polynomial 0xedb88320) as used by the MCAP format for chunk, data and attachment CRCs.
+ *
+ * The implementation is chosen once, at runtime, depending on the capabilities of the CPU:
+ * - x86_64 with PCLMULQDQ and SSE4.1: folding with carry-less multiplications.
+ * - ARMv8 built with the CRC extension: CRC32 instructions.
+ * - Otherwise: the table-based implementation of the MCAP library.
+ *
+ * Every implementation returns the same values as \c mcap::internal::crc32Update , so the state can be passed from
+ * one to another (i.e. it is neither pre- nor post-inverted).
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI Crc32
+{
+public:
+
+    //! Initial value of a streaming CRC32 calculation
+    static constexpr std::uint32_t INIT = 0xffffffff;
+
+    /**
+     * @brief Update a streaming CRC32 calculation with the fastest implementation available.
+     *
+     * @param crc Current state (\c INIT for the first call).
+     * @param data Bytes to add to the calculation.
+     * @param size Number of bytes in \c data .
+     * @return The updated state.
+     */
+    static std::uint32_t update(
+            const std::uint32_t crc,
+            const void* data,
+            const std::size_t size) noexcept;
+
+    //! Update a streaming CRC32 calculation with the portable (table-based) implementation
+    static std::uint32_t update_portable(
+            const std::uint32_t crc,
+            const void* data,
+            const std::size_t size) noexcept;
+
+    //! Finalize a streaming CRC32 calculation
+    static std::uint32_t finalize(
+            const std::uint32_t crc) noexcept
+    {
+        return crc ^ 0xffffffff;
+    }
+
+    //! Compute the CRC32 of \c data in one go
+    static std::uint32_t compute(
+            const void* data,
+            const std::size_t size) noexcept
+    {
+        return finalize(update(INIT, data, size));
+    }
+
+    //! Name of the implementation selected for this CPU ("pclmul", "armv8-crc" or "table")
+    static const char* implementation() noexcept;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
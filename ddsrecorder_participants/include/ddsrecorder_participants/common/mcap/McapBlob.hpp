@@ -0,0 +1,109 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapBlob.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <mcap/reader.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Payloads written out of the chunks ("blobs").
+ *
+ * A blob is an attachment record, written right away (i.e. ahead of the chunk being built), holding the payload of a
+ * message (optionally compressed, as told by its media type). The message itself is written in the chunk with a
+ * fixed-size reference to the blob instead of its payload. The reference is laid out as (little endian):
+ * - Magic (8 bytes). Its first byte is not zero, so it cannot be mistaken for a CDR encapsulation.
+ * - Offset of the attachment record in the file (8 bytes).
+ * - Size of the payload once decompressed (8 bytes).
+ *
+ * Several references may point to the same blob, when the recorder writes each distinct payload only once per file.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapBlob
+{
+public:
+
+    //! Size of the reference written in the chunk
+    static constexpr std::size_t REFERENCE_SIZE = 24;
+
+    //! Serialized reference to a blob
+    using Reference = std::array<std::byte, REFERENCE_SIZE>;
+
+    //! Name of the attachment records holding blobs
+    static constexpr const char* ATTACHMENT_NAME = "blob";
+
+    //! Content digest of a payload: its size, a 64-bit hash and its CRC32 (only meaningful within a process)
+    using Digest = std::array<std::uint64_t, 3>;
+
+    //! Serialize a reference to the blob written at \c offset holding a payload of \c size bytes
+    static Reference make_reference(
+            const std::uint64_t offset,
+            const std::uint64_t size) noexcept;
+
+    /**
+     * @brief Parse a message payload as a reference to a blob.
+     *
+     * @param data Payload of the message.
+     * @param size Size of the payload of the message.
+     * @param offset Offset of the attachment record of the blob (set only if the payload is a reference).
+     * @param payload_size Size of the payload of the blob (set only if the payload is a reference).
+     * @return Whether the payload is a reference to a blob.
+     */
+    static bool parse_reference(
+            const std::byte* data,
+            const std::uint64_t size,
+            std::uint64_t& offset,
+            std::uint64_t& payload_size) noexcept;
+
+    //! Digest of the payload \c data of \c size bytes, telling apart the payloads to be written in different blobs
+    static Digest digest(
+            const std::byte* data,
+            const std::uint64_t size) noexcept;
+
+    //! Media type of the blobs compressed with \c compression
+    static const char* media_type(
+            const mcap::Compression compression) noexcept;
+
+    /**
+     * @brief Read (and decompress) the payload of the blob at \c offset of \c source .
+     *
+     * @param source File holding the blob. It must not be shared with a reader iterating the messages, since reading
+     * the blob invalidates the data previously read from it.
+     * @param offset Offset of the attachment record of the blob.
+     * @param payload_size Size of the payload of the blob.
+     * @param payload Where to leave the payload.
+     * @throws \c InconsistencyException if the blob cannot be read or decompressed.
+     */
+    static void read(
+            mcap::IReadable& source,
+            const std::uint64_t offset,
+            const std::uint64_t payload_size,
+            mcap::ByteArray& payload);
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
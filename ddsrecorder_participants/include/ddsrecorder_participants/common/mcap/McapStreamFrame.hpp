@@ -0,0 +1,97 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapStreamFrame.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Frames in which the MCAP files are streamed to a collector (see \c McapStreamWriter ).
+ *
+ * Every frame is a fixed-size header followed by \c length bytes of payload. The header is laid out as (little
+ * endian):
+ * - Magic (4 bytes).
+ * - Version (1 byte).
+ * - Kind (1 byte).
+ * - Reserved (2 bytes).
+ * - Id of the file the frame belongs to (8 bytes).
+ * - Offset in the file (8 bytes).
+ * - Length of the payload (8 bytes).
+ *
+ * A file is streamed as an \c open frame (whose payload is the name of the file), \c data frames (whose payloads are
+ * the bytes of the file at their offset) and a \c close frame (whose offset is the final size of the file). Since
+ * every data frame carries its offset, a collector can take frames sent again after a reconnection, and detect the
+ * ones it missed.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapStreamFrame
+{
+public:
+
+    //! Kinds of frames
+    enum class Kind : std::uint8_t
+    {
+        open = 1,           //! A new file starts. The payload is its name.
+        data = 2,           //! The payload holds bytes of the file.
+        close = 3,          //! The file is complete. Its offset is the size of the file.
+    };
+
+    //! Size of the header of every frame
+    static constexpr std::size_t HEADER_SIZE = 32;
+
+    //! Max length of the payload of a frame (larger lengths are taken as a corrupted stream)
+    static constexpr std::uint64_t MAX_LENGTH = 256ull * 1024 * 1024;
+
+    //! Serialized header of a frame
+    using Header = std::array<std::byte, HEADER_SIZE>;
+
+    //! Serialize the header of a frame
+    static Header make_header(
+            const Kind kind,
+            const std::uint64_t file_id,
+            const std::uint64_t offset,
+            const std::uint64_t length) noexcept;
+
+    /**
+     * @brief Parse the header of a frame.
+     *
+     * @param data Header of the frame (\c HEADER_SIZE bytes).
+     * @param kind Kind of the frame (set only if the header is valid).
+     * @param file_id Id of the file of the frame (set only if the header is valid).
+     * @param offset Offset in the file (set only if the header is valid).
+     * @param length Length of the payload (set only if the header is valid).
+     * @return Whether the header is valid.
+     */
+    static bool parse_header(
+            const std::byte* data,
+            Kind& kind,
+            std::uint64_t& file_id,
+            std::uint64_t& offset,
+            std::uint64_t& length) noexcept;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
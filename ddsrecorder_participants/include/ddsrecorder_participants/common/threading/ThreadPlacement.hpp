@@ -0,0 +1,117 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ThreadPlacement.hpp
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacementConfiguration.hpp>
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Process-wide placement of the threads of the recorder and the replayer.
+ *
+ * Every thread is given a name (as shown by \c top -H or a profiler), pinned to the CPUs of its \c ThreadKind and,
+ * if \c numa_local , made to allocate its memory on the NUMA node of the CPUs writing the samples (those of the
+ * workers, or of the event threads if the workers are not pinned). As the memory is allocated on the node of the
+ * thread first touching it, this keeps the payloads (filled by the DDS threads) and the chunk buffers (filled by the
+ * writing threads) on the same node.
+ *
+ * Threads created by other libraries (the DDS Pipe thread pool, Fast DDS) inherit the placement of the thread
+ * creating them, so they are placed by creating them within a \c ScopedThreadPlacement .
+ *
+ * Only supported on Linux: elsewhere threads are left unplaced.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI ThreadPlacement
+{
+public:
+
+    //! Get the process-wide instance
+    static ThreadPlacement& get_instance() noexcept;
+
+    //! Set where the threads placed from now on run
+    void configure(
+            const ThreadPlacementConfiguration& configuration);
+
+    /**
+     * @brief Name and place the calling thread.
+     *
+     * @param kind Kind of the thread.
+     * @param name Name of the thread (truncated to 15 characters).
+     */
+    void place_current_thread(
+            const ThreadKind kind,
+            const std::string& name) const noexcept;
+
+protected:
+
+    ThreadPlacement() = default;
+
+    //! CPUs of \c kind (empty <-> not pinned)
+    const std::set<unsigned int>& cpus_(
+            const ThreadKind kind) const noexcept;
+
+    //! Protects \c configuration_ and \c numa_node_
+    mutable std::mutex mutex_;
+
+    //! Where the threads run
+    ThreadPlacementConfiguration configuration_;
+
+    //! NUMA node where the placed threads allocate their memory (-1 <-> not set)
+    int numa_node_{-1};
+};
+
+/**
+ * @brief Name and place the calling thread for the lifetime of the object.
+ *
+ * Threads created by the calling thread meanwhile inherit its name and placement.
+ * Once destroyed, the calling thread recovers its name, its CPUs and the default memory policy.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI ScopedThreadPlacement
+{
+public:
+
+    ScopedThreadPlacement(
+            const ThreadKind kind,
+            const std::string& name);
+
+    ~ScopedThreadPlacement();
+
+    ScopedThreadPlacement(
+            const ScopedThreadPlacement&) = delete;
+    ScopedThreadPlacement& operator =(
+            const ScopedThreadPlacement&) = delete;
+
+protected:
+
+    //! Placement of the calling thread before the object was created (platform-specific)
+    struct SavedPlacement;
+
+    std::unique_ptr<SavedPlacement> saved_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,62 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ThreadPlacementConfiguration.hpp
+ */
+
+#pragma once
+
+#include <set>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+//! Classes of threads placed together by the \c ThreadPlacement
+enum class ThreadKind
+{
+    dds = 0,                //! Threads created by the DDS participants (reception, events, flow controllers...).
+    workers,                //! Threads of the DDS Pipe thread pool, delivering (and writing) the received samples.
+    event,                  //! Threads of the MCAP handler writing the samples on events and when stopping.
+    io,                     //! Auxiliary input/output threads (file migration, streaming, metrics, MCAP reading).
+    count,
+};
+
+/**
+ * Structure encapsulating the CPUs where each \c ThreadKind runs, and the NUMA placement of their memory.
+ *
+ * An empty CPU set leaves the threads of its kind wherever the operating system schedules them.
+ */
+struct ThreadPlacementConfiguration
+{
+    //! CPUs of the threads created by the DDS participants
+    std::set<unsigned int> dds_cpus;
+
+    //! CPUs of the threads of the DDS Pipe thread pool
+    std::set<unsigned int> workers_cpus;
+
+    //! CPUs of the threads of the MCAP handler
+    std::set<unsigned int> event_cpus;
+
+    //! CPUs of the auxiliary input/output threads
+    std::set<unsigned int> io_cpus;
+
+    //! Whether every placed thread allocates its memory on the NUMA node of the CPUs writing the samples
+    bool numa_local{false};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
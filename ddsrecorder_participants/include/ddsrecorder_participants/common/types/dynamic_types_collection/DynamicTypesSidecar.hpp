@@ -0,0 +1,103 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file DynamicTypesSidecar.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <mcap/types.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Content-addressed file holding a serialized \c DynamicTypesCollection shared by the MCAP files of a recording.
+ *
+ * The sidecar is named after the hash of its contents, so files recorded with the same types reference the same
+ * sidecar, and a sidecar is never rewritten once it exists.
+ * Each MCAP file only stores a metadata record with the name of its sidecar and the hash of its contents.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI DynamicTypesSidecar
+{
+public:
+
+    /**
+     * @brief Hash of a serialized \c DynamicTypesCollection .
+     *
+     * @return The 64-bit FNV-1a hash of \c data as a 16-digit hexadecimal string.
+     */
+    static std::string hash(
+            const unsigned char* data,
+            const std::uint64_t size);
+
+    //! Name of the sidecar file holding the dynamic types whose hash is \c hash
+    static std::string filename(
+            const std::string& hash);
+
+    //! Metadata record referencing the sidecar file whose hash is \c hash
+    static mcap::Metadata reference(
+            const std::string& hash);
+
+    /**
+     * @brief Write the sidecar file of \c data in \c directory , unless it already exists.
+     *
+     * The file is written atomically, through a temporary file and a rename.
+     *
+     * @return The hash of \c data .
+     * @throws \c InconsistencyException if the file cannot be written.
+     */
+    static std::string write(
+            const std::string& directory,
+            const unsigned char* data,
+            const std::uint64_t size);
+
+    /**
+     * @brief Read the sidecar file referenced by \c reference , relative to \c directory .
+     *
+     * @return The serialized \c DynamicTypesCollection .
+     * @throws \c InconsistencyException if the reference is malformed, or if the file is missing or does not match
+     * the hash of the reference.
+     */
+    static std::vector<unsigned char> read(
+            const std::string& directory,
+            const mcap::Metadata& reference);
+
+    /**
+     * @brief Read the serialized \c DynamicTypesCollection of an MCAP file in \c directory .
+     *
+     * The types are read from the sidecar referenced in \c metadatas , or from the dynamic types attachment if the
+     * file references no sidecar or it cannot be read.
+     *
+     * @return The serialized \c DynamicTypesCollection , or an empty vector if the file has none.
+     */
+    static std::vector<unsigned char> read_collection(
+            const std::string& directory,
+            const std::map<std::string, mcap::Metadata>& metadatas,
+            const std::map<std::string, mcap::Attachment>& attachments);
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -32,14 +32,36 @@ constexpr const char* QOS_SERIALIZATION_KEYED("keyed");
 // Dynamic types serialization
 constexpr const char* DYNAMIC_TYPES_ATTACHMENT_NAME("dynamic_types");
 
+// Dynamic types sidecar metadata
+constexpr const char* DYNAMIC_TYPES_SIDECAR_METADATA_NAME("dynamic_types_sidecar");
+constexpr const char* DYNAMIC_TYPES_SIDECAR_FILE("file");
+constexpr const char* DYNAMIC_TYPES_SIDECAR_HASH("hash");
+constexpr const char* DYNAMIC_TYPES_SIDECAR_PREFIX("dynamic_types_");
+constexpr const char* DYNAMIC_TYPES_SIDECAR_EXTENSION(".cdr");
+
 // ROS 2 Types metadata
 constexpr const char* ROS2_TYPES("ros2-types");
 
+// Domain metadata
+constexpr const char* DOMAIN_ID_METADATA("domain");
+
 // Version metadata
 constexpr const char* VERSION_METADATA_NAME("version");
 constexpr const char* VERSION_METADATA_RELEASE("release");
 constexpr const char* VERSION_METADATA_COMMIT("commit");
 
+// Channel statistics metadata
+constexpr const char* CHANNEL_STATISTICS_METADATA_PREFIX("statistics/");
+constexpr const char* CHANNEL_STATISTICS_TOPIC("topic");
+constexpr const char* CHANNEL_STATISTICS_MESSAGES("message_count");
+constexpr const char* CHANNEL_STATISTICS_BYTES("bytes");
+constexpr const char* CHANNEL_STATISTICS_FIRST_LOG_TIME("first_log_time");
+constexpr const char* CHANNEL_STATISTICS_LAST_LOG_TIME("last_log_time");
+constexpr const char* CHANNEL_STATISTICS_MIN_INTER_ARRIVAL("min_inter_arrival");
+constexpr const char* CHANNEL_STATISTICS_MAX_INTER_ARRIVAL("max_inter_arrival");
+constexpr const char* CHANNEL_STATISTICS_MEAN_INTER_ARRIVAL("mean_inter_arrival");
+constexpr const char* CHANNEL_STATISTICS_GAPS("gaps");
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
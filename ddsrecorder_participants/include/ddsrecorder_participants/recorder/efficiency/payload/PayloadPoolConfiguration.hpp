@@ -0,0 +1,52 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file PayloadPoolConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+//! Implementation of the \c PayloadPool shared by the recorder participants
+enum class PayloadPoolKind
+{
+    fast,                   //! Generic \c FastPayloadPool of the DDS Pipe (one heap allocation per payload).
+    slab,                   //! Recorder-specific \c SlabPayloadPool (size-class slabs with thread-local caches).
+};
+
+/**
+ * Structure encapsulating all of the payload pool configuration options.
+ */
+struct PayloadPoolConfiguration
+{
+    //! Implementation of the payload pool
+    PayloadPoolKind kind{PayloadPoolKind::fast};
+
+    //! Whether to back the slabs with huge pages (applies to slab)
+    bool huge_pages{false};
+
+    //! Max bytes cached by each thread and size class before returning blocks to the pool (applies to slab)
+    std::uint64_t thread_cache_size{1024 * 1024};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
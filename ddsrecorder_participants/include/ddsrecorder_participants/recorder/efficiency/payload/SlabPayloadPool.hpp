@@ -0,0 +1,235 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file SlabPayloadPool.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
+#include <ddspipe_core/types/dds/Payload.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/efficiency/payload/PayloadPoolConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief \c PayloadPool that serves payloads from per-size-class slabs.
+ *
+ * Every payload is rounded up to a size class (four classes per power of two, so at most 25% of each block is
+ * wasted) and carved from a slab of \c SLAB_SIZE bytes reserved for that class. Released blocks are kept in a cache
+ * of the releasing thread and handed back to the pool in batches, so the reception and write threads of the
+ * recorder seldom contend on the pool locks nor fragment the process heap with millions of small allocations.
+ *
+ * Slabs are only returned to the system when the pool is destroyed. Payloads bigger than the largest size class are
+ * allocated individually: from the process heap, which already reuses large chunks, or, with huge pages, mapped in
+ * multiples of \c SLAB_SIZE and kept for reuse (up to \c MAX_CACHED_LARGE_BYTES ) when released. Either way, topics
+ * with large samples do not pay a system call per sample.
+ *
+ * As in the \c FastPayloadPool , payloads are shared by reference counting: getting a payload from another payload
+ * of this same pool does not copy its data.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI SlabPayloadPool : public ddspipe::core::PayloadPool
+{
+public:
+
+    /**
+     * @brief Construct a \c SlabPayloadPool .
+     *
+     * @param configuration Whether to use huge pages and how many bytes to cache per thread.
+     */
+    SlabPayloadPool(
+            const PayloadPoolConfiguration& configuration = {});
+
+    /**
+     * @brief Destroy the \c SlabPayloadPool .
+     *
+     * Returns every slab to the system. Payloads still referenced at this point are left dangling.
+     */
+    ~SlabPayloadPool();
+
+    //! Reserve a payload of at least \c size bytes
+    bool get_payload(
+            uint32_t size,
+            ddspipe::core::types::Payload& payload) override;
+
+    //! Reference \c src_payload in \c target_payload if it belongs to this pool, or copy it otherwise
+    bool get_payload(
+            const ddspipe::core::types::Payload& src_payload,
+            ddspipe::core::types::Payload& target_payload) override;
+
+    //! Release a reference to \c payload , returning its block to the pool when it is no longer referenced
+    bool release_payload(
+            ddspipe::core::types::Payload& payload) override;
+
+    //! Bytes currently reserved from the system (slabs, individually allocated payloads and cached huge-page blocks)
+    std::uint64_t reserved_bytes() const noexcept;
+
+    //! Size of the slabs in which blocks are carved (the size of a huge page)
+    static constexpr std::size_t SLAB_SIZE = 2 * 1024 * 1024;
+
+    //! Size of the smallest size class
+    static constexpr std::size_t MIN_CLASS_SIZE = 64;
+
+    //! Size of the largest size class (bigger payloads are allocated individually)
+    static constexpr std::size_t MAX_CLASS_SIZE = 256 * 1024;
+
+    //! Max bytes of released huge-page blocks kept for reuse
+    static constexpr std::size_t MAX_CACHED_LARGE_BYTES = 16 * SLAB_SIZE;
+
+protected:
+
+    //! Header preceding the data of every block
+    struct alignas(16) BlockHeader
+    {
+        //! Number of payloads referencing the block
+        std::atomic<std::uint32_t> references;
+
+        //! Size class of the block (\c LARGE_CLASS or \c HEAP_CLASS if allocated individually)
+        std::uint32_t size_class;
+
+        //! Bytes allocated for the block (header included)
+        std::uint64_t allocated_size;
+    };
+
+    //! Blocks cached by a thread for a given pool, one list per size class
+    using BlockCache = std::vector<std::vector<BlockHeader*>>;
+
+    //! Per-thread caches of every alive pool (in which blocks are returned to their pool on thread exit)
+    struct ThreadCaches;
+
+    //! State shared by the threads for a given size class
+    struct SizeClass
+    {
+        //! Bytes of data of the blocks in this class
+        std::size_t size;
+
+        //! Bytes allocated for each block (header included)
+        std::size_t block_size;
+
+        //! Max blocks kept in a thread cache before returning some to the pool
+        std::size_t cache_blocks;
+
+        //! Protects the free blocks and the current slab
+        std::mutex mutex;
+
+        //! Blocks returned by the thread caches
+        std::vector<BlockHeader*> free_blocks;
+
+        //! Next unused byte of the current slab
+        std::uint8_t* slab_cursor{nullptr};
+
+        //! End of the current slab
+        std::uint8_t* slab_end{nullptr};
+    };
+
+    //! Size class index of a payload of \c size bytes
+    std::uint32_t size_class_of_(
+            std::size_t size) const noexcept;
+
+    //! Take a block of class \c size_class , from the thread cache if possible
+    BlockHeader* allocate_block_(
+            std::uint32_t size_class);
+
+    //! Give back a block of class \c size_class to the thread cache
+    void deallocate_block_(
+            BlockHeader* block);
+
+    //! Move up to \c count blocks of class \c size_class from the pool to \c cache , carving slabs if required
+    void refill_(
+            std::uint32_t size_class,
+            std::vector<BlockHeader*>& cache,
+            std::size_t count);
+
+    //! Move the blocks in \c cache beyond the first \c keep back to the pool
+    void drain_(
+            std::uint32_t size_class,
+            std::vector<BlockHeader*>& cache,
+            std::size_t keep);
+
+    //! Take a block for a payload of \c size bytes bigger than the largest size class, from the cache if possible
+    BlockHeader* allocate_large_block_(
+            std::size_t size);
+
+    //! Free a block allocated by \c allocate_large_block_ , keeping it for reuse if mapped in huge pages
+    void deallocate_large_block_(
+            BlockHeader* block);
+
+    //! Cache of the calling thread for this pool
+    BlockCache& thread_cache_();
+
+    //! Reserve \c size bytes of memory from the system
+    void* map_(
+            std::size_t size);
+
+    //! Return \c size bytes at \c address to the system
+    void unmap_(
+            void* address,
+            std::size_t size) noexcept;
+
+    //! Size class of blocks mapped individually (in huge pages)
+    static constexpr std::uint32_t LARGE_CLASS = static_cast<std::uint32_t>(-1);
+
+    //! Size class of blocks allocated individually from the process heap
+    static constexpr std::uint32_t HEAP_CLASS = static_cast<std::uint32_t>(-2);
+
+    //! The configuration of the pool
+    const PayloadPoolConfiguration configuration_;
+
+    //! Process-unique identifier of this pool (never reused, so stale thread caches are never mistaken for it)
+    const std::uint64_t id_;
+
+    //! Data size of every size class, in increasing order (kept apart from \c size_classes_ to look it up faster)
+    std::vector<std::size_t> class_sizes_;
+
+    //! Size classes, in increasing size order
+    std::vector<std::unique_ptr<SizeClass>> size_classes_;
+
+    //! Slabs reserved from the system
+    std::vector<std::pair<void*, std::size_t>> slabs_;
+
+    //! Protects \c slabs_
+    std::mutex slabs_mutex_;
+
+    //! Released huge-page blocks kept for reuse, by allocated size
+    std::multimap<std::size_t, BlockHeader*> large_blocks_;
+
+    //! Bytes of the blocks in \c large_blocks_
+    std::size_t cached_large_bytes_{0};
+
+    //! Protects \c large_blocks_ and \c cached_large_bytes_
+    std::mutex large_blocks_mutex_;
+
+    //! Bytes currently reserved from the system
+    std::atomic<std::uint64_t> reserved_bytes_{0};
+
+    //! Whether the huge pages could not be reserved (to warn only once)
+    std::atomic<bool> huge_pages_failed_{false};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,210 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file MpmcQueue.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue that never takes a lock.
+ *
+ * Every cell of the ring holds a sequence number telling whether it is ready to be written or read in the current
+ * lap, so producers and consumers only contend on a single compare-and-swap of their own index, and never on each
+ * other (D. Vyukov's bounded MPMC queue).
+ *
+ * The capacity is rounded up to the next power of two.
+ *
+ * @tparam T Type of the elements (default-constructible and move-assignable).
+ */
+template <typename T>
+class MpmcQueue
+{
+public:
+
+    /**
+     * @brief Construct an \c MpmcQueue .
+     *
+     * @param capacity Minimum number of elements the queue holds.
+     */
+    explicit MpmcQueue(
+            const std::size_t capacity)
+        : mask_(round_up_power_of_two_(capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+    {
+        for (std::size_t i = 0; i <= mask_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(
+            const MpmcQueue&) = delete;
+    MpmcQueue& operator =(
+            const MpmcQueue&) = delete;
+
+    /**
+     * @brief Insert \c value at the back of the queue.
+     *
+     * @return Whether \c value was inserted (false <-> the queue is full, \c value is left untouched).
+     */
+    bool try_push(
+            T&& value) noexcept
+    {
+        Cell* cell;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                // The cell is free in this lap: claim it
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The cell still holds the element of the previous lap
+                return false;
+            }
+            else
+            {
+                // Another producer claimed the cell
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Extract the element at the front of the queue.
+     *
+     * @return Whether an element was extracted in \c value (false <-> the queue is empty).
+     */
+    bool try_pop(
+            T& value) noexcept
+    {
+        Cell* cell;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                // The cell was written in this lap: claim it
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The cell has not been written yet
+                return false;
+            }
+            else
+            {
+                // Another consumer claimed the cell
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //! Whether the queue held no element at the time of the call
+    bool empty() const noexcept
+    {
+        const std::size_t pos = dequeue_pos_.load(std::memory_order_acquire);
+
+        return cells_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    //! Max number of elements held at a time
+    std::size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+protected:
+
+    //! Size of a cache line, so the indexes of the producers and the consumers do not share one
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    //! Element of the ring
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    //! Smallest power of two not smaller than \c value (and not smaller than 2)
+    static std::size_t round_up_power_of_two_(
+            const std::size_t value) noexcept
+    {
+        std::size_t power = 2;
+
+        while (power < value)
+        {
+            power <<= 1;
+        }
+
+        return power;
+    }
+
+    //! Capacity - 1, to wrap the indexes around the ring
+    const std::size_t mask_;
+
+    //! Ring of elements
+    const std::unique_ptr<Cell[]> cells_;
+
+    //! Index of the next element to be inserted
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_pos_{0};
+
+    //! Index of the next element to be extracted
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_pos_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,193 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EmbeddedRecorder.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cpp_utils/time/time_utils.hpp>
+
+#include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
+
+#include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
+#include <ddspipe_core/types/dds/Payload.hpp>
+#include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/embedded/EmbeddedRecorderConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapHandler.hpp>
+#include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Class recording samples handed over by the application itself, without any DDS entity nor DDS Pipe.
+ *
+ * It wraps the \c McapHandler , \c McapWriter and \c FileTracker of the recorder: the samples follow the same path
+ * (buffering, pending samples, chunking, blobs, resource limits and rotation) as the ones received from DDS.
+ *
+ * Payloads reserved with \c reserve_payload are handed to the handler without copying them.
+ * With the memory sink, the output files are kept in memory and retrieved with \c closed_files .
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI EmbeddedRecorder
+{
+public:
+
+    /**
+     * @brief Construct an \c EmbeddedRecorder .
+     *
+     * @param configuration Where to write the output files and how to record the samples.
+     * @param init_state    Initial state of the recorder.
+     */
+    EmbeddedRecorder(
+            const EmbeddedRecorderConfiguration& configuration,
+            const McapHandlerStateCode& init_state = McapHandlerStateCode::RUNNING);
+
+    /**
+     * @brief Destroy the \c EmbeddedRecorder .
+     *
+     * Writes the samples in memory and closes the current output file.
+     */
+    ~EmbeddedRecorder();
+
+    /**
+     * @brief Register the type of the samples of some topics.
+     *
+     * Its schema is written in the output files and, if \c record_types is set, the type itself.
+     * Samples of types not registered yet are kept as pending samples (up to \c max_pending_samples ).
+     *
+     * @param dynamic_type The type to register.
+     * @throws \c InconsistencyException if the type cannot be registered in the type object registry.
+     */
+    void register_type(
+            const fastdds::dds::DynamicType::_ref_type& dynamic_type);
+
+    /**
+     * @brief Reserve a payload from the pool of the recorder.
+     *
+     * The payload is meant to be filled with the serialized sample and handed to \c write , which takes it without
+     * copying it.
+     *
+     * @param size    Size (in bytes) of the payload.
+     * @param payload The payload reserved.
+     * @throws \c InconsistencyException if the pool fails to reserve the payload.
+     */
+    void reserve_payload(
+            const std::uint32_t size,
+            ddspipe::core::types::Payload& payload);
+
+    /**
+     * @brief Record a sample whose payload was reserved with \c reserve_payload .
+     *
+     * The payload is handed to the recorder without copying it, and released from \c payload .
+     *
+     * @param topic_name Name of the topic of the sample.
+     * @param type_name  Name of the type of the sample.
+     * @param payload    Serialized sample (with its encapsulation).
+     * @param timestamp  Publication (and log) time of the sample.
+     * @throws \c InconsistencyException if the payload is empty or was not reserved with \c reserve_payload .
+     */
+    void write(
+            const std::string& topic_name,
+            const std::string& type_name,
+            ddspipe::core::types::Payload& payload,
+            const utils::Timestamp& timestamp = utils::now());
+
+    /**
+     * @brief Record a sample, copying its payload into a payload of the pool of the recorder.
+     *
+     * @param topic_name Name of the topic of the sample.
+     * @param type_name  Name of the type of the sample.
+     * @param data       Serialized sample (with its encapsulation).
+     * @param size       Size (in bytes) of \c data .
+     * @param timestamp  Publication (and log) time of the sample.
+     * @throws \c InconsistencyException if the payload is empty or cannot be reserved.
+     */
+    void write(
+            const std::string& topic_name,
+            const std::string& type_name,
+            const std::byte* data,
+            const std::uint32_t size,
+            const utils::Timestamp& timestamp = utils::now());
+
+    //! Start recording (see \c McapHandler::start )
+    void start();
+
+    //! Pause recording, keeping the samples of the last event window (see \c McapHandler::pause )
+    void pause();
+
+    //! Write the samples of the last event window (see \c McapHandler::trigger_event )
+    void trigger_event();
+
+    /**
+     * @brief Stop recording (see \c McapHandler::stop ).
+     *
+     * Waits until the current output file is closed, so it is listed by \c closed_files on return.
+     */
+    void stop();
+
+    /**
+     * @brief Get the output files closed and not removed by the rotation, from the oldest to the newest.
+     *
+     * With the memory sink, the files hold their contents.
+     */
+    std::vector<File> closed_files();
+
+protected:
+
+    //! Output settings of the \c FileTracker and \c McapWriter matching \c configuration
+    static OutputSettings output_settings_(
+            const EmbeddedRecorderConfiguration& configuration);
+
+    //! Configuration of the \c McapHandler matching \c configuration
+    static McapHandlerConfiguration handler_configuration_(
+            const EmbeddedRecorderConfiguration& configuration);
+
+    //! Get the topic named \c topic_name with type \c type_name , creating it the first time
+    const ddspipe::core::types::DdsTopic& topic_(
+            const std::string& topic_name,
+            const std::string& type_name);
+
+    // The pool the payloads are reserved from
+    std::shared_ptr<ddspipe::core::PayloadPool> payload_pool_;
+
+    // Track the output files
+    std::shared_ptr<FileTracker> file_tracker_;
+
+    // Write the samples in the output files
+    std::unique_ptr<McapHandler> handler_;
+
+    // The topics of the samples written, by topic and type name
+    std::map<std::pair<std::string, std::string>, ddspipe::core::types::DdsTopic> topics_;
+
+    // The mutex to protect the topics
+    std::mutex topics_mutex_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
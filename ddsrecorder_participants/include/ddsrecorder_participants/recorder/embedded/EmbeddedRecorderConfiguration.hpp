@@ -0,0 +1,125 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EmbeddedRecorderConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <mcap/mcap.hpp>
+
+#include <ddsrecorder_participants/recorder/efficiency/payload/PayloadPoolConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapBlobsConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkingConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/DiskFullForecastConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Structure encapsulating all of \c EmbeddedRecorder configuration options.
+ */
+struct EmbeddedRecorderConfiguration
+{
+    ////////////
+    // OUTPUT //
+    ////////////
+
+    //! Where to write the output files
+    OutputSinkKind sink{OutputSinkKind::file};
+
+    //! Where and how to stream the output files (applies to the stream sink)
+    McapStreamConfiguration stream;
+
+    //! Path where the output files are created (applies to the file sink)
+    std::string filepath{"."};
+
+    //! Name of the output files (the id of the file is appended when there may be several)
+    std::string filename{"output"};
+
+    //! Whether to prepend the timestamp of their creation to the output filenames
+    bool prepend_timestamp{false};
+
+    //! Format to use in the timestamp prefix
+    std::string timestamp_format{"%Y-%m-%d_%H-%M-%S_%Z"};
+
+    //! Max size of an output file (0 <-> the space available on disk with the file sink, 256 MiB with the stream sink,
+    //! no limit otherwise)
+    std::uint64_t max_file_size{0};
+
+    //! Max aggregate size of the output files (0 <-> max_file_size)
+    std::uint64_t max_size{0};
+
+    //! Whether to remove the oldest output files when reaching max_size
+    bool file_rotation{false};
+
+    //! Safety margin on the estimation of the size of the output files
+    std::uint64_t safety_margin{0};
+
+    //! Directory where the output files are written before being moved to filepath once closed (applies to the file
+    //! sink, empty to disable)
+    std::string staging_path;
+
+    //! Max aggregate size of the files in the staging directory (0 <-> the space available in it)
+    std::uint64_t staging_max_size{0};
+
+    //! Forecast when the output will be full and act before it is (applies to the file sink)
+    DiskFullForecastConfiguration disk_full_forecast{};
+
+    //////////
+    // MCAP //
+    //////////
+
+    //! MCAP writer configuration options
+    mcap::McapWriterOptions mcap_writer_options{"ros2"};
+
+    //! Strategy deciding when to close the chunks of the output files
+    McapChunkingConfiguration chunking;
+
+    //! Which payloads to write out of the chunks of the output files
+    McapBlobsConfiguration blobs;
+
+    ///////////////
+    // RECORDING //
+    ///////////////
+
+    //! Max number of samples to keep in memory before writing them (applies to running state)
+    unsigned int buffer_size{100};
+
+    //! Keep in memory the samples received in the last event window [s] (applies to paused state)
+    unsigned int event_window{20};
+
+    //! Max number of samples to keep while their type is not registered (-1 <-> no limit, 0 <-> no pending samples)
+    int max_pending_samples{5000};
+
+    //! Whether to store the registered types in the output files
+    bool record_types{true};
+
+    //! Whether to generate schemas as OMG IDL or ROS2 msg
+    bool ros2_types{false};
+
+    //! Implementation of the pool the payloads are reserved from
+    PayloadPoolConfiguration payload_pool;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,143 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file LogRateLimiter.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Lock-free limiter that lets through at most one log entry per period.
+ *
+ * The entries discarded in a period are counted, so the next entry let through can report them.
+ * It is meant to be instantiated once per log call site (see \c DDSRECORDER_LOG_WARNING_RATE_LIMITED ), so repeated
+ * entries on the recording path neither flood the log (and the \c DdsRecorderLogConsumer topic) nor pay the cost of
+ * formatting them.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI LogRateLimiter
+{
+public:
+
+    //! Function returning the current time [ns]
+    using Clock = std::int64_t (*)();
+
+    /**
+     * @brief Construct a \c LogRateLimiter .
+     *
+     * @param period Minimum time between two entries let through.
+     * @param clock Clock measuring the \c period (the steady clock unless testing).
+     */
+    LogRateLimiter(
+            const std::chrono::nanoseconds& period = std::chrono::seconds(1),
+            Clock clock = steady_now) noexcept;
+
+    //! Current time [ns] of the steady clock
+    static std::int64_t steady_now();
+
+    /**
+     * @brief Check whether a log entry can be emitted now.
+     *
+     * @param suppressed Set to the number of entries discarded since the last one let through (only if returns true).
+     * @return Whether the entry can be emitted.
+     */
+    bool acquire(
+            std::uint64_t& suppressed) noexcept;
+
+protected:
+
+    //! Clock measuring the period
+    const Clock clock_;
+
+    //! Minimum time between two entries let through [ns]
+    const std::int64_t period_;
+
+    //! Time [ns] (steady clock) at which the last entry was let through
+    std::atomic<std::int64_t> last_entry_;
+
+    //! Number of entries discarded since the last one let through
+    std::atomic<std::uint64_t> suppressed_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
+
+/**
+ * Log a warning at most once per second from this call site, reporting how many occurrences were discarded.
+ *
+ * The message is only formatted if the entry is emitted.
+ */
+#define DDSRECORDER_LOG_WARNING_RATE_LIMITED(cat, msg) \
+    DDSRECORDER_LOG_RATE_LIMITED_(EPROSIMA_LOG_WARNING, cat, msg)
+
+/**
+ * Log an error at most once per second from this call site, reporting how many occurrences were discarded.
+ *
+ * The message is only formatted if the entry is emitted.
+ */
+#define DDSRECORDER_LOG_ERROR_RATE_LIMITED(cat, msg) \
+    DDSRECORDER_LOG_RATE_LIMITED_(EPROSIMA_LOG_ERROR, cat, msg)
+
+/**
+ * Log an info entry from a per-sample call site of the recording path.
+ *
+ * These entries compile to nothing unless both the info logs (LOG_INFO) and the recording path info logs
+ * (DDSRECORDER_HOT_PATH_LOG_INFO) are enabled, since a single one of them per sample is enough to slow down the
+ * recording under load.
+ */
+#if defined(DDSRECORDER_HOT_PATH_LOG_INFO)
+#define DDSRECORDER_LOG_INFO_HOT_PATH(cat, msg) EPROSIMA_LOG_INFO(cat, msg)
+#else
+#define DDSRECORDER_LOG_INFO_HOT_PATH(cat, msg)
+#endif // if defined(DDSRECORDER_HOT_PATH_LOG_INFO)
+
+#define DDSRECORDER_LOG_RATE_LIMITED_(log_macro, cat, msg)                                           \
+    do                                                                                                \
+    {                                                                                                 \
+        static ::eprosima::ddsrecorder::participants::LogRateLimiter ddsrecorder_log_rate_limiter_;   \
+        DDSRECORDER_LOG_WITH_RATE_LIMITER_(ddsrecorder_log_rate_limiter_, log_macro, cat, msg);       \
+    } while (0)
+
+// Log through the given LogRateLimiter (exposed so tests can inject a limiter with its own clock)
+#define DDSRECORDER_LOG_WITH_RATE_LIMITER_(limiter, log_macro, cat, msg)                             \
+    do                                                                                                \
+    {                                                                                                 \
+        std::uint64_t ddsrecorder_log_suppressed_ = 0;                                                \
+        if ((limiter).acquire(ddsrecorder_log_suppressed_))                                           \
+        {                                                                                             \
+            if (ddsrecorder_log_suppressed_ == 0)                                                     \
+            {                                                                                         \
+                log_macro(cat, msg);                                                                  \
+            }                                                                                         \
+            else                                                                                      \
+            {                                                                                         \
+                log_macro(cat, msg << " [" << ddsrecorder_log_suppressed_                             \
+                                   << " more occurrences since last report]");                        \
+            }                                                                                         \
+        }                                                                                             \
+    } while (0)
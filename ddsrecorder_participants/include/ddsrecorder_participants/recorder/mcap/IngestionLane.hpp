@@ -0,0 +1,149 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file IngestionLane.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/efficiency/queue/MpmcQueue.hpp>
+#include <ddsrecorder_participants/recorder/mcap/IngestionLaneConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapMessage.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Sample received in a topic of an \c IngestionLane , waiting to be added to the \c McapHandler .
+ */
+struct IngestionSample
+{
+    //! Topic where the sample was received
+    std::shared_ptr<const ddspipe::core::types::DdsTopic> topic;
+
+    //! Message holding a reference to the payload of the sample (stored in the slots of the lane, not allocated)
+    McapMessage message;
+};
+
+/**
+ * @brief Thread and lock-free queue dedicated to the samples of some topics.
+ *
+ * The threads receiving the samples only insert them in the queue, so a high-rate topic never holds them (nor the
+ * lock of the \c McapHandler ) while the samples of other topics wait. The lane thread takes the samples out in
+ * batches and hands each batch over to the \c McapHandler at once.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI IngestionLane
+{
+public:
+
+    /**
+     * @brief Callback adding a batch of samples to the \c McapHandler .
+     *
+     * Returns whether the samples handed over so far have been added. Otherwise, the lane calls it again (with an
+     * empty batch if no sample arrives) every \c HANDOVER_RETRY_PERIOD until they are.
+     */
+    using BatchHandler = std::function<bool (std::vector<IngestionSample>&)>;
+
+    /**
+     * @brief Construct an \c IngestionLane and start its thread.
+     *
+     * @param configuration Configuration of the lane.
+     * @param batch_handler Callback adding the samples of the lane, called from the lane thread.
+     */
+    IngestionLane(
+            const IngestionLaneConfiguration& configuration,
+            const BatchHandler& batch_handler);
+
+    //! Hand the samples left over to the \c batch_handler and stop the lane thread
+    ~IngestionLane();
+
+    /**
+     * @brief Insert a sample in the lane.
+     *
+     * @return Whether the sample was inserted (false <-> the lane is full, the sample is left untouched).
+     */
+    bool push(
+            IngestionSample&& sample);
+
+    //! Block until the samples inserted before the call have been handed to the \c batch_handler
+    void flush();
+
+    //! Name of the lane
+    const std::string& name() const noexcept;
+
+protected:
+
+    //! Routine of the lane thread
+    void routine_();
+
+    //! Max number of samples handed to the \c batch_handler at once
+    static constexpr std::size_t MAX_BATCH_SIZE = 256;
+
+    //! Time between calls to the \c batch_handler while the samples handed over have not been added
+    static constexpr std::chrono::milliseconds HANDOVER_RETRY_PERIOD{1};
+
+    //! Configuration of the lane
+    const IngestionLaneConfiguration configuration_;
+
+    //! Callback adding the samples of the lane
+    const BatchHandler batch_handler_;
+
+    //! Samples waiting to be handed to the \c batch_handler
+    MpmcQueue<IngestionSample> queue_;
+
+    //! Number of samples inserted in \c queue_
+    std::atomic<std::uint64_t> pushed_samples_{0};
+
+    //! Number of samples handed to the \c batch_handler
+    std::atomic<std::uint64_t> handled_samples_{0};
+
+    //! Whether the lane thread is (about to be) waiting for samples, so the producers know to wake it up
+    std::atomic<bool> waiting_{false};
+
+    //! Whether the lane thread must keep running
+    bool running_{true};
+
+    //! Protects \c running_ and the waits on \c samples_cv_ and \c handled_cv_
+    std::mutex mutex_;
+
+    //! Notified when samples are inserted in an empty lane, or when the lane is stopped
+    std::condition_variable samples_cv_;
+
+    //! Notified when a batch has been handed to the \c batch_handler
+    std::condition_variable handled_cv_;
+
+    //! Lane thread
+    std::thread thread_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,47 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file IngestionLaneConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Structure encapsulating the configuration of an \c IngestionLane .
+ */
+struct IngestionLaneConfiguration
+{
+    //! Name of the lane, as shown in logs
+    std::string name;
+
+    //! Topic name patterns (wildcards allowed) whose samples are handed to the lane
+    std::vector<std::string> topics;
+
+    //! Max number of samples waiting in the lane (samples received when full are discarded)
+    std::uint32_t queue_size{4096};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,68 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file LogTimeClock.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <mcap/types.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClockConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Clock used to timestamp the \c logTime of the received samples.
+ *
+ * The \c coarse clock reads the coarse real-time clock of the kernel, which is even cheaper but only as precise as
+ * the kernel tick. On platforms without it, the system clock is used instead.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI LogTimeClock
+{
+public:
+
+    /**
+     * @brief Construct a \c LogTimeClock .
+     *
+     * @param configuration Which clock to read and to which precision.
+     */
+    LogTimeClock(
+            const LogTimeClockConfiguration& configuration);
+
+    //! Current time in mcap format, truncated to the configured precision
+    mcap::Timestamp now() const noexcept;
+
+    //! Resolution [ns] of the clock read, before truncating it to the configured precision
+    std::uint64_t resolution() const noexcept;
+
+protected:
+
+    //! Read the clock without truncating it
+    std::uint64_t read_() const noexcept;
+
+    //! The configuration of the clock
+    const LogTimeClockConfiguration configuration_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,49 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file LogTimeClockConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+//! Clock used to timestamp the \c logTime of the received samples
+enum class LogTimeClockKind
+{
+    system,                 //! System clock, read once per sample.
+    coarse,                 //! Coarse real-time clock of the kernel (a few milliseconds of resolution).
+};
+
+/**
+ * Structure encapsulating all of \c LogTimeClock configuration options.
+ */
+struct LogTimeClockConfiguration
+{
+    //! Clock used to timestamp the samples
+    LogTimeClockKind kind{LogTimeClockKind::system};
+
+    //! Precision [ns] to which the timestamps are truncated (1 <-> full resolution of the clock)
+    std::uint64_t precision{1};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
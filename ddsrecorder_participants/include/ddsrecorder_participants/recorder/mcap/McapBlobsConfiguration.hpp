@@ -0,0 +1,49 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapBlobsConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <mcap/types.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Structure encapsulating the configuration of the payloads written out of the chunks (see \c McapBlob ).
+ */
+struct McapBlobsConfiguration
+{
+    //! Whether to write the payloads of at least \c threshold bytes out of the chunks
+    bool enabled{false};
+
+    //! Size [bytes] from which a payload is written out of the chunks
+    std::uint64_t threshold{1024 * 1024};
+
+    //! Compression of the blobs (a blob is only kept compressed if that makes it smaller)
+    mcap::Compression compression{mcap::Compression::None};
+
+    //! Whether to write each distinct payload in a single blob per file, referenced by every message repeating it
+    bool deduplicate{false};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
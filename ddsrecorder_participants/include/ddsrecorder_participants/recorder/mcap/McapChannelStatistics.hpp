@@ -0,0 +1,119 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapChannelStatistics.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <mcap/types.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Statistics of the messages of a channel written in an MCAP file.
+ *
+ * The statistics are updated incrementally with a constant cost per message, so the \c McapWriter can write them as
+ * a metadata record when closing the file without scanning the written messages.
+ *
+ * Times are \c logTime values, so they are nanoseconds since epoch.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapChannelStatistics
+{
+public:
+
+    /**
+     * @brief Account for a new message of the channel.
+     *
+     * A message logged before the previous one (e.g. with \c log-publish-time ) counts as a zero inter-arrival time.
+     *
+     * @param log_time The \c logTime of the message.
+     * @param size The size of the message's data.
+     */
+    void add_message(
+            const mcap::Timestamp log_time,
+            const std::uint64_t size) noexcept;
+
+    /**
+     * @brief Build the metadata record with the statistics of \c channel .
+     *
+     * @param channel The channel whose messages have been accounted for.
+     */
+    mcap::Metadata to_metadata(
+            const mcap::Channel& channel) const;
+
+    /**
+     * @brief Build the largest metadata record that \c to_metadata can return for \c channel .
+     *
+     * Used to reserve the space of the statistics in the MCAP file when the channel is written.
+     *
+     * @param channel The channel whose statistics are to be written.
+     */
+    static mcap::Metadata max_metadata(
+            const mcap::Channel& channel);
+
+protected:
+
+    //! Build a metadata record with the keys of the statistics of \c channel and the given values
+    static mcap::Metadata build_metadata_(
+            const mcap::Channel& channel,
+            const std::uint64_t messages,
+            const std::uint64_t bytes,
+            const mcap::Timestamp first_log_time,
+            const mcap::Timestamp last_log_time,
+            const std::uint64_t min_inter_arrival,
+            const std::uint64_t max_inter_arrival,
+            const std::uint64_t mean_inter_arrival,
+            const std::uint64_t gaps);
+
+    //! Number of messages
+    std::uint64_t messages_{0};
+
+    //! Sum of the sizes of the messages' data
+    std::uint64_t bytes_{0};
+
+    //! logTime of the first message
+    mcap::Timestamp first_log_time_{0};
+
+    //! Latest logTime of all the messages
+    mcap::Timestamp last_log_time_{0};
+
+    //! Minimum time between two consecutive messages [ns]
+    std::uint64_t min_inter_arrival_{std::numeric_limits<std::uint64_t>::max()};
+
+    //! Maximum time between two consecutive messages [ns]
+    std::uint64_t max_inter_arrival_{0};
+
+    //! Number of inter-arrival times longer than GAP_FACTOR times the mean inter-arrival time
+    std::uint64_t gaps_{0};
+
+    //! An inter-arrival time longer than this many times the mean one is a gap
+    static constexpr std::uint64_t GAP_FACTOR = 2;
+
+    //! Number of inter-arrival times needed to estimate the expected period before looking for gaps
+    static constexpr std::uint64_t MIN_INTER_ARRIVALS_FOR_GAPS = 2;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
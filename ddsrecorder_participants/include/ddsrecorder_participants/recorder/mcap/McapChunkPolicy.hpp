@@ -0,0 +1,174 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapChunkPolicy.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkingConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Chunks written in an MCAP file, to weigh the write throughput against the random-access read cost.
+ */
+struct McapChunkStatistics
+{
+    //! Number of chunks written
+    std::uint64_t chunks{0};
+
+    //! Number of chunks written per \c ChunkCloseReason
+    std::array<std::uint64_t, CHUNK_CLOSE_REASONS> chunks_per_reason{};
+
+    //! Number of messages in the written chunks
+    std::uint64_t messages{0};
+
+    //! Estimated uncompressed size [bytes] of the written chunks
+    std::uint64_t uncompressed_size{0};
+
+    //! Size [bytes] of the written chunks in the file (compressed chunks and message indexes)
+    std::uint64_t written_size{0};
+
+    //! Smallest estimated uncompressed size [bytes] of a written chunk
+    std::uint64_t min_uncompressed_size{0};
+
+    //! Largest estimated uncompressed size [bytes] of a written chunk
+    std::uint64_t max_uncompressed_size{0};
+
+    //! Sum of the time spans [ns] of the messages of every written chunk
+    std::uint64_t duration{0};
+};
+
+/**
+ * @brief Decides when to close the current chunk of an MCAP file, and keeps the statistics of the written chunks.
+ *
+ * With fixed chunking, the MCAP library closes a chunk once it reaches the configured size, and this class only
+ * keeps the statistics.
+ *
+ * With adaptive chunking, a chunk is closed once the time span of its messages reaches the target duration, so
+ * sparse topics get small chunks (fine seek granularity) and high rates get large ones (better compression, fewer
+ * index records). The size of a chunk is kept between the configured minimum and maximum, and a chunk is closed
+ * early when the recent message rate departs from the rate of the previous chunk, so a burst does not end up in the
+ * same chunk as the quiet period before it.
+ *
+ * The sizes are estimated from the messages written, without the schemas and channels written in the chunk.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapChunkPolicy
+{
+public:
+
+    /**
+     * @brief Construct a \c McapChunkPolicy .
+     *
+     * @param configuration Chunking settings.
+     */
+    McapChunkPolicy(
+            const McapChunkingConfiguration& configuration);
+
+    //! Uncompressed size [bytes] at which the MCAP library has to close a chunk by itself with \c configuration
+    static std::uint64_t library_chunk_size(
+            const McapChunkingConfiguration& configuration) noexcept;
+
+    /**
+     * @brief Account a message written in the current chunk.
+     *
+     * @param log_time Log time [ns] of the message.
+     * @param data_size Size [bytes] of the payload of the message.
+     */
+    void message_written(
+            const std::uint64_t log_time,
+            const std::uint64_t data_size) noexcept;
+
+    /**
+     * @brief Whether the current chunk has to be closed after the last written message.
+     *
+     * @param reason Set to the reason to close the chunk, if it has to be closed.
+     */
+    bool should_close(
+            ChunkCloseReason& reason) const noexcept;
+
+    /**
+     * @brief Account the current chunk as written, and start a new one.
+     *
+     * @param reason Why the chunk has been closed.
+     * @param written_size Size [bytes] the chunk took in the file.
+     */
+    void chunk_closed(
+            const ChunkCloseReason reason,
+            const std::uint64_t written_size) noexcept;
+
+    //! Whether no message has been written in the current chunk
+    bool empty() const noexcept;
+
+    //! Estimated uncompressed size [bytes] of the current chunk
+    std::uint64_t current_size() const noexcept;
+
+    //! Time span [ns] of the messages of the current chunk
+    std::uint64_t current_duration() const noexcept;
+
+    //! Statistics of the chunks written since the last \c reset_statistics
+    const McapChunkStatistics& statistics() const noexcept;
+
+    //! Clear the statistics of the written chunks (e.g. when a new file is opened)
+    void reset_statistics() noexcept;
+
+    //! Size of a message record besides its payload (opcode, length, channel id, sequence, log and publish times)
+    static constexpr std::uint64_t MESSAGE_RECORD_OVERHEAD{1 + 8 + 2 + 4 + 8 + 8};
+
+    //! Messages of a chunk needed before its recent rate is compared to the previous one
+    static constexpr std::uint64_t RATE_CHANGE_MIN_MESSAGES{16};
+
+protected:
+
+    //! Chunking settings
+    const McapChunkingConfiguration configuration_;
+
+    //! Estimated uncompressed size [bytes] of the current chunk
+    std::uint64_t chunk_size_{0};
+
+    //! Number of messages in the current chunk
+    std::uint64_t chunk_messages_{0};
+
+    //! Smallest log time [ns] of the current chunk
+    std::uint64_t chunk_start_{0};
+
+    //! Largest log time [ns] of the current chunk
+    std::uint64_t chunk_end_{0};
+
+    //! Log time [ns] of the last written message (0 <-> none)
+    std::uint64_t last_log_time_{0};
+
+    //! Exponential moving average of the interval [ns] between consecutive messages (0 <-> unknown)
+    double recent_interval_{0};
+
+    //! Average interval [ns] between messages when the previous chunk was closed (0 <-> unknown)
+    double reference_interval_{0};
+
+    //! Statistics of the written chunks
+    McapChunkStatistics statistics_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,62 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapChunkingConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+//! Strategy deciding when the current MCAP chunk is closed
+enum class McapChunkingKind
+{
+    fixed,                  //! Close the chunk once its uncompressed size reaches \c size .
+    adaptive,               //! Close the chunk once it spans \c target_duration , within [min_size, max_size].
+};
+
+/**
+ * Structure encapsulating all of \c McapChunkPolicy configuration options.
+ */
+struct McapChunkingConfiguration
+{
+    //! Strategy deciding when to close a chunk
+    McapChunkingKind kind{McapChunkingKind::fixed};
+
+    //! Uncompressed size [bytes] of the chunks (applies to fixed chunking)
+    std::uint64_t size{1024 * 768};
+
+    //! Time span [ms] of the messages of a chunk (applies to adaptive chunking)
+    std::uint64_t target_duration{1000};
+
+    //! Minimum uncompressed size [bytes] of a chunk before it can be closed (applies to adaptive chunking)
+    std::uint64_t min_size{64 * 1024};
+
+    //! Maximum uncompressed size [bytes] of a chunk (applies to adaptive chunking)
+    std::uint64_t max_size{4 * 1024 * 1024};
+
+    //! Ratio between the recent message rate and the rate of the previous chunk that closes the current chunk
+    //! early (applies to adaptive chunking, <= 1 <-> disabled)
+    double rate_change_factor{4};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
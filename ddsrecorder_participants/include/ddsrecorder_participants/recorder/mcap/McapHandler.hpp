@@ -18,13 +18,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include <mcap/mcap.hpp>
 
@@ -42,6 +47,8 @@
 #include <ddspipe_participants/participant/dynamic_types/ISchemaHandler.hpp>
 
 #include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/mcap/IngestionLane.hpp>
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClock.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapMessage.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapWriter.hpp>
@@ -71,7 +78,34 @@ class McapHandler : public ddspipe::participants::ISchemaHandler
 {
 public:
 
-    using pending_list = std::list<std::pair<ddspipe::core::types::DdsTopic, McapMessage>>;
+    struct PendingSample;
+
+    using pending_list = std::list<PendingSample>;
+
+    //! Entry of \c pending_by_age_ : the pending list holding the sample, and whether it was received RUNNING
+    struct PendingAge
+    {
+        pending_list* list;
+        bool received_running;
+    };
+
+    //! Sample whose type is unknown, with its entry in \c pending_by_age_
+    struct PendingSample
+    {
+        ddspipe::core::types::DdsTopic topic;
+        McapMessage msg;
+        std::list<PendingAge>::iterator age;
+    };
+
+    //! Samples handed over by an ingestion lane, waiting for the next thread taking \c mtx_ to add them
+    struct LaneBuffer
+    {
+        //! Protects \c samples (only held to move samples in or out)
+        std::mutex mtx;
+
+        //! Samples in the order the lane handed them over
+        std::vector<IngestionSample> samples;
+    };
 
     /**
      * McapHandler constructor by required values.
@@ -134,6 +168,9 @@ public:
      *
      * If instance is STOPPED, received data is not processed.
      *
+     * Samples of the topics of an ingestion lane are only inserted in the lane here, and handed over by the lane
+     * thread to a buffer of the lane, from which they are added by whichever thread takes the handler lock next.
+     *
      * @param [in] topic DDS topic associated to this sample.
      * @param [in] data McapMessage to be added.
      */
@@ -146,6 +183,7 @@ public:
      * @brief Start handler instance
      *
      * If previous state was PAUSED, the event thread is stopped (and buffers are cleared).
+     * If the output file of a previous \c stop is still being finalized, waits for it first.
      *
      * @warning Not thread safe with respect to other command methods ( \c start , \c pause , \c stop ,
      * and \c trigger_event). This is, they are expected to be executed sequentially and all in the same thread.
@@ -161,7 +199,11 @@ public:
      * If previous state was PAUSED, the event thread is stopped (and buffers are cleared).
      * In both cases, pending samples are stored without schema if allowed (only_with_schema not true).
      *
+     * The state transition is immediate: the samples in memory are written and the output file is closed in a
+     * background thread. Use \c wait_for_finalization to wait for it to complete.
+     *
      * @param [in] on_destruction Whether this command is executed on object's destruction.
+     * @param [in] on_finalized   Callback to execute (from the background thread) once the output file is closed.
      *
      * @warning Not thread safe with respect to other command methods ( \c start , \c pause , \c stop ,
      * and \c trigger_event). This is, they are expected to be executed sequentially and all in the same thread.
@@ -169,7 +211,18 @@ public:
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
     void stop(
-            bool on_destruction = false);
+            bool on_destruction = false,
+            const std::function<void()>& on_finalized = nullptr);
+
+    /**
+     * @brief Wait until the output file closed by the last \c stop has been finalized
+     *
+     * @warning Not thread safe with respect to other command methods ( \c start , \c pause , \c stop ,
+     * and \c trigger_event). This is, they are expected to be executed sequentially and all in the same thread.
+     *
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void wait_for_finalization();
 
     /**
      * @brief Pause handler instance
@@ -177,6 +230,7 @@ public:
      * Creates event thread waiting for an event to dump samples in buffer.
      *
      * If previous state was RUNNING, data stored in buffer is dumped to disk.
+     * If the output file of a previous \c stop is still being finalized, waits for it first.
      *
      * @warning Not thread safe with respect to other command methods ( \c start , \c pause , \c stop ,
      * and \c trigger_event). This is, they are expected to be executed sequentially and all in the same thread.
@@ -238,6 +292,62 @@ protected:
         stopped,                //! Signals event thread to exit.
     };
 
+    /**
+     * @brief Fill \c msg with a reference to the payload of \c data and its timestamps.
+     *
+     * With keyframes, the messages of transient-local topics are marked as keyframes of their instance.
+     *
+     * @throw InconsistencyException if \c data has no payload or no payload owner.
+     */
+    void fill_message_(
+            const ddspipe::core::types::DdsTopic& topic,
+            ddspipe::core::types::RtpsPayloadData& data,
+            const mcap::Timestamp reception_time,
+            McapMessage& msg);
+
+    /**
+     * @brief Add a received message as described in \c add_data .
+     *
+     * The memory budget is not enforced, so a batch of messages enforces it once.
+     *
+     * @param [in] topic Topic of message to be added
+     * @param [in] msg McapMessage to be added
+     */
+    void add_message_nts_(
+            const ddspipe::core::types::DdsTopic& topic,
+            McapMessage& msg);
+
+    /**
+     * @brief Hand over a batch of samples taken out of an ingestion lane (called from the lane thread).
+     *
+     * The samples are moved to the \c buffer of the lane and, only if \c mtx_ is free, added right away. The lane
+     * thread only waits for \c mtx_ when the buffers of the lanes hold \c MAX_LANE_BUFFERED_SAMPLES samples, so a
+     * lane keeps taking samples out of its queue while e.g. the samples buffer is written to disk.
+     *
+     * @return Whether the samples handed over have been added (false <-> \c mtx_ was busy, the lane retries later
+     * with an empty batch, as the thread holding \c mtx_ may have looked into the buffers before they were filled).
+     */
+    bool add_lane_samples_(
+            LaneBuffer& buffer,
+            std::vector<IngestionSample>& samples);
+
+    //! Add the samples in the buffers of the lanes, in the order each lane handed them over
+    void add_lane_samples_nts_();
+
+    /**
+     * @brief Find the ingestion lane of \c topic .
+     *
+     * @param [in] topic Topic of the sample
+     * @param [out] lane_topic Copy of \c topic shared by the samples of the lane
+     * @return Lane of the topic, or \c nullptr if its samples are added directly.
+     */
+    IngestionLane* get_lane_(
+            const ddspipe::core::types::DdsTopic& topic,
+            std::shared_ptr<const ddspipe::core::types::DdsTopic>& lane_topic);
+
+    //! Wait for every ingestion lane to add the samples inserted so far
+    void flush_lanes_();
+
     /**
      * @brief Add message to \c buffer_ structure, or directly write to MCAP file.
      *
@@ -341,27 +451,83 @@ protected:
     //! Write in disk samples stored in buffer
     void dump_data_nts_();
 
+    //! Write in disk (and pop) every sample in \c samples
+    void write_samples_(
+            std::list<McapMessage>& samples);
+
+    //! Write in disk \c samples and close the output file (executed by \c finalization_thread_ )
+    void finalization_routine_(
+            std::list<McapMessage> samples,
+            std::function<void()> on_finalized);
+
+    //! Append a sample to \c pending_samples , keeping \c pending_by_age_ and the pending totals up to date
+    void push_pending_nts_(
+            pending_list& pending_samples,
+            const ddspipe::core::types::DdsTopic& topic,
+            const McapMessage& msg,
+            const bool received_running);
+
+    //! Remove the oldest sample of \c pending_samples , keeping \c pending_by_age_ and the pending totals up to date
+    void pop_pending_nts_(
+            pending_list& pending_samples);
+
+    //! Remove \c it from \c pending_samples , keeping \c pending_by_age_ and the pending totals up to date
+    pending_list::iterator erase_pending_nts_(
+            pending_list& pending_samples,
+            pending_list::iterator it);
+
+    //! Remove every sample of \c pending_samples
+    void clear_pending_nts_(
+            std::map<std::string, pending_list>& pending_samples);
+
+    //! Publish in \c RecorderMetrics the number of samples kept in \c pending_samples_ and \c pending_samples_paused_
+    void update_pending_samples_metric_nts_() const;
+
+    //! Publish in \c RecorderMetrics the number of samples kept in \c samples_buffer_ and the memory they hold
+    void update_buffer_metrics_nts_() const;
+
     /**
-     * @brief Create and add to \c mcap_writer_ channel associated to given \c topic
+     * @brief Keep the payloads held in memory under the configured memory budget.
+     *
+     * When the budget is exceeded, the samples buffer is first written to disk if RUNNING.
+     * If the budget is still exceeded, the oldest samples kept in memory are discarded (pending samples received in
+     * RUNNING state are written without schema instead, if only_with_schema not true and still RUNNING with the output
+     * not congested).
+     */
+    void enforce_memory_budget_nts_();
+
+    //! Log the memory held by every recorder subsystem
+    void log_memory_usage_nts_() const;
+
+    //! Whether \c topic matches any of the low priority topics dropped before the output is full
+    bool is_low_priority_nts_(
+            const ddspipe::core::types::DdsTopic& topic);
+
+    /**
+     * @brief Create and add to \c mcap_writer_ channel associated to given \c topic in \c domain
      *
      * A channel with blank schema is created when none found, unless only_with_schema true.
      *
      * @throw InconsistencyException if creation fails (schema not found and only_with_schema true).
      *
      * @param [in] topic Topic associated to the channel to be created
+     * @param [in] domain Domain in which the messages of the channel are received
      */
     mcap::ChannelId create_channel_id_nts_(
-            const ddspipe::core::types::DdsTopic& topic);
+            const ddspipe::core::types::DdsTopic& topic,
+            const ddspipe::core::types::DomainIdType domain);
 
     /**
-     * @brief Attempt to get channel associated to given \c topic, and attempt to create one if not found.
+     * @brief Attempt to get channel associated to given \c topic in \c domain, and attempt to create one if not found.
      *
      * @throw InconsistencyException if not found, and creation fails (schema not found and only_with_schema true).
      *
      * @param [in] topic Topic associated to the channel to be created
+     * @param [in] domain Domain in which the messages of the channel are received
      */
     mcap::ChannelId get_channel_id_nts_(
-            const ddspipe::core::types::DdsTopic& topic);
+            const ddspipe::core::types::DdsTopic& topic,
+            const ddspipe::core::types::DomainIdType domain);
 
     /**
      * @brief Update channels with \c old_schema_id to use \c new_schema_id instead.
@@ -477,14 +643,17 @@ protected:
     //! MCAP writer
     McapWriter mcap_writer_;
 
+    //! Clock timestamping the logTime of the received samples
+    LogTimeClock log_time_clock_;
+
     //! Schemas map
     std::map<std::string, mcap::Schema> schemas_;
 
     //! Received types set
     std::set<std::string> received_types_;
 
-    //! Channels map
-    std::map<ddspipe::core::types::DdsTopic, mcap::Channel> channels_;
+    //! Channels map (a topic has a channel per domain it is received in)
+    std::map<std::pair<ddspipe::core::types::DdsTopic, ddspipe::core::types::DomainIdType>, mcap::Channel> channels_;
 
     //! Samples buffer
     std::list<McapMessage> samples_buffer_;
@@ -498,12 +667,18 @@ protected:
     //! Structure where messages (received in PAUSED state) with unknown type are kept
     std::map<std::string, pending_list> pending_samples_paused_;
 
+    //! Every sample in \c pending_samples_ and \c pending_samples_paused_ , in the order they were kept
+    std::list<PendingAge> pending_by_age_;
+
     //! Mutex synchronizing state transitions and access to object's data structures
     std::mutex mtx_;
 
     //! Event thread
     std::thread event_thread_;
 
+    //! Thread writing the samples left in memory and closing the output file after a \c stop
+    std::thread finalization_thread_;
+
     //! Event flag
     EventCode event_flag_ = EventCode::stopped;
 
@@ -515,6 +690,46 @@ protected:
 
     //! Unique sequence number assigned to received messages. It is incremented with every sample added.
     unsigned int unique_sequence_number_{0};
+
+    //! Bytes of the payloads of the samples in \c samples_buffer_
+    std::uint64_t buffered_bytes_{0};
+
+    //! Bytes of the payloads of the samples in \c pending_samples_ and \c pending_samples_paused_
+    std::uint64_t pending_bytes_{0};
+
+    //! Number of samples in \c pending_samples_ and \c pending_samples_paused_
+    std::uint64_t pending_count_{0};
+
+    //! Whether each topic (by name) matches the low priority topics, so the patterns are only matched once
+    std::map<std::string, bool> low_priority_topics_;
+
+    //! Lane of a topic, with a copy of the topic shared by its samples (lane nullptr <-> no lane)
+    using LaneRoute = std::pair<IngestionLane*, std::shared_ptr<const ddspipe::core::types::DdsTopic>>;
+
+    //! Lane of every topic with samples received, so the patterns are only matched once
+    std::map<ddspipe::core::types::DdsTopic, LaneRoute> lane_routes_;
+
+    //! Protects \c lane_routes_ (read by every thread receiving samples, without taking \c mtx_ )
+    std::shared_mutex lane_routes_mtx_;
+
+    //! Samples handed over by every ingestion lane (by lane, so the lanes never contend with each other)
+    std::vector<std::unique_ptr<LaneBuffer>> lane_buffers_;
+
+    //! Number of samples in \c lane_buffers_ , so the threads taking \c mtx_ only look into them when not empty
+    std::atomic<std::size_t> lane_buffered_samples_{0};
+
+    //! Ingestion lanes, declared last so their threads stop before the rest of the handler is destroyed
+    std::vector<std::unique_ptr<IngestionLane>> lanes_;
+
+    //! Samples in \c lane_buffers_ from which the lane threads wait for \c mtx_ to add them
+    static constexpr std::size_t MAX_LANE_BUFFERED_SAMPLES = 16 * 1024;
+
+    //! Approximate memory taken by an entry of \c samples_buffer_ (excluding its payload)
+    static constexpr std::uint64_t BUFFER_ENTRY_SIZE = sizeof(McapMessage) + 2 * sizeof(void*);
+
+    //! Approximate memory taken by an entry of a \c pending_list (excluding its payload)
+    static constexpr std::uint64_t PENDING_ENTRY_SIZE =
+            sizeof(PendingSample) + sizeof(PendingAge) + 4 * sizeof(void*);
 };
 
 } /* namespace participants */
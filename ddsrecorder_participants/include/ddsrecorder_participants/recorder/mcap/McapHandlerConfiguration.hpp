@@ -19,11 +19,19 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
 #include <mcap/mcap.hpp>
 
+#include <ddspipe_core/types/dds/DomainId.hpp>
+#include <ddspipe_core/types/participant/ParticipantId.hpp>
+
+#include <ddsrecorder_participants/recorder/mcap/IngestionLaneConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClockConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapBlobsConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkingConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 
 namespace eprosima {
@@ -45,7 +53,18 @@ struct McapHandlerConfiguration
             const bool& only_with_schema,
             const mcap::McapWriterOptions& mcap_writer_options,
             const bool& record_types,
-            const bool& ros2_types)
+            const bool& ros2_types,
+            const bool& record_statistics = false,
+            const std::uint64_t& memory_budget = 0,
+            const bool& lazy_channels = false,
+            const bool& types_sidecar = false,
+            const LogTimeClockConfiguration& log_time_clock = {},
+            const McapChunkingConfiguration& chunking = {},
+            const McapBlobsConfiguration& blobs = {},
+            const std::vector<IngestionLaneConfiguration>& ingestion_lanes = {},
+            const bool& keyframes = false,
+            const std::map<ddspipe::core::types::ParticipantId, ddspipe::core::types::DomainIdType>&
+            participant_domains = {})
         : output_settings(output_settings)
         , max_pending_samples(max_pending_samples)
         , buffer_size(buffer_size)
@@ -56,6 +75,16 @@ struct McapHandlerConfiguration
         , mcap_writer_options(mcap_writer_options)
         , record_types(record_types)
         , ros2_types(ros2_types)
+        , record_statistics(record_statistics)
+        , memory_budget(memory_budget)
+        , lazy_channels(lazy_channels)
+        , types_sidecar(types_sidecar)
+        , log_time_clock(log_time_clock)
+        , chunking(chunking)
+        , blobs(blobs)
+        , ingestion_lanes(ingestion_lanes)
+        , keyframes(keyframes)
+        , participant_domains(participant_domains)
     {
     }
 
@@ -88,6 +117,36 @@ struct McapHandlerConfiguration
 
     //! Whether to generate schemas as OMG IDL or ROS2 msg
     bool ros2_types;
+
+    //! Whether to write the statistics of each channel in every output MCAP file
+    bool record_statistics;
+
+    //! Max bytes of payloads to keep in memory before flushing or discarding samples (0 <-> no limit)
+    std::uint64_t memory_budget;
+
+    //! Whether to write schemas and channels only in the output files where their channel has messages
+    bool lazy_channels;
+
+    //! Whether to store the dynamic types in a sidecar file shared by every output MCAP file
+    bool types_sidecar;
+
+    //! Clock timestamping the logTime of the received samples (applies when log_publishTime is false)
+    LogTimeClockConfiguration log_time_clock;
+
+    //! Strategy deciding when to close the chunks of the output MCAP files
+    McapChunkingConfiguration chunking;
+
+    //! Which payloads to write out of the chunks of the output MCAP files
+    McapBlobsConfiguration blobs;
+
+    //! Lanes adding the samples of their topics from a dedicated thread
+    std::vector<IngestionLaneConfiguration> ingestion_lanes;
+
+    //! Whether to write the last sample of every instance of the transient-local topics at the start of every new file
+    bool keyframes;
+
+    //! Domain of every participant receiving samples, written in the channels of their topics (empty <-> unknown)
+    std::map<ddspipe::core::types::ParticipantId, ddspipe::core::types::DomainIdType> participant_domains;
 };
 
 } /* namespace participants */
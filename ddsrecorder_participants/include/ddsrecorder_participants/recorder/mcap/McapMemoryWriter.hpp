@@ -0,0 +1,63 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapMemoryWriter.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <mcap/mcap.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Output of the MCAP library keeping the file being written in a growable buffer instead of on disk.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapMemoryWriter : public mcap::IWritable
+{
+public:
+
+    void end() override;
+
+    uint64_t size() const override;
+
+    //! Take the bytes written so far, leaving the writer empty for the next file
+    std::vector<std::byte> release() noexcept;
+
+protected:
+
+    void handleWrite(
+            const std::byte* data,
+            uint64_t size) override;
+
+    void handleWrite(
+            const mcap::ConstBuffer* buffers,
+            size_t count) override;
+
+    // The bytes of the file being written
+    std::vector<std::byte> buffer_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -20,6 +20,9 @@
 
 #include <mcap/types.hpp>
 
+#include <fastdds/rtps/common/InstanceHandle.hpp>
+
+#include <ddspipe_core/types/dds/DomainId.hpp>
 #include <ddspipe_core/types/dds/Payload.hpp>
 #include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
 
@@ -46,6 +49,22 @@ struct McapMessage : public mcap::Message
     McapMessage(
             const McapMessage& msg);
 
+    /**
+     * Message move constructor
+     *
+     * Take over the payload of \c msg without going through the PayloadPool API, leaving \c msg without payload.
+     */
+    McapMessage(
+            McapMessage&& msg) noexcept;
+
+    //! Release the payload of this message and take over the payload of \c msg (see move constructor)
+    McapMessage& operator =(
+            McapMessage&& msg) noexcept;
+
+    //! Not copy-assignable: the default copy assignment would share the payload without taking a reference
+    McapMessage& operator =(
+            const McapMessage& msg) = delete;
+
     /**
      * Message destructor
      *
@@ -62,6 +81,15 @@ struct McapMessage : public mcap::Message
 
     //! Payload owner (reference to \c PayloadPool which created/reserved it)
     ddspipe::core::PayloadPool* payload_owner{nullptr};
+
+    //! Whether the message holds the state of its instance, to be written again at the start of every new file
+    bool keyframe{false};
+
+    //! Instance of the message (only set for the keyframes of keyed topics)
+    fastdds::rtps::InstanceHandle_t instance_handle{};
+
+    //! Domain in which the message was received (only set when the domain of every participant is known)
+    ddspipe::core::types::DomainIdType domain{0};
 };
 
 } /* namespace participants */
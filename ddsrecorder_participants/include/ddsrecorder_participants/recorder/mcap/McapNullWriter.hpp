@@ -0,0 +1,64 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapNullWriter.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <mcap/mcap.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Output of the MCAP library discarding the file being written, only keeping track of its size.
+ *
+ * Used to measure the recording path without the cost of the disk.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapNullWriter : public mcap::IWritable
+{
+public:
+
+    void end() override;
+
+    uint64_t size() const override;
+
+    //! Set the size back to zero for the next file
+    void reset() noexcept;
+
+protected:
+
+    void handleWrite(
+            const std::byte* data,
+            uint64_t size) override;
+
+    void handleWrite(
+            const mcap::ConstBuffer* buffers,
+            size_t count) override;
+
+    // The size of the file being written
+    uint64_t size_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -42,9 +42,12 @@ public:
     /**
      * @brief Constructor
      *
+     * @param lazy_channels Whether schemas and channels are only written in the files where their channel has
+     * messages (and not repeated in the summary section).
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
-    McapSizeTracker();
+    McapSizeTracker(
+            const bool lazy_channels = false);
 
     /**
      * @brief Destructor
@@ -73,6 +76,30 @@ public:
     void message_written(
             const uint64_t& data_size);
 
+    /**
+     * @brief Reserve the space of the first message of \c channel in the current file, along with \c channel itself
+     * and its \c schema (\c nullptr if it has already been written in the current file).
+     * The space of the channel's \c statistics metadata (\c nullptr if not recorded) is reserved too.
+     *
+     * Only applies when schemas and channels are written lazily.
+     * The minimum MCAP size is kept, since the next file only needs them if it receives a message of \c channel .
+     *
+     * @throws \c FullFileException carrying the size of all of them together, so a new file can
+     * be opened with enough space for all of them.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void first_message_to_write(
+            const uint64_t& data_size,
+            const mcap::Channel& channel,
+            const mcap::Schema* schema,
+            const mcap::Metadata* statistics = nullptr);
+
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void first_message_written(
+            const uint64_t& data_size,
+            const mcap::Channel& channel,
+            const mcap::Schema* schema);
+
     DDSRECORDER_PARTICIPANTS_DllAPI
     void schema_to_write(
             const mcap::Schema& schema);
@@ -102,10 +129,34 @@ public:
     void attachment_written(
             const uint64_t& payload_size);
 
+    /**
+     * @brief Reserve the space of a blob (an attachment record holding a payload written out of the chunks) of
+     * \c data_size bytes.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void blob_to_write(
+            const uint64_t& data_size);
+
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void blob_written(
+            const uint64_t& data_size);
+
     DDSRECORDER_PARTICIPANTS_DllAPI
     void metadata_to_write(
             const mcap::Metadata& metadata);
 
+    /**
+     * @brief Replace the space reserved for \c metadata_to_remove with the space needed by \c metadata_to_write .
+     *
+     * Shrinking a reservation never throws, not even after the file has been found full, so it can be called while
+     * closing the file.
+     * The minimum MCAP size is kept, since it must account for the largest metadata.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void metadata_to_write(
+            const mcap::Metadata& metadata_to_write,
+            const mcap::Metadata& metadata_to_remove);
+
     DDSRECORDER_PARTICIPANTS_DllAPI
     void metadata_written(
             const mcap::Metadata& metadata);
@@ -118,7 +169,6 @@ public:
 
     DDSRECORDER_PARTICIPANTS_DllAPI
     std::uint64_t get_min_mcap_size() const;
-
 protected:
 
     bool can_increase_potential_mcap_size_(
@@ -167,6 +217,13 @@ protected:
     std::uint64_t get_attachment_size_(
             const std::uint64_t& payload_size);
 
+    /**
+     * @brief Get space needed to write blob
+     *
+     */
+    std::uint64_t get_blob_size_(
+            const std::uint64_t& data_size);
+
     /**
      * @brief Get space needed to write metadata
      *
@@ -191,6 +248,9 @@ protected:
 
     bool enabled_ = false;
 
+    //! Whether schemas and channels are written once (in the data section) and only in the files that need them
+    const bool lazy_channels_;
+
     //! MCAP file overhead
     /**
      * To reach this number, we use the following constants:
@@ -213,6 +273,9 @@ protected:
     //! Additional overhead size for a MCAP attachment
     static constexpr std::uint64_t MCAP_ATTACHMENT_OVERHEAD{58 + 70}; // Write Attachment + Write AttachmentIndex
 
+    //! Additional overhead size for a MCAP blob (named "blob" with the longest media type)
+    static constexpr std::uint64_t MCAP_BLOB_OVERHEAD{73 + 85}; // Write Attachment + Write AttachmentIndex
+
     //! Additional overhead size for a MCAP metadata
     static constexpr std::uint64_t MCAP_METADATA_OVERHEAD{17 + 29}; // Write Metadata + Write MetadataIndex
 
@@ -0,0 +1,65 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapStreamConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+//! Where the \c McapStreamWriter streams the MCAP files
+enum class McapStreamKind
+{
+    tcp,                    //! A collector listening on a TCP port.
+    unix_socket,            //! A collector listening on a Unix domain socket.
+    pipe,                   //! The standard output of the process (e.g. piped into a collector).
+};
+
+/**
+ * Structure encapsulating the configuration of the stream sink (see \c McapStreamWriter ).
+ */
+struct McapStreamConfiguration
+{
+    //! Where to stream the MCAP files
+    McapStreamKind kind{McapStreamKind::tcp};
+
+    //! Host name or address of the collector (applies to tcp)
+    std::string address{"127.0.0.1"};
+
+    //! TCP port of the collector (applies to tcp)
+    std::uint16_t port{9475};
+
+    //! Path of the Unix domain socket of the collector (applies to unix_socket)
+    std::string path{};
+
+    //! Period [ms] with which to try to (re)connect to the collector
+    std::uint32_t reconnection_period{1000};
+
+    //! Max size [bytes] of the frames already sent kept to send them again after a reconnection
+    std::uint64_t replay_buffer_size{8 * 1024 * 1024};
+
+    //! Size [bytes] of the frames waiting to be sent from which the stream is congested
+    std::uint64_t max_unsent_size{32 * 1024 * 1024};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
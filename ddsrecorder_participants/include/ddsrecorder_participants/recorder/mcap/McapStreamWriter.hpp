@@ -0,0 +1,202 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapStreamWriter.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mcap/mcap.hpp>
+
+#include <ddsrecorder_participants/common/mcap/McapStreamFrame.hpp>
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Output of the MCAP library streaming the files being written to a collector (see \c McapStreamFrame ).
+ *
+ * The MCAP library never seeks back in its output, so the bytes of a file are framed as they are written: the
+ * \c McapWriter frames them at chunk boundaries (calling \c flush ), and larger stretches without chunks are framed
+ * every \c MAX_FRAME_LENGTH bytes. The frames are sent by a background thread, so writing never blocks on the
+ * network.
+ *
+ * When the connection is lost, the thread keeps trying to reconnect every \c reconnection_period . Once reconnected,
+ * it sends again the \c open frames of the files not closed yet and the frames kept in the replay buffer, so the
+ * collector resumes those files where it lost them (as long as the replay buffer reaches that far back).
+ *
+ * The frames waiting to be sent are not bounded. Instead, the stream reports being congested once they exceed
+ * \c max_unsent_size , and the \c McapHandler stops writing until it is not, applying its overload policy meanwhile.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapStreamWriter : public mcap::IWritable
+{
+public:
+
+    /**
+     * @brief Construct a \c McapStreamWriter and start its sending thread.
+     *
+     * With a \c pipe stream, the standard output of the process is taken over by the stream: everything else written
+     * to it (e.g. logs) is redirected to the standard error.
+     *
+     * @param configuration Where and how to stream the files.
+     * @throws \c InitializationException if streaming is not supported on this platform.
+     */
+    McapStreamWriter(
+            const McapStreamConfiguration& configuration);
+
+    /**
+     * @brief Destroy the \c McapStreamWriter .
+     *
+     * Sends the frames left while connected to the collector, and discards them otherwise.
+     */
+    ~McapStreamWriter();
+
+    //! Start streaming a new file named \c filename
+    void open(
+            const std::string& filename);
+
+    //! Frame the bytes written since the last frame
+    void flush();
+
+    //! Frame the bytes left and close the file
+    void end() override;
+
+    uint64_t size() const override;
+
+    //! Whether the frames waiting to be sent exceed \c max_unsent_size
+    bool congested() const noexcept;
+
+protected:
+
+    void handleWrite(
+            const std::byte* data,
+            uint64_t size) override;
+
+    void handleWrite(
+            const mcap::ConstBuffer* buffers,
+            size_t count) override;
+
+    //! A frame (header and payload) to be sent
+    struct Frame
+    {
+        McapStreamFrame::Kind kind;
+        std::uint64_t file_id;
+        McapStreamFrame::Header header;
+        std::vector<std::byte> payload;
+
+        //! Size of the frame once sent
+        std::uint64_t size() const noexcept
+        {
+            return header.size() + payload.size();
+        }
+
+    };
+
+    //! Queue a frame to be sent
+    void enqueue_(
+            const McapStreamFrame::Kind kind,
+            const std::uint64_t offset,
+            std::vector<std::byte>&& payload);
+
+    //! Send the queued frames, (re)connecting to the collector when needed, until the writer is destroyed
+    void sender_routine_();
+
+    //! Keep a frame just sent in the replay buffer (or forget the frames of its file if it closes it)
+    void on_frame_sent_nts_(
+            const std::shared_ptr<const Frame>& frame);
+
+    //! Publish in \c RecorderMetrics the memory held by the frames
+    void update_memory_metrics_nts_() const;
+
+    //! Connect to the collector
+    bool connect_();
+
+    //! Close the connection to the collector
+    void disconnect_() noexcept;
+
+    //! Send \c frame to the collector
+    bool send_(
+            const Frame& frame) const;
+
+    // The configuration of the stream
+    const McapStreamConfiguration configuration_;
+
+    // Id of the file being written (only accessed by the MCAP library)
+    std::uint64_t file_id_{0};
+
+    // Size of the file being written (only accessed by the MCAP library)
+    std::uint64_t size_{0};
+
+    // Bytes written since the last frame (only accessed by the MCAP library)
+    std::vector<std::byte> unframed_;
+
+    // Protects the queues and the connection state
+    std::mutex mutex_;
+
+    // Wakes up the sending thread
+    std::condition_variable cv_;
+
+    // Frames waiting to be sent
+    std::deque<std::shared_ptr<const Frame>> unsent_;
+
+    // Size of the frames waiting to be sent
+    std::atomic<std::uint64_t> unsent_size_{0};
+
+    // Data frames already sent, to be sent again after a reconnection
+    std::deque<std::shared_ptr<const Frame>> replay_;
+
+    // Size of the frames in the replay buffer
+    std::uint64_t replay_size_{0};
+
+    // The open frames of the files not closed yet, to be sent again after a reconnection
+    std::map<std::uint64_t, std::shared_ptr<const Frame>> open_frames_;
+
+    // Whether the sending thread must stop once the queued frames are sent
+    bool stop_{false};
+
+    // Connection to the collector (-1 if not connected)
+    int fd_{-1};
+
+    // Standard output of the process, taken over by a pipe stream (-1 if broken or not a pipe stream)
+    int pipe_fd_{-1};
+
+    // Thread sending the frames
+    std::thread thread_;
+
+    //! Max length of the data frames
+    static constexpr std::uint64_t MAX_FRAME_LENGTH = 4 * 1024 * 1024;
+
+    //! Time [ms] after which a blocked send is taken as a lost connection
+    static constexpr int SEND_TIMEOUT_MS = 5000;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
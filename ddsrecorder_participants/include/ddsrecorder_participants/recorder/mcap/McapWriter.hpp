@@ -18,18 +18,36 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include <mcap/mcap.hpp>
 
 #include <fastdds/rtps/common/SerializedPayload.hpp>
 
+#include <ddsrecorder_participants/common/mcap/McapBlob.hpp>
 #include <ddsrecorder_participants/constants.hpp>
 #include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/mcap/McapBlobsConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChannelStatistics.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkingConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkPolicy.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapHandlerConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapMemoryWriter.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapMessage.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapNullWriter.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapSizeTracker.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamWriter.hpp>
+#include <ddsrecorder_participants/recorder/output/DiskFullForecaster.hpp>
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
 #include <ddsrecorder_participants/recorder/output/FullFileException.hpp>
 
@@ -45,7 +63,12 @@ public:
             const OutputSettings& configuration,
             const mcap::McapWriterOptions& mcap_configuration,
             std::shared_ptr<FileTracker>& file_tracker,
-            const bool record_types = true);
+            const bool record_types = true,
+            const bool record_statistics = false,
+            const bool lazy_channels = false,
+            const bool types_sidecar = false,
+            const McapChunkingConfiguration& chunking = {},
+            const McapBlobsConfiguration& blobs = {});
 
     ~McapWriter();
 
@@ -85,7 +108,8 @@ public:
     /**
      * @brief Updates the dynamic types payload.
      *
-     * The dynamic types payload is written down as an attachment when the MCAP file is being closed.
+     * The dynamic types payload is written down as an attachment when the MCAP file is being closed, or in a sidecar
+     * file referenced by a metadata record if \c types_sidecar is set.
      *
      * @param dynamic_types_payload The dynamic types payload to be written.
      *
@@ -105,6 +129,21 @@ public:
     void set_on_disk_full_callback(
             std::function<void()> on_disk_full_lambda) noexcept;
 
+    /**
+     * @brief Whether the output cannot take more data for now.
+     *
+     * Only the stream sink gets congested, when the collector does not keep up with the data written.
+     */
+    bool congested() const noexcept;
+
+    /**
+     * @brief Whether the samples of the low priority topics are to be discarded.
+     *
+     * Only happens when the output is forecast to be full sooner than the drop threshold of the
+     * \c DiskFullForecastConfiguration .
+     */
+    bool dropping_low_priority() const noexcept;
+
 protected:
 
     /**
@@ -136,6 +175,95 @@ protected:
     void write_nts_(
             const T& data);
 
+    /**
+     * @brief Writes a message (whose payload is written in the chunk) to the MCAP file.
+     *
+     * @param msg The message to be written.
+     * @throws \c FullFileException if the MCAP file is full.
+     */
+    void write_message_nts_(
+            const McapMessage& msg);
+
+    /**
+     * @brief Writes the payload of a message out of the chunks, in a blob, and a reference to it in the chunk.
+     *
+     * @param msg The message to be written.
+     * @throws \c FullFileException if the MCAP file is full.
+     */
+    void write_blob_nts_(
+            const McapMessage& msg);
+
+    /**
+     * @brief Writes a message in the chunk with a reference to the blob at \c offset instead of its payload.
+     *
+     * @param msg The message to be written.
+     * @param offset The offset of the blob holding the payload of the message.
+     * @throws \c FullFileException if the MCAP file is full.
+     */
+    void write_blob_reference_nts_(
+            const McapMessage& msg,
+            const std::uint64_t offset);
+
+    /**
+     * @brief Keeps a copy of \c msg (sharing its payload) as the keyframe of its instance, replacing the previous one.
+     */
+    void store_keyframe_nts_(
+            const McapMessage& msg);
+
+    /**
+     * @brief Writes the keyframes at the start of the current file, so the file can be replayed on its own.
+     *
+     * The keyframes are timestamped with the last log time written, and the ones that do not fit in the file are
+     * skipped.
+     */
+    void write_keyframes_nts_();
+
+    /**
+     * @brief Writes the first message of a channel in the current file, along with the channel and its schema.
+     *
+     * Only applies to lazy channels.
+     *
+     * @param msg The message to be written.
+     * @throws \c FullFileException if the MCAP file is full.
+     */
+    void write_first_message_nts_(
+            const McapMessage& msg);
+
+    /**
+     * @brief Updates the file size, the channel statistics and the metrics after writing \c msg .
+     */
+    void on_message_written_nts_(
+            const McapMessage& msg);
+
+    /**
+     * @brief Closes the current chunk if it has been closed by the MCAP library or if the chunk policy says so.
+     */
+    void update_chunk_nts_(
+            const McapMessage& msg);
+
+    /**
+     * @brief Closes the current chunk, if it holds any message.
+     */
+    void close_chunk_nts_(
+            const ChunkCloseReason reason);
+
+    /**
+     * @brief Accounts the chunk just written in the chunk policy and the metrics.
+     */
+    void on_chunk_written_nts_(
+            const ChunkCloseReason reason);
+
+    /**
+     * @brief Checks whether writing to the output of the MCAP library has failed (e.g. the disk is full) and, if so,
+     * reports it as a full disk.
+     */
+    void check_output_nts_();
+
+    /**
+     * @brief Logs the statistics of the chunks written in the current file.
+     */
+    void log_chunk_statistics_nts_() const;
+
     /**
      * @brief Writes the attachment to the MCAP file.
      *
@@ -146,6 +274,25 @@ protected:
      */
     void write_attachment_nts_();
 
+    /**
+     * @brief Writes the dynamic types payload in its sidecar file (unless it already exists) and a metadata record
+     * referencing it to the MCAP file.
+     *
+     * The size of the reference is allocated by calling \c update_dynamic_types.
+     */
+    void write_types_sidecar_nts_();
+
+    //! Metadata record referencing the sidecar file of \c dynamic_types_payload
+    static mcap::Metadata types_reference_(
+            const fastdds::rtps::SerializedPayload_t& dynamic_types_payload);
+
+    /**
+     * @brief Writes the statistics of every channel of the current file as metadata records.
+     *
+     * The space of the statistics is reserved when their channel is written.
+     */
+    void write_channels_statistics_nts_();
+
     /**
      * @brief Writes the channels to the MCAP file.
      *
@@ -153,6 +300,15 @@ protected:
      */
     void write_channels_nts_();
 
+    /**
+     * @brief Registers the known schemas and channels in the MCAP library without writing them.
+     *
+     * Used when writing them lazily: the MCAP library writes a schema and a channel down the first time a message of
+     * the channel is written in the current file. The schemas and channels are registered in the same order they
+     * were first written, so they keep their ids.
+     */
+    void register_schemas_and_channels_nts_();
+
     /**
      * @brief Writes the metadata to the MCAP file.
      *
@@ -180,16 +336,50 @@ protected:
     void on_mcap_full_nts_(
             const FullFileException& e);
 
+    /**
+     * @brief Function called when an MCAP file cannot be created.
+     */
+    void on_file_creation_failure_() const noexcept;
+
     /**
      * @brief Function called when the disk is full.
      */
     void on_disk_full_() const noexcept;
 
+    /**
+     * @brief Forecasts when the output will be full, if the last forecast is older than the forecast period, and takes
+     * or stops taking the actions of the \c DiskFullForecastConfiguration .
+     */
+    void update_disk_full_forecast_nts_();
+
+    /**
+     * @brief Publish in \c RecorderMetrics the memory held by the schemas, channels, dynamic types and chunk buffers.
+     */
+    void update_memory_metrics_nts_();
+
+    /**
+     * @brief Store \c schema to write it on new MCAP files, accounting for the memory it holds.
+     */
+    void store_schema_nts_(
+            const mcap::Schema& schema);
+
+    /**
+     * @brief Store \c channel to write it on new MCAP files, accounting for the memory it holds.
+     */
+    void store_channel_nts_(
+            const mcap::Channel& channel);
+
     // The configuration for the class
     const OutputSettings configuration_;
 
     // The configuration for the MCAP library
-    const mcap::McapWriterOptions mcap_configuration_;
+    const mcap::McapWriterOptions default_mcap_configuration_;
+
+    // The configuration for the MCAP library when the output is forecast to be full soon (applies to the forecast)
+    const mcap::McapWriterOptions forecast_mcap_configuration_;
+
+    // The configuration for the MCAP library of the current file
+    mcap::McapWriterOptions mcap_configuration_;
 
     // Track the files written by the MCAP library
     std::shared_ptr<FileTracker> file_tracker_;
@@ -197,6 +387,48 @@ protected:
     // Whether to record the types
     const bool record_types_{false};
 
+    // Whether to write the statistics of each channel when closing a file
+    const bool record_statistics_{false};
+
+    // Whether to write the schemas and channels only in the files where their channel has messages
+    const bool lazy_channels_{false};
+
+    // Whether to write the types in a sidecar file shared by every MCAP file instead of in an attachment
+    const bool types_sidecar_{false};
+
+    // Decides when to close the chunks and keeps their statistics
+    McapChunkPolicy chunk_policy_;
+
+    // Number of chunks written by the MCAP library in the current file
+    std::uint64_t file_chunks_{0};
+
+    // Size of the current file when the last chunk was written
+    std::uint64_t chunk_offset_{0};
+
+    // The messages whose payloads are referenced by the current chunk (applies to uncompressed chunks)
+    std::deque<McapMessage> chunk_messages_;
+
+    // Which payloads to write out of the chunks
+    const McapBlobsConfiguration blobs_;
+
+    // Compresses the blobs (nullptr if they are not compressed)
+    std::unique_ptr<mcap::IChunkWriter> blob_compressor_;
+
+    // The references to blobs written in the current chunk (kept alive until the chunk is written)
+    std::deque<McapBlob::Reference> chunk_blob_references_;
+
+    // The offset of the blob holding each distinct payload written in the current file (applies to deduplication)
+    std::map<McapBlob::Digest, std::uint64_t> file_blobs_;
+
+    // The last message written of every instance of the transient-local topics (applies to keyframes)
+    std::map<std::pair<mcap::ChannelId, fastdds::rtps::InstanceHandle_t>, McapMessage> keyframes_;
+
+    // The bytes of the payloads of the keyframes
+    std::uint64_t keyframes_size_{0};
+
+    // The greatest log time written, given to the keyframes written at the start of a new file
+    mcap::Timestamp last_log_time_{0};
+
     // The mutex to protect the calls to write
     std::mutex mutex_;
 
@@ -209,6 +441,15 @@ protected:
     // The writer from the MCAP library
     mcap::McapWriter writer_;
 
+    // The output of the MCAP library (applies to the memory sink)
+    McapMemoryWriter memory_output_;
+
+    // The output of the MCAP library (applies to the null sink)
+    McapNullWriter null_output_;
+
+    // The output of the MCAP library (applies to the stream sink)
+    std::unique_ptr<McapStreamWriter> stream_output_;
+
     // The dynamic types payload to be written as an attachment
     std::unique_ptr<fastdds::rtps::SerializedPayload_t> dynamic_types_payload_;
 
@@ -218,9 +459,37 @@ protected:
     // The schemas that have been written
     std::map<mcap::SchemaId, mcap::Schema> schemas_;
 
+    // The memory held by schemas_ and channels_ (updated as they change, so it is never recomputed)
+    std::uint64_t schemas_size_{0};
+    std::uint64_t channels_size_{0};
+
+    // The schemas written in the current file (applies to lazy channels)
+    std::unordered_set<mcap::SchemaId> file_schemas_;
+
+    // The channels written in the current file (applies to lazy channels)
+    std::unordered_set<mcap::ChannelId> file_channels_;
+
+    // The statistics of the channels written in the current file
+    std::unordered_map<mcap::ChannelId, McapChannelStatistics> channels_statistics_;
+
     //! Lambda to call when the disk is full
     std::function<void()> on_disk_full_lambda_;
 
+    // Whether writing to the current file has failed (so it is only reported once)
+    bool output_failed_{false};
+
+    // Forecasts when the output will be full (nullptr if disabled)
+    std::unique_ptr<DiskFullForecaster> disk_full_forecaster_;
+
+    // Time from which the next forecast is due
+    std::chrono::steady_clock::time_point next_forecast_;
+
+    // Aggregate size of the files closed by this writer
+    std::uint64_t closed_files_size_{0};
+
+    // Whether the samples of the low priority topics are to be discarded
+    std::atomic<bool> dropping_low_priority_{false};
+
     // The size of an MCAP file only with metadata and an empty attachment
     static constexpr std::uint64_t MIN_MCAP_SIZE = 2056;
 };
@@ -0,0 +1,62 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MetricsExporterConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+//! Where the \c PrometheusExporter publishes the metrics
+enum class MetricsExporterKind
+{
+    http,                   //! Served over HTTP on a TCP port.
+    unix_socket,            //! Served over HTTP on a Unix domain socket.
+    file,                   //! Written periodically to a text file.
+};
+
+/**
+ * Structure encapsulating all of \c PrometheusExporter configuration options.
+ */
+struct MetricsExporterConfiguration
+{
+    //! Whether to export the metrics
+    bool enabled{false};
+
+    //! Where to export the metrics
+    MetricsExporterKind kind{MetricsExporterKind::http};
+
+    //! Address to bind the TCP port to (applies to http)
+    std::string address{"127.0.0.1"};
+
+    //! TCP port (applies to http)
+    std::uint16_t port{9464};
+
+    //! Path of the Unix domain socket or of the text file (applies to unix_socket and file)
+    std::string path{};
+
+    //! Period [ms] with which the text file is rewritten (applies to file)
+    std::uint32_t period{1000};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
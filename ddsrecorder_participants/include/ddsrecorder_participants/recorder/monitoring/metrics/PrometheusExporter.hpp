@@ -0,0 +1,130 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PrometheusExporter.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/MetricsExporterConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Exports the \c RecorderMetrics in the Prometheus text exposition format.
+ *
+ * Depending on its configuration, the metrics are served over HTTP on a local TCP port or on a Unix domain socket,
+ * or they are periodically written to a text file (atomically, through a temporary file and a rename).
+ *
+ * The exporter only reads snapshots of the \c RecorderMetrics atomics, so a scrape never takes any lock of the
+ * recording path.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI PrometheusExporter
+{
+public:
+
+    /**
+     * @brief Construct a \c PrometheusExporter .
+     *
+     * @param configuration Where and how to export the metrics.
+     */
+    PrometheusExporter(
+            const MetricsExporterConfiguration& configuration);
+
+    /**
+     * @brief Destroy the \c PrometheusExporter .
+     *
+     * Stops the exporter thread and releases the socket (or leaves the last version of the text file).
+     */
+    ~PrometheusExporter();
+
+    /**
+     * @brief Start exporting the metrics in a background thread.
+     *
+     * @throws \c InitializationException if the socket cannot be created, bound or listened on.
+     */
+    void start();
+
+    //! Stop exporting the metrics
+    void stop() noexcept;
+
+    /**
+     * @brief Serialize a snapshot of the metrics in the Prometheus text exposition format.
+     *
+     * @param snapshot Values to serialize.
+     * @return The text exposition of \c snapshot .
+     */
+    static std::string serialize(
+            const RecorderMetricsSnapshot& snapshot);
+
+protected:
+
+    //! Create, bind and listen on the TCP or Unix domain socket
+    void open_socket_();
+
+    //! Close the listening socket (and remove the Unix domain socket file)
+    void close_socket_() noexcept;
+
+    //! Accept connections and answer them until the exporter is stopped
+    void serve_routine_();
+
+    //! Read a request from \c connection and answer it with the current metrics
+    void serve_connection_(
+            int connection);
+
+    //! Rewrite the text file every \c period until the exporter is stopped
+    void file_routine_();
+
+    //! Atomically replace the text file with the current metrics
+    void write_file_() const;
+
+    //! The configuration of the exporter
+    const MetricsExporterConfiguration configuration_;
+
+    //! Whether the exporter thread must keep running
+    std::atomic<bool> running_{false};
+
+    //! Thread serving the socket or writing the file
+    std::thread thread_;
+
+    //! Listening socket (-1 if not open)
+    int listen_fd_{-1};
+
+    //! Wakes up the file routine when stopping
+    std::condition_variable cv_;
+
+    //! Protects \c cv_
+    std::mutex cv_mutex_;
+
+    //! Time [ms] to wait for new connections before checking whether the exporter has been stopped
+    static constexpr int POLL_TIMEOUT_MS = 200;
+
+    //! Max size of the request read from a connection
+    static constexpr std::size_t MAX_REQUEST_SIZE = 4096;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
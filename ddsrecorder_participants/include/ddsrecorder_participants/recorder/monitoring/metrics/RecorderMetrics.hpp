@@ -0,0 +1,331 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RecorderMetrics.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Copy of the values of an \c AtomicHistogram at a given point in time.
+ */
+struct HistogramSnapshot
+{
+    //! Upper bounds of the finite buckets (the +Inf bucket is implicit)
+    std::vector<double> bounds;
+
+    //! Cumulative number of observations per bucket (one more entry than \c bounds , the last one being +Inf)
+    std::vector<std::uint64_t> cumulative_counts;
+
+    //! Sum of all the observed values
+    double sum{0};
+
+    //! Number of observed values
+    std::uint64_t count{0};
+};
+
+/**
+ * @brief Histogram with fixed buckets that can be updated and read concurrently without locks.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI AtomicHistogram
+{
+public:
+
+    /**
+     * @brief Construct an \c AtomicHistogram .
+     *
+     * @param bounds Upper bounds of the finite buckets, in increasing order.
+     */
+    AtomicHistogram(
+            std::vector<double> bounds);
+
+    //! Add an observation to the histogram
+    void observe(
+            const double value) noexcept;
+
+    //! Set every bucket back to zero
+    void reset() noexcept;
+
+    //! Take a (non-atomic as a whole) copy of the histogram values
+    HistogramSnapshot snapshot() const;
+
+protected:
+
+    //! Upper bounds of the finite buckets
+    const std::vector<double> bounds_;
+
+    //! Non-cumulative count of each bucket (bounds_.size() + 1 entries)
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counts_;
+
+    //! Sum of all the observed values
+    std::atomic<double> sum_{0};
+
+    //! Number of observed values
+    std::atomic<std::uint64_t> count_{0};
+};
+
+//! Recorder subsystems whose memory usage is accounted for
+enum class MemorySubsystem
+{
+    payloads = 0,           //! Payloads of the samples kept in memory (buffered or pending).
+    samples_buffer,         //! Entries of the samples buffer (excluding their payloads).
+    pending_samples,        //! Entries of the pending samples queues (excluding their payloads).
+    schemas_and_channels,   //! Schemas and channels kept to be rewritten in every new file.
+    dynamic_types,          //! Serialized dynamic types to be written as an attachment.
+    mcap_chunks,            //! Chunk buffers of the MCAP library (estimated from the chunk size).
+    stream_frames,          //! Frames of the stream sink waiting to be sent or kept to be sent again.
+    keyframes,              //! Last samples of the transient-local instances, written again in every new file.
+    count,
+};
+
+//! Number of \c MemorySubsystem values
+constexpr std::size_t MEMORY_SUBSYSTEMS = static_cast<std::size_t>(MemorySubsystem::count);
+
+//! Name of a \c MemorySubsystem , as used in logs and exported metrics
+DDSRECORDER_PARTICIPANTS_DllAPI
+const char* to_string(
+        const MemorySubsystem subsystem) noexcept;
+
+//! Reasons to close an MCAP chunk
+enum class ChunkCloseReason
+{
+    size = 0,               //! The chunk reached its maximum size.
+    duration,               //! The messages of the chunk span the target duration.
+    rate_change,            //! The message rate departed from the rate of the previous chunk.
+    flush,                  //! The chunk was closed to write another record or to close the file.
+    count,
+};
+
+//! Number of \c ChunkCloseReason values
+constexpr std::size_t CHUNK_CLOSE_REASONS = static_cast<std::size_t>(ChunkCloseReason::count);
+
+//! Name of a \c ChunkCloseReason , as used in logs and exported metrics
+DDSRECORDER_PARTICIPANTS_DllAPI
+const char* to_string(
+        const ChunkCloseReason reason) noexcept;
+
+//! Actions taken before the output is full (see \c DiskFullForecaster )
+enum class DiskFullAction
+{
+    warning = 0,            //! Warn that the output will soon be full.
+    compression,            //! Write the next files with a stronger compression.
+    drop,                   //! Discard the samples of the low priority topics.
+    count,
+};
+
+//! Number of \c DiskFullAction values
+constexpr std::size_t DISK_FULL_ACTIONS = static_cast<std::size_t>(DiskFullAction::count);
+
+//! Name of a \c DiskFullAction , as used in logs and exported metrics
+DDSRECORDER_PARTICIPANTS_DllAPI
+const char* to_string(
+        const DiskFullAction action) noexcept;
+
+/**
+ * @brief Copy of the values of the \c RecorderMetrics at a given point in time.
+ */
+struct RecorderMetricsSnapshot
+{
+    std::uint64_t messages_received{0};
+    std::uint64_t messages_written{0};
+    std::uint64_t messages_dropped{0};
+    std::uint64_t bytes_written{0};
+    std::uint64_t files_opened{0};
+    std::uint64_t files_closed{0};
+    std::uint64_t file_creation_failures{0};
+    std::uint64_t disk_full_events{0};
+    std::uint64_t blobs_written{0};
+    std::uint64_t blob_bytes_written{0};
+    std::uint64_t blobs_deduplicated{0};
+    std::uint64_t deduplicated_bytes{0};
+    std::uint64_t files_migrated{0};
+    std::uint64_t migration_failures{0};
+    std::uint64_t buffered_samples{0};
+    std::uint64_t pending_samples{0};
+    std::uint64_t current_file_size{0};
+    std::uint64_t migration_backlog_files{0};
+    std::uint64_t migration_backlog_bytes{0};
+    double write_rate{0};
+    double time_to_full{std::numeric_limits<double>::infinity()};
+    std::array<std::uint64_t, DISK_FULL_ACTIONS> disk_full_actions{};
+    std::array<std::uint64_t, MEMORY_SUBSYSTEMS> memory_usage{};
+    std::array<std::uint64_t, CHUNK_CLOSE_REASONS> chunks_written{};
+    HistogramSnapshot message_size;
+    HistogramSnapshot buffer_dump_duration;
+    HistogramSnapshot chunk_size;
+    HistogramSnapshot chunk_duration;
+};
+
+/**
+ * @brief Process-wide counters, gauges and histograms of the recording path.
+ *
+ * Every value is kept in an atomic so the recording threads update it without taking any extra lock, and readers
+ * (e.g. the \c PrometheusExporter ) take snapshots without ever touching the locks of the \c McapHandler or the
+ * \c McapWriter .
+ *
+ * Counters are monotonic for the whole life of the process, so they survive the destruction and re-creation of the
+ * recorder entities between STOPPED and RUNNING.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI RecorderMetrics
+{
+public:
+
+    //! Get the process-wide instance
+    static RecorderMetrics& get_instance() noexcept;
+
+    //! A sample has been received by the handler
+    void message_received() noexcept;
+
+    //! \c samples samples have been discarded without being written
+    void message_dropped(
+            const std::uint64_t samples = 1) noexcept;
+
+    //! A sample of \c size bytes has been written in the MCAP file
+    void message_written(
+            const std::uint64_t size) noexcept;
+
+    //! The samples buffer has been dumped to disk in \c duration
+    void buffer_dumped(
+            const std::chrono::nanoseconds& duration) noexcept;
+
+    //! A chunk of \c size uncompressed bytes whose messages span \c duration has been written in the MCAP file
+    void chunk_written(
+            const ChunkCloseReason reason,
+            const std::uint64_t size,
+            const std::chrono::nanoseconds& duration) noexcept;
+
+    //! A payload has been written out of the chunks, taking \c size bytes in the MCAP file
+    void blob_written(
+            const std::uint64_t size) noexcept;
+
+    //! A payload of \c size bytes has been written as a reference to a blob already in the MCAP file
+    void blob_deduplicated(
+            const std::uint64_t size) noexcept;
+
+    //! A new MCAP file has been opened
+    void file_opened() noexcept;
+
+    //! The current MCAP file has been closed
+    void file_closed() noexcept;
+
+    //! The MCAP library failed to open a new file
+    void file_creation_failed() noexcept;
+
+    //! The disk (or the configured resource limits) is full
+    void disk_full() noexcept;
+
+    //! A closed file has been moved from the staging directory to the output directory
+    void file_migrated() noexcept;
+
+    //! A closed file could not be moved from the staging directory to the output directory
+    void migration_failed() noexcept;
+
+    //! Set the number of samples currently kept in the samples buffer
+    void set_buffered_samples(
+            const std::uint64_t samples) noexcept;
+
+    //! Set the number of samples currently waiting for their type
+    void set_pending_samples(
+            const std::uint64_t samples) noexcept;
+
+    //! Set the size of the MCAP file currently being written
+    void set_current_file_size(
+            const std::uint64_t size) noexcept;
+
+    //! Set the number and the size of the closed files waiting to be moved out of the staging directory
+    void set_migration_backlog(
+            const std::uint64_t files,
+            const std::uint64_t bytes) noexcept;
+
+    //! Set the smoothed write rate [bytes/s] and the forecasted time [s] until the output is full
+    void set_disk_full_forecast(
+            const double write_rate,
+            const double time_to_full) noexcept;
+
+    //! Set whether \c action is being taken
+    void set_disk_full_action(
+            const DiskFullAction action,
+            const bool active) noexcept;
+
+    //! Set the bytes held in memory by \c subsystem
+    void set_memory_usage(
+            const MemorySubsystem subsystem,
+            const std::uint64_t bytes) noexcept;
+
+    //! Get the bytes held in memory by every subsystem
+    std::uint64_t total_memory_usage() const noexcept;
+
+    //! Take a copy of the current values
+    RecorderMetricsSnapshot snapshot() const;
+
+    //! Set every value back to zero
+    void reset() noexcept;
+
+protected:
+
+    RecorderMetrics();
+
+    // Counters
+    std::atomic<std::uint64_t> messages_received_{0};
+    std::atomic<std::uint64_t> messages_written_{0};
+    std::atomic<std::uint64_t> messages_dropped_{0};
+    std::atomic<std::uint64_t> bytes_written_{0};
+    std::atomic<std::uint64_t> files_opened_{0};
+    std::atomic<std::uint64_t> files_closed_{0};
+    std::atomic<std::uint64_t> file_creation_failures_{0};
+    std::atomic<std::uint64_t> disk_full_events_{0};
+    std::atomic<std::uint64_t> blobs_written_{0};
+    std::atomic<std::uint64_t> blob_bytes_written_{0};
+    std::atomic<std::uint64_t> blobs_deduplicated_{0};
+    std::atomic<std::uint64_t> deduplicated_bytes_{0};
+    std::atomic<std::uint64_t> files_migrated_{0};
+    std::atomic<std::uint64_t> migration_failures_{0};
+    std::array<std::atomic<std::uint64_t>, CHUNK_CLOSE_REASONS> chunks_written_{};
+
+    // Gauges
+    std::atomic<std::uint64_t> buffered_samples_{0};
+    std::atomic<std::uint64_t> pending_samples_{0};
+    std::atomic<std::uint64_t> current_file_size_{0};
+    std::atomic<std::uint64_t> migration_backlog_files_{0};
+    std::atomic<std::uint64_t> migration_backlog_bytes_{0};
+    std::atomic<double> write_rate_{0};
+    std::atomic<double> time_to_full_{std::numeric_limits<double>::infinity()};
+    std::array<std::atomic<std::uint64_t>, DISK_FULL_ACTIONS> disk_full_actions_{};
+    std::array<std::atomic<std::uint64_t>, MEMORY_SUBSYSTEMS> memory_usage_{};
+
+    // Histograms
+    AtomicHistogram message_size_;
+    AtomicHistogram buffer_dump_duration_;
+    AtomicHistogram chunk_size_;
+    AtomicHistogram chunk_duration_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,69 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiskFullForecastConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <mcap/types.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Structure encapsulating the configuration of the \c DiskFullForecaster and of the actions taken before the output
+ * is full.
+ *
+ * Every threshold is a time to full [s] below which its action is taken (0 <-> disabled).
+ */
+struct DiskFullForecastConfiguration
+{
+    //! Whether to forecast when the output will be full
+    bool enabled{false};
+
+    //! Minimum time [ms] between two forecasts
+    std::uint64_t period{1000};
+
+    //! Time constant [s] of the exponential moving average of the write rate
+    std::uint64_t rate_window{30};
+
+    //! Time to full [s] below which a warning is raised
+    std::uint64_t warning_threshold{600};
+
+    //! Time to full [s] below which the next files are written with \c compression
+    std::uint64_t compression_threshold{0};
+
+    //! Compression algorithm of the files written once below \c compression_threshold
+    mcap::Compression compression{mcap::Compression::Zstd};
+
+    //! Compression level of the files written once below \c compression_threshold
+    mcap::CompressionLevel compression_level{mcap::CompressionLevel::Slowest};
+
+    //! Time to full [s] below which the samples of \c drop_topics are discarded
+    std::uint64_t drop_threshold{0};
+
+    //! Names (wildcards allowed) of the topics whose samples are discarded once below \c drop_threshold
+    std::vector<std::string> drop_topics;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
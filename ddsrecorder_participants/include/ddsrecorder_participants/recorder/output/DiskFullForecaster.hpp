@@ -0,0 +1,133 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiskFullForecaster.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+#include <ddsrecorder_participants/recorder/output/DiskFullForecastConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Forecasts when the output will be full from the rate at which it grows, and decides which \c DiskFullAction to take.
+ *
+ * The write rate is an exponential moving average (with time constant \c rate_window ) of the bytes written between
+ * two updates, and the time to full is the remaining budget divided by it.
+ *
+ * An action is activated when the time to full drops below its threshold, and deactivated once it goes back above
+ * \c HYSTERESIS times its threshold, so a forecast hovering around a threshold does not toggle its action.
+ *
+ * This class is not thread-safe.
+ */
+class DiskFullForecaster
+{
+public:
+
+    //! Factor of its threshold above which the time to full deactivates an action
+    static constexpr double HYSTERESIS = 1.5;
+
+    //! Bytes left of an output that cannot be full
+    static constexpr std::uint64_t NEVER_FULL = std::numeric_limits<std::uint64_t>::max();
+
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    DiskFullForecaster(
+            const DiskFullForecastConfiguration& configuration);
+
+    /**
+     * @brief Bytes that can still be written before the output is full.
+     *
+     * When rotating files, the output stops growing once it reaches \c max_size (the oldest files are removed), so
+     * it can only be full if the disk has less space \c available than the output has left to grow.
+     *
+     * @param used Bytes used by the output files.
+     * @param max_size Max bytes of the output files.
+     * @param available Bytes available in the disk.
+     * @param file_rotation Whether the oldest files are removed to keep the output below \c max_size .
+     * @return Bytes left, or \c NEVER_FULL if the output cannot be full.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static std::uint64_t remaining(
+            const std::uint64_t used,
+            const std::uint64_t max_size,
+            const std::uint64_t available,
+            const bool file_rotation) noexcept;
+
+    /**
+     * @brief Update the forecast.
+     *
+     * @param now Time of the update.
+     * @param written Bytes written since the recording started (monotonic).
+     * @param remaining Bytes that can still be written before the output is full (\c NEVER_FULL <-> no forecast).
+     * @return Whether any action has been activated or deactivated.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool update(
+            const std::chrono::steady_clock::time_point& now,
+            const std::uint64_t written,
+            const std::uint64_t remaining) noexcept;
+
+    //! Smoothed write rate [bytes/s]
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    double write_rate() const noexcept;
+
+    //! Forecasted time [s] until the output is full (infinity if it does not grow)
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    double time_to_full() const noexcept;
+
+    //! Whether \c action is to be taken
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool active(
+            const DiskFullAction action) const noexcept;
+
+protected:
+
+    //! Threshold [s] of \c action (0 <-> disabled)
+    std::uint64_t threshold_(
+            const DiskFullAction action) const noexcept;
+
+    // Configuration of the forecast and of the thresholds
+    const DiskFullForecastConfiguration configuration_;
+
+    // Whether the forecaster has been updated at least once
+    bool initialized_{false};
+
+    // Time and bytes written of the last update
+    std::chrono::steady_clock::time_point last_update_;
+    std::uint64_t last_written_{0};
+
+    // Smoothed write rate [bytes/s]
+    double write_rate_{0};
+
+    // Forecasted time [s] until the output is full
+    double time_to_full_;
+
+    // Whether each action is active
+    std::array<bool, DISK_FULL_ACTIONS> active_{};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
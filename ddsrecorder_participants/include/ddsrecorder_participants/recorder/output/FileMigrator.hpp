@@ -0,0 +1,155 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FileMigrator.hpp
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Moves the closed files from the staging directory to their final location in a background thread.
+ *
+ * The files are moved in the order they are handed over. When both directories are in the same filesystem a file is
+ * just renamed. Otherwise it is copied next to its destination with a temporary name, synced to disk, renamed and
+ * only then removed from the staging directory, so the output directory never holds a partially copied file.
+ *
+ * A file that cannot be moved is left in the staging directory, and its size keeps counting as staged.
+ */
+class FileMigrator
+{
+public:
+
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    FileMigrator();
+
+    /**
+     * @brief Destroy the \c FileMigrator .
+     *
+     * Waits for every file handed over to be moved before stopping the background thread.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    ~FileMigrator();
+
+    /**
+     * @brief Hand over a closed file to be moved.
+     *
+     * @param source Path of the file in the staging directory.
+     * @param destination Final path of the file.
+     * @param size Size of the file.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void migrate(
+            const std::string& source,
+            const std::string& destination,
+            const std::uint64_t size);
+
+    /**
+     * @brief Discard a file handed over and not moved yet.
+     *
+     * If the file is being moved, it is removed once moved.
+     *
+     * @param destination Final path of the file.
+     * @return Whether the file had not been moved yet.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool discard(
+            const std::string& destination) noexcept;
+
+    //! Size of the files in the staging directory (waiting to be moved or that could not be moved)
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint64_t staged_size() const noexcept;
+
+protected:
+
+    //! A file waiting to be moved
+    struct Migration
+    {
+        std::string source;
+        std::string destination;
+        std::uint64_t size;
+    };
+
+    //! Move the files handed over until stopped and there are no more
+    void run_() noexcept;
+
+    /**
+     * @brief Move a file to its final location.
+     *
+     * @throws \c std::filesystem::filesystem_error or \c std::runtime_error if the file cannot be moved.
+     */
+    static void move_(
+            const std::string& source,
+            const std::string& destination);
+
+    /**
+     * @brief Copy a file to a different filesystem and sync it to disk.
+     *
+     * @throws \c std::runtime_error if the file cannot be copied.
+     */
+    static void copy_and_sync_(
+            const std::string& source,
+            const std::string& destination);
+
+    //! Sync to disk a file or directory (no-op where not supported)
+    static void sync_(
+            const std::string& path);
+
+    //! Update the migration backlog metrics
+    void update_metrics_nts_() const noexcept;
+
+    //! Protects every member below
+    mutable std::mutex mutex_;
+
+    //! Notified when a file is handed over or when stopping
+    std::condition_variable cv_;
+
+    //! Files waiting to be moved, in the order they were handed over
+    std::deque<Migration> pending_;
+
+    //! Destination of the file being moved (empty if none)
+    std::string current_;
+
+    //! Whether the file being moved has been discarded
+    bool current_discarded_{false};
+
+    //! Size of the files waiting to be moved, including the one being moved
+    std::uint64_t backlog_size_{0};
+
+    //! Size of the files that could not be moved and remain in the staging directory
+    std::uint64_t stranded_size_{0};
+
+    //! Whether to stop once there are no more files to move
+    bool stop_{false};
+
+    //! Thread moving the files
+    std::thread thread_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -18,14 +18,18 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
 #include <cpp_utils/utils.hpp>
 
 #include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/output/FileMigrator.hpp>
 #include <ddsrecorder_participants/recorder/output/IFileTracker.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 
@@ -45,11 +49,23 @@ struct File
     std::uint64_t id;
     std::string name;
     std::uint64_t size;
+
+    //! Contents of the file (only kept with the memory sink)
+    std::shared_ptr<const std::vector<std::byte>> contents;
+
+    //! Dynamic types sidecar referenced by the file (empty if none)
+    std::string sidecar;
 };
 
 
 /**
  * Class to keep track of files and their sizes.
+ *
+ * With the memory and null sinks, the files are never written to disk: the tracker keeps the contents of the closed
+ * files (memory sink) or only their size (null sink) instead, and applies the same resource limits and rotation.
+ *
+ * With a staging directory, the files are written there and handed over to a \c FileMigrator once closed, unless the
+ * staging directory could not fit another file, in which case the new file is written straight to the output path.
  */
 class FileTracker : IFileTracker
 {
@@ -97,6 +113,8 @@ public:
     /**
      * @brief Calculates the temporary filename of the current file.
      *
+     * It is in the staging directory if the current file is being staged.
+     *
      * @return The temporary filename of the current file.
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
@@ -111,6 +129,38 @@ public:
     void set_current_file_size(
             const std::uint64_t size) noexcept;
 
+    /**
+     * @brief Sets the contents of the current file, to be kept once it is closed.
+     *
+     * Only applies to the memory sink.
+     *
+     * @param contents The bytes of the current file.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void set_current_file_contents(
+            std::vector<std::byte>&& contents) noexcept;
+
+    /**
+     * @brief Sets the dynamic types sidecar referenced by the current file.
+     *
+     * The sidecars created by this tracker's recording are removed along with the last file referencing them.
+     *
+     * @param sidecar The path of the sidecar.
+     * @param created Whether the sidecar was created for the current file (instead of existing beforehand).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void set_current_file_sidecar(
+            const std::string& sidecar,
+            const bool created) noexcept;
+
+    /**
+     * @brief Gets the files closed and not removed yet, from the oldest to the newest.
+     *
+     * @return A copy of the closed files (which share their contents with the tracker).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::vector<File> get_closed_files();
+
 protected:
 
     /**
@@ -120,6 +170,14 @@ protected:
      */
     std::uint64_t remove_oldest_file_nts_() noexcept;
 
+    /**
+     * @brief Removes \c sidecar if it was created by this tracker's recording and no file references it anymore.
+     *
+     * @param sidecar The path of the sidecar (nothing is done if empty).
+     */
+    void remove_unreferenced_sidecar_nts_(
+            const std::string& sidecar) noexcept;
+
     /**
      * @brief Generates a filename for the current file id.
      *
@@ -151,6 +209,18 @@ protected:
 
     // The total size of all files in the tracker
     std::uint64_t size_{0};
+
+    // Maximum aggregate size of the files in the staging directory
+    std::uint64_t staging_max_size_{0};
+
+    // Path of the current file in the staging directory (empty if it is not being staged)
+    std::string current_staged_name_;
+
+    // The dynamic types sidecars created by this tracker's recording and not removed yet
+    std::set<std::string> created_sidecars_;
+
+    // Moves the closed files out of the staging directory (only with a staging directory)
+    std::unique_ptr<FileMigrator> migrator_;
 };
 
 } /* namespace participants */
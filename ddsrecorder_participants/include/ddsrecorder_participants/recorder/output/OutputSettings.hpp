@@ -19,13 +19,37 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <string>
 
+#include <ddsrecorder_participants/recorder/mcap/McapStreamConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/DiskFullForecastConfiguration.hpp>
 
 namespace eprosima {
 namespace ddsrecorder {
 namespace participants {
 
+//! Where the output files are written
+enum class OutputSinkKind
+{
+    file,                   //! Files on disk.
+    memory,                 //! Files kept in memory by the \c FileTracker (bounded by the resource limits).
+    null,                   //! Files discarded as they are written (only their size is tracked).
+    stream,                 //! Files streamed to a collector as they are written (see \c McapStreamWriter ).
+};
+
+//! Size limit standing for no limit (it must fit in a signed integer, since the \c FileTracker subtracts sizes)
+constexpr std::uint64_t UNLIMITED_OUTPUT_SIZE = std::numeric_limits<std::int64_t>::max();
+
+//! Max aggregate size of the files kept by the memory sink of the recorder, unless set by its resource limits
+constexpr std::uint64_t MEMORY_SINK_DEFAULT_MAX_SIZE = 1024ull * 1024 * 1024;
+
+//! Max size of each file streamed by the stream sink of the recorder, unless set by its resource limits
+constexpr std::uint64_t STREAM_SINK_DEFAULT_MAX_FILE_SIZE = 256ull * 1024 * 1024;
+
+//! Memory budget of the recorder with the stream sink, unless set, so a congested stream does not exhaust the memory
+constexpr std::uint64_t STREAM_SINK_DEFAULT_MEMORY_BUDGET = 256ull * 1024 * 1024;
+
 /**
  * Structure encapsulating all output configuration options.
  */
@@ -40,6 +64,12 @@ struct OutputSettings
     //! Extension of the output file
     std::string extension;
 
+    //! Where to write the output files
+    OutputSinkKind sink{OutputSinkKind::file};
+
+    //! Where and how to stream the output files (applies to the stream sink)
+    McapStreamConfiguration stream{};
+
     ///////////////
     // TIMESTAMP //
     ///////////////
@@ -68,6 +98,20 @@ struct OutputSettings
 
     //! Whether to rotate output files after reaching the max-size
     bool file_rotation{false};
+
+    //! When to act before the output is full (applies to the file sink)
+    DiskFullForecastConfiguration disk_full_forecast{};
+
+    /////////////
+    // STAGING //
+    /////////////
+
+    //! Directory where the files are written before being moved to \c filepath once closed (empty to disable)
+    std::string staging_path;
+
+    //! Maximum aggregate size of the files in the staging directory (being written or waiting to be moved), or 0 for
+    //! the space available in the staging directory when the \c FileTracker is created
+    std::uint64_t staging_max_size{0};
 };
 
 } /* namespace participants */
@@ -18,6 +18,7 @@
 #include <cpp_utils/types/Fuzzy.hpp>
 
 #include <ddspipe_core/configuration/IConfiguration.hpp>
+#include <ddspipe_core/types/dds/DomainId.hpp>
 #include <ddspipe_participants/configuration/ParticipantConfiguration.hpp>
 
 namespace eprosima {
@@ -33,6 +34,9 @@ struct McapReaderParticipantConfiguration : ddspipe::participants::ParticipantCo
     utils::Fuzzy<utils::Timestamp> end_time{};
     float rate{1};
     utils::Fuzzy<utils::Timestamp> start_replay_time{};
+
+    //! Only replay the channels recorded in this domain (and the ones recorded without domain)
+    utils::Fuzzy<ddspipe::core::types::DomainId> recorded_domain{};
 };
 
 } /* namespace participants */
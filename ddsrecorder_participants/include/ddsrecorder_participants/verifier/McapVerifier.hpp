@@ -0,0 +1,148 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapVerifier.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/verifier/McapVerifierConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Result of verifying the messages of a topic in an MCAP file.
+ */
+struct TopicVerification
+{
+    //! Name of the schema of the channel
+    std::string type_name;
+
+    //! Messages found in the chunks
+    std::uint64_t messages{0};
+
+    //! Bytes of the messages found in the chunks
+    std::uint64_t bytes{0};
+
+    //! Messages missing from (or misplaced in) the message indexes
+    std::uint64_t index_errors{0};
+
+    //! Messages deserialized with the recorded type
+    std::uint64_t sampled{0};
+
+    //! Sampled messages that could not be deserialized
+    std::uint64_t decode_errors{0};
+
+    //! Whether the recorded type of the topic could not be built (so no message has been sampled)
+    bool missing_type{false};
+
+    //! Whether no error has been found in the topic
+    bool ok() const noexcept
+    {
+        return index_errors == 0 && decode_errors == 0;
+    }
+};
+
+/**
+ * @brief Result of verifying an MCAP file.
+ */
+struct FileVerification
+{
+    //! Path of the file
+    std::string path;
+
+    //! Chunks referenced by the summary
+    std::uint64_t chunks{0};
+
+    //! Chunks written without a CRC (which could not be checked)
+    std::uint64_t chunks_without_crc{0};
+
+    //! Chunks whose uncompressed records do not match their CRC
+    std::uint64_t crc_errors{0};
+
+    //! Chunks that could not be read, decompressed or parsed, or that do not match their chunk index
+    std::uint64_t chunk_errors{0};
+
+    //! Message indexes, or statistics, that do not match the records of the chunks
+    std::uint64_t index_errors{0};
+
+    //! Messages found in the chunks
+    std::uint64_t messages{0};
+
+    //! Result per topic
+    std::map<std::string, TopicVerification> topics;
+
+    //! Description of every error found, to be reported
+    std::vector<std::string> errors;
+
+    //! Whether no error has been found in the file
+    bool ok() const noexcept
+    {
+        return errors.empty();
+    }
+};
+
+/**
+ * Verifies the integrity of MCAP files written by the DDS Recorder.
+ *
+ * The chunks referenced by the summary of every file are read, decompressed and checked in parallel, across chunks
+ * and files:
+ * - the CRC of their uncompressed records.
+ * - their messages against their chunk index and their message indexes.
+ * Once every chunk of a file is checked, the message counts are checked against the statistics of the file.
+ *
+ * Optionally, a sample of the messages of every channel is deserialized with the types recorded in the file.
+ */
+class DDSRECORDER_PARTICIPANTS_DllAPI McapVerifier
+{
+public:
+
+    /**
+     * @brief Construct a \c McapVerifier .
+     *
+     * @param configuration What to verify and with how many threads.
+     */
+    McapVerifier(
+            const McapVerifierConfiguration& configuration);
+
+    /**
+     * @brief Verify the MCAP files in \c paths .
+     *
+     * Errors are reported in the returned results, never thrown.
+     *
+     * @param paths Files to verify.
+     * @return The result of each file, in the same order as \c paths .
+     */
+    std::vector<FileVerification> verify(
+            const std::vector<std::string>& paths) const;
+
+protected:
+
+    //! The configuration of the verifier
+    const McapVerifierConfiguration configuration_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,48 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapVerifierConfiguration.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Structure encapsulating all of \c McapVerifier configuration options.
+ */
+struct McapVerifierConfiguration
+{
+    //! Number of threads verifying files and chunks in parallel (0 to use one per hardware thread)
+    std::uint32_t n_threads{0};
+
+    //! Whether to check the CRC of the uncompressed records of every chunk
+    bool check_crcs{true};
+
+    //! Whether to check the message indexes and the statistics against the records of every chunk
+    bool check_indexes{true};
+
+    //! Max number of messages per channel and file to deserialize with the recorded types (0 to not deserialize)
+    std::uint32_t sampled_messages{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
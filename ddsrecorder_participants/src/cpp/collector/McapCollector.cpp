@@ -0,0 +1,551 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapCollector.cpp
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // ifndef _WIN32
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/collector/McapCollector.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+McapCollector::McapCollector(
+        const McapCollectorConfiguration& configuration,
+        std::function<void()> on_input_closed /* = nullptr */)
+    : configuration_(configuration)
+    , on_input_closed_(on_input_closed)
+{
+}
+
+McapCollector::~McapCollector()
+{
+    stop();
+}
+
+void McapCollector::start()
+{
+    if (running_)
+    {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(configuration_.output_directory, error);
+
+    if (error)
+    {
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to create the output directory " << configuration_.output_directory << ": " <<
+                      error.message());
+    }
+
+    if (configuration_.kind != McapStreamKind::pipe)
+    {
+        open_socket_();
+    }
+
+    running_ = true;
+    thread_ = std::thread(&McapCollector::serve_routine_, this);
+}
+
+void McapCollector::stop() noexcept
+{
+    running_ = false;
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+
+    close_socket_();
+
+    for (auto& it : files_)
+    {
+        abandon_file_(it.second, "the collector has been stopped");
+    }
+
+    files_.clear();
+}
+
+std::vector<std::string> McapCollector::collected_files() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<std::string> files;
+
+    for (const auto& file : collected_)
+    {
+        files.push_back(file.first);
+    }
+
+    return files;
+}
+
+void McapCollector::receive_(
+        int fd)
+{
+    McapStreamFrame::Header header;
+    std::vector<std::byte> payload;
+
+    while (read_(fd, header.data(), header.size()))
+    {
+        McapStreamFrame::Kind kind;
+        std::uint64_t file_id;
+        std::uint64_t offset;
+        std::uint64_t length;
+
+        if (!McapStreamFrame::parse_header(header.data(), kind, file_id, offset, length))
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_COLLECTOR,
+                    "MCAP_COLLECTOR | Corrupted frame received, dropping the connection.");
+            return;
+        }
+
+        payload.resize(length);
+
+        if (!read_(fd, payload.data(), payload.size()))
+        {
+            return;
+        }
+
+        switch (kind)
+        {
+            case McapStreamFrame::Kind::open:
+                open_file_(file_id, std::string(reinterpret_cast<const char*>(payload.data()), payload.size()));
+                break;
+
+            case McapStreamFrame::Kind::data:
+                write_file_(file_id, offset, payload);
+                break;
+
+            case McapStreamFrame::Kind::close:
+                close_file_(file_id, offset);
+                break;
+        }
+    }
+}
+
+void McapCollector::open_file_(
+        const std::uint64_t file_id,
+        const std::string& name)
+{
+    // Never write out of the output directory
+    auto file_name = std::filesystem::path(name).filename().string();
+
+    if (file_name.empty() || file_name == "." || file_name == "..")
+    {
+        file_name = "file_" + std::to_string(file_id) + ".mcap";
+    }
+
+    auto it = files_.find(file_id);
+
+    if (it != files_.end())
+    {
+        if (it->second.name == file_name)
+        {
+            EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_COLLECTOR,
+                    "MCAP_COLLECTOR | Resuming file " << file_name << " at " << utils::from_bytes(it->second.size) <<
+                    ".");
+            return;
+        }
+
+        abandon_file_(it->second, "a new stream has started");
+        files_.erase(it);
+    }
+
+    File file;
+    file.name = file_name;
+    file.stream.open(tmp_path_(file_name), std::ios::binary | std::ios::out | std::ios::trunc);
+
+    if (!file.stream.is_open())
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Failed to open " << tmp_path_(file_name) << " for writing.");
+        file.broken = true;
+    }
+    else
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Collecting file " << file_name << ".");
+    }
+
+    files_.emplace(file_id, std::move(file));
+}
+
+void McapCollector::write_file_(
+        const std::uint64_t file_id,
+        const std::uint64_t offset,
+        const std::vector<std::byte>& payload)
+{
+    auto it = files_.find(file_id);
+
+    if (it == files_.end() || it->second.broken)
+    {
+        // The file started before the collector, or it has been abandoned
+        return;
+    }
+
+    auto& file = it->second;
+
+    if (offset > file.size)
+    {
+        abandon_file_(file, "missed " + utils::from_bytes(offset - file.size) + " of the stream");
+        return;
+    }
+
+    // NOTE: the bytes sent again after a reconnection are the same bytes already written at that offset
+    file.stream.seekp(static_cast<std::streamoff>(offset));
+    file.stream.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+    if (!file.stream.good())
+    {
+        abandon_file_(file, "failed to write to disk");
+        return;
+    }
+
+    file.size = std::max(file.size, offset + payload.size());
+}
+
+void McapCollector::close_file_(
+        const std::uint64_t file_id,
+        const std::uint64_t size)
+{
+    auto it = files_.find(file_id);
+
+    if (it == files_.end())
+    {
+        return;
+    }
+
+    auto& file = it->second;
+
+    if (!file.broken && file.size != size)
+    {
+        abandon_file_(file, "received " + utils::from_bytes(file.size) + " out of " + utils::from_bytes(size));
+    }
+
+    if (file.broken)
+    {
+        files_.erase(it);
+        return;
+    }
+
+    file.stream.close();
+
+    std::error_code error;
+    std::filesystem::rename(tmp_path_(file.name), path_(file.name), error);
+
+    if (error)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Error renaming " << tmp_path_(file.name) << ": " << error.message());
+    }
+    else
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Collected file " << file.name << " (" << utils::from_bytes(size) << ").");
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        collected_.emplace_back(path_(file.name), size);
+        collected_size_ += size;
+        rotate_nts_();
+    }
+
+    files_.erase(it);
+}
+
+void McapCollector::abandon_file_(
+        File& file,
+        const std::string& reason)
+{
+    if (file.broken)
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_COLLECTOR,
+            "MCAP_COLLECTOR | Abandoning file " << file.name << " (" << reason << "), leaving it as " <<
+            tmp_path_(file.name) << ".");
+
+    file.stream.close();
+    file.broken = true;
+}
+
+void McapCollector::rotate_nts_()
+{
+    if (configuration_.max_size == 0)
+    {
+        return;
+    }
+
+    // Always keep the last file collected
+    while (collected_size_ > configuration_.max_size && collected_.size() > 1)
+    {
+        const auto& oldest = collected_.front();
+
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Removing file " << oldest.first << " to keep the collected files under " <<
+                utils::from_bytes(configuration_.max_size) << ".");
+
+        std::error_code error;
+        std::filesystem::remove(oldest.first, error);
+
+        collected_size_ -= oldest.second;
+        collected_.pop_front();
+    }
+}
+
+std::string McapCollector::path_(
+        const std::string& name) const
+{
+    return (std::filesystem::path(configuration_.output_directory) / name).string();
+}
+
+std::string McapCollector::tmp_path_(
+        const std::string& name) const
+{
+    static const std::string TMP_SUFFIX = ".tmp~";
+    return path_(name) + TMP_SUFFIX;
+}
+
+#ifndef _WIN32
+
+void McapCollector::open_socket_()
+{
+    if (configuration_.kind == McapStreamKind::tcp)
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(configuration_.port);
+
+        if (inet_pton(AF_INET, configuration_.address.c_str(), &address.sin_addr) != 1)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Invalid collector address " << configuration_.address << ".");
+        }
+
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (listen_fd_ < 0)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to create collector socket: " << std::strerror(errno));
+        }
+
+        const int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            const std::string error = std::strerror(errno);
+            close_socket_();
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to bind collector socket to " << configuration_.address << ":" <<
+                          configuration_.port << ": " << error);
+        }
+    }
+    else
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (configuration_.path.empty() || configuration_.path.size() >= sizeof(address.sun_path))
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Invalid collector socket path " << configuration_.path << ".");
+        }
+
+        std::strncpy(address.sun_path, configuration_.path.c_str(), sizeof(address.sun_path) - 1);
+
+        // Remove a stale socket left by a previous execution
+        unlink(configuration_.path.c_str());
+
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (listen_fd_ < 0)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to create collector socket: " << std::strerror(errno));
+        }
+
+        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            const std::string error = std::strerror(errno);
+            close_socket_();
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to bind collector socket to " << configuration_.path << ": " << error);
+        }
+    }
+
+    if (listen(listen_fd_, 1) != 0)
+    {
+        const std::string error = std::strerror(errno);
+        close_socket_();
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to listen on collector socket: " << error);
+    }
+}
+
+void McapCollector::close_socket_() noexcept
+{
+    if (listen_fd_ < 0)
+    {
+        return;
+    }
+
+    close(listen_fd_);
+    listen_fd_ = -1;
+
+    if (configuration_.kind == McapStreamKind::unix_socket)
+    {
+        unlink(configuration_.path.c_str());
+    }
+}
+
+void McapCollector::serve_routine_()
+{
+    if (configuration_.kind == McapStreamKind::pipe)
+    {
+        receive_(STDIN_FILENO);
+
+        if (running_ && on_input_closed_ != nullptr)
+        {
+            on_input_closed_();
+        }
+
+        return;
+    }
+
+    while (running_)
+    {
+        pollfd listen_poll{listen_fd_, POLLIN, 0};
+
+        if (poll(&listen_poll, 1, POLL_TIMEOUT_MS) <= 0 || !(listen_poll.revents & POLLIN))
+        {
+            continue;
+        }
+
+        const int connection = accept(listen_fd_, nullptr, nullptr);
+
+        if (connection < 0)
+        {
+            continue;
+        }
+
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Recorder connected.");
+
+        receive_(connection);
+        close(connection);
+
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_COLLECTOR,
+                "MCAP_COLLECTOR | Recorder disconnected.");
+    }
+}
+
+bool McapCollector::read_(
+        int fd,
+        std::byte* data,
+        std::size_t size) const
+{
+    while (size > 0)
+    {
+        if (!running_)
+        {
+            return false;
+        }
+
+        pollfd fd_poll{fd, POLLIN, 0};
+        const auto result = poll(&fd_poll, 1, POLL_TIMEOUT_MS);
+
+        if (result == 0 || (result < 0 && errno == EINTR))
+        {
+            continue;
+        }
+
+        if (result < 0)
+        {
+            return false;
+        }
+
+        const auto received = read(fd, data, size);
+
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (received <= 0)
+        {
+            return false;
+        }
+
+        data += received;
+        size -= static_cast<std::size_t>(received);
+    }
+
+    return true;
+}
+
+#else
+
+void McapCollector::open_socket_()
+{
+    throw utils::InitializationException(
+              STR_ENTRY << "Collecting a stream on a socket is not supported on this platform.");
+}
+
+void McapCollector::close_socket_() noexcept
+{
+}
+
+void McapCollector::serve_routine_()
+{
+}
+
+bool McapCollector::read_(
+        int,
+        std::byte*,
+        std::size_t) const
+{
+    return false;
+}
+
+#endif // ifndef _WIN32
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
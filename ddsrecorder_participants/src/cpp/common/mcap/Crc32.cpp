@@ -0,0 +1,251 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file Crc32.cpp
+ */
+
+#include <mcap/crc32.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DDSRECORDER_CRC32_PCLMUL
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define DDSRECORDER_CRC32_ARMV8
+#include <arm_acle.h>
+#include <cstring>
+#endif // if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <ddsrecorder_participants/common/mcap/Crc32.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+using UpdateFunction = std::uint32_t (*)(
+    std::uint32_t,
+    const std::byte*,
+    std::size_t);
+
+std::uint32_t update_table(
+        const std::uint32_t crc,
+        const std::byte* data,
+        const std::size_t size)
+{
+    return mcap::internal::crc32Update(crc, data, size);
+}
+
+#if defined(DDSRECORDER_CRC32_PCLMUL)
+
+#define DDSRECORDER_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+
+//! Fold the 128 bits of \c x over \c next with the pair of constants \c k
+DDSRECORDER_CRC32_PCLMUL_TARGET
+inline __m128i fold(
+        const __m128i x,
+        const __m128i k,
+        const __m128i next)
+{
+    const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+    const __m128i high = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+DDSRECORDER_CRC32_PCLMUL_TARGET
+inline __m128i load(
+        const std::byte* data)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/**
+ * Fold 64 bytes per iteration with carry-less multiplications and reduce the result with a Barrett reduction, as
+ * described in "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Gopal et al., Intel, 2009).
+ *
+ * \c size must be at least 64 and a multiple of 16.
+ */
+DDSRECORDER_CRC32_PCLMUL_TARGET
+std::uint32_t update_pclmul_blocks(
+        const std::uint32_t crc,
+        const std::byte* data,
+        std::size_t size)
+{
+    // Constants of the bit-reflected domain for the polynomial 0x104c11db7 (k1 to k5, P(x)' and u')
+    alignas(16) static const std::uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const std::uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const std::uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const std::uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x1 = load(data + 0x00);
+    __m128i x2 = load(data + 0x10);
+    __m128i x3 = load(data + 0x20);
+    __m128i x4 = load(data + 0x30);
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+
+    data += 64;
+    size -= 64;
+
+    // Fold four 128-bit lanes in parallel
+    while (size >= 64)
+    {
+        x1 = fold(x1, x0, load(data + 0x00));
+        x2 = fold(x2, x0, load(data + 0x10));
+        x3 = fold(x3, x0, load(data + 0x20));
+        x4 = fold(x4, x0, load(data + 0x30));
+
+        data += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+    x1 = fold(x1, x0, x2);
+    x1 = fold(x1, x0, x3);
+    x1 = fold(x1, x0, x4);
+
+    // Fold the remaining 16-byte blocks
+    while (size >= 16)
+    {
+        x1 = fold(x1, x0, load(data));
+
+        data += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits into 64 bits
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+std::uint32_t update_pclmul(
+        const std::uint32_t crc,
+        const std::byte* data,
+        const std::size_t size)
+{
+    // Below this size the setup of the folding costs more than the table lookups
+    constexpr std::size_t MIN_SIZE = 64;
+
+    if (size < MIN_SIZE)
+    {
+        return update_table(crc, data, size);
+    }
+
+    const std::size_t blocks_size = size & ~static_cast<std::size_t>(15);
+    const std::uint32_t blocks_crc = update_pclmul_blocks(crc, data, blocks_size);
+
+    return update_table(blocks_crc, data + blocks_size, size - blocks_size);
+}
+
+#elif defined(DDSRECORDER_CRC32_ARMV8)
+
+std::uint32_t update_armv8(
+        std::uint32_t crc,
+        const std::byte* data,
+        std::size_t size)
+{
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = __crc32d(crc, word);
+    }
+
+    for (; size > 0; data++, size--)
+    {
+        crc = __crc32b(crc, static_cast<std::uint8_t>(*data));
+    }
+
+    return crc;
+}
+
+#endif // if defined(DDSRECORDER_CRC32_PCLMUL)
+
+struct Implementation
+{
+    UpdateFunction update;
+    const char* name;
+};
+
+Implementation select_implementation() noexcept
+{
+#if defined(DDSRECORDER_CRC32_PCLMUL)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    {
+        return {update_pclmul, "pclmul"};
+    }
+#elif defined(DDSRECORDER_CRC32_ARMV8)
+    return {update_armv8, "armv8-crc"};
+#endif // if defined(DDSRECORDER_CRC32_PCLMUL)
+
+    return {update_table, "table"};
+}
+
+const Implementation& implementation_() noexcept
+{
+    static const Implementation implementation = select_implementation();
+    return implementation;
+}
+
+} /* namespace */
+
+std::uint32_t Crc32::update(
+        const std::uint32_t crc,
+        const void* data,
+        const std::size_t size) noexcept
+{
+    return implementation_().update(crc, static_cast<const std::byte*>(data), size);
+}
+
+std::uint32_t Crc32::update_portable(
+        const std::uint32_t crc,
+        const void* data,
+        const std::size_t size) noexcept
+{
+    return update_table(crc, static_cast<const std::byte*>(data), size);
+}
+
+const char* Crc32::implementation() noexcept
+{
+    return implementation_().name;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
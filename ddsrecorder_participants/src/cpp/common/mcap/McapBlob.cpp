@@ -0,0 +1,292 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapBlob.cpp
+ */
+
+#include <cstring>
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/Formatter.hpp>
+
+#include <ddsrecorder_participants/common/mcap/Crc32.hpp>
+#include <ddsrecorder_participants/common/mcap/McapBlob.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Magic starting every reference to a blob
+constexpr std::array<std::uint8_t, 8> REFERENCE_MAGIC = {0x89, 'D', 'D', 'S', 'B', 'L', 'O', 'B'};
+
+constexpr const char* MEDIA_TYPE_NONE = "application/octet-stream";
+constexpr const char* MEDIA_TYPE_LZ4 = "application/x-lz4";
+constexpr const char* MEDIA_TYPE_ZSTD = "application/zstd";
+
+void write_uint64(
+        std::byte* data,
+        const std::uint64_t value) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        data[i] = static_cast<std::byte>((value >> (8 * i)) & 0xff);
+    }
+}
+
+std::uint64_t read_uint64(
+        const std::byte* data) noexcept
+{
+    std::uint64_t value = 0;
+
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+// Primes of the 64-bit xxHash
+constexpr std::uint64_t PRIME_1 = 0x9e3779b185ebca87ULL;
+constexpr std::uint64_t PRIME_2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr std::uint64_t PRIME_3 = 0x165667b19e3779f9ULL;
+constexpr std::uint64_t PRIME_4 = 0x85ebca77c2b2ae63ULL;
+constexpr std::uint64_t PRIME_5 = 0x27d4eb2f165667c5ULL;
+
+std::uint64_t rotate_left(
+        const std::uint64_t value,
+        const int bits) noexcept
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// NOTE: The digests are never written to the files, so the words are read in the byte order of the host
+std::uint64_t load_uint64(
+        const std::byte* data) noexcept
+{
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::uint64_t hash_round(
+        std::uint64_t accumulator,
+        const std::uint64_t input) noexcept
+{
+    accumulator += input * PRIME_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * PRIME_1;
+}
+
+std::uint64_t hash_merge(
+        std::uint64_t hash,
+        const std::uint64_t accumulator) noexcept
+{
+    hash ^= hash_round(0, accumulator);
+    return hash * PRIME_1 + PRIME_4;
+}
+
+//! 64-bit xxHash (seed 0) of \c data
+std::uint64_t hash64(
+        const std::byte* data,
+        const std::uint64_t size) noexcept
+{
+    const std::byte* const end = data + size;
+    std::uint64_t hash;
+
+    if (size >= 32)
+    {
+        // Four independent accumulators, each taking one word of every 32-byte stripe
+        std::uint64_t accumulators[4] = {PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1};
+
+        do
+        {
+            for (std::size_t i = 0; i < 4; i++)
+            {
+                accumulators[i] = hash_round(accumulators[i], load_uint64(data + 8 * i));
+            }
+
+            data += 32;
+        } while (data + 32 <= end);
+
+        hash = rotate_left(accumulators[0], 1) + rotate_left(accumulators[1], 7) +
+                rotate_left(accumulators[2], 12) + rotate_left(accumulators[3], 18);
+
+        for (const auto accumulator : accumulators)
+        {
+            hash = hash_merge(hash, accumulator);
+        }
+    }
+    else
+    {
+        hash = PRIME_5;
+    }
+
+    hash += size;
+
+    for (; data + 8 <= end; data += 8)
+    {
+        hash ^= hash_round(0, load_uint64(data));
+        hash = rotate_left(hash, 27) * PRIME_1 + PRIME_4;
+    }
+
+    if (data + 4 <= end)
+    {
+        std::uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+
+        hash ^= static_cast<std::uint64_t>(word) * PRIME_1;
+        hash = rotate_left(hash, 23) * PRIME_2 + PRIME_3;
+        data += 4;
+    }
+
+    for (; data < end; data++)
+    {
+        hash ^= static_cast<std::uint64_t>(*data) * PRIME_5;
+        hash = rotate_left(hash, 11) * PRIME_1;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+} // namespace
+
+McapBlob::Reference McapBlob::make_reference(
+        const std::uint64_t offset,
+        const std::uint64_t size) noexcept
+{
+    Reference reference;
+
+    std::memcpy(reference.data(), REFERENCE_MAGIC.data(), REFERENCE_MAGIC.size());
+    write_uint64(reference.data() + 8, offset);
+    write_uint64(reference.data() + 16, size);
+
+    return reference;
+}
+
+bool McapBlob::parse_reference(
+        const std::byte* data,
+        const std::uint64_t size,
+        std::uint64_t& offset,
+        std::uint64_t& payload_size) noexcept
+{
+    if (data == nullptr || size != REFERENCE_SIZE ||
+            std::memcmp(data, REFERENCE_MAGIC.data(), REFERENCE_MAGIC.size()) != 0)
+    {
+        return false;
+    }
+
+    offset = read_uint64(data + 8);
+    payload_size = read_uint64(data + 16);
+
+    return true;
+}
+
+McapBlob::Digest McapBlob::digest(
+        const std::byte* data,
+        const std::uint64_t size) noexcept
+{
+    // Two unrelated checksums, so telling apart two payloads of the same size does not rely on a single 64-bit hash
+    return {size, hash64(data, size), Crc32::update(Crc32::INIT, data, size)};
+}
+
+const char* McapBlob::media_type(
+        const mcap::Compression compression) noexcept
+{
+    switch (compression)
+    {
+        case mcap::Compression::Lz4:
+            return MEDIA_TYPE_LZ4;
+
+        case mcap::Compression::Zstd:
+            return MEDIA_TYPE_ZSTD;
+
+        default:
+            return MEDIA_TYPE_NONE;
+    }
+}
+
+void McapBlob::read(
+        mcap::IReadable& source,
+        const std::uint64_t offset,
+        const std::uint64_t payload_size,
+        mcap::ByteArray& payload)
+{
+    mcap::RecordReader reader(source, offset);
+    const auto record = reader.next();
+
+    if (!record || record->opcode != mcap::OpCode::Attachment)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "No blob at offset " << offset << ".");
+    }
+
+    mcap::Attachment attachment;
+    auto status = mcap::McapReader::ParseAttachment(*record, &attachment);
+
+    if (!status.ok() || attachment.name != ATTACHMENT_NAME)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "No blob at offset " << offset << ": " << status.message);
+    }
+
+    if (attachment.mediaType == MEDIA_TYPE_NONE)
+    {
+        if (attachment.dataSize != payload_size)
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "The blob at offset " << offset << " holds " << attachment.dataSize <<
+                          " bytes instead of " << payload_size << ".");
+        }
+
+        payload.assign(attachment.data, attachment.data + attachment.dataSize);
+        return;
+    }
+
+    if (attachment.mediaType == MEDIA_TYPE_LZ4)
+    {
+        mcap::LZ4Reader lz4_reader;
+        status = lz4_reader.decompressAll(attachment.data, attachment.dataSize, payload_size, &payload);
+    }
+    else if (attachment.mediaType == MEDIA_TYPE_ZSTD)
+    {
+        status = mcap::ZStdReader::DecompressAll(attachment.data, attachment.dataSize, payload_size, &payload);
+    }
+    else
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "The blob at offset " << offset << " has an unknown media type: " <<
+                      attachment.mediaType << ".");
+    }
+
+    if (!status.ok())
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Failed to decompress the blob at offset " << offset << ": " << status.message);
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,115 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapStreamFrame.cpp
+ */
+
+#include <cstring>
+
+#include <ddsrecorder_participants/common/mcap/McapStreamFrame.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Magic starting every frame
+constexpr std::array<std::uint8_t, 4> FRAME_MAGIC = {'D', 'D', 'S', 'R'};
+
+//! Version of the frame format
+constexpr std::uint8_t FRAME_VERSION = 1;
+
+void write_uint64(
+        std::byte* data,
+        const std::uint64_t value) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        data[i] = static_cast<std::byte>((value >> (8 * i)) & 0xff);
+    }
+}
+
+std::uint64_t read_uint64(
+        const std::byte* data) noexcept
+{
+    std::uint64_t value = 0;
+
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+} // namespace
+
+McapStreamFrame::Header McapStreamFrame::make_header(
+        const Kind kind,
+        const std::uint64_t file_id,
+        const std::uint64_t offset,
+        const std::uint64_t length) noexcept
+{
+    Header header{};
+
+    std::memcpy(header.data(), FRAME_MAGIC.data(), FRAME_MAGIC.size());
+    header[4] = static_cast<std::byte>(FRAME_VERSION);
+    header[5] = static_cast<std::byte>(kind);
+    write_uint64(header.data() + 8, file_id);
+    write_uint64(header.data() + 16, offset);
+    write_uint64(header.data() + 24, length);
+
+    return header;
+}
+
+bool McapStreamFrame::parse_header(
+        const std::byte* data,
+        Kind& kind,
+        std::uint64_t& file_id,
+        std::uint64_t& offset,
+        std::uint64_t& length) noexcept
+{
+    if (data == nullptr || std::memcmp(data, FRAME_MAGIC.data(), FRAME_MAGIC.size()) != 0 ||
+            static_cast<std::uint8_t>(data[4]) != FRAME_VERSION)
+    {
+        return false;
+    }
+
+    const auto raw_kind = static_cast<std::uint8_t>(data[5]);
+
+    if (raw_kind < static_cast<std::uint8_t>(Kind::open) || raw_kind > static_cast<std::uint8_t>(Kind::close))
+    {
+        return false;
+    }
+
+    const auto raw_length = read_uint64(data + 24);
+
+    if (raw_length > MAX_LENGTH)
+    {
+        return false;
+    }
+
+    kind = static_cast<Kind>(raw_kind);
+    file_id = read_uint64(data + 8);
+    offset = read_uint64(data + 16);
+    length = raw_length;
+
+    return true;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
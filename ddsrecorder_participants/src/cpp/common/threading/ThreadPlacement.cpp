@@ -0,0 +1,287 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ThreadPlacement.cpp
+ */
+
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // if defined(__linux__)
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+#if defined(__linux__)
+
+//! Max length of a thread name (excluding the terminating null character)
+constexpr std::size_t THREAD_NAME_MAX_LENGTH = 15;
+
+//! Max number of NUMA nodes in a memory policy mask
+constexpr std::size_t MAX_NUMA_NODES = 1024;
+
+//! Bits of a word of a memory policy mask
+constexpr std::size_t NODE_MASK_WORD_BITS = 8 * sizeof(unsigned long);
+
+using NodeMask = std::array<unsigned long, MAX_NUMA_NODES / NODE_MASK_WORD_BITS>;
+
+//! NUMA node of \c cpu (-1 if unknown)
+int numa_node_of(
+        const unsigned int cpu)
+{
+    std::error_code ec;
+
+    for (const auto& entry :
+            std::filesystem::directory_iterator("/sys/devices/system/cpu/cpu" + std::to_string(cpu), ec))
+    {
+        const auto name = entry.path().filename().string();
+
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 && std::isdigit(name[4]))
+        {
+            return std::stoi(name.substr(4));
+        }
+    }
+
+    return -1;
+}
+
+bool set_thread_name(
+        const std::string& name) noexcept
+{
+    return pthread_setname_np(pthread_self(), name.substr(0, THREAD_NAME_MAX_LENGTH).c_str()) == 0;
+}
+
+bool set_thread_cpus(
+        const std::set<unsigned int>& cpus) noexcept
+{
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    for (const auto cpu : cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+}
+
+bool set_memory_policy(
+        const int mode,
+        const NodeMask& mask) noexcept
+{
+    // NOTE: The kernel takes one bit less than maxnode.
+    return syscall(SYS_set_mempolicy, mode, mode == MPOL_DEFAULT ? nullptr : mask.data(), MAX_NUMA_NODES + 1) == 0;
+}
+
+#endif // if defined(__linux__)
+
+} /* namespace */
+
+#if defined(__linux__)
+
+struct ScopedThreadPlacement::SavedPlacement
+{
+    std::array<char, THREAD_NAME_MAX_LENGTH + 1> name{};
+    bool name_saved{false};
+
+    cpu_set_t cpus;
+    bool cpus_saved{false};
+
+    int memory_policy{MPOL_DEFAULT};
+    NodeMask memory_nodes{};
+    bool memory_policy_saved{false};
+};
+
+#else
+
+struct ScopedThreadPlacement::SavedPlacement
+{
+};
+
+#endif // if defined(__linux__)
+
+ThreadPlacement& ThreadPlacement::get_instance() noexcept
+{
+    static ThreadPlacement instance;
+    return instance;
+}
+
+void ThreadPlacement::configure(
+        const ThreadPlacementConfiguration& configuration)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    configuration_ = configuration;
+    numa_node_ = -1;
+
+#if defined(__linux__)
+    if (!configuration_.numa_local)
+    {
+        return;
+    }
+
+    // The samples are written by the workers, or by the event threads when the buffer is dumped on an event
+    const auto& writer_cpus = !configuration_.workers_cpus.empty() ?
+            configuration_.workers_cpus : configuration_.event_cpus;
+
+    if (writer_cpus.empty())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_THREAD_PLACEMENT,
+                "THREAD_PLACEMENT | Ignoring the NUMA placement: neither the workers nor the event threads are pinned.");
+        return;
+    }
+
+    numa_node_ = numa_node_of(*writer_cpus.begin());
+
+    if (numa_node_ < 0 || static_cast<std::size_t>(numa_node_) >= MAX_NUMA_NODES)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_THREAD_PLACEMENT,
+                "THREAD_PLACEMENT | Ignoring the NUMA placement: the NUMA node of CPU " << *writer_cpus.begin() <<
+                " is unknown.");
+        numa_node_ = -1;
+        return;
+    }
+
+    for (const auto cpu : writer_cpus)
+    {
+        if (numa_node_of(cpu) != numa_node_)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_THREAD_PLACEMENT,
+                    "THREAD_PLACEMENT | The CPUs writing the samples span several NUMA nodes, allocating the memory on "
+                    "node " << numa_node_ << ".");
+            break;
+        }
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_THREAD_PLACEMENT,
+            "THREAD_PLACEMENT | Allocating the memory of the placed threads on NUMA node " << numa_node_ << ".");
+#else
+    if (!configuration_.dds_cpus.empty() || !configuration_.workers_cpus.empty() ||
+            !configuration_.event_cpus.empty() || !configuration_.io_cpus.empty() || configuration_.numa_local)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_THREAD_PLACEMENT,
+                "THREAD_PLACEMENT | Thread placement is only supported on Linux, ignoring it.");
+    }
+#endif // if defined(__linux__)
+}
+
+void ThreadPlacement::place_current_thread(
+        const ThreadKind kind,
+        const std::string& name) const noexcept
+{
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    set_thread_name(name);
+
+    const auto& cpus = cpus_(kind);
+
+    if (!cpus.empty() && !set_thread_cpus(cpus))
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_THREAD_PLACEMENT,
+                "THREAD_PLACEMENT | Failed to pin thread " << name << ": " << std::strerror(errno) << ".");
+    }
+
+    if (numa_node_ >= 0)
+    {
+        NodeMask mask{};
+        mask[numa_node_ / NODE_MASK_WORD_BITS] |= 1UL << (numa_node_ % NODE_MASK_WORD_BITS);
+
+        if (!set_memory_policy(MPOL_PREFERRED, mask))
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_THREAD_PLACEMENT,
+                    "THREAD_PLACEMENT | Failed to set the NUMA node of thread " << name << ": " <<
+                    std::strerror(errno) << ".");
+        }
+    }
+#else
+    static_cast<void>(kind);
+    static_cast<void>(name);
+#endif // if defined(__linux__)
+}
+
+const std::set<unsigned int>& ThreadPlacement::cpus_(
+        const ThreadKind kind) const noexcept
+{
+    switch (kind)
+    {
+        case ThreadKind::dds:
+            return configuration_.dds_cpus;
+        case ThreadKind::workers:
+            return configuration_.workers_cpus;
+        case ThreadKind::event:
+            return configuration_.event_cpus;
+        default:
+            return configuration_.io_cpus;
+    }
+}
+
+ScopedThreadPlacement::ScopedThreadPlacement(
+        const ThreadKind kind,
+        const std::string& name)
+    : saved_(std::make_unique<SavedPlacement>())
+{
+#if defined(__linux__)
+    saved_->name_saved = pthread_getname_np(pthread_self(), saved_->name.data(), saved_->name.size()) == 0;
+    saved_->cpus_saved = pthread_getaffinity_np(pthread_self(), sizeof(saved_->cpus), &saved_->cpus) == 0;
+    saved_->memory_policy_saved = syscall(SYS_get_mempolicy, &saved_->memory_policy, saved_->memory_nodes.data(),
+                    MAX_NUMA_NODES + 1, nullptr, 0) == 0;
+#endif // if defined(__linux__)
+
+    ThreadPlacement::get_instance().place_current_thread(kind, name);
+}
+
+ScopedThreadPlacement::~ScopedThreadPlacement()
+{
+#if defined(__linux__)
+    if (saved_->name_saved)
+    {
+        pthread_setname_np(pthread_self(), saved_->name.data());
+    }
+
+    if (saved_->cpus_saved)
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(saved_->cpus), &saved_->cpus);
+    }
+
+    if (saved_->memory_policy_saved)
+    {
+        set_memory_policy(saved_->memory_policy, saved_->memory_nodes);
+    }
+#endif // if defined(__linux__)
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,187 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file DynamicTypesSidecar.cpp
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesSidecar.hpp>
+#include <ddsrecorder_participants/constants.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+std::string DynamicTypesSidecar::hash(
+        const unsigned char* data,
+        const std::uint64_t size)
+{
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+
+    for (std::uint64_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+
+    return hex;
+}
+
+std::string DynamicTypesSidecar::filename(
+        const std::string& hash)
+{
+    return DYNAMIC_TYPES_SIDECAR_PREFIX + hash + DYNAMIC_TYPES_SIDECAR_EXTENSION;
+}
+
+mcap::Metadata DynamicTypesSidecar::reference(
+        const std::string& hash)
+{
+    mcap::Metadata metadata;
+
+    metadata.name = DYNAMIC_TYPES_SIDECAR_METADATA_NAME;
+    metadata.metadata[DYNAMIC_TYPES_SIDECAR_FILE] = filename(hash);
+    metadata.metadata[DYNAMIC_TYPES_SIDECAR_HASH] = hash;
+
+    return metadata;
+}
+
+std::string DynamicTypesSidecar::write(
+        const std::string& directory,
+        const unsigned char* data,
+        const std::uint64_t size)
+{
+    const auto data_hash = hash(data, size);
+    const auto path = std::filesystem::path(directory) / filename(data_hash);
+
+    if (std::filesystem::exists(path))
+    {
+        // Content-addressed: a file with the same name already holds the same types
+        return data_hash;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_DYNAMIC_TYPES_SIDECAR,
+            "MCAP_WRITE | Writing dynamic types sidecar " << path.string() << ".");
+
+    const auto tmp_path = path.string() + ".tmp~";
+
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+
+        if (!file.write(reinterpret_cast<const char*>(data), size))
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "Failed to write the dynamic types sidecar " << tmp_path << ".");
+        }
+    }
+
+    // Rename so readers never see a partially written file
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+
+    if (ec)
+    {
+        std::filesystem::remove(tmp_path, ec);
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Failed to write the dynamic types sidecar " << path.string() << ": " << ec.message());
+    }
+
+    return data_hash;
+}
+
+std::vector<unsigned char> DynamicTypesSidecar::read(
+        const std::string& directory,
+        const mcap::Metadata& reference)
+{
+    const auto file_it = reference.metadata.find(DYNAMIC_TYPES_SIDECAR_FILE);
+    const auto hash_it = reference.metadata.find(DYNAMIC_TYPES_SIDECAR_HASH);
+
+    if (file_it == reference.metadata.end() || hash_it == reference.metadata.end())
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Malformed dynamic types sidecar reference.");
+    }
+
+    // NOTE: Only the file name is kept, so a reference can never point outside of the directory.
+    const auto path = std::filesystem::path(directory) / std::filesystem::path(file_it->second).filename();
+
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Failed to open the dynamic types sidecar " << path.string() << ".");
+    }
+
+    std::vector<unsigned char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    if (hash(data.data(), data.size()) != hash_it->second)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "The dynamic types sidecar " << path.string() << " does not match its hash.");
+    }
+
+    return data;
+}
+
+std::vector<unsigned char> DynamicTypesSidecar::read_collection(
+        const std::string& directory,
+        const std::map<std::string, mcap::Metadata>& metadatas,
+        const std::map<std::string, mcap::Attachment>& attachments)
+{
+    const auto reference = metadatas.find(DYNAMIC_TYPES_SIDECAR_METADATA_NAME);
+
+    if (reference != metadatas.end())
+    {
+        try
+        {
+            return read(directory, reference->second);
+        }
+        catch (const utils::InconsistencyException& e)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_DYNAMIC_TYPES_SIDECAR,
+                    "Failed to read the dynamic types sidecar: " << e.what() << " Falling back to embedded types.");
+        }
+    }
+
+    const auto attachment = attachments.find(DYNAMIC_TYPES_ATTACHMENT_NAME);
+
+    if (attachment == attachments.end() || attachment->second.data == nullptr)
+    {
+        return {};
+    }
+
+    const auto data = reinterpret_cast<const unsigned char*>(attachment->second.data);
+
+    return std::vector<unsigned char>(data, data + attachment->second.dataSize);
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,600 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file SlabPayloadPool.cpp
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif // if defined(__linux__)
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/recorder/efficiency/payload/SlabPayloadPool.hpp>
+#include <ddsrecorder_participants/recorder/logging/LogRateLimiter.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Next identifier to assign to a \c SlabPayloadPool
+std::atomic<std::uint64_t> next_pool_id{1};
+
+//! Protects \c alive_pools
+std::mutex& alive_pools_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+//! Pools not destroyed yet, by identifier
+std::unordered_map<std::uint64_t, SlabPayloadPool*>& alive_pools()
+{
+    static std::unordered_map<std::uint64_t, SlabPayloadPool*> pools;
+    return pools;
+}
+
+} /* namespace */
+
+struct SlabPayloadPool::ThreadCaches
+{
+    ThreadCaches()
+    {
+        // Make sure the registry of pools outlives the caches of the main thread
+        alive_pools_mutex();
+        alive_pools();
+    }
+
+    ~ThreadCaches()
+    {
+        // Return the cached blocks to the pools still alive
+        std::lock_guard<std::mutex> lock(alive_pools_mutex());
+
+        for (auto& it : caches)
+        {
+            const auto pool = alive_pools().find(it.first);
+
+            if (pool == alive_pools().end())
+            {
+                continue;
+            }
+
+            for (std::uint32_t size_class = 0; size_class < it.second.size(); size_class++)
+            {
+                pool->second->drain_(size_class, it.second[size_class], 0);
+            }
+        }
+    }
+
+    //! Cache of every pool used by the thread, by pool identifier
+    std::unordered_map<std::uint64_t, BlockCache> caches;
+
+    //! Identifier of the pool used last by the thread
+    std::uint64_t last_id{0};
+
+    //! Cache of the pool used last by the thread
+    BlockCache* last_cache{nullptr};
+};
+
+SlabPayloadPool::SlabPayloadPool(
+        const PayloadPoolConfiguration& configuration /* = {} */)
+    : configuration_(configuration)
+    , id_(next_pool_id++)
+{
+    // Four size classes per power of two, from MIN_CLASS_SIZE up to MAX_CLASS_SIZE
+    class_sizes_.push_back(MIN_CLASS_SIZE);
+
+    for (std::size_t base = MIN_CLASS_SIZE; base < MAX_CLASS_SIZE; base *= 2)
+    {
+        for (std::size_t step = 1; step <= 4; step++)
+        {
+            class_sizes_.push_back(base + step * base / 4);
+        }
+    }
+
+    for (const auto size : class_sizes_)
+    {
+        auto size_class = std::make_unique<SizeClass>();
+        size_class->size = size;
+        size_class->block_size = sizeof(BlockHeader) + size;
+        size_class->cache_blocks = std::min<std::uint64_t>(
+            configuration_.thread_cache_size / size_class->block_size, SLAB_SIZE / size_class->block_size);
+
+        size_classes_.push_back(std::move(size_class));
+    }
+
+    std::lock_guard<std::mutex> lock(alive_pools_mutex());
+    alive_pools()[id_] = this;
+}
+
+SlabPayloadPool::~SlabPayloadPool()
+{
+    {
+        // From now on, the thread caches of this pool are ignored
+        std::lock_guard<std::mutex> lock(alive_pools_mutex());
+        alive_pools().erase(id_);
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_PAYLOAD_POOL,
+            "PAYLOAD_POOL | Releasing " << slabs_.size() << " slabs (" << reserved_bytes() << " bytes reserved).");
+
+    {
+        std::lock_guard<std::mutex> lock(large_blocks_mutex_);
+
+        for (const auto& large_block : large_blocks_)
+        {
+            large_block.second->~BlockHeader();
+            unmap_(large_block.second, large_block.first);
+        }
+
+        large_blocks_.clear();
+        cached_large_bytes_ = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(slabs_mutex_);
+
+    for (const auto& slab : slabs_)
+    {
+        unmap_(slab.first, slab.second);
+    }
+
+    slabs_.clear();
+}
+
+bool SlabPayloadPool::get_payload(
+        uint32_t size,
+        ddspipe::core::types::Payload& payload)
+{
+    const auto size_class = size_class_of_(size);
+
+    BlockHeader* block = nullptr;
+
+    if (size_class == LARGE_CLASS)
+    {
+        block = allocate_large_block_(size);
+    }
+    else
+    {
+        block = allocate_block_(size_class);
+    }
+
+    if (block == nullptr)
+    {
+        DDSRECORDER_LOG_ERROR_RATE_LIMITED(DDSRECORDER_PAYLOAD_POOL,
+                "PAYLOAD_POOL | Failed to reserve a payload of " << size << " bytes.");
+        return false;
+    }
+
+    block->references.store(1, std::memory_order_relaxed);
+
+    payload.data = reinterpret_cast<fastdds::rtps::octet*>(block + 1);
+    payload.max_size = size;
+    payload.length = 0;
+    payload.pos = 0;
+    payload.payload_owner = this;
+
+    reserve_count_++;
+
+    return true;
+}
+
+bool SlabPayloadPool::get_payload(
+        const ddspipe::core::types::Payload& src_payload,
+        ddspipe::core::types::Payload& target_payload)
+{
+    if (src_payload.payload_owner == this)
+    {
+        // The payload belongs to this pool: share it
+        auto block = reinterpret_cast<BlockHeader*>(src_payload.data) - 1;
+        block->references.fetch_add(1, std::memory_order_relaxed);
+
+        target_payload.data = src_payload.data;
+        target_payload.max_size = src_payload.max_size;
+        target_payload.payload_owner = this;
+
+        reserve_count_++;
+    }
+    else
+    {
+        // The payload belongs to another pool (or to none): copy it
+        if (!get_payload(src_payload.length, target_payload))
+        {
+            return false;
+        }
+
+        std::memcpy(target_payload.data, src_payload.data, src_payload.length);
+    }
+
+    target_payload.length = src_payload.length;
+    target_payload.pos = 0;
+    target_payload.encapsulation = src_payload.encapsulation;
+
+    return true;
+}
+
+bool SlabPayloadPool::release_payload(
+        ddspipe::core::types::Payload& payload)
+{
+    if (payload.payload_owner != this)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_PAYLOAD_POOL,
+                "PAYLOAD_POOL | Trying to release a payload that does not belong to this pool.");
+        return false;
+    }
+
+    auto block = reinterpret_cast<BlockHeader*>(payload.data) - 1;
+
+    if (block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        if (block->size_class == LARGE_CLASS || block->size_class == HEAP_CLASS)
+        {
+            deallocate_large_block_(block);
+        }
+        else
+        {
+            deallocate_block_(block);
+        }
+    }
+
+    payload.data = nullptr;
+    payload.length = 0;
+    payload.max_size = 0;
+    payload.pos = 0;
+    payload.payload_owner = nullptr;
+
+    release_count_++;
+
+    return true;
+}
+
+std::uint64_t SlabPayloadPool::reserved_bytes() const noexcept
+{
+    return reserved_bytes_.load(std::memory_order_relaxed);
+}
+
+std::uint32_t SlabPayloadPool::size_class_of_(
+        std::size_t size) const noexcept
+{
+    if (size > MAX_CLASS_SIZE)
+    {
+        return LARGE_CLASS;
+    }
+
+    return static_cast<std::uint32_t>(
+        std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size) - class_sizes_.begin());
+}
+
+SlabPayloadPool::BlockHeader* SlabPayloadPool::allocate_block_(
+        std::uint32_t size_class)
+{
+    auto& cache = thread_cache_()[size_class];
+
+    if (cache.empty())
+    {
+        refill_(size_class, cache, size_classes_[size_class]->cache_blocks / 2 + 1);
+
+        if (cache.empty())
+        {
+            return nullptr;
+        }
+    }
+
+    auto block = cache.back();
+    cache.pop_back();
+
+    return block;
+}
+
+void SlabPayloadPool::deallocate_block_(
+        BlockHeader* block)
+{
+    const auto size_class = block->size_class;
+    auto& cache = thread_cache_()[size_class];
+
+    cache.push_back(block);
+
+    const auto cache_blocks = size_classes_[size_class]->cache_blocks;
+
+    if (cache.size() > cache_blocks)
+    {
+        // Return half of the cache to the pool, so the threads that only allocate can take them
+        drain_(size_class, cache, cache_blocks / 2);
+    }
+}
+
+void SlabPayloadPool::refill_(
+        std::uint32_t size_class,
+        std::vector<BlockHeader*>& cache,
+        std::size_t count)
+{
+    auto& klass = *size_classes_[size_class];
+
+    std::lock_guard<std::mutex> lock(klass.mutex);
+
+    // Take the blocks returned by other threads first
+    const auto reused = std::min(count, klass.free_blocks.size());
+    cache.insert(cache.end(), klass.free_blocks.end() - reused, klass.free_blocks.end());
+    klass.free_blocks.resize(klass.free_blocks.size() - reused);
+    count -= reused;
+
+    // Carve the remaining blocks from the slabs
+    while (count > 0)
+    {
+        if (static_cast<std::size_t>(klass.slab_end - klass.slab_cursor) < klass.block_size)
+        {
+            auto slab = static_cast<std::uint8_t*>(map_(SLAB_SIZE));
+
+            if (slab == nullptr)
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> slabs_lock(slabs_mutex_);
+                slabs_.emplace_back(slab, SLAB_SIZE);
+            }
+
+            klass.slab_cursor = slab;
+            klass.slab_end = slab + SLAB_SIZE;
+        }
+
+        auto block = new (klass.slab_cursor) BlockHeader();
+        block->size_class = size_class;
+        block->allocated_size = klass.block_size;
+
+        klass.slab_cursor += klass.block_size;
+        cache.push_back(block);
+        count--;
+    }
+}
+
+void SlabPayloadPool::drain_(
+        std::uint32_t size_class,
+        std::vector<BlockHeader*>& cache,
+        std::size_t keep)
+{
+    if (cache.size() <= keep)
+    {
+        return;
+    }
+
+    auto& klass = *size_classes_[size_class];
+
+    std::lock_guard<std::mutex> lock(klass.mutex);
+
+    klass.free_blocks.insert(klass.free_blocks.end(), cache.begin() + keep, cache.end());
+    cache.resize(keep);
+}
+
+SlabPayloadPool::BlockHeader* SlabPayloadPool::allocate_large_block_(
+        std::size_t size)
+{
+    if (!configuration_.huge_pages)
+    {
+        // The heap keeps the large chunks released and reuses them, unlike a mapping per payload
+        const auto allocated_size = sizeof(BlockHeader) + size;
+        void* address = std::malloc(allocated_size);
+
+        if (address == nullptr)
+        {
+            return nullptr;
+        }
+
+        reserved_bytes_.fetch_add(allocated_size, std::memory_order_relaxed);
+
+        auto block = new (address) BlockHeader();
+        block->size_class = HEAP_CLASS;
+        block->allocated_size = allocated_size;
+
+        return block;
+    }
+
+    const auto allocated_size = (sizeof(BlockHeader) + size + SLAB_SIZE - 1) / SLAB_SIZE * SLAB_SIZE;
+
+    {
+        std::lock_guard<std::mutex> lock(large_blocks_mutex_);
+
+        // Reuse the smallest cached block big enough, unless it would waste more than half of it
+        const auto it = large_blocks_.lower_bound(allocated_size);
+
+        if (it != large_blocks_.end() && it->first <= 2 * allocated_size)
+        {
+            const auto block = it->second;
+            cached_large_bytes_ -= it->first;
+            large_blocks_.erase(it);
+
+            return block;
+        }
+    }
+
+    void* address = map_(allocated_size);
+
+    if (address == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto block = new (address) BlockHeader();
+    block->size_class = LARGE_CLASS;
+    block->allocated_size = allocated_size;
+
+    return block;
+}
+
+void SlabPayloadPool::deallocate_large_block_(
+        BlockHeader* block)
+{
+    const auto allocated_size = static_cast<std::size_t>(block->allocated_size);
+
+    if (block->size_class == HEAP_CLASS)
+    {
+        block->~BlockHeader();
+        std::free(block);
+        reserved_bytes_.fetch_sub(allocated_size, std::memory_order_relaxed);
+        return;
+    }
+
+    if (allocated_size <= MAX_CACHED_LARGE_BYTES)
+    {
+        std::vector<BlockHeader*> evicted;
+
+        {
+            std::lock_guard<std::mutex> lock(large_blocks_mutex_);
+
+            // Make room for the block evicting the oldest cached blocks of its same size first, then the smallest
+            while (cached_large_bytes_ + allocated_size > MAX_CACHED_LARGE_BYTES)
+            {
+                auto it = large_blocks_.find(allocated_size);
+
+                if (it == large_blocks_.end())
+                {
+                    it = large_blocks_.begin();
+                }
+
+                cached_large_bytes_ -= it->first;
+                evicted.push_back(it->second);
+                large_blocks_.erase(it);
+            }
+
+            large_blocks_.emplace(allocated_size, block);
+            cached_large_bytes_ += allocated_size;
+        }
+
+        // Return the evicted blocks to the system out of the lock
+        for (const auto evicted_block : evicted)
+        {
+            const auto evicted_size = evicted_block->allocated_size;
+            evicted_block->~BlockHeader();
+            unmap_(evicted_block, evicted_size);
+        }
+
+        return;
+    }
+
+    block->~BlockHeader();
+    unmap_(block, allocated_size);
+}
+
+SlabPayloadPool::BlockCache& SlabPayloadPool::thread_cache_()
+{
+    static thread_local ThreadCaches thread_caches;
+
+    if (thread_caches.last_id == id_)
+    {
+        return *thread_caches.last_cache;
+    }
+
+    auto it = thread_caches.caches.find(id_);
+
+    if (it == thread_caches.caches.end())
+    {
+        // First use of this pool in this thread: forget the caches of the pools already destroyed
+        {
+            std::lock_guard<std::mutex> lock(alive_pools_mutex());
+
+            for (auto cache = thread_caches.caches.begin(); cache != thread_caches.caches.end();)
+            {
+                if (alive_pools().count(cache->first) == 0)
+                {
+                    cache = thread_caches.caches.erase(cache);
+                }
+                else
+                {
+                    ++cache;
+                }
+            }
+        }
+
+        it = thread_caches.caches.emplace(id_, BlockCache(size_classes_.size())).first;
+    }
+
+    thread_caches.last_id = id_;
+    thread_caches.last_cache = &it->second;
+
+    return it->second;
+}
+
+void* SlabPayloadPool::map_(
+        std::size_t size)
+{
+#if defined(__linux__)
+    void* address = MAP_FAILED;
+
+    if (configuration_.huge_pages)
+    {
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (address == MAP_FAILED && !huge_pages_failed_.exchange(true))
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_PAYLOAD_POOL,
+                    "PAYLOAD_POOL | Failed to reserve huge pages: " << std::strerror(errno) <<
+                    ". Falling back to regular pages (advised as transparent huge pages).");
+        }
+    }
+
+    if (address == MAP_FAILED)
+    {
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (address == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        if (configuration_.huge_pages)
+        {
+            madvise(address, size, MADV_HUGEPAGE);
+        }
+    }
+#else
+    void* address = std::malloc(size);
+
+    if (address == nullptr)
+    {
+        return nullptr;
+    }
+#endif // if defined(__linux__)
+
+    reserved_bytes_.fetch_add(size, std::memory_order_relaxed);
+
+    return address;
+}
+
+void SlabPayloadPool::unmap_(
+        void* address,
+        std::size_t size) noexcept
+{
+#if defined(__linux__)
+    munmap(address, size);
+#else
+    std::free(address);
+#endif // if defined(__linux__)
+
+    reserved_bytes_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,282 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EmbeddedRecorder.cpp
+ */
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/rtps/common/Time_t.hpp>
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/Log.hpp>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+#include <ddspipe_core/types/data/RtpsPayloadData.hpp>
+
+#include <ddsrecorder_participants/recorder/efficiency/payload/SlabPayloadPool.hpp>
+#include <ddsrecorder_participants/recorder/embedded/EmbeddedRecorder.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+using namespace eprosima::ddspipe::core::types;
+
+EmbeddedRecorder::EmbeddedRecorder(
+        const EmbeddedRecorderConfiguration& configuration,
+        const McapHandlerStateCode& init_state /* = McapHandlerStateCode::RUNNING */)
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_EMBEDDED_RECORDER,
+            "Creating embedded recorder.");
+
+    if (configuration.payload_pool.kind == PayloadPoolKind::slab)
+    {
+        payload_pool_ = std::make_shared<SlabPayloadPool>(configuration.payload_pool);
+    }
+    else
+    {
+        payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    }
+
+    const auto output_settings = output_settings_(configuration);
+
+    file_tracker_ = std::make_shared<FileTracker>(output_settings);
+
+    handler_ = std::make_unique<McapHandler>(
+        handler_configuration_(configuration),
+        payload_pool_,
+        file_tracker_,
+        init_state);
+}
+
+EmbeddedRecorder::~EmbeddedRecorder()
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_EMBEDDED_RECORDER,
+            "Destroying embedded recorder.");
+
+    // Destroy the handler (closing the current file) before the pool its samples were reserved from
+    handler_.reset();
+}
+
+void EmbeddedRecorder::register_type(
+        const fastdds::dds::DynamicType::_ref_type& dynamic_type)
+{
+    if (dynamic_type == nullptr)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Cannot register a null type.");
+    }
+
+    fastdds::dds::xtypes::TypeIdentifierPair type_identifiers;
+
+    if (fastdds::dds::RETCODE_OK !=
+            fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().
+                    register_typeobject_w_dynamic_type(dynamic_type, type_identifiers))
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Failed to register type " << dynamic_type->get_name().to_string() << ".");
+    }
+
+    // NOTE: The handler expects the complete type identifier
+    const auto& type_identifier =
+            type_identifiers.type_identifier2()._d() == fastdds::dds::xtypes::EK_COMPLETE ?
+            type_identifiers.type_identifier2() : type_identifiers.type_identifier1();
+
+    handler_->add_schema(dynamic_type, type_identifier);
+}
+
+void EmbeddedRecorder::reserve_payload(
+        const std::uint32_t size,
+        Payload& payload)
+{
+    if (!payload_pool_->get_payload(size, payload))
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Failed to reserve a payload of " << size << " bytes.");
+    }
+
+    payload.length = size;
+}
+
+void EmbeddedRecorder::write(
+        const std::string& topic_name,
+        const std::string& type_name,
+        Payload& payload,
+        const utils::Timestamp& timestamp /* = utils::now() */)
+{
+    if (payload.payload_owner != payload_pool_.get())
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "The payload written in topic " << topic_name << " was not reserved by the recorder.");
+    }
+
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timestamp.time_since_epoch()).count();
+
+    RtpsPayloadData data;
+    data.source_timestamp = fastdds::rtps::Time_t(
+        static_cast<std::int32_t>(nanoseconds / 1000000000),
+        static_cast<std::uint32_t>(nanoseconds % 1000000000));
+
+    // Share the payload with the data (the pool only counts a new reference to it) and release the caller's reference
+    payload_pool_->get_payload(payload, data.payload);
+    data.payload_owner = payload_pool_.get();
+    payload_pool_->release_payload(payload);
+
+    handler_->add_data(topic_(topic_name, type_name), data);
+}
+
+void EmbeddedRecorder::write(
+        const std::string& topic_name,
+        const std::string& type_name,
+        const std::byte* data,
+        const std::uint32_t size,
+        const utils::Timestamp& timestamp /* = utils::now() */)
+{
+    Payload payload;
+    reserve_payload(size, payload);
+
+    std::memcpy(payload.data, data, size);
+
+    write(topic_name, type_name, payload, timestamp);
+}
+
+void EmbeddedRecorder::start()
+{
+    handler_->start();
+}
+
+void EmbeddedRecorder::pause()
+{
+    handler_->pause();
+}
+
+void EmbeddedRecorder::trigger_event()
+{
+    handler_->trigger_event();
+}
+
+void EmbeddedRecorder::stop()
+{
+    handler_->stop();
+    handler_->wait_for_finalization();
+}
+
+std::vector<File> EmbeddedRecorder::closed_files()
+{
+    return file_tracker_->get_closed_files();
+}
+
+OutputSettings EmbeddedRecorder::output_settings_(
+        const EmbeddedRecorderConfiguration& configuration)
+{
+    OutputSettings output_settings;
+
+    output_settings.sink = configuration.sink;
+    output_settings.stream = configuration.stream;
+    output_settings.filepath = configuration.filepath;
+    output_settings.filename = configuration.filename;
+    output_settings.extension = ".mcap";
+    output_settings.prepend_timestamp = configuration.prepend_timestamp;
+    output_settings.timestamp_format = configuration.timestamp_format;
+    output_settings.local_timestamp = false;
+    output_settings.safety_margin = configuration.safety_margin;
+    output_settings.file_rotation = configuration.file_rotation;
+    output_settings.max_file_size = configuration.max_file_size;
+
+    if (output_settings.max_file_size == 0)
+    {
+        switch (configuration.sink)
+        {
+            case OutputSinkKind::file:
+                output_settings.max_file_size = std::filesystem::space(output_settings.filepath).available;
+                break;
+
+            case OutputSinkKind::stream:
+                output_settings.max_file_size = STREAM_SINK_DEFAULT_MAX_FILE_SIZE;
+                break;
+
+            default:
+                output_settings.max_file_size = UNLIMITED_OUTPUT_SIZE;
+                break;
+        }
+    }
+
+    output_settings.staging_path = configuration.staging_path;
+    output_settings.staging_max_size = configuration.staging_max_size;
+    output_settings.disk_full_forecast = configuration.disk_full_forecast;
+    output_settings.max_size = configuration.max_size;
+
+    if (output_settings.max_size == 0)
+    {
+        output_settings.max_size = output_settings.max_file_size;
+    }
+
+    return output_settings;
+}
+
+McapHandlerConfiguration EmbeddedRecorder::handler_configuration_(
+        const EmbeddedRecorderConfiguration& configuration)
+{
+    // NOTE: The timestamp of the samples is both their publication and their log time
+    return McapHandlerConfiguration(
+        output_settings_(configuration),
+        configuration.max_pending_samples,
+        configuration.buffer_size,
+        configuration.event_window,
+        2 * configuration.event_window,
+        true,
+        false,
+        configuration.mcap_writer_options,
+        configuration.record_types,
+        configuration.ros2_types,
+        false,
+        configuration.sink == OutputSinkKind::stream ? STREAM_SINK_DEFAULT_MEMORY_BUDGET : 0,
+        false,
+        false,
+        {},
+        configuration.chunking,
+        configuration.blobs);
+}
+
+const DdsTopic& EmbeddedRecorder::topic_(
+        const std::string& topic_name,
+        const std::string& type_name)
+{
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+
+    const auto key = std::make_pair(topic_name, type_name);
+
+    auto it = topics_.find(key);
+
+    if (it == topics_.end())
+    {
+        DdsTopic topic;
+        topic.m_topic_name = topic_name;
+        topic.type_name = type_name;
+
+        it = topics_.emplace(key, std::move(topic)).first;
+    }
+
+    return it->second;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,61 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file LogRateLimiter.cpp
+ */
+
+#include <ddsrecorder_participants/recorder/logging/LogRateLimiter.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+LogRateLimiter::LogRateLimiter(
+        const std::chrono::nanoseconds& period /* = std::chrono::seconds(1) */,
+        Clock clock /* = steady_now */) noexcept
+    : clock_(clock)
+    , period_(period.count())
+    , last_entry_(clock() - period.count())
+{
+}
+
+std::int64_t LogRateLimiter::steady_now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool LogRateLimiter::acquire(
+        std::uint64_t& suppressed) noexcept
+{
+    const auto now = clock_();
+    auto last_entry = last_entry_.load(std::memory_order_relaxed);
+
+    if (now - last_entry < period_ ||
+            !last_entry_.compare_exchange_strong(last_entry, now, std::memory_order_relaxed))
+    {
+        // Too soon, or another thread has just let an entry through
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,194 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file IngestionLane.cpp
+ */
+
+#include <exception>
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+#include <ddsrecorder_participants/recorder/mcap/IngestionLane.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+IngestionLane::IngestionLane(
+        const IngestionLaneConfiguration& configuration,
+        const BatchHandler& batch_handler)
+    : configuration_(configuration)
+    , batch_handler_(batch_handler)
+    , queue_(configuration.queue_size)
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_INGESTION_LANE,
+            "INGESTION_LANE | Creating lane " << configuration_.name << " holding up to " << queue_.capacity() <<
+            " samples.");
+
+    thread_ = std::thread(&IngestionLane::routine_, this);
+}
+
+IngestionLane::~IngestionLane()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+
+    samples_cv_.notify_all();
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+bool IngestionLane::push(
+        IngestionSample&& sample)
+{
+    if (!queue_.try_push(std::move(sample)))
+    {
+        return false;
+    }
+
+    pushed_samples_++;
+
+    // Pairs with the fence of the lane thread: either it sees the sample or this thread sees it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (waiting_.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_cv_.notify_one();
+    }
+
+    return true;
+}
+
+void IngestionLane::flush()
+{
+    const std::uint64_t target = pushed_samples_.load();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    handled_cv_.wait(
+        lock,
+        [&]
+        {
+            return handled_samples_.load() >= target;
+        });
+}
+
+const std::string& IngestionLane::name() const noexcept
+{
+    return configuration_.name;
+}
+
+void IngestionLane::routine_()
+{
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::workers, "ddsrec.lane");
+
+    std::vector<IngestionSample> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+
+    // Whether the samples handed over have not been added yet, so the handover must be retried
+    bool pending = false;
+
+    while (true)
+    {
+        IngestionSample sample;
+
+        while (batch.size() < MAX_BATCH_SIZE && queue_.try_pop(sample))
+        {
+            batch.push_back(std::move(sample));
+        }
+
+        if (!batch.empty() || pending)
+        {
+            const auto batch_size = batch.size();
+
+            try
+            {
+                pending = !batch_handler_(batch);
+            }
+            catch (const std::exception& e)
+            {
+                EPROSIMA_LOG_ERROR(DDSRECORDER_INGESTION_LANE,
+                        "INGESTION_LANE | Error adding " << batch_size << " samples of lane " << configuration_.name <<
+                        ": " << e.what());
+
+                pending = false;
+            }
+
+            if (batch_size > 0)
+            {
+                // Release the references to the payloads before announcing the samples as handled
+                batch.clear();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    handled_samples_ += batch_size;
+                }
+
+                handled_cv_.notify_all();
+                continue;
+            }
+
+            if (!pending)
+            {
+                continue;
+            }
+
+            // The retry found the handler busy again and there are no new samples: wait for the next retry
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        waiting_.store(true, std::memory_order_relaxed);
+
+        // Pairs with the fence of the producers: either this thread sees their sample or they see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (queue_.empty())
+        {
+            if (!running_)
+            {
+                // Every sample has been handed over (whoever stops the handler adds the ones still pending)
+                break;
+            }
+
+            const auto woken_up = [&]
+                    {
+                        return !running_ || !queue_.empty();
+                    };
+
+            if (pending)
+            {
+                samples_cv_.wait_for(lock, HANDOVER_RETRY_PERIOD, woken_up);
+            }
+            else
+            {
+                samples_cv_.wait(lock, woken_up);
+            }
+        }
+
+        waiting_.store(false, std::memory_order_relaxed);
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,105 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file LogTimeClock.cpp
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <time.h>
+#endif // if defined(__linux__)
+
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClock.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+std::int64_t system_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+LogTimeClock::LogTimeClock(
+        const LogTimeClockConfiguration& configuration)
+    : configuration_(configuration)
+{
+}
+
+mcap::Timestamp LogTimeClock::now() const noexcept
+{
+    const auto time = read_();
+
+    if (configuration_.precision > 1)
+    {
+        return time - time % configuration_.precision;
+    }
+
+    return time;
+}
+
+std::uint64_t LogTimeClock::resolution() const noexcept
+{
+#if defined(__linux__)
+    if (configuration_.kind == LogTimeClockKind::coarse)
+    {
+        timespec ts;
+
+        if (clock_getres(CLOCK_REALTIME_COARSE, &ts) == 0)
+        {
+            return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+        }
+    }
+#endif // if defined(__linux__)
+
+    // The coarse clock falls back to the system clock where it is not available
+    return std::max<std::uint64_t>(
+        1, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::duration(1)).count());
+}
+
+std::uint64_t LogTimeClock::read_() const noexcept
+{
+    switch (configuration_.kind)
+    {
+        case LogTimeClockKind::coarse:
+        {
+#if defined(__linux__)
+            timespec ts;
+
+            if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0)
+            {
+                return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+            }
+#endif // if defined(__linux__)
+            return system_ns();
+        }
+
+        case LogTimeClockKind::system:
+        default:
+            return system_ns();
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
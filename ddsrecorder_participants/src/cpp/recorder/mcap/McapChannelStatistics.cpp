@@ -0,0 +1,117 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapChannelStatistics.cpp
+ */
+
+#include <algorithm>
+#include <string>
+
+#include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChannelStatistics.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+void McapChannelStatistics::add_message(
+        const mcap::Timestamp log_time,
+        const std::uint64_t size) noexcept
+{
+    bytes_ += size;
+
+    if (messages_++ == 0)
+    {
+        first_log_time_ = log_time;
+        last_log_time_ = log_time;
+        return;
+    }
+
+    const std::uint64_t inter_arrival = log_time > last_log_time_ ? log_time - last_log_time_ : 0;
+    const std::uint64_t previous_inter_arrivals = messages_ - 2;
+
+    // The mean is derived from the first and last logTimes, so no per-message history is kept.
+    // NOTE: Dividing the span (instead of multiplying the inter-arrival time) keeps a long gap from overflowing.
+    // The comparison is exact, since a * n > b <=> a > b / n for integers.
+    if (previous_inter_arrivals >= MIN_INTER_ARRIVALS_FOR_GAPS &&
+            inter_arrival > GAP_FACTOR * (last_log_time_ - first_log_time_) / previous_inter_arrivals)
+    {
+        gaps_++;
+    }
+
+    min_inter_arrival_ = std::min(min_inter_arrival_, inter_arrival);
+    max_inter_arrival_ = std::max(max_inter_arrival_, inter_arrival);
+    last_log_time_ = std::max(last_log_time_, log_time);
+}
+
+mcap::Metadata McapChannelStatistics::to_metadata(
+        const mcap::Channel& channel) const
+{
+    if (messages_ < 2)
+    {
+        return build_metadata_(channel, messages_, bytes_, first_log_time_, last_log_time_, 0, 0, 0, 0);
+    }
+
+    return build_metadata_(
+        channel,
+        messages_,
+        bytes_,
+        first_log_time_,
+        last_log_time_,
+        min_inter_arrival_,
+        max_inter_arrival_,
+        (last_log_time_ - first_log_time_) / (messages_ - 1),
+        gaps_);
+}
+
+mcap::Metadata McapChannelStatistics::max_metadata(
+        const mcap::Channel& channel)
+{
+    constexpr auto MAX = std::numeric_limits<std::uint64_t>::max();
+
+    return build_metadata_(channel, MAX, MAX, MAX, MAX, MAX, MAX, MAX, MAX);
+}
+
+mcap::Metadata McapChannelStatistics::build_metadata_(
+        const mcap::Channel& channel,
+        const std::uint64_t messages,
+        const std::uint64_t bytes,
+        const mcap::Timestamp first_log_time,
+        const mcap::Timestamp last_log_time,
+        const std::uint64_t min_inter_arrival,
+        const std::uint64_t max_inter_arrival,
+        const std::uint64_t mean_inter_arrival,
+        const std::uint64_t gaps)
+{
+    mcap::Metadata metadata;
+
+    metadata.name = CHANNEL_STATISTICS_METADATA_PREFIX + std::to_string(channel.id);
+    metadata.metadata[CHANNEL_STATISTICS_TOPIC] = channel.topic;
+    metadata.metadata[CHANNEL_STATISTICS_MESSAGES] = std::to_string(messages);
+    metadata.metadata[CHANNEL_STATISTICS_BYTES] = std::to_string(bytes);
+    metadata.metadata[CHANNEL_STATISTICS_FIRST_LOG_TIME] = std::to_string(first_log_time);
+    metadata.metadata[CHANNEL_STATISTICS_LAST_LOG_TIME] = std::to_string(last_log_time);
+    metadata.metadata[CHANNEL_STATISTICS_MIN_INTER_ARRIVAL] = std::to_string(min_inter_arrival);
+    metadata.metadata[CHANNEL_STATISTICS_MAX_INTER_ARRIVAL] = std::to_string(max_inter_arrival);
+    metadata.metadata[CHANNEL_STATISTICS_MEAN_INTER_ARRIVAL] = std::to_string(mean_inter_arrival);
+    metadata.metadata[CHANNEL_STATISTICS_GAPS] = std::to_string(gaps);
+
+    return metadata;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,188 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapChunkPolicy.cpp
+ */
+
+#include <algorithm>
+
+#include <ddsrecorder_participants/recorder/mcap/McapChunkPolicy.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Weight of the last interval in the moving average of the interval between messages
+constexpr double RECENT_INTERVAL_WEIGHT = 1.0 / 8;
+
+} // namespace
+
+McapChunkPolicy::McapChunkPolicy(
+        const McapChunkingConfiguration& configuration)
+    : configuration_(configuration)
+{
+}
+
+std::uint64_t McapChunkPolicy::library_chunk_size(
+        const McapChunkingConfiguration& configuration) noexcept
+{
+    if (configuration.kind == McapChunkingKind::adaptive)
+    {
+        return configuration.max_size;
+    }
+
+    return configuration.size;
+}
+
+void McapChunkPolicy::message_written(
+        const std::uint64_t log_time,
+        const std::uint64_t data_size) noexcept
+{
+    if (chunk_messages_ == 0)
+    {
+        chunk_start_ = log_time;
+        chunk_end_ = log_time;
+    }
+    else
+    {
+        chunk_start_ = std::min(chunk_start_, log_time);
+        chunk_end_ = std::max(chunk_end_, log_time);
+    }
+
+    chunk_size_ += MESSAGE_RECORD_OVERHEAD + data_size;
+    chunk_messages_++;
+
+    // NOTE: Messages may not arrive in log time order (e.g. when logging the publish time), so only forward
+    // intervals update the average.
+    if (last_log_time_ != 0 && log_time >= last_log_time_)
+    {
+        const auto interval = static_cast<double>(log_time - last_log_time_);
+
+        if (recent_interval_ == 0)
+        {
+            recent_interval_ = interval;
+        }
+        else
+        {
+            recent_interval_ += (interval - recent_interval_) * RECENT_INTERVAL_WEIGHT;
+        }
+    }
+
+    last_log_time_ = std::max(last_log_time_, log_time);
+}
+
+bool McapChunkPolicy::should_close(
+        ChunkCloseReason& reason) const noexcept
+{
+    if (configuration_.kind != McapChunkingKind::adaptive || chunk_messages_ == 0)
+    {
+        // The MCAP library closes the fixed-size chunks by itself
+        return false;
+    }
+
+    if (chunk_size_ >= configuration_.max_size)
+    {
+        reason = ChunkCloseReason::size;
+        return true;
+    }
+
+    if (chunk_size_ < configuration_.min_size)
+    {
+        return false;
+    }
+
+    if (current_duration() >= configuration_.target_duration * 1000000)
+    {
+        reason = ChunkCloseReason::duration;
+        return true;
+    }
+
+    const auto factor = configuration_.rate_change_factor;
+
+    if (factor > 1 && chunk_messages_ >= RATE_CHANGE_MIN_MESSAGES && reference_interval_ > 0 &&
+            recent_interval_ > 0)
+    {
+        if (recent_interval_ * factor < reference_interval_ || recent_interval_ > reference_interval_ * factor)
+        {
+            reason = ChunkCloseReason::rate_change;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void McapChunkPolicy::chunk_closed(
+        const ChunkCloseReason reason,
+        const std::uint64_t written_size) noexcept
+{
+    if (statistics_.chunks == 0)
+    {
+        statistics_.min_uncompressed_size = chunk_size_;
+        statistics_.max_uncompressed_size = chunk_size_;
+    }
+    else
+    {
+        statistics_.min_uncompressed_size = std::min(statistics_.min_uncompressed_size, chunk_size_);
+        statistics_.max_uncompressed_size = std::max(statistics_.max_uncompressed_size, chunk_size_);
+    }
+
+    statistics_.chunks++;
+    statistics_.chunks_per_reason[static_cast<std::size_t>(reason)]++;
+    statistics_.messages += chunk_messages_;
+    statistics_.uncompressed_size += chunk_size_;
+    statistics_.written_size += written_size;
+    statistics_.duration += current_duration();
+
+    // The next chunk is compared against the rate the messages arrived at by the end of this one
+    reference_interval_ = recent_interval_;
+
+    chunk_size_ = 0;
+    chunk_messages_ = 0;
+    chunk_start_ = 0;
+    chunk_end_ = 0;
+}
+
+bool McapChunkPolicy::empty() const noexcept
+{
+    return chunk_messages_ == 0;
+}
+
+std::uint64_t McapChunkPolicy::current_size() const noexcept
+{
+    return chunk_size_;
+}
+
+std::uint64_t McapChunkPolicy::current_duration() const noexcept
+{
+    return chunk_end_ - chunk_start_;
+}
+
+const McapChunkStatistics& McapChunkPolicy::statistics() const noexcept
+{
+    return statistics_;
+}
+
+void McapChunkPolicy::reset_statistics() noexcept
+{
+    statistics_ = McapChunkStatistics();
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
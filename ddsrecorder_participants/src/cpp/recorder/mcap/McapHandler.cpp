@@ -17,13 +17,18 @@
  */
 
 #define MCAP_IMPLEMENTATION  // Define this in exactly one .cpp file
+#define MCAP_CRC32_UPDATE ::eprosima::ddsrecorder::participants::Crc32::update  // Hardware-accelerated when available
 
 #include <algorithm>
 #include <cstdio>
 #include <filesystem>
 #include <memory>
+#include <sstream>
 #include <vector>
 
+// Must be declared before the MCAP implementation uses MCAP_CRC32_UPDATE
+#include <ddsrecorder_participants/common/mcap/Crc32.hpp>
+
 #include <mcap/reader.hpp>
 
 #include <yaml-cpp/yaml.h>
@@ -46,11 +51,14 @@
 
 #include <ddspipe_core/types/dynamic_types/schema.hpp>
 
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollectionPubSubTypes.hpp>
 #include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/logging/LogRateLimiter.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapHandler.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapMessage.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
 
 namespace eprosima {
 namespace ddsrecorder {
@@ -67,7 +75,10 @@ McapHandler::McapHandler(
     : configuration_(config)
     , payload_pool_(payload_pool)
     , state_(McapHandlerStateCode::STOPPED)
-    , mcap_writer_(config.output_settings, config.mcap_writer_options, file_tracker, config.record_types)
+    , mcap_writer_(config.output_settings, config.mcap_writer_options, file_tracker, config.record_types,
+            config.record_statistics, config.lazy_channels, config.types_sidecar, config.chunking,
+            config.blobs)
+    , log_time_clock_(config.log_time_clock)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_STATE | Creating MCAP handler instance.");
@@ -77,6 +88,18 @@ McapHandler::McapHandler(
         mcap_writer_.set_on_disk_full_callback(on_disk_full_lambda);
     }
 
+    for (const auto& lane_configuration : configuration_.ingestion_lanes)
+    {
+        lane_buffers_.push_back(std::make_unique<LaneBuffer>());
+
+        lanes_.push_back(std::make_unique<IngestionLane>(
+                    lane_configuration,
+                    [this, buffer = lane_buffers_.back().get()](std::vector<IngestionSample>& samples)
+                    {
+                        return add_lane_samples_(*buffer, samples);
+                    }));
+    }
+
     switch (init_state)
     {
         case McapHandlerStateCode::RUNNING:
@@ -99,6 +122,7 @@ McapHandler::~McapHandler()
 
     // Stop handler prior to destruction
     stop(true);
+    wait_for_finalization();
 }
 
 void McapHandler::add_schema(
@@ -107,6 +131,8 @@ void McapHandler::add_schema(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
+    add_lane_samples_nts_();
+
     // NOTE: Process schemas even if in STOPPED state to avoid losing them (only sent/received once in discovery)
 
     assert(nullptr != dynamic_type);
@@ -193,108 +219,51 @@ void McapHandler::add_data(
         const DdsTopic& topic,
         RtpsPayloadData& data)
 {
-    std::unique_lock<std::mutex> lock(mtx_);
+    auto& metrics = RecorderMetrics::get_instance();
+    metrics.message_received();
 
-    if (state_ == McapHandlerStateCode::STOPPED)
-    {
-        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
-                "FAIL_MCAP_WRITE | Attempting to add sample through a stopped handler, dropping...");
-        return;
-    }
+    // Timestamp the sample before waiting for the lock, so the logTime reflects its reception
+    const mcap::Timestamp reception_time = configuration_.log_publishTime ? 0 : log_time_clock_.now();
 
-    EPROSIMA_LOG_INFO(
-        DDSRECORDER_MCAP_HANDLER,
-        "MCAP_WRITE | Adding data in topic " << topic);
-
-    // Add data to channel
-    McapMessage msg;
-    msg.sequence = unique_sequence_number_++;
-    msg.publishTime = fastdds_timestamp_to_mcap_timestamp(data.source_timestamp);
-    if (configuration_.log_publishTime)
+    if (!lanes_.empty())
     {
-        msg.logTime = msg.publishTime;
-    }
-    else
-    {
-        msg.logTime = now();
-    }
-    msg.dataSize = data.payload.length;
+        std::shared_ptr<const DdsTopic> lane_topic;
+        IngestionLane* lane = get_lane_(topic, lane_topic);
 
-    if (data.payload.length > 0)
-    {
-        if (data.payload_owner != nullptr)
-        {
-            payload_pool_->get_payload(
-                data.payload,
-                msg.payload);
-
-            msg.payload_owner = payload_pool_.get();
-            msg.data = reinterpret_cast<std::byte*>(msg.payload.data);
-        }
-        else
+        if (lane != nullptr)
         {
-            throw utils::InconsistencyException(
-                      STR_ENTRY << "Payload owner not found in data received."
-                      );
-        }
-    }
-    else
-    {
-        throw utils::InconsistencyException(
-                  STR_ENTRY << "Received sample with no payload."
-                  );
-    }
+            IngestionSample sample;
+            sample.topic = std::move(lane_topic);
+            fill_message_(topic, data, reception_time, sample.message);
 
-    if (received_types_.count(topic.type_name) != 0)
-    {
-        // Schema available -> add to buffer
-        add_data_nts_(msg, topic);
-    }
-    else
-    {
-        if (state_ == McapHandlerStateCode::RUNNING)
-        {
-            if (configuration_.max_pending_samples == 0)
+            if (!lane->push(std::move(sample)))
             {
-                if (configuration_.only_with_schema)
-                {
-                    // No schema available + no pending samples + only_with_schema -> Discard message
-                    return;
-                }
-                else
-                {
-                    // No schema available + no pending samples -> Add to buffer with blank schema
-                    add_data_nts_(msg, topic);
-                }
+                DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
+                        "MCAP_WRITE | Ingestion lane " << lane->name() << " full, dropping sample in topic " <<
+                        topic << ".");
+                metrics.message_dropped();
             }
-            else
-            {
-                EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
-                        "MCAP_WRITE | Schema for topic " << topic << " not yet available. "
-                        "Inserting to pending samples queue.");
-
-                add_to_pending_nts_(msg, topic);
-            }
-        }
-        else if (state_ == McapHandlerStateCode::PAUSED)
-        {
-            EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
-                    "MCAP_WRITE | Schema for topic " << topic << " not yet available. "
-                    "Inserting to (paused) pending samples queue.");
 
-            pending_samples_paused_[topic.type_name].push_back({topic, msg});
-        }
-        else
-        {
-            // Should not happen, protected with mutex and state verified at beginning
-            utils::tsnh(
-                utils::Formatter() << "Trying to add sample from a stopped instance.");
+            return;
         }
     }
+
+    McapMessage msg;
+    fill_message_(topic, data, reception_time, msg);
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    add_lane_samples_nts_();
+    add_message_nts_(topic, msg);
+
+    enforce_memory_budget_nts_();
 }
 
 void McapHandler::start()
 {
+    // Wait for the output file of the last stop to be closed before opening a new one
+    wait_for_finalization();
+
     // Wait for completion of event routine in case event was triggered
     std::unique_lock<std::mutex> event_lock(event_cv_mutex_);
     event_cv_.wait(
@@ -307,6 +276,9 @@ void McapHandler::start()
     // Protect access to state and data structures (cleared in stop_event_thread_nts)
     std::lock_guard<std::mutex> lock(mtx_);
 
+    // The samples handed over by the lanes were received in the previous state
+    add_lane_samples_nts_();
+
     // Store previous state to act differently depending on its value
     McapHandlerStateCode prev_state = state_;
     state_ = McapHandlerStateCode::RUNNING;
@@ -330,12 +302,21 @@ void McapHandler::start()
             // Stop event routine (cleans buffers)
             stop_event_thread_nts_(event_lock);
         }
+
+        log_memory_usage_nts_();
     }
 }
 
 void McapHandler::stop(
-        bool on_destruction /* false */)
+        bool on_destruction /* false */,
+        const std::function<void()>& on_finalized /* nullptr */)
 {
+    // Add the samples waiting in the ingestion lanes, so they are written in the file being closed
+    flush_lanes_();
+
+    // Only one output file is finalized at a time
+    wait_for_finalization();
+
     // Wait for completion of event routine in case event was triggered
     std::unique_lock<std::mutex> event_lock(event_cv_mutex_);
     event_cv_.wait(
@@ -348,6 +329,9 @@ void McapHandler::stop(
     // Protect access to state and data structures
     std::lock_guard<std::mutex> lock(mtx_);
 
+    // The samples handed over by the lanes were received in the previous state
+    add_lane_samples_nts_();
+
     // Store previous state to act differently depending on its value
     McapHandlerStateCode prev_state = state_;
     state_ = McapHandlerStateCode::STOPPED;
@@ -379,29 +363,57 @@ void McapHandler::stop(
     else
     {
         // Free memory resources
-        pending_samples_.clear();
+        for (const auto& pending_type : pending_samples_)
+        {
+            RecorderMetrics::get_instance().message_dropped(pending_type.second.size());
+        }
+
+        clear_pending_nts_(pending_samples_);
+        update_pending_samples_metric_nts_();
     }
-    dump_data_nts_();  // if prev_state == RUNNING -> writes buffer + added pending samples (if !only_with_schema)
-                       // if prev_state == PAUSED  -> writes added pending samples (if !only_with_schema)
+
+    // Hand the samples to write over to the finalization thread:
+    // if prev_state == RUNNING -> buffer + added pending samples (if !only_with_schema)
+    // if prev_state == PAUSED  -> added pending samples (if !only_with_schema)
+    std::list<McapMessage> samples;
+    samples.swap(samples_buffer_);
+    buffered_bytes_ = 0;
+    update_buffer_metrics_nts_();
 
     // Ideally, the channels and schemas should be shared between the McapHandler and McapWriter.
     // Right now, the data is duplicated in both classes, which uses more memory and can lead to inconsistencies.
     // TODO: Share the channels and schemas between the McapHandler and McapWriter.
 
-    // NOTE: disabling the McapWriter clears its channels
-    mcap_writer_.disable();
-
     // Clear the channels after a stop so the old channels are not rewritten in every new file
     channels_.clear();
+
+    log_memory_usage_nts_();
+
+    // Write the samples and close the file in the background, so the state transition is not delayed by the disk
+    finalization_thread_ = std::thread(&McapHandler::finalization_routine_, this, std::move(samples), on_finalized);
+}
+
+void McapHandler::wait_for_finalization()
+{
+    if (finalization_thread_.joinable())
+    {
+        finalization_thread_.join();
+    }
 }
 
 void McapHandler::pause()
 {
+    // Wait for the output file of the last stop to be closed before opening a new one
+    wait_for_finalization();
+
     // Protect access to state and data structures
     std::lock_guard<std::mutex> lock(mtx_);
 
     // NOTE: no need to take event mutex as event thread does not exist at this point
 
+    // The samples handed over by the lanes were received in the previous state
+    add_lane_samples_nts_();
+
     // Store previous state to act differently depending on its value
     McapHandlerStateCode prev_state = state_;
     state_ = McapHandlerStateCode::PAUSED;
@@ -427,11 +439,14 @@ void McapHandler::pause()
             // Clear buffer
             // NOTE: not really needed, dump_data_nts_ already writes and pops all samples
             samples_buffer_.clear();
+            buffered_bytes_ = 0;
         }
 
         // Launch event thread routine
         event_flag_ = EventCode::untriggered;  // No need to take event mutex (protected by mtx_)
         event_thread_ = std::thread(&McapHandler::event_thread_routine_, this);
+
+        log_memory_usage_nts_();
     }
 }
 
@@ -449,6 +464,9 @@ void McapHandler::trigger_event()
     // Protect access to state
     std::lock_guard<std::mutex> lock(mtx_);
 
+    // The samples handed over by the lanes before the event are part of it
+    add_lane_samples_nts_();
+
     if (state_ != McapHandlerStateCode::PAUSED)
     {
         EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_HANDLER,
@@ -497,9 +515,19 @@ void McapHandler::add_data_nts_(
     else
     {
         samples_buffer_.push_back(msg);
+        buffered_bytes_ += msg.dataSize;
+        update_buffer_metrics_nts_();
 
-        if (state_ == McapHandlerStateCode::RUNNING && samples_buffer_.size() == configuration_.buffer_size)
+        if (state_ == McapHandlerStateCode::RUNNING && samples_buffer_.size() >= configuration_.buffer_size)
         {
+            if (mcap_writer_.congested())
+            {
+                // Keep the samples until the output takes data again, shedding them as per the memory budget
+                DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
+                        "MCAP_WRITE | Output congested, holding " << samples_buffer_.size() << " samples in memory.");
+                return;
+            }
+
             EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
                     "MCAP_WRITE | Full buffer, writing to disk...");
             dump_data_nts_();
@@ -514,12 +542,12 @@ void McapHandler::add_data_nts_(
 {
     try
     {
-        auto channel_id = get_channel_id_nts_(topic);
+        auto channel_id = get_channel_id_nts_(topic, msg.domain);
         msg.channelId = channel_id;
     }
     catch (const utils::InconsistencyException& e)
     {
-        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_HANDLER,
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
                 "MCAP_WRITE | Error adding message in topic " << topic << ". Error message:\n " << e.what());
         return;
     }
@@ -533,31 +561,35 @@ void McapHandler::add_to_pending_nts_(
 {
     assert(configuration_.max_pending_samples != 0);
 
+    auto& pending_samples = pending_samples_[topic.type_name];
+
     if (configuration_.max_pending_samples > 0 &&
-            pending_samples_[topic.type_name].size() == static_cast<unsigned int>(configuration_.max_pending_samples))
+            pending_samples.size() == static_cast<unsigned int>(configuration_.max_pending_samples))
     {
         if (configuration_.only_with_schema)
         {
             // Discard oldest message in pending samples
-            EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_HANDLER,
+            DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
                     "MCAP_WRITE | Dropping pending sample in type " << topic.type_name << ": buffer limit (" <<
                     configuration_.max_pending_samples << ") reached.");
+            RecorderMetrics::get_instance().message_dropped();
         }
         else
         {
-            EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
+            DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_HANDLER,
                     "MCAP_WRITE | Buffer limit (" << configuration_.max_pending_samples <<  ") reached for type " <<
                     topic.type_name << ": writing oldest sample without schema.");
 
             // Write oldest message without schema
-            auto& oldest_sample = pending_samples_[topic.type_name].front();
-            add_data_nts_(oldest_sample.second, oldest_sample.first);
+            auto& oldest_sample = pending_samples.front();
+            add_data_nts_(oldest_sample.msg, oldest_sample.topic);
         }
 
-        pending_samples_[topic.type_name].pop_front();
+        pop_pending_nts_(pending_samples);
     }
 
-    pending_samples_[topic.type_name].push_back({topic, msg});
+    push_pending_nts_(pending_samples, topic, msg, true);
+    update_pending_samples_metric_nts_();
 }
 
 void McapHandler::add_pending_samples_nts_(
@@ -580,6 +612,8 @@ void McapHandler::add_pending_samples_nts_(
         add_pending_samples_nts_(pending_samples_paused_[schema_name]);
         pending_samples_paused_.erase(schema_name);
     }
+
+    update_pending_samples_metric_nts_();
 }
 
 void McapHandler::add_pending_samples_nts_(
@@ -590,9 +624,9 @@ void McapHandler::add_pending_samples_nts_(
     {
         // Move samples from pending list to buffer, or write them directly to MCAP file
         auto& sample = pending_samples.front();
-        add_data_nts_(sample.second, sample.first, direct_write);
+        add_data_nts_(sample.msg, sample.topic, direct_write);
 
-        pending_samples.pop_front();
+        pop_pending_nts_(pending_samples);
     }
 }
 
@@ -610,6 +644,8 @@ void McapHandler::add_pending_samples_nts_()
 
 void McapHandler::event_thread_routine_()
 {
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::event, "ddsrec.event");
+
     bool keep_going = true;
     while (keep_going)
     {
@@ -653,6 +689,8 @@ void McapHandler::event_thread_routine_()
 
             // NOTE: event mutex not released until routine completed to avoid other commands (start/stop/trigger) to interfere.
 
+            add_lane_samples_nts_();
+
             // Delete outdated samples if timeout, and also before dumping (event triggered case)
             remove_outdated_samples_nts_();
 
@@ -685,16 +723,18 @@ void McapHandler::event_thread_routine_()
                                 else
                                 {
                                     // Add to buffer with blank schema
-                                    add_data_nts_(sample.second, sample.first);
+                                    add_data_nts_(sample.msg, sample.topic);
                                 }
                             }
                             else
                             {
-                                add_to_pending_nts_(sample.second, sample.first);
+                                add_to_pending_nts_(sample.msg, sample.topic);
                             }
-                            pending_list.pop_front();
+                            pop_pending_nts_(pending_list);
                         }
                     }
+
+                    update_pending_samples_metric_nts_();
                 }
                 dump_data_nts_();
             }
@@ -714,19 +754,43 @@ void McapHandler::remove_outdated_samples_nts_()
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_STATE | Removing outdated samples.");
 
-    auto threshold = std_timepoint_to_mcap_timestamp(utils::now() - std::chrono::seconds(configuration_.event_window));
+    auto& metrics = RecorderMetrics::get_instance();
+
+    const auto event_window = std::chrono::nanoseconds(std::chrono::seconds(configuration_.event_window)).count();
+    const auto now = log_time_clock_.now();
+    auto threshold = now > static_cast<mcap::Timestamp>(event_window) ? now - event_window : 0;
     samples_buffer_.remove_if([&](auto& sample)
             {
-                return sample.logTime < threshold;
+                if (sample.logTime < threshold)
+                {
+                    metrics.message_dropped();
+                    buffered_bytes_ -= sample.dataSize;
+                    return true;
+                }
+
+                return false;
             });
 
     for (auto& pending_type : pending_samples_paused_)
     {
-        pending_type.second.remove_if([&](auto& sample)
-                {
-                    return sample.second.logTime < threshold;
-                });
+        auto& pending_samples = pending_type.second;
+
+        for (auto it = pending_samples.begin(); it != pending_samples.end();)
+        {
+            if (it->msg.logTime < threshold)
+            {
+                metrics.message_dropped();
+                it = erase_pending_nts_(pending_samples, it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
     }
+
+    update_buffer_metrics_nts_();
+    update_pending_samples_metric_nts_();
 }
 
 void McapHandler::stop_event_thread_nts_(
@@ -749,7 +813,11 @@ void McapHandler::stop_event_thread_nts_(
     }
 
     samples_buffer_.clear();
-    pending_samples_paused_.clear();
+    buffered_bytes_ = 0;
+    clear_pending_nts_(pending_samples_paused_);
+
+    update_buffer_metrics_nts_();
+    update_pending_samples_metric_nts_();
 }
 
 void McapHandler::dump_data_nts_()
@@ -757,20 +825,509 @@ void McapHandler::dump_data_nts_()
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_WRITE | Writing data stored in buffer.");
 
-    while (!samples_buffer_.empty())
+    if (samples_buffer_.empty())
+    {
+        return;
+    }
+
+    write_samples_(samples_buffer_);
+
+    buffered_bytes_ = 0;
+    update_buffer_metrics_nts_();
+}
+
+void McapHandler::write_samples_(
+        std::list<McapMessage>& samples)
+{
+    const auto dump_start = std::chrono::steady_clock::now();
+
+    while (!samples.empty())
     {
-        auto& sample = samples_buffer_.front();
+        auto& sample = samples.front();
 
         // Write to MCAP file
         mcap_writer_.write(sample);
 
         // Pop written sample
+        samples.pop_front();
+    }
+
+    RecorderMetrics::get_instance().buffer_dumped(std::chrono::steady_clock::now() - dump_start);
+}
+
+void McapHandler::finalization_routine_(
+        std::list<McapMessage> samples,
+        std::function<void()> on_finalized)
+{
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::event, "ddsrec.finalize");
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
+            "MCAP_STATE | Finalizing output file.");
+
+    if (!samples.empty())
+    {
+        write_samples_(samples);
+    }
+
+    // NOTE: disabling the McapWriter clears its channels
+    mcap_writer_.disable();
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
+            "MCAP_STATE | Output file finalized.");
+
+    if (on_finalized != nullptr)
+    {
+        on_finalized();
+    }
+}
+
+void McapHandler::update_buffer_metrics_nts_() const
+{
+    auto& metrics = RecorderMetrics::get_instance();
+
+    metrics.set_buffered_samples(samples_buffer_.size());
+    metrics.set_memory_usage(MemorySubsystem::samples_buffer, samples_buffer_.size() * BUFFER_ENTRY_SIZE);
+    metrics.set_memory_usage(MemorySubsystem::payloads, buffered_bytes_ + pending_bytes_);
+}
+
+void McapHandler::push_pending_nts_(
+        pending_list& pending_samples,
+        const DdsTopic& topic,
+        const McapMessage& msg,
+        const bool received_running)
+{
+    const auto age = pending_by_age_.insert(pending_by_age_.end(), {&pending_samples, received_running});
+    pending_samples.push_back({topic, msg, age});
+
+    pending_bytes_ += msg.dataSize;
+    pending_count_++;
+}
+
+void McapHandler::pop_pending_nts_(
+        pending_list& pending_samples)
+{
+    erase_pending_nts_(pending_samples, pending_samples.begin());
+}
+
+McapHandler::pending_list::iterator McapHandler::erase_pending_nts_(
+        pending_list& pending_samples,
+        pending_list::iterator it)
+{
+    pending_by_age_.erase(it->age);
+
+    pending_bytes_ -= it->msg.dataSize;
+    pending_count_--;
+
+    return pending_samples.erase(it);
+}
+
+void McapHandler::clear_pending_nts_(
+        std::map<std::string, pending_list>& pending_samples)
+{
+    for (auto& pending_type : pending_samples)
+    {
+        while (!pending_type.second.empty())
+        {
+            pop_pending_nts_(pending_type.second);
+        }
+    }
+
+    pending_samples.clear();
+}
+
+void McapHandler::update_pending_samples_metric_nts_() const
+{
+    auto& metrics = RecorderMetrics::get_instance();
+
+    metrics.set_pending_samples(pending_count_);
+    metrics.set_memory_usage(MemorySubsystem::pending_samples, pending_count_ * PENDING_ENTRY_SIZE);
+    metrics.set_memory_usage(MemorySubsystem::payloads, buffered_bytes_ + pending_bytes_);
+}
+
+void McapHandler::enforce_memory_budget_nts_()
+{
+    if (configuration_.memory_budget == 0 || buffered_bytes_ + pending_bytes_ <= configuration_.memory_budget)
+    {
+        return;
+    }
+
+    if (state_ == McapHandlerStateCode::RUNNING && !samples_buffer_.empty() && !mcap_writer_.congested())
+    {
+        // Flush early: the buffered samples are to be written anyway, and writing them releases their payloads
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
+                "MCAP_WRITE | Memory budget (" << utils::from_bytes(configuration_.memory_budget) <<
+                ") exceeded: writing buffered samples to disk early.");
+
+        dump_data_nts_();
+    }
+
+    std::uint64_t samples_dropped = 0;
+
+    // Shed the oldest samples kept in memory until the budget is met.
+    // NOTE: the samples buffer is only non-empty at this point when PAUSED, where the oldest samples would be removed
+    // by the event thread anyway, or when the output is congested.
+    while (buffered_bytes_ + pending_bytes_ > configuration_.memory_budget && !samples_buffer_.empty())
+    {
+        buffered_bytes_ -= samples_buffer_.front().dataSize;
         samples_buffer_.pop_front();
+        samples_dropped++;
+    }
+
+    // Writing the oldest pending samples without schema only releases memory if they go straight to the output
+    const bool write_pending = !configuration_.only_with_schema && state_ == McapHandlerStateCode::RUNNING &&
+            !mcap_writer_.congested();
+
+    while (buffered_bytes_ + pending_bytes_ > configuration_.memory_budget && !pending_by_age_.empty())
+    {
+        // The oldest pending sample is the first of its pending list
+        const auto oldest = pending_by_age_.front();
+        auto& oldest_sample = oldest.list->front();
+
+        if (oldest.received_running && write_pending)
+        {
+            // Write the oldest sample without schema, as when the pending samples limit is reached
+            add_data_nts_(oldest_sample.msg, oldest_sample.topic, true);
+        }
+        else
+        {
+            samples_dropped++;
+        }
+
+        pop_pending_nts_(*oldest.list);
     }
+
+    if (samples_dropped > 0)
+    {
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
+                "MCAP_WRITE | Memory budget (" << utils::from_bytes(configuration_.memory_budget) <<
+                ") exceeded: dropping " << samples_dropped << " samples.");
+
+        RecorderMetrics::get_instance().message_dropped(samples_dropped);
+    }
+
+    update_buffer_metrics_nts_();
+    update_pending_samples_metric_nts_();
 }
 
-mcap::ChannelId McapHandler::create_channel_id_nts_(
+void McapHandler::log_memory_usage_nts_() const
+{
+    const auto snapshot = RecorderMetrics::get_instance().snapshot();
+
+    std::stringstream memory_usage;
+
+    for (std::size_t i = 0; i < MEMORY_SUBSYSTEMS; i++)
+    {
+        memory_usage << (i == 0 ? "" : ", ") << to_string(static_cast<MemorySubsystem>(i)) << ": " <<
+            utils::from_bytes(snapshot.memory_usage[i]);
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
+            "MCAP_STATE | Memory usage: " << memory_usage.str() << ".");
+}
+
+bool McapHandler::is_low_priority_nts_(
         const DdsTopic& topic)
+{
+    const auto it = low_priority_topics_.find(topic.m_topic_name);
+
+    if (it != low_priority_topics_.end())
+    {
+        return it->second;
+    }
+
+    const auto& patterns = configuration_.output_settings.disk_full_forecast.drop_topics;
+
+    const bool low_priority = std::any_of(patterns.begin(), patterns.end(), [&](const std::string& pattern)
+                    {
+                        return utils::match_pattern(pattern, topic.m_topic_name);
+                    });
+
+    low_priority_topics_[topic.m_topic_name] = low_priority;
+
+    return low_priority;
+}
+
+void McapHandler::fill_message_(
+        const DdsTopic& topic,
+        RtpsPayloadData& data,
+        const mcap::Timestamp reception_time,
+        McapMessage& msg)
+{
+    msg.publishTime = fastdds_timestamp_to_mcap_timestamp(data.source_timestamp);
+    if (configuration_.log_publishTime)
+    {
+        msg.logTime = msg.publishTime;
+    }
+    else
+    {
+        msg.logTime = reception_time;
+    }
+    msg.dataSize = data.payload.length;
+
+    if (!configuration_.participant_domains.empty())
+    {
+        const auto domain_it = configuration_.participant_domains.find(data.participant_receiver);
+
+        if (domain_it != configuration_.participant_domains.end())
+        {
+            msg.domain = domain_it->second;
+        }
+    }
+
+    if (configuration_.keyframes && topic.topic_qos.is_transient_local())
+    {
+        // The writer keeps the last message of every instance to write it again at the start of every new file
+        msg.keyframe = true;
+
+        if (topic.topic_qos.keyed)
+        {
+            msg.instance_handle = data.instanceHandle;
+        }
+    }
+
+    if (data.payload.length > 0)
+    {
+        if (data.payload_owner != nullptr)
+        {
+            payload_pool_->get_payload(
+                data.payload,
+                msg.payload);
+
+            msg.payload_owner = payload_pool_.get();
+            msg.data = reinterpret_cast<std::byte*>(msg.payload.data);
+        }
+        else
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "Payload owner not found in data received."
+                      );
+        }
+    }
+    else
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "Received sample with no payload."
+                  );
+    }
+}
+
+void McapHandler::add_message_nts_(
+        const DdsTopic& topic,
+        McapMessage& msg)
+{
+    auto& metrics = RecorderMetrics::get_instance();
+
+    if (state_ == McapHandlerStateCode::STOPPED)
+    {
+        DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_HANDLER,
+                "FAIL_MCAP_WRITE | Attempting to add sample through a stopped handler, dropping...");
+        metrics.message_dropped();
+        return;
+    }
+
+    if (mcap_writer_.dropping_low_priority() && is_low_priority_nts_(topic))
+    {
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_HANDLER,
+                "MCAP_WRITE | Output forecast to be full soon, dropping sample in low priority topic " << topic << ".");
+        metrics.message_dropped();
+        return;
+    }
+
+    DDSRECORDER_LOG_INFO_HOT_PATH(
+        DDSRECORDER_MCAP_HANDLER,
+        "MCAP_WRITE | Adding data in topic " << topic);
+
+    // Add data to channel
+    msg.sequence = unique_sequence_number_++;
+
+    if (received_types_.count(topic.type_name) != 0)
+    {
+        // Schema available -> add to buffer
+        add_data_nts_(msg, topic);
+    }
+    else
+    {
+        if (state_ == McapHandlerStateCode::RUNNING)
+        {
+            if (configuration_.max_pending_samples == 0)
+            {
+                if (configuration_.only_with_schema)
+                {
+                    // No schema available + no pending samples + only_with_schema -> Discard message
+                    metrics.message_dropped();
+                    return;
+                }
+                else
+                {
+                    // No schema available + no pending samples -> Add to buffer with blank schema
+                    add_data_nts_(msg, topic);
+                }
+            }
+            else
+            {
+                DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_HANDLER,
+                        "MCAP_WRITE | Schema for topic " << topic << " not yet available. "
+                        "Inserting to pending samples queue.");
+
+                add_to_pending_nts_(msg, topic);
+            }
+        }
+        else if (state_ == McapHandlerStateCode::PAUSED)
+        {
+            DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_HANDLER,
+                    "MCAP_WRITE | Schema for topic " << topic << " not yet available. "
+                    "Inserting to (paused) pending samples queue.");
+
+            push_pending_nts_(pending_samples_paused_[topic.type_name], topic, msg, false);
+            update_pending_samples_metric_nts_();
+        }
+        else
+        {
+            // Should not happen, protected with mutex and state verified at beginning
+            utils::tsnh(
+                utils::Formatter() << "Trying to add sample from a stopped instance.");
+        }
+    }
+}
+
+bool McapHandler::add_lane_samples_(
+        LaneBuffer& buffer,
+        std::vector<IngestionSample>& samples)
+{
+    const auto handed_over = samples.size();
+
+    if (handed_over == 0 && lane_buffered_samples_.load() == 0)
+    {
+        // Retry of a previous handover, already added by another thread
+        return true;
+    }
+
+    if (handed_over > 0)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer.mtx);
+
+        if (buffer.samples.empty())
+        {
+            // Swap the vectors, so neither the samples nor the storage of the batch are copied
+            buffer.samples.swap(samples);
+        }
+        else
+        {
+            buffer.samples.insert(
+                buffer.samples.end(),
+                std::make_move_iterator(samples.begin()),
+                std::make_move_iterator(samples.end()));
+        }
+    }
+
+    const auto buffered = lane_buffered_samples_.fetch_add(handed_over) + handed_over;
+
+    std::unique_lock<std::mutex> lock(mtx_, std::defer_lock);
+
+    if (buffered >= MAX_LANE_BUFFERED_SAMPLES)
+    {
+        // Too many samples waiting: hold the lane back until they are added
+        lock.lock();
+    }
+    else if (!lock.try_lock())
+    {
+        // The next thread taking the lock adds the samples, unless the lane retries first
+        return false;
+    }
+
+    add_lane_samples_nts_();
+
+    enforce_memory_budget_nts_();
+
+    return true;
+}
+
+void McapHandler::add_lane_samples_nts_()
+{
+    if (lane_buffered_samples_.load() == 0)
+    {
+        return;
+    }
+
+    std::vector<IngestionSample> samples;
+
+    for (auto& buffer : lane_buffers_)
+    {
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mtx);
+            samples.swap(buffer->samples);
+        }
+
+        lane_buffered_samples_ -= samples.size();
+
+        for (auto& sample : samples)
+        {
+            add_message_nts_(*sample.topic, sample.message);
+        }
+
+        samples.clear();
+    }
+}
+
+IngestionLane* McapHandler::get_lane_(
+        const DdsTopic& topic,
+        std::shared_ptr<const DdsTopic>& lane_topic)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(lane_routes_mtx_);
+
+        const auto it = lane_routes_.find(topic);
+
+        if (it != lane_routes_.end())
+        {
+            lane_topic = it->second.second;
+            return it->second.first;
+        }
+    }
+
+    // First sample of the topic: the first lane with a matching pattern takes it
+    IngestionLane* lane = nullptr;
+
+    for (std::size_t i = 0; i < lanes_.size() && lane == nullptr; ++i)
+    {
+        const auto& patterns = configuration_.ingestion_lanes[i].topics;
+
+        if (std::any_of(patterns.begin(), patterns.end(), [&](const std::string& pattern)
+                {
+                    return utils::match_pattern(pattern, topic.m_topic_name);
+                }))
+        {
+            lane = lanes_[i].get();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(lane_routes_mtx_);
+
+    const auto result = lane_routes_.emplace(topic, LaneRoute(lane, std::make_shared<const DdsTopic>(topic)));
+    const auto& route = result.first->second;
+
+    if (result.second && lane != nullptr)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
+                "MCAP_STATE | Adding the samples of topic " << topic << " through ingestion lane " << lane->name() <<
+                ".");
+    }
+
+    lane_topic = route.second;
+    return route.first;
+}
+
+void McapHandler::flush_lanes_()
+{
+    for (auto& lane : lanes_)
+    {
+        lane->flush();
+    }
+}
+
+mcap::ChannelId McapHandler::create_channel_id_nts_(
+        const DdsTopic& topic,
+        const DomainIdType domain)
 {
     // Find schema
     mcap::SchemaId schema_id;
@@ -808,29 +1365,37 @@ mcap::ChannelId McapHandler::create_channel_id_nts_(
             configuration_.ros2_types ? utils::demangle_if_ros_topic(topic.m_topic_name) : topic.m_topic_name;
     // Set ROS2_TYPES to "false" if the given topic_name is equal to topic.m_topic_name, otherwise set it to "true".
     metadata[ROS2_TYPES] = topic_name.compare(topic.m_topic_name) ? "true" : "false";
+
+    if (!configuration_.participant_domains.empty())
+    {
+        // The replayer tells apart the channels of a topic recorded in several domains by their domain
+        metadata[DOMAIN_ID_METADATA] = std::to_string(domain);
+    }
+
     mcap::Channel new_channel(topic_name, "cdr", schema_id, metadata);
 
     mcap_writer_.write(new_channel);
 
     auto channel_id = new_channel.id;
-    channels_.insert({topic, std::move(new_channel)});
+    channels_.insert({{topic, domain}, std::move(new_channel)});
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
-            "MCAP_WRITE | Channel created: " << topic << ".");
+            "MCAP_WRITE | Channel created: " << topic << " in domain " << domain << ".");
 
     return channel_id;
 }
 
 mcap::ChannelId McapHandler::get_channel_id_nts_(
-        const DdsTopic& topic)
+        const DdsTopic& topic,
+        const DomainIdType domain)
 {
-    auto it = channels_.find(topic);
+    auto it = channels_.find({topic, domain});
     if (it != channels_.end())
     {
         return it->second.id;
     }
 
     // If it does not exist yet, create it (call it with mutex taken)
-    return create_channel_id_nts_(topic);
+    return create_channel_id_nts_(topic, domain);
 }
 
 void McapHandler::update_channels_nts_(
@@ -842,9 +1407,9 @@ void McapHandler::update_channels_nts_(
         if (channel.second.schemaId == old_schema_id)
         {
             EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
-                    "MCAP_WRITE | Updating channel in topic " << channel.first.m_topic_name << ".");
+                    "MCAP_WRITE | Updating channel in topic " << channel.first.first.m_topic_name << ".");
 
-            assert(channel.first.m_topic_name == channel.second.topic);
+            assert(channel.first.first.m_topic_name == channel.second.topic);
             mcap::Channel new_channel(channel.second.topic, "cdr", new_schema_id, channel.second.metadata);
 
             mcap_writer_.write(new_channel);
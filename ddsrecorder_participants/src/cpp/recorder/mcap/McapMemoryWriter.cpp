@@ -0,0 +1,72 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapMemoryWriter.cpp
+ */
+
+#include <utility>
+
+#include <ddsrecorder_participants/recorder/mcap/McapMemoryWriter.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+void McapMemoryWriter::end()
+{
+    // Nothing to flush
+}
+
+uint64_t McapMemoryWriter::size() const
+{
+    return buffer_.size();
+}
+
+std::vector<std::byte> McapMemoryWriter::release() noexcept
+{
+    std::vector<std::byte> contents;
+    std::swap(contents, buffer_);
+    return contents;
+}
+
+void McapMemoryWriter::handleWrite(
+        const std::byte* data,
+        uint64_t size)
+{
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+void McapMemoryWriter::handleWrite(
+        const mcap::ConstBuffer* buffers,
+        size_t count)
+{
+    std::size_t size = buffer_.size();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size += buffers[i].size;
+    }
+
+    buffer_.reserve(size);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        buffer_.insert(buffer_.end(), buffers[i].data, buffers[i].data + buffers[i].size);
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
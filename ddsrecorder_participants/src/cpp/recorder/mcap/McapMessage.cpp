@@ -16,6 +16,8 @@
  * @file McapMessage.cpp
  */
 
+#include <utility>
+
 #include <fastdds/rtps/history/IPayloadPool.hpp>
 
 #include <ddsrecorder_participants/recorder/mcap/McapMessage.hpp>
@@ -28,6 +30,9 @@ namespace participants {
 McapMessage::McapMessage(
         const McapMessage& msg)
     : mcap::Message(msg)
+    , keyframe(msg.keyframe)
+    , instance_handle(msg.instance_handle)
+    , domain(msg.domain)
 {
     payload_owner = msg.payload_owner;
     payload_owner->get_payload(
@@ -35,6 +40,49 @@ McapMessage::McapMessage(
         this->payload);
 }
 
+McapMessage::McapMessage(
+        McapMessage&& msg) noexcept
+    : mcap::Message(msg)
+    , payload(std::move(msg.payload))
+    , payload_owner(msg.payload_owner)
+    , keyframe(msg.keyframe)
+    , instance_handle(msg.instance_handle)
+    , domain(msg.domain)
+{
+    // The payload now belongs to this message, so msg must not release it
+    msg.payload_owner = nullptr;
+    msg.data = nullptr;
+    msg.dataSize = 0;
+}
+
+McapMessage& McapMessage::operator =(
+        McapMessage&& msg) noexcept
+{
+    if (this == &msg)
+    {
+        return *this;
+    }
+
+    if (payload_owner && payload.length > 0)
+    {
+        payload_owner->release_payload(payload);
+    }
+
+    mcap::Message::operator =(msg);
+    payload = std::move(msg.payload);
+    payload_owner = msg.payload_owner;
+    keyframe = msg.keyframe;
+    instance_handle = msg.instance_handle;
+    domain = msg.domain;
+
+    // The payload now belongs to this message, so msg must not release it
+    msg.payload_owner = nullptr;
+    msg.data = nullptr;
+    msg.dataSize = 0;
+
+    return *this;
+}
+
 McapMessage::~McapMessage()
 {
     // If payload owner exists and payload has size, release it correctly in pool
@@ -0,0 +1,59 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapNullWriter.cpp
+ */
+
+#include <ddsrecorder_participants/recorder/mcap/McapNullWriter.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+void McapNullWriter::end()
+{
+    // Nothing to flush
+}
+
+uint64_t McapNullWriter::size() const
+{
+    return size_;
+}
+
+void McapNullWriter::reset() noexcept
+{
+    size_ = 0;
+}
+
+void McapNullWriter::handleWrite(
+        const std::byte* /* data */,
+        uint64_t size)
+{
+    size_ += size;
+}
+
+void McapNullWriter::handleWrite(
+        const mcap::ConstBuffer* buffers,
+        size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        size_ += buffers[i].size;
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -32,7 +32,9 @@ namespace eprosima {
 namespace ddsrecorder {
 namespace participants {
 
-McapSizeTracker::McapSizeTracker()
+McapSizeTracker::McapSizeTracker(
+        const bool lazy_channels /* = false */)
+    : lazy_channels_(lazy_channels)
 {
 }
 
@@ -121,6 +123,42 @@ void McapSizeTracker::message_written(
     check_and_increase_written_mcap_size_(get_message_size_(data_size));
 }
 
+void McapSizeTracker::first_message_to_write(
+        const uint64_t& data_size,
+        const mcap::Channel& channel,
+        const mcap::Schema* schema,
+        const mcap::Metadata* statistics /* = nullptr */)
+{
+    std::uint64_t size = get_message_size_(data_size) + get_channel_size_(channel);
+
+    if (schema != nullptr)
+    {
+        size += get_schema_size_(*schema);
+    }
+
+    if (statistics != nullptr)
+    {
+        size += get_metadata_size_(*statistics);
+    }
+
+    check_and_increase_potential_mcap_size_(size);
+}
+
+void McapSizeTracker::first_message_written(
+        const uint64_t& data_size,
+        const mcap::Channel& channel,
+        const mcap::Schema* schema)
+{
+    std::uint64_t size = get_message_size_(data_size) + get_channel_size_(channel);
+
+    if (schema != nullptr)
+    {
+        size += get_schema_size_(*schema);
+    }
+
+    check_and_increase_written_mcap_size_(size);
+}
+
 void McapSizeTracker::schema_to_write(
         const mcap::Schema& schema)
 {
@@ -180,6 +218,18 @@ void McapSizeTracker::attachment_written(
     check_and_increase_written_mcap_size_(get_attachment_size_(payload_size));
 }
 
+void McapSizeTracker::blob_to_write(
+        const uint64_t& data_size)
+{
+    check_and_increase_potential_mcap_size_(get_blob_size_(data_size));
+}
+
+void McapSizeTracker::blob_written(
+        const uint64_t& data_size)
+{
+    check_and_increase_written_mcap_size_(get_blob_size_(data_size));
+}
+
 void McapSizeTracker::metadata_to_write(
         const mcap::Metadata& metadata)
 {
@@ -187,6 +237,23 @@ void McapSizeTracker::metadata_to_write(
     check_and_increase_potential_mcap_size_(get_metadata_size_(metadata), INCREASE_MIN_MCAP_SIZE);
 }
 
+void McapSizeTracker::metadata_to_write(
+        const mcap::Metadata& metadata_to_write,
+        const mcap::Metadata& metadata_to_remove)
+{
+    const auto size_to_write = get_metadata_size_(metadata_to_write);
+    const auto size_to_remove = get_metadata_size_(metadata_to_remove);
+
+    if (size_to_write <= size_to_remove)
+    {
+        decrease_potential_mcap_size_(size_to_remove - size_to_write);
+    }
+    else
+    {
+        check_and_increase_potential_mcap_size_(size_to_write - size_to_remove);
+    }
+}
+
 void McapSizeTracker::metadata_written(
         const mcap::Metadata& metadata)
 {
@@ -340,7 +407,8 @@ std::uint64_t McapSizeTracker::get_message_size_(
 std::uint64_t McapSizeTracker::get_schema_size_(
         const mcap::Schema& schema)
 {
-    constexpr std::uint64_t NUMBER_OF_TIMES_COPIED = 2;
+    // NOTE: When written lazily, schemas are not repeated in the summary section.
+    const std::uint64_t NUMBER_OF_TIMES_COPIED = lazy_channels_ ? 1 : 2;
     constexpr std::uint64_t CONST_SCHEMA = 5;
 
     std::uint64_t size = MCAP_SCHEMA_OVERHEAD;
@@ -349,7 +417,10 @@ std::uint64_t McapSizeTracker::get_schema_size_(
     size += schema.data.size();
     size *= NUMBER_OF_TIMES_COPIED;
 
-    size -= CONST_SCHEMA;
+    if (!lazy_channels_)
+    {
+        size -= CONST_SCHEMA;
+    }
 
     return size;
 }
@@ -357,7 +428,8 @@ std::uint64_t McapSizeTracker::get_schema_size_(
 std::uint64_t McapSizeTracker::get_channel_size_(
         const mcap::Channel& channel)
 {
-    constexpr int NUMBER_OF_TIMES_COPIED = 2;
+    // NOTE: When written lazily, channels are not repeated in the summary section.
+    const std::uint64_t NUMBER_OF_TIMES_COPIED = lazy_channels_ ? 1 : 2;
 
     std::uint64_t size = MCAP_CHANNEL_OVERHEAD;
     size += channel.topic.size();
@@ -380,6 +452,18 @@ std::uint64_t McapSizeTracker::get_attachment_size_(
     return size;
 }
 
+std::uint64_t McapSizeTracker::get_blob_size_(
+        const uint64_t& data_size)
+{
+    constexpr std::uint64_t NUMBER_OF_TIMES_COPIED = 1;
+
+    std::uint64_t size = MCAP_BLOB_OVERHEAD;
+    size += data_size;
+    size *= NUMBER_OF_TIMES_COPIED;
+
+    return size;
+}
+
 std::uint64_t McapSizeTracker::get_metadata_size_(
         const mcap::Metadata& metadata)
 {
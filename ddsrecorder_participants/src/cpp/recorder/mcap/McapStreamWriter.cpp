@@ -0,0 +1,546 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapStreamWriter.cpp
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // ifndef _WIN32
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+#include <ddsrecorder_participants/recorder/logging/LogRateLimiter.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamWriter.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Human readable endpoint of the collector, as used in logs
+std::string endpoint(
+        const McapStreamConfiguration& configuration)
+{
+    switch (configuration.kind)
+    {
+        case McapStreamKind::tcp:
+            return configuration.address + ":" + std::to_string(configuration.port);
+
+        case McapStreamKind::unix_socket:
+            return configuration.path;
+
+        default:
+            return "standard output";
+    }
+}
+
+} // namespace
+
+McapStreamWriter::McapStreamWriter(
+        const McapStreamConfiguration& configuration)
+    : configuration_(configuration)
+{
+#ifdef _WIN32
+    throw utils::InitializationException(
+              STR_ENTRY << "Streaming the MCAP files is not supported on this platform.");
+#else
+    if (configuration_.kind == McapStreamKind::pipe)
+    {
+        // A closed pipe must be reported as a failed write instead of terminating the process
+        std::signal(SIGPIPE, SIG_IGN);
+
+        // Take the standard output over, so nothing else written to it corrupts the stream
+        std::cout.flush();
+        std::fflush(stdout);
+
+        pipe_fd_ = dup(STDOUT_FILENO);
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+
+    thread_ = std::thread(&McapStreamWriter::sender_routine_, this);
+#endif // ifdef _WIN32
+}
+
+McapStreamWriter::~McapStreamWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    cv_.notify_all();
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+void McapStreamWriter::open(
+        const std::string& filename)
+{
+    file_id_++;
+    size_ = 0;
+    unframed_.clear();
+
+    std::vector<std::byte> payload(filename.size());
+    std::memcpy(payload.data(), filename.data(), filename.size());
+
+    enqueue_(McapStreamFrame::Kind::open, 0, std::move(payload));
+}
+
+void McapStreamWriter::flush()
+{
+    if (unframed_.empty())
+    {
+        return;
+    }
+
+    const auto offset = size_ - unframed_.size();
+
+    std::vector<std::byte> payload;
+    payload.swap(unframed_);
+
+    enqueue_(McapStreamFrame::Kind::data, offset, std::move(payload));
+}
+
+void McapStreamWriter::end()
+{
+    flush();
+    enqueue_(McapStreamFrame::Kind::close, size_, {});
+}
+
+uint64_t McapStreamWriter::size() const
+{
+    return size_;
+}
+
+bool McapStreamWriter::congested() const noexcept
+{
+    return unsent_size_ > configuration_.max_unsent_size;
+}
+
+void McapStreamWriter::handleWrite(
+        const std::byte* data,
+        uint64_t size)
+{
+    unframed_.insert(unframed_.end(), data, data + size);
+    size_ += size;
+
+    if (unframed_.size() >= MAX_FRAME_LENGTH)
+    {
+        flush();
+    }
+}
+
+void McapStreamWriter::handleWrite(
+        const mcap::ConstBuffer* buffers,
+        size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        handleWrite(buffers[i].data, buffers[i].size);
+    }
+}
+
+void McapStreamWriter::enqueue_(
+        const McapStreamFrame::Kind kind,
+        const std::uint64_t offset,
+        std::vector<std::byte>&& payload)
+{
+    auto frame = std::make_shared<Frame>();
+    frame->kind = kind;
+    frame->file_id = file_id_;
+    frame->header = McapStreamFrame::make_header(kind, file_id_, offset, payload.size());
+    frame->payload = std::move(payload);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        unsent_size_ += frame->size();
+        unsent_.push_back(std::move(frame));
+        update_memory_metrics_nts_();
+    }
+
+    cv_.notify_one();
+}
+
+void McapStreamWriter::sender_routine_()
+{
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::io, "ddsrec.stream");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        if (fd_ < 0)
+        {
+            lock.unlock();
+            const bool connected = connect_();
+            lock.lock();
+
+            if (!connected)
+            {
+                if (stop_)
+                {
+                    // Give up on the frames left
+                    break;
+                }
+
+                cv_.wait_for(lock, std::chrono::milliseconds(configuration_.reconnection_period), [this]()
+                        {
+                            return stop_;
+                        });
+                continue;
+            }
+
+            // Send again the frames the collector may have missed, so it resumes the files not closed yet
+            std::vector<std::shared_ptr<const Frame>> resend;
+
+            for (const auto& it : open_frames_)
+            {
+                resend.push_back(it.second);
+            }
+
+            resend.insert(resend.end(), replay_.begin(), replay_.end());
+
+            lock.unlock();
+
+            for (const auto& frame : resend)
+            {
+                if (!send_(*frame))
+                {
+                    disconnect_();
+                    break;
+                }
+            }
+
+            lock.lock();
+            continue;
+        }
+
+        cv_.wait(lock, [this]()
+                {
+                    return stop_ || !unsent_.empty();
+                });
+
+        if (unsent_.empty())
+        {
+            // Stopped with every frame sent
+            break;
+        }
+
+        const auto frame = unsent_.front();
+
+        lock.unlock();
+        const bool sent = send_(*frame);
+        lock.lock();
+
+        if (!sent)
+        {
+            disconnect_();
+            continue;
+        }
+
+        unsent_.pop_front();
+        unsent_size_ -= frame->size();
+        on_frame_sent_nts_(frame);
+        update_memory_metrics_nts_();
+    }
+
+    if (!unsent_.empty())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_STREAM,
+                "MCAP_STREAM | Discarding " << utils::from_bytes(unsent_size_) << " of frames not sent to the collector at " <<
+                endpoint(configuration_) << ".");
+    }
+
+    unsent_.clear();
+    unsent_size_ = 0;
+    replay_.clear();
+    replay_size_ = 0;
+    open_frames_.clear();
+    update_memory_metrics_nts_();
+
+    lock.unlock();
+    disconnect_();
+}
+
+void McapStreamWriter::on_frame_sent_nts_(
+        const std::shared_ptr<const Frame>& frame)
+{
+    switch (frame->kind)
+    {
+        case McapStreamFrame::Kind::open:
+            open_frames_[frame->file_id] = frame;
+            break;
+
+        case McapStreamFrame::Kind::close:
+
+            // The file is complete, so its frames are not to be sent again
+            open_frames_.erase(frame->file_id);
+
+            while (!replay_.empty() && replay_.front()->file_id == frame->file_id)
+            {
+                replay_size_ -= replay_.front()->size();
+                replay_.pop_front();
+            }
+
+            break;
+
+        default:
+            replay_.push_back(frame);
+            replay_size_ += frame->size();
+
+            while (replay_size_ > configuration_.replay_buffer_size && !replay_.empty())
+            {
+                replay_size_ -= replay_.front()->size();
+                replay_.pop_front();
+            }
+
+            break;
+    }
+}
+
+void McapStreamWriter::update_memory_metrics_nts_() const
+{
+    RecorderMetrics::get_instance().set_memory_usage(MemorySubsystem::stream_frames, unsent_size_ + replay_size_);
+}
+
+#ifndef _WIN32
+
+bool McapStreamWriter::connect_()
+{
+    if (configuration_.kind == McapStreamKind::pipe)
+    {
+        // A broken pipe cannot be reopened
+        fd_ = pipe_fd_;
+        return fd_ >= 0;
+    }
+
+    std::string error;
+
+    if (configuration_.kind == McapStreamKind::tcp)
+    {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo* addresses = nullptr;
+        const auto result = getaddrinfo(configuration_.address.c_str(), std::to_string(configuration_.port).c_str(),
+                        &hints, &addresses);
+
+        if (result != 0)
+        {
+            error = gai_strerror(result);
+        }
+
+        for (auto address = addresses; address != nullptr && fd_ < 0; address = address->ai_next)
+        {
+            fd_ = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+
+            if (fd_ < 0)
+            {
+                error = std::strerror(errno);
+                continue;
+            }
+
+            if (connect(fd_, address->ai_addr, address->ai_addrlen) != 0)
+            {
+                error = std::strerror(errno);
+                close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        if (addresses != nullptr)
+        {
+            freeaddrinfo(addresses);
+        }
+    }
+    else
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (configuration_.path.empty() || configuration_.path.size() >= sizeof(address.sun_path))
+        {
+            error = "invalid socket path";
+        }
+        else
+        {
+            std::strncpy(address.sun_path, configuration_.path.c_str(), sizeof(address.sun_path) - 1);
+
+            fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+
+            if (fd_ < 0)
+            {
+                error = std::strerror(errno);
+            }
+            else if (connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                error = std::strerror(errno);
+                close(fd_);
+                fd_ = -1;
+            }
+        }
+    }
+
+    if (fd_ < 0)
+    {
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_STREAM,
+                "MCAP_STREAM | Failed to connect to the collector at " << endpoint(configuration_) << ": " << error <<
+                ". Retrying every " << configuration_.reconnection_period << " ms.");
+        return false;
+    }
+
+    // A collector not reading the stream must not block the sending thread forever
+    timeval timeout{};
+    timeout.tv_sec = SEND_TIMEOUT_MS / 1000;
+    timeout.tv_usec = (SEND_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_STREAM,
+            "MCAP_STREAM | Connected to the collector at " << endpoint(configuration_) << ".");
+
+    return true;
+}
+
+void McapStreamWriter::disconnect_() noexcept
+{
+    if (fd_ < 0)
+    {
+        return;
+    }
+
+    close(fd_);
+
+    if (fd_ == pipe_fd_)
+    {
+        pipe_fd_ = -1;
+    }
+
+    fd_ = -1;
+}
+
+bool McapStreamWriter::send_(
+        const Frame& frame) const
+{
+    iovec buffers[2];
+    buffers[0].iov_base = const_cast<std::byte*>(frame.header.data());
+    buffers[0].iov_len = frame.header.size();
+    buffers[1].iov_base = const_cast<std::byte*>(frame.payload.data());
+    buffers[1].iov_len = frame.payload.size();
+
+    iovec* current = buffers;
+    std::size_t count = frame.payload.empty() ? 1 : 2;
+
+#ifdef MSG_NOSIGNAL
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif // ifdef MSG_NOSIGNAL
+
+    while (count > 0)
+    {
+        ssize_t result;
+
+        if (configuration_.kind == McapStreamKind::pipe)
+        {
+            result = writev(fd_, current, static_cast<int>(count));
+        }
+        else
+        {
+            msghdr message{};
+            message.msg_iov = current;
+            message.msg_iovlen = count;
+
+            result = sendmsg(fd_, &message, flags);
+        }
+
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (result <= 0)
+        {
+            DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_STREAM,
+                    "MCAP_STREAM | Lost the connection to the collector at " << endpoint(configuration_) << ": " <<
+                    std::strerror(errno) << ".");
+            return false;
+        }
+
+        // Skip the bytes sent
+        auto sent = static_cast<std::size_t>(result);
+
+        while (count > 0 && sent >= current->iov_len)
+        {
+            sent -= current->iov_len;
+            current++;
+            count--;
+        }
+
+        if (count > 0)
+        {
+            current->iov_base = static_cast<char*>(current->iov_base) + sent;
+            current->iov_len -= sent;
+        }
+    }
+
+    return true;
+}
+
+#else
+
+bool McapStreamWriter::connect_()
+{
+    return false;
+}
+
+void McapStreamWriter::disconnect_() noexcept
+{
+}
+
+bool McapStreamWriter::send_(
+        const Frame&) const
+{
+    return false;
+}
+
+#endif // ifndef _WIN32
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -16,8 +16,10 @@
  * @file McapWriter.cpp
  */
 
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
+#include <system_error>
 
 #include <mcap/internal.hpp>
 
@@ -28,8 +30,11 @@
 #include <cpp_utils/time/time_utils.hpp>
 #include <cpp_utils/utils.hpp>
 
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesSidecar.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapMessage.hpp>
+#include <ddsrecorder_participants/recorder/logging/LogRateLimiter.hpp>
 #include <ddsrecorder_participants/recorder/mcap/McapWriter.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
 #include <ddsrecorder_participants/recorder/monitoring/producers/DdsRecorderStatusMonitorProducer.hpp>
 #include <ddsrecorder_participants/recorder/output/FullDiskException.hpp>
 #include <ddsrecorder_participants/recorder/output/FullFileException.hpp>
@@ -38,16 +43,124 @@ namespace eprosima {
 namespace ddsrecorder {
 namespace participants {
 
+namespace {
+
+mcap::McapWriterOptions writer_options(
+        const mcap::McapWriterOptions& mcap_configuration,
+        const bool lazy_channels,
+        const McapChunkingConfiguration& chunking)
+{
+    auto options = mcap_configuration;
+
+    // NOTE: With adaptive chunking, the MCAP library only closes the chunks reaching the maximum size.
+    options.chunkSize = McapChunkPolicy::library_chunk_size(chunking);
+
+    if (options.compression == mcap::Compression::None && !options.noChunking)
+    {
+        // The uncompressed chunks reference the payloads (kept alive until their chunk is written) instead of
+        // copying them, and are written with a single gather write
+        options.referencePayloads = true;
+    }
+
+    if (lazy_channels)
+    {
+        // Only the schemas and channels with messages are written (in the data section) in each file
+        options.noRepeatedSchemas = true;
+        options.noRepeatedChannels = true;
+    }
+
+    return options;
+}
+
+mcap::McapWriterOptions forecast_writer_options(
+        const mcap::McapWriterOptions& mcap_configuration,
+        const DiskFullForecastConfiguration& forecast)
+{
+    auto options = mcap_configuration;
+
+    if (forecast.compression_threshold == 0)
+    {
+        return options;
+    }
+
+    options.compression = forecast.compression;
+    options.compressionLevel = forecast.compression_level;
+
+    // Only the uncompressed chunks reference the payloads
+    options.referencePayloads = options.compression == mcap::Compression::None && !options.noChunking;
+
+    return options;
+}
+
+std::uint64_t memory_size(
+        const mcap::Schema& schema)
+{
+    return sizeof(mcap::Schema) + schema.name.size() + schema.encoding.size() + schema.data.size();
+}
+
+std::uint64_t memory_size(
+        const mcap::Channel& channel)
+{
+    return sizeof(mcap::Channel) + channel.topic.size() + channel.messageEncoding.size() +
+           mcap::internal::KeyValueMapSize(channel.metadata);
+}
+
+} // namespace
+
 McapWriter::McapWriter(
         const OutputSettings& configuration,
         const mcap::McapWriterOptions& mcap_configuration,
         std::shared_ptr<FileTracker>& file_tracker,
-        const bool record_types)
+        const bool record_types,
+        const bool record_statistics,
+        const bool lazy_channels,
+        const bool types_sidecar,
+        const McapChunkingConfiguration& chunking,
+        const McapBlobsConfiguration& blobs)
     : configuration_(configuration)
-    , mcap_configuration_(mcap_configuration)
+    , default_mcap_configuration_(writer_options(mcap_configuration, lazy_channels, chunking))
+    , forecast_mcap_configuration_(forecast_writer_options(default_mcap_configuration_,
+            configuration.disk_full_forecast))
+    , mcap_configuration_(default_mcap_configuration_)
     , file_tracker_(file_tracker)
     , record_types_(record_types)
+    , record_statistics_(record_statistics)
+    , lazy_channels_(lazy_channels)
+    , types_sidecar_(types_sidecar && configuration.sink == OutputSinkKind::file)
+    , chunk_policy_(chunking)
+    , blobs_(blobs)
+    , size_tracker_(lazy_channels)
 {
+    if (types_sidecar && configuration.sink != OutputSinkKind::file)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | The types sidecar is only available when writing the output files to disk, "
+                "the types are written in an attachment instead.");
+    }
+
+    if (configuration.sink == OutputSinkKind::stream)
+    {
+        stream_output_ = std::make_unique<McapStreamWriter>(configuration.stream);
+    }
+
+    if (configuration.disk_full_forecast.enabled && configuration.sink == OutputSinkKind::file)
+    {
+        disk_full_forecaster_ = std::make_unique<DiskFullForecaster>(configuration.disk_full_forecast);
+    }
+    else if (configuration.disk_full_forecast.enabled)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | The disk full forecast only applies when writing the output files to disk, ignoring it.");
+    }
+
+    if (blobs_.enabled && blobs_.compression == mcap::Compression::Lz4)
+    {
+        blob_compressor_ = std::make_unique<mcap::LZ4Writer>(mcap_configuration_.compressionLevel, blobs_.threshold);
+    }
+    else if (blobs_.enabled && blobs_.compression == mcap::Compression::Zstd)
+    {
+        blob_compressor_ = std::make_unique<mcap::ZStdWriter>(mcap_configuration_.compressionLevel, blobs_.threshold);
+    }
 }
 
 McapWriter::~McapWriter()
@@ -97,6 +210,13 @@ void McapWriter::disable()
 
     // Clear the channels when disabling the writer so the old channels are not rewritten in every new file
     channels_.clear();
+    channels_size_ = 0;
+
+    // Likewise, the keyframes reference the cleared channels
+    keyframes_.clear();
+    keyframes_size_ = 0;
+
+    update_memory_metrics_nts_();
 
     enabled_ = false;
 }
@@ -108,7 +228,18 @@ void McapWriter::update_dynamic_types(
 
     const auto& update_dynamic_types_payload = [&]()
             {
-                if (dynamic_types_payload_ == nullptr)
+                if (types_sidecar_)
+                {
+                    if (dynamic_types_payload_ == nullptr)
+                    {
+                        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                                "MCAP_WRITE | Reserving the reference to the dynamic types sidecar.");
+
+                        // NOTE: The size of the reference does not depend on the payload, so it is only reserved once.
+                        size_tracker_.metadata_to_write(types_reference_(dynamic_types_payload));
+                    }
+                }
+                else if (dynamic_types_payload_ == nullptr)
                 {
                     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
                             "MCAP_WRITE | Setting the dynamic types payload to " <<
@@ -148,6 +279,7 @@ void McapWriter::update_dynamic_types(
 
     dynamic_types_payload_.reset(const_cast<fastdds::rtps::SerializedPayload_t*>(&dynamic_types_payload));
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
+    update_memory_metrics_nts_();
 }
 
 void McapWriter::set_on_disk_full_callback(
@@ -156,6 +288,16 @@ void McapWriter::set_on_disk_full_callback(
     on_disk_full_lambda_ = on_disk_full_lambda;
 }
 
+bool McapWriter::congested() const noexcept
+{
+    return stream_output_ != nullptr && stream_output_->congested();
+}
+
+bool McapWriter::dropping_low_priority() const noexcept
+{
+    return dropping_low_priority_.load(std::memory_order_relaxed);
+}
+
 void McapWriter::open_new_file_nts_(
         const std::uint64_t min_file_size)
 {
@@ -171,17 +313,43 @@ void McapWriter::open_new_file_nts_(
     }
 
     const auto filename = file_tracker_->get_current_filename();
-    const auto status = writer_.open(filename, mcap_configuration_);
 
-    if (!status.ok())
+    // NOTE: The MCAP library fixes the compression of a file when opening it.
+    const auto forecast_compression =
+            disk_full_forecaster_ != nullptr && disk_full_forecaster_->active(DiskFullAction::compression);
+    mcap_configuration_ = forecast_compression ? forecast_mcap_configuration_ : default_mcap_configuration_;
+
+    if (configuration_.sink == OutputSinkKind::memory)
+    {
+        writer_.open(memory_output_, mcap_configuration_);
+    }
+    else if (configuration_.sink == OutputSinkKind::null)
+    {
+        writer_.open(null_output_, mcap_configuration_);
+    }
+    else if (configuration_.sink == OutputSinkKind::stream)
     {
-        const auto error_msg = "Failed to open MCAP file " + filename + " for writing: " + status.message;
+        // The collector names the file as it would have been named on disk
+        stream_output_->open(std::filesystem::path(filename).filename().replace_extension().string());
+        writer_.open(*stream_output_, mcap_configuration_);
+    }
+    else
+    {
+        const auto status = writer_.open(filename, mcap_configuration_);
 
-        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
-                "FAIL_MCAP_OPEN | " << error_msg);
-        throw utils::InitializationException(error_msg);
+        if (!status.ok())
+        {
+            const auto error_msg = "Failed to open MCAP file " + filename + " for writing: " + status.message;
+
+            EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                    "FAIL_MCAP_OPEN | " << error_msg);
+            on_file_creation_failure_();
+            throw utils::InitializationException(error_msg);
+        }
     }
 
+    RecorderMetrics::get_instance().file_opened();
+
     // Set the file's maximum size
     const auto max_file_size = std::min(
         configuration_.max_file_size,
@@ -191,30 +359,92 @@ void McapWriter::open_new_file_nts_(
 
     // NOTE: These writes should never fail since the minimum size accounts for them.
     write_metadata_nts_();
-    write_schemas_nts_();
-    write_channels_nts_();
+
+    if (lazy_channels_)
+    {
+        register_schemas_and_channels_nts_();
+    }
+    else
+    {
+        write_schemas_nts_();
+        write_channels_nts_();
+    }
 
     if (dynamic_types_payload_ != nullptr && record_types_)
     {
-        size_tracker_.attachment_to_write(dynamic_types_payload_->length);
+        if (types_sidecar_)
+        {
+            size_tracker_.metadata_to_write(types_reference_(*dynamic_types_payload_));
+        }
+        else
+        {
+            size_tracker_.attachment_to_write(dynamic_types_payload_->length);
+        }
+    }
+
+    file_chunks_ = 0;
+    chunk_offset_ = writer_.dataSink()->size();
+    output_failed_ = false;
+    chunk_policy_.reset_statistics();
+
+    if (!keyframes_.empty())
+    {
+        write_keyframes_nts_();
     }
 
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
+    update_memory_metrics_nts_();
 }
 
 void McapWriter::close_current_file_nts_()
 {
+    // Close the last chunk before writing the records after the messages (the MCAP library would close it anyway)
+    close_chunk_nts_(ChunkCloseReason::flush);
+    log_chunk_statistics_nts_();
+
     if (record_types_ && dynamic_types_payload_ != nullptr)
     {
         // NOTE: This write should never fail since the minimum size accounts for it.
-        write_attachment_nts_();
+        if (types_sidecar_)
+        {
+            write_types_sidecar_nts_();
+        }
+        else
+        {
+            write_attachment_nts_();
+        }
+    }
+
+    if (record_statistics_)
+    {
+        // NOTE: These writes should never fail since the space was reserved when writing the channels.
+        write_channels_statistics_nts_();
     }
 
     file_tracker_->set_current_file_size(size_tracker_.get_written_mcap_size());
     size_tracker_.reset(file_tracker_->get_current_filename());
 
+    // The blobs of this file cannot be referenced from the next one
+    file_blobs_.clear();
+
+    closed_files_size_ += writer_.dataSink() != nullptr ? writer_.dataSink()->size() : 0;
+
+    check_output_nts_();
     writer_.close();
+
+    if (configuration_.sink == OutputSinkKind::memory)
+    {
+        file_tracker_->set_current_file_contents(memory_output_.release());
+    }
+    else if (configuration_.sink == OutputSinkKind::null)
+    {
+        null_output_.reset();
+    }
+
     file_tracker_->close_file();
+
+    RecorderMetrics::get_instance().file_closed();
+    update_memory_metrics_nts_();
 }
 
 template <>
@@ -243,10 +473,28 @@ template <>
 void McapWriter::write_nts_(
         const mcap::Channel& channel)
 {
+    if (lazy_channels_)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Registering channel " << channel.topic << ".");
+
+        // The channel is written (and its space reserved) along with its first message in each file
+        writer_.addChannel(const_cast<mcap::Channel&>(channel));
+        store_channel_nts_(channel);
+        update_memory_metrics_nts_();
+        return;
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
             "MCAP_WRITE | Writing channel " << channel.topic << ".");
 
     size_tracker_.channel_to_write(channel);
+
+    if (record_statistics_)
+    {
+        size_tracker_.metadata_to_write(McapChannelStatistics::max_metadata(channel));
+    }
+
     writer_.addChannel(const_cast<mcap::Channel&>(channel));
     size_tracker_.channel_written(channel);
 
@@ -257,7 +505,14 @@ void McapWriter::write_nts_(
     // TODO: Share the channels and schemas between the McapHandler and McapWriter.
 
     // Store the channel to write it on new MCAP files
-    channels_[channel.id] = channel;
+    store_channel_nts_(channel);
+
+    if (record_statistics_)
+    {
+        channels_statistics_[channel.id] = McapChannelStatistics();
+    }
+
+    update_memory_metrics_nts_();
 }
 
 template <>
@@ -266,25 +521,420 @@ void McapWriter::write_nts_(
 {
     if (!enabled_)
     {
-        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_MCAP_WRITER,
                 "MCAP_WRITE | Attempting to write a message in a disabled writer.");
         return;
     }
 
-    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER, "Writing message: " << utils::from_bytes(msg.dataSize) << ".");
+    DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Writing message: " << utils::from_bytes(msg.dataSize) << ".");
+
+    if (blobs_.enabled && msg.dataSize >= blobs_.threshold)
+    {
+        write_blob_nts_(msg);
+    }
+    else
+    {
+        write_message_nts_(msg);
+    }
+
+    // NOTE: Only after writing the message, so it is not written twice if the write opens a new file.
+    if (msg.keyframe)
+    {
+        store_keyframe_nts_(msg);
+    }
+}
+
+void McapWriter::write_message_nts_(
+        const McapMessage& msg)
+{
+    if (lazy_channels_ && file_channels_.count(msg.channelId) == 0)
+    {
+        write_first_message_nts_(msg);
+        return;
+    }
 
     size_tracker_.message_to_write(msg.dataSize);
     const auto status = writer_.write(msg);
 
     if (!status.ok())
     {
-        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+        DDSRECORDER_LOG_ERROR_RATE_LIMITED(DDSRECORDER_MCAP_WRITER,
                 "MCAP_WRITE | Error writing in MCAP. Error message: " << status.message);
         return;
     }
 
     size_tracker_.message_written(msg.dataSize);
+    on_message_written_nts_(msg);
+}
+
+void McapWriter::write_blob_nts_(
+        const McapMessage& msg)
+{
+    McapBlob::Digest digest{};
+
+    if (blobs_.deduplicate)
+    {
+        digest = McapBlob::digest(msg.data, msg.dataSize);
+
+        const auto blob_it = file_blobs_.find(digest);
+
+        if (blob_it != file_blobs_.end())
+        {
+            // The payload is already in a blob of this file: only write another reference to it
+            write_blob_reference_nts_(msg, blob_it->second);
+            RecorderMetrics::get_instance().blob_deduplicated(msg.dataSize);
+
+            DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_WRITER,
+                    "MCAP_WRITE | Referenced blob of " << utils::from_bytes(msg.dataSize) << " at offset " <<
+                    blob_it->second << " again.");
+            return;
+        }
+    }
+
+    const std::byte* data = msg.data;
+    std::uint64_t data_size = msg.dataSize;
+    auto compression = mcap::Compression::None;
+
+    if (blob_compressor_ != nullptr)
+    {
+        blob_compressor_->clear();
+        blob_compressor_->write(msg.data, msg.dataSize);
+        blob_compressor_->end();
+
+        // Only keep the blob compressed if that makes it smaller
+        if (blob_compressor_->compressedSize() < msg.dataSize)
+        {
+            data = blob_compressor_->compressedData();
+            data_size = blob_compressor_->compressedSize();
+            compression = blobs_.compression;
+        }
+    }
+
+    mcap::Attachment blob;
+    blob.name = McapBlob::ATTACHMENT_NAME;
+    blob.mediaType = McapBlob::media_type(compression);
+    blob.logTime = msg.logTime;
+    blob.createTime = msg.publishTime;
+    blob.data = data;
+    blob.dataSize = data_size;
+
+    // NOTE: If the reference does not fit in the current file, the blob is left unreferenced in it and written again
+    // in the next one.
+    size_tracker_.blob_to_write(data_size);
+
+    const auto offset = writer_.dataSink()->size();
+
+    // The blob is written right away, while the current chunk keeps growing
+    static constexpr bool CLOSE_CHUNK = false;
+    const auto status = writer_.write(blob, CLOSE_CHUNK);
+
+    if (!status.ok())
+    {
+        DDSRECORDER_LOG_ERROR_RATE_LIMITED(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Error writing blob in MCAP. Error message: " << status.message);
+        return;
+    }
+
+    size_tracker_.blob_written(data_size);
+    RecorderMetrics::get_instance().blob_written(data_size);
+
+    // The blob is not part of the chunk being built
+    chunk_offset_ += writer_.dataSink()->size() - offset;
+
+    DDSRECORDER_LOG_INFO_HOT_PATH(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Written blob of " << utils::from_bytes(msg.dataSize) << " (" <<
+            utils::from_bytes(data_size) << " in the file) at offset " << offset << ".");
+
+    if (blobs_.deduplicate)
+    {
+        // NOTE: If the reference does not fit in the current file, these blobs are forgotten along with the file.
+        file_blobs_[digest] = offset;
+    }
+
+    write_blob_reference_nts_(msg, offset);
+}
+
+void McapWriter::write_blob_reference_nts_(
+        const McapMessage& msg,
+        const std::uint64_t offset)
+{
+    // The chunk may reference the payload of the message until it is written (see referencePayloads)
+    chunk_blob_references_.push_back(McapBlob::make_reference(offset, msg.dataSize));
+
+    McapMessage reference;
+    static_cast<mcap::Message&>(reference) = msg;
+    reference.data = chunk_blob_references_.back().data();
+    reference.dataSize = McapBlob::REFERENCE_SIZE;
+
+    write_message_nts_(reference);
+
+    if (!mcap_configuration_.referencePayloads)
+    {
+        chunk_blob_references_.clear();
+    }
+}
+
+void McapWriter::store_keyframe_nts_(
+        const McapMessage& msg)
+{
+    const auto key = std::make_pair(msg.channelId, msg.instance_handle);
+    const auto keyframe_it = keyframes_.find(key);
+
+    if (keyframe_it != keyframes_.end())
+    {
+        keyframes_size_ -= keyframe_it->second.dataSize;
+        keyframes_.erase(keyframe_it);
+    }
+
+    // NOTE: The copy shares the payload of the message, which stays in the payload pool until it is replaced.
+    auto& keyframe = keyframes_.emplace(key, msg).first->second;
+    keyframe.keyframe = false;
+    keyframes_size_ += keyframe.dataSize;
+
+    RecorderMetrics::get_instance().set_memory_usage(MemorySubsystem::keyframes,
+            keyframes_size_ + keyframes_.size() * sizeof(McapMessage));
+}
+
+void McapWriter::write_keyframes_nts_()
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Writing " << keyframes_.size() << " keyframes (" << utils::from_bytes(keyframes_size_) <<
+            ").");
+
+    for (const auto& [_, keyframe] : keyframes_)
+    {
+        // Timestamp the keyframe at the start of the file, so a replay of the file does not wait before the others
+        McapMessage msg(keyframe);
+        msg.logTime = std::max(msg.logTime, last_log_time_);
+
+        try
+        {
+            if (blobs_.enabled && msg.dataSize >= blobs_.threshold)
+            {
+                write_blob_nts_(msg);
+            }
+            else
+            {
+                write_message_nts_(msg);
+            }
+        }
+        catch (const FullFileException& e)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                    "MCAP_WRITE | The keyframes do not fit in the new file, skipping the remaining ones: " << e.what());
+            return;
+        }
+    }
+}
+
+void McapWriter::write_first_message_nts_(
+        const McapMessage& msg)
+{
+    const auto channel_it = channels_.find(msg.channelId);
+
+    if (channel_it == channels_.end())
+    {
+        DDSRECORDER_LOG_ERROR_RATE_LIMITED(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Error writing in MCAP. Unknown channel id " << msg.channelId << ".");
+        return;
+    }
+
+    const auto& channel = channel_it->second;
+
+    const mcap::Schema* schema = nullptr;
+
+    if (file_schemas_.count(channel.schemaId) == 0)
+    {
+        const auto schema_it = schemas_.find(channel.schemaId);
+
+        if (schema_it != schemas_.end())
+        {
+            schema = &schema_it->second;
+        }
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Writing channel " << channel.topic << " along with its first message.");
+
+    if (record_statistics_)
+    {
+        const auto statistics = McapChannelStatistics::max_metadata(channel);
+        size_tracker_.first_message_to_write(msg.dataSize, channel, schema, &statistics);
+    }
+    else
+    {
+        size_tracker_.first_message_to_write(msg.dataSize, channel, schema);
+    }
+
+    // NOTE: The MCAP library writes the schema and the channel right before the message.
+    const auto status = writer_.write(msg);
+
+    if (!status.ok())
+    {
+        DDSRECORDER_LOG_ERROR_RATE_LIMITED(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Error writing in MCAP. Error message: " << status.message);
+        return;
+    }
+
+    size_tracker_.first_message_written(msg.dataSize, channel, schema);
+
+    file_schemas_.insert(channel.schemaId);
+    file_channels_.insert(channel.id);
+
+    if (record_statistics_)
+    {
+        channels_statistics_[channel.id] = McapChannelStatistics();
+    }
+
+    on_message_written_nts_(msg);
+}
+
+void McapWriter::on_message_written_nts_(
+        const McapMessage& msg)
+{
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
+
+    if (mcap_configuration_.referencePayloads && msg.payload_owner != nullptr)
+    {
+        // Keep a reference to the payload until the chunk referencing it is written
+        chunk_messages_.push_back(msg);
+    }
+
+    update_chunk_nts_(msg);
+
+    last_log_time_ = std::max(last_log_time_, msg.logTime);
+
+    if (record_statistics_)
+    {
+        const auto it = channels_statistics_.find(msg.channelId);
+
+        if (it != channels_statistics_.end())
+        {
+            it->second.add_message(msg.logTime, msg.dataSize);
+        }
+    }
+
+    auto& metrics = RecorderMetrics::get_instance();
+    metrics.message_written(msg.dataSize);
+    metrics.set_current_file_size(size_tracker_.get_written_mcap_size());
+}
+
+void McapWriter::update_chunk_nts_(
+        const McapMessage& msg)
+{
+    if (mcap_configuration_.noChunking)
+    {
+        // Without chunks, the output and the forecast are checked after every message instead of after every chunk
+        check_output_nts_();
+        update_disk_full_forecast_nts_();
+        return;
+    }
+
+    chunk_policy_.message_written(msg.logTime, msg.dataSize);
+
+    if (writer_.statistics().chunkCount != file_chunks_)
+    {
+        // The MCAP library has closed the chunk when writing the message
+        on_chunk_written_nts_(ChunkCloseReason::size);
+        return;
+    }
+
+    ChunkCloseReason reason;
+
+    if (chunk_policy_.should_close(reason))
+    {
+        close_chunk_nts_(reason);
+    }
+}
+
+void McapWriter::close_chunk_nts_(
+        const ChunkCloseReason reason)
+{
+    if (mcap_configuration_.noChunking || chunk_policy_.empty())
+    {
+        return;
+    }
+
+    writer_.closeLastChunk();
+    on_chunk_written_nts_(reason);
+}
+
+void McapWriter::on_chunk_written_nts_(
+        const ChunkCloseReason reason)
+{
+    const auto file_size = writer_.dataSink()->size();
+
+    RecorderMetrics::get_instance().chunk_written(
+        reason,
+        chunk_policy_.current_size(),
+        std::chrono::nanoseconds(chunk_policy_.current_duration()));
+
+    chunk_policy_.chunk_closed(reason, file_size - chunk_offset_);
+
+    // The chunk has been written, so the payloads it referenced can be released
+    chunk_messages_.clear();
+    chunk_blob_references_.clear();
+
+    if (stream_output_ != nullptr)
+    {
+        // Stream the chunk in a frame of its own
+        stream_output_->flush();
+    }
+
+    file_chunks_ = writer_.statistics().chunkCount;
+    chunk_offset_ = file_size;
+
+    check_output_nts_();
+    update_disk_full_forecast_nts_();
+}
+
+void McapWriter::check_output_nts_()
+{
+    if (output_failed_ || writer_.dataSink() == nullptr)
+    {
+        return;
+    }
+
+    const auto status = writer_.dataSink()->status();
+
+    if (status.ok())
+    {
+        return;
+    }
+
+    // The MCAP library cannot report a failed write, so it is reported once per file
+    output_failed_ = true;
+
+    EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+            "FAIL_MCAP_WRITE | Error writing to MCAP file " << file_tracker_->get_current_filename() << ": " <<
+            status.message);
+    on_disk_full_();
+}
+
+void McapWriter::log_chunk_statistics_nts_() const
+{
+    const auto& statistics = chunk_policy_.statistics();
+
+    if (statistics.chunks == 0)
+    {
+        return;
+    }
+
+    const auto ratio = statistics.written_size > 0 ?
+            static_cast<double>(statistics.uncompressed_size) / statistics.written_size : 1.0;
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Written " << statistics.chunks << " chunks with " << statistics.messages << " messages in " <<
+            file_tracker_->get_current_filename() << ". Closed by size: " <<
+            statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::size)] << ", duration: " <<
+            statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::duration)] << ", rate change: " <<
+            statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::rate_change)] << ", flush: " <<
+            statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::flush)] << ". Average size: " <<
+            utils::from_bytes(statistics.uncompressed_size / statistics.chunks) << " (" <<
+            utils::from_bytes(statistics.min_uncompressed_size) << " to " <<
+            utils::from_bytes(statistics.max_uncompressed_size) << "), average duration: " <<
+            statistics.duration / statistics.chunks / 1000000 << " ms, compression ratio: " << ratio << ".");
 }
 
 template <>
@@ -312,6 +962,18 @@ template <>
 void McapWriter::write_nts_(
         const mcap::Schema& schema)
 {
+    if (lazy_channels_)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Registering schema: " << schema.name << ".");
+
+        // The schema is written (and its space reserved) along with the first message of its channels in each file
+        writer_.addSchema(const_cast<mcap::Schema&>(schema));
+        store_schema_nts_(schema);
+        update_memory_metrics_nts_();
+        return;
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
             "MCAP_WRITE | Writing schema: " << schema.name << ".");
 
@@ -322,7 +984,9 @@ void McapWriter::write_nts_(
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
 
     // Store the schema to write it on new MCAP files
-    schemas_[schema.id] = schema;
+    store_schema_nts_(schema);
+
+    update_memory_metrics_nts_();
 }
 
 void McapWriter::write_attachment_nts_()
@@ -340,6 +1004,83 @@ void McapWriter::write_attachment_nts_()
     write_nts_(attachment);
 }
 
+void McapWriter::write_types_sidecar_nts_()
+{
+    // NOTE: The output path and not the directory of the current file, which may be the staging directory.
+    const auto& directory = configuration_.filepath;
+
+    try
+    {
+        const auto sidecar = std::filesystem::path(directory) / DynamicTypesSidecar::filename(
+            DynamicTypesSidecar::hash(dynamic_types_payload_->data, dynamic_types_payload_->length));
+        const auto created = !std::filesystem::exists(sidecar);
+
+        const auto hash = DynamicTypesSidecar::write(
+            directory,
+            dynamic_types_payload_->data,
+            dynamic_types_payload_->length);
+
+        // The tracker removes the sidecar along with the last file referencing it
+        file_tracker_->set_current_file_sidecar(sidecar.string(), created);
+
+        const auto reference = DynamicTypesSidecar::reference(hash);
+
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Writing reference to dynamic types sidecar: " <<
+                reference.metadata.at(DYNAMIC_TYPES_SIDECAR_FILE) << ".");
+
+        // NOTE: There is no need to check if the MCAP is full, since it is checked when adding a new dynamic_type.
+        const auto status = writer_.write(reference);
+
+        if (!status.ok())
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                    "MCAP_WRITE | Error writing in MCAP. Error message: " << status.message);
+            return;
+        }
+
+        size_tracker_.metadata_written(reference);
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Error writing the dynamic types: " << e.what());
+    }
+}
+
+mcap::Metadata McapWriter::types_reference_(
+        const fastdds::rtps::SerializedPayload_t& dynamic_types_payload)
+{
+    return DynamicTypesSidecar::reference(
+        DynamicTypesSidecar::hash(dynamic_types_payload.data, dynamic_types_payload.length));
+}
+
+void McapWriter::write_channels_statistics_nts_()
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Writing channels statistics.");
+
+    for (const auto& [channel_id, statistics] : channels_statistics_)
+    {
+        const auto& channel = channels_[channel_id];
+        const auto metadata = statistics.to_metadata(channel);
+
+        size_tracker_.metadata_to_write(metadata, McapChannelStatistics::max_metadata(channel));
+        const auto status = writer_.write(metadata);
+
+        if (!status.ok())
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                    "MCAP_WRITE | Error writing in MCAP. Error message: " << status.message);
+            continue;
+        }
+
+        size_tracker_.metadata_written(metadata);
+    }
+
+    channels_statistics_.clear();
+}
+
 void McapWriter::write_channels_nts_()
 {
     if (channels_.empty())
@@ -357,6 +1098,23 @@ void McapWriter::write_channels_nts_()
     }
 }
 
+void McapWriter::register_schemas_and_channels_nts_()
+{
+    file_schemas_.clear();
+    file_channels_.clear();
+
+    // NOTE: The maps are ordered by id, so the MCAP library assigns every schema and channel its previous id.
+    for (auto& [_, schema] : schemas_)
+    {
+        writer_.addSchema(schema);
+    }
+
+    for (auto& [_, channel] : channels_)
+    {
+        writer_.addChannel(channel);
+    }
+}
+
 void McapWriter::write_metadata_nts_()
 {
     mcap::Metadata metadata;
@@ -409,9 +1167,147 @@ void McapWriter::on_mcap_full_nts_(
     enabled_ = true;
 }
 
+void McapWriter::update_memory_metrics_nts_()
+{
+    auto& metrics = RecorderMetrics::get_instance();
+
+    // NOTE: The McapHandler, the McapWriter and the MCAP library keep a copy each.
+    metrics.set_memory_usage(MemorySubsystem::schemas_and_channels, 3 * (schemas_size_ + channels_size_));
+
+    metrics.set_memory_usage(MemorySubsystem::dynamic_types,
+            dynamic_types_payload_ != nullptr ? dynamic_types_payload_->max_size : 0);
+
+    std::uint64_t mcap_chunks = 0;
+
+    if (writer_.dataSink() != nullptr && !mcap_configuration_.noChunking)
+    {
+        // The uncompressed chunk grows up to the chunk size, and the compressed one takes up to as much again
+        mcap_chunks = mcap_configuration_.chunkSize;
+
+        if (mcap_configuration_.compression != mcap::Compression::None)
+        {
+            mcap_chunks *= 2;
+        }
+    }
+
+    metrics.set_memory_usage(MemorySubsystem::mcap_chunks, mcap_chunks);
+
+    metrics.set_memory_usage(MemorySubsystem::keyframes, keyframes_size_ + keyframes_.size() * sizeof(McapMessage));
+}
+
+void McapWriter::store_schema_nts_(
+        const mcap::Schema& schema)
+{
+    const auto it = schemas_.find(schema.id);
+
+    if (it != schemas_.end())
+    {
+        schemas_size_ -= memory_size(it->second);
+    }
+
+    schemas_[schema.id] = schema;
+    schemas_size_ += memory_size(schema);
+}
+
+void McapWriter::store_channel_nts_(
+        const mcap::Channel& channel)
+{
+    const auto it = channels_.find(channel.id);
+
+    if (it != channels_.end())
+    {
+        channels_size_ -= memory_size(it->second);
+    }
+
+    channels_[channel.id] = channel;
+    channels_size_ += memory_size(channel);
+}
+
+void McapWriter::update_disk_full_forecast_nts_()
+{
+    if (disk_full_forecaster_ == nullptr)
+    {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (now < next_forecast_)
+    {
+        return;
+    }
+
+    const auto& forecast = configuration_.disk_full_forecast;
+    next_forecast_ = now + std::chrono::milliseconds(forecast.period);
+
+    const auto file_size = writer_.dataSink() != nullptr ? writer_.dataSink()->size() : 0;
+
+    std::error_code ec;
+    const auto space = std::filesystem::space(configuration_.filepath, ec);
+
+    // The output is full when either the resource limits (unless rotating files) or the disk are
+    const auto remaining = DiskFullForecaster::remaining(
+        file_tracker_->get_total_size() + file_size,
+        configuration_.max_size,
+        ec ? DiskFullForecaster::NEVER_FULL : space.available,
+        configuration_.file_rotation);
+
+    const auto changed = disk_full_forecaster_->update(now, closed_files_size_ + file_size, remaining);
+
+    const auto write_rate = disk_full_forecaster_->write_rate();
+    const auto time_to_full = disk_full_forecaster_->time_to_full();
+
+    auto& metrics = RecorderMetrics::get_instance();
+    metrics.set_disk_full_forecast(write_rate, time_to_full);
+
+    if (!changed)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < DISK_FULL_ACTIONS; i++)
+    {
+        const auto action = static_cast<DiskFullAction>(i);
+        metrics.set_disk_full_action(action, disk_full_forecaster_->active(action));
+    }
+
+    const auto dropping_low_priority = disk_full_forecaster_->active(DiskFullAction::drop);
+
+    if (dropping_low_priority != dropping_low_priority_.load(std::memory_order_relaxed))
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | " << (dropping_low_priority ? "Started" : "Stopped") << " discarding the samples of " <<
+                "the low priority topics.");
+        dropping_low_priority_.store(dropping_low_priority, std::memory_order_relaxed);
+    }
+
+    if (disk_full_forecaster_->active(DiskFullAction::warning))
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | The output is forecast to be full in " << static_cast<std::uint64_t>(time_to_full) <<
+                " s: " << utils::from_bytes(remaining) << " left at " <<
+                utils::from_bytes(static_cast<std::uint64_t>(write_rate)) << "/s." <<
+                (disk_full_forecaster_->active(DiskFullAction::compression) ?
+                " The next files are written with the forecast compression." : ""));
+    }
+    else
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | The output is no longer forecast to be full within the warning threshold.");
+    }
+}
+
+void McapWriter::on_file_creation_failure_() const noexcept
+{
+    // Report the error and count it at once, so the status monitor and the exported metrics never diverge
+    monitor_error("MCAP_FILE_CREATION_FAILURE");
+    RecorderMetrics::get_instance().file_creation_failed();
+}
+
 void McapWriter::on_disk_full_() const noexcept
 {
     monitor_error("DISK_FULL");
+    RecorderMetrics::get_instance().disk_full();
 
     if (on_disk_full_lambda_ != nullptr)
     {
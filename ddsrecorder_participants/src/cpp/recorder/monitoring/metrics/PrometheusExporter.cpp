@@ -0,0 +1,538 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PrometheusExporter.cpp
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // ifndef _WIN32
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/PrometheusExporter.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+std::string format_value(
+        const double value)
+{
+    if (std::isinf(value))
+    {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+
+    std::ostringstream os;
+    os << std::setprecision(15) << value;
+    return os.str();
+}
+
+void serialize_counter(
+        std::ostringstream& os,
+        const std::string& name,
+        const std::string& help,
+        const std::uint64_t value)
+{
+    os << "# HELP " << name << " " << help << "\n";
+    os << "# TYPE " << name << " counter\n";
+    os << name << " " << value << "\n";
+}
+
+void serialize_gauge(
+        std::ostringstream& os,
+        const std::string& name,
+        const std::string& help,
+        const std::uint64_t value)
+{
+    os << "# HELP " << name << " " << help << "\n";
+    os << "# TYPE " << name << " gauge\n";
+    os << name << " " << value << "\n";
+}
+
+void serialize_gauge(
+        std::ostringstream& os,
+        const std::string& name,
+        const std::string& help,
+        const double value)
+{
+    os << "# HELP " << name << " " << help << "\n";
+    os << "# TYPE " << name << " gauge\n";
+    os << name << " " << format_value(value) << "\n";
+}
+
+void serialize_histogram(
+        std::ostringstream& os,
+        const std::string& name,
+        const std::string& help,
+        const HistogramSnapshot& histogram)
+{
+    os << "# HELP " << name << " " << help << "\n";
+    os << "# TYPE " << name << " histogram\n";
+
+    for (std::size_t i = 0; i < histogram.bounds.size(); i++)
+    {
+        os << name << "_bucket{le=\"" << format_value(histogram.bounds[i]) << "\"} " <<
+            histogram.cumulative_counts[i] << "\n";
+    }
+
+    os << name << "_bucket{le=\"+Inf\"} " << histogram.cumulative_counts.back() << "\n";
+    os << name << "_sum " << format_value(histogram.sum) << "\n";
+    os << name << "_count " << histogram.count << "\n";
+}
+
+} /* namespace */
+
+PrometheusExporter::PrometheusExporter(
+        const MetricsExporterConfiguration& configuration)
+    : configuration_(configuration)
+{
+}
+
+PrometheusExporter::~PrometheusExporter()
+{
+    stop();
+}
+
+void PrometheusExporter::start()
+{
+    if (running_)
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_METRICS,
+            "METRICS | Starting Prometheus exporter.");
+
+    if (configuration_.kind == MetricsExporterKind::file)
+    {
+        running_ = true;
+        thread_ = std::thread(&PrometheusExporter::file_routine_, this);
+        return;
+    }
+
+    open_socket_();
+
+    running_ = true;
+    thread_ = std::thread(&PrometheusExporter::serve_routine_, this);
+}
+
+void PrometheusExporter::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(cv_mutex_);
+
+        if (!running_)
+        {
+            return;
+        }
+
+        running_ = false;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_METRICS,
+            "METRICS | Stopping Prometheus exporter.");
+
+    cv_.notify_all();
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+
+    close_socket_();
+}
+
+std::string PrometheusExporter::serialize(
+        const RecorderMetricsSnapshot& snapshot)
+{
+    std::ostringstream os;
+
+    serialize_counter(os, "ddsrecorder_messages_received_total",
+            "Samples received by the recorder.", snapshot.messages_received);
+    serialize_counter(os, "ddsrecorder_messages_written_total",
+            "Samples written to MCAP files.", snapshot.messages_written);
+    serialize_counter(os, "ddsrecorder_messages_dropped_total",
+            "Samples discarded without being written.", snapshot.messages_dropped);
+    serialize_counter(os, "ddsrecorder_written_bytes_total",
+            "Payload bytes written to MCAP files.", snapshot.bytes_written);
+    serialize_counter(os, "ddsrecorder_files_opened_total",
+            "MCAP files opened.", snapshot.files_opened);
+    serialize_counter(os, "ddsrecorder_files_closed_total",
+            "MCAP files closed.", snapshot.files_closed);
+    serialize_counter(os, "ddsrecorder_file_creation_failures_total",
+            "Failures to create an MCAP file.", snapshot.file_creation_failures);
+    serialize_counter(os, "ddsrecorder_disk_full_total",
+            "Times the disk or the configured resource limits have been reached.", snapshot.disk_full_events);
+    serialize_counter(os, "ddsrecorder_blobs_written_total",
+            "Payloads written out of the MCAP chunks.", snapshot.blobs_written);
+    serialize_counter(os, "ddsrecorder_blob_written_bytes_total",
+            "Bytes (possibly compressed) of the payloads written out of the MCAP chunks.", snapshot.blob_bytes_written);
+    serialize_counter(os, "ddsrecorder_blobs_deduplicated_total",
+            "Payloads written as a reference to an identical blob already in the MCAP file.",
+            snapshot.blobs_deduplicated);
+    serialize_counter(os, "ddsrecorder_deduplicated_bytes_total",
+            "Bytes of the payloads not written again thanks to deduplication.", snapshot.deduplicated_bytes);
+    serialize_counter(os, "ddsrecorder_files_migrated_total",
+            "MCAP files moved from the staging directory to the output directory.", snapshot.files_migrated);
+    serialize_counter(os, "ddsrecorder_migration_failures_total",
+            "Failures to move an MCAP file from the staging directory to the output directory.",
+            snapshot.migration_failures);
+
+    serialize_gauge(os, "ddsrecorder_buffered_samples",
+            "Samples kept in memory waiting to be written.", snapshot.buffered_samples);
+    serialize_gauge(os, "ddsrecorder_pending_samples",
+            "Samples kept in memory waiting for their type.", snapshot.pending_samples);
+    serialize_gauge(os, "ddsrecorder_current_file_size_bytes",
+            "Size of the MCAP file being written.", snapshot.current_file_size);
+    serialize_gauge(os, "ddsrecorder_migration_backlog_files",
+            "Closed MCAP files waiting to be moved out of the staging directory.", snapshot.migration_backlog_files);
+    serialize_gauge(os, "ddsrecorder_migration_backlog_bytes",
+            "Size of the closed MCAP files waiting to be moved out of the staging directory.",
+            snapshot.migration_backlog_bytes);
+    serialize_gauge(os, "ddsrecorder_write_rate_bytes",
+            "Smoothed rate [bytes/s] at which the output grows.", snapshot.write_rate);
+    serialize_gauge(os, "ddsrecorder_time_to_full_seconds",
+            "Forecasted time until the output is full.", snapshot.time_to_full);
+
+    os << "# HELP ddsrecorder_disk_full_action Whether each action taken before the output is full is active.\n";
+    os << "# TYPE ddsrecorder_disk_full_action gauge\n";
+
+    for (std::size_t i = 0; i < DISK_FULL_ACTIONS; i++)
+    {
+        os << "ddsrecorder_disk_full_action{action=\"" << to_string(static_cast<DiskFullAction>(i)) << "\"} "
+           << snapshot.disk_full_actions[i] << "\n";
+    }
+
+    os << "# HELP ddsrecorder_memory_bytes Memory held by each recorder subsystem.\n";
+    os << "# TYPE ddsrecorder_memory_bytes gauge\n";
+
+    for (std::size_t i = 0; i < MEMORY_SUBSYSTEMS; i++)
+    {
+        os << "ddsrecorder_memory_bytes{subsystem=\"" << to_string(static_cast<MemorySubsystem>(i)) << "\"} "
+           << snapshot.memory_usage[i] << "\n";
+    }
+
+    os << "# HELP ddsrecorder_chunks_written_total MCAP chunks written, by the reason they were closed.\n";
+    os << "# TYPE ddsrecorder_chunks_written_total counter\n";
+
+    for (std::size_t i = 0; i < CHUNK_CLOSE_REASONS; i++)
+    {
+        os << "ddsrecorder_chunks_written_total{reason=\"" << to_string(static_cast<ChunkCloseReason>(i)) << "\"} "
+           << snapshot.chunks_written[i] << "\n";
+    }
+
+    serialize_histogram(os, "ddsrecorder_message_size_bytes",
+            "Size of the samples written to MCAP files.", snapshot.message_size);
+    serialize_histogram(os, "ddsrecorder_buffer_dump_duration_seconds",
+            "Time spent writing the samples buffer to disk.", snapshot.buffer_dump_duration);
+    serialize_histogram(os, "ddsrecorder_chunk_size_bytes",
+            "Estimated uncompressed size of the MCAP chunks written.", snapshot.chunk_size);
+    serialize_histogram(os, "ddsrecorder_chunk_duration_seconds",
+            "Time spanned by the messages of the MCAP chunks written.", snapshot.chunk_duration);
+
+    return os.str();
+}
+
+#ifndef _WIN32
+
+void PrometheusExporter::open_socket_()
+{
+    if (configuration_.kind == MetricsExporterKind::http)
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(configuration_.port);
+
+        if (inet_pton(AF_INET, configuration_.address.c_str(), &address.sin_addr) != 1)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Invalid metrics address " << configuration_.address << ".");
+        }
+
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (listen_fd_ < 0)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to create metrics socket: " << std::strerror(errno));
+        }
+
+        const int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            const std::string error = std::strerror(errno);
+            close_socket_();
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to bind metrics socket to " << configuration_.address << ":" <<
+                          configuration_.port << ": " << error);
+        }
+    }
+    else
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (configuration_.path.empty() || configuration_.path.size() >= sizeof(address.sun_path))
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Invalid metrics socket path " << configuration_.path << ".");
+        }
+
+        std::strncpy(address.sun_path, configuration_.path.c_str(), sizeof(address.sun_path) - 1);
+
+        // Remove a stale socket left by a previous execution
+        unlink(configuration_.path.c_str());
+
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (listen_fd_ < 0)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to create metrics socket: " << std::strerror(errno));
+        }
+
+        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            const std::string error = std::strerror(errno);
+            close_socket_();
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to bind metrics socket to " << configuration_.path << ": " << error);
+        }
+    }
+
+    if (listen(listen_fd_, SOMAXCONN) != 0)
+    {
+        const std::string error = std::strerror(errno);
+        close_socket_();
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to listen on metrics socket: " << error);
+    }
+}
+
+void PrometheusExporter::close_socket_() noexcept
+{
+    if (listen_fd_ < 0)
+    {
+        return;
+    }
+
+    close(listen_fd_);
+    listen_fd_ = -1;
+
+    if (configuration_.kind == MetricsExporterKind::unix_socket)
+    {
+        unlink(configuration_.path.c_str());
+    }
+}
+
+void PrometheusExporter::serve_routine_()
+{
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::io, "ddsrec.metrics");
+
+    while (running_)
+    {
+        pollfd listen_poll{listen_fd_, POLLIN, 0};
+
+        if (poll(&listen_poll, 1, POLL_TIMEOUT_MS) <= 0 || !(listen_poll.revents & POLLIN))
+        {
+            continue;
+        }
+
+        const int connection = accept(listen_fd_, nullptr, nullptr);
+
+        if (connection < 0)
+        {
+            continue;
+        }
+
+        serve_connection_(connection);
+        close(connection);
+    }
+}
+
+void PrometheusExporter::serve_connection_(
+        int connection)
+{
+    // Read the request headers
+    std::string request;
+    char chunk[512];
+
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+    {
+        pollfd connection_poll{connection, POLLIN, 0};
+
+        if (poll(&connection_poll, 1, POLL_TIMEOUT_MS) <= 0)
+        {
+            break;
+        }
+
+        const auto received = recv(connection, chunk, sizeof(chunk), 0);
+
+        if (received <= 0)
+        {
+            break;
+        }
+
+        request.append(chunk, static_cast<std::size_t>(received));
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+
+    const auto request_line = request.substr(0, request.find("\r\n"));
+
+    if (request_line.rfind("GET ", 0) != 0)
+    {
+        status = "405 Method Not Allowed";
+    }
+    else if (request_line.rfind("GET /metrics ", 0) != 0 && request_line.rfind("GET / ", 0) != 0)
+    {
+        status = "404 Not Found";
+    }
+    else
+    {
+        body = serialize(RecorderMetrics::get_instance().snapshot());
+    }
+
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n";
+    response << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n";
+    response << "Content-Length: " << body.size() << "\r\n";
+    response << "Connection: close\r\n\r\n";
+    response << body;
+
+    const auto data = response.str();
+    std::size_t sent = 0;
+
+#ifdef MSG_NOSIGNAL
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif // ifdef MSG_NOSIGNAL
+
+    while (sent < data.size())
+    {
+        const auto result = send(connection, data.data() + sent, data.size() - sent, flags);
+
+        if (result <= 0)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_METRICS,
+                    "METRICS | Failed to send metrics: " << std::strerror(errno));
+            return;
+        }
+
+        sent += static_cast<std::size_t>(result);
+    }
+}
+
+#else
+
+void PrometheusExporter::open_socket_()
+{
+    throw utils::InitializationException(
+              STR_ENTRY << "Serving metrics on a socket is not supported on this platform. Use a file instead.");
+}
+
+void PrometheusExporter::close_socket_() noexcept
+{
+}
+
+void PrometheusExporter::serve_routine_()
+{
+}
+
+void PrometheusExporter::serve_connection_(
+        int)
+{
+}
+
+#endif // ifndef _WIN32
+
+void PrometheusExporter::file_routine_()
+{
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::io, "ddsrec.metrics");
+
+    std::unique_lock<std::mutex> lock(cv_mutex_);
+
+    while (running_)
+    {
+        lock.unlock();
+        write_file_();
+        lock.lock();
+
+        cv_.wait_for(
+            lock,
+            std::chrono::milliseconds(configuration_.period),
+            [&]
+            {
+                return !running_;
+            });
+    }
+}
+
+void PrometheusExporter::write_file_() const
+{
+    const auto tmp_path = configuration_.path + ".tmp~";
+
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+
+        if (!file)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_METRICS,
+                    "METRICS | Failed to open " << tmp_path << " to write the metrics.");
+            return;
+        }
+
+        file << serialize(RecorderMetrics::get_instance().snapshot());
+    }
+
+    // Rename so readers never see a partially written file
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, configuration_.path, ec);
+
+    if (ec)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_METRICS,
+                "METRICS | Failed to write the metrics to " << configuration_.path << ": " << ec.message());
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
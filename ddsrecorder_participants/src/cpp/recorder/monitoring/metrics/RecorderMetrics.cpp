@@ -0,0 +1,398 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RecorderMetrics.cpp
+ */
+
+#include <utility>
+
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+AtomicHistogram::AtomicHistogram(
+        std::vector<double> bounds)
+    : bounds_(std::move(bounds))
+    , counts_(new std::atomic<std::uint64_t>[bounds_.size() + 1])
+{
+    reset();
+}
+
+void AtomicHistogram::observe(
+        const double value) noexcept
+{
+    std::size_t bucket = 0;
+
+    while (bucket < bounds_.size() && value > bounds_[bucket])
+    {
+        bucket++;
+    }
+
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    // NOTE: std::atomic<double>::fetch_add is only available from C++20
+    auto sum = sum_.load(std::memory_order_relaxed);
+    while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void AtomicHistogram::reset() noexcept
+{
+    for (std::size_t i = 0; i <= bounds_.size(); i++)
+    {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+
+    sum_.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+}
+
+HistogramSnapshot AtomicHistogram::snapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.bounds = bounds_;
+    snapshot.cumulative_counts.reserve(bounds_.size() + 1);
+
+    std::uint64_t accumulated = 0;
+
+    for (std::size_t i = 0; i <= bounds_.size(); i++)
+    {
+        accumulated += counts_[i].load(std::memory_order_relaxed);
+        snapshot.cumulative_counts.push_back(accumulated);
+    }
+
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+
+    // The buckets are read one by one, so report the count that matches them (i.e. the +Inf bucket)
+    snapshot.count = accumulated;
+
+    return snapshot;
+}
+
+const char* to_string(
+        const MemorySubsystem subsystem) noexcept
+{
+    switch (subsystem)
+    {
+        case MemorySubsystem::payloads:
+            return "payloads";
+        case MemorySubsystem::samples_buffer:
+            return "samples_buffer";
+        case MemorySubsystem::pending_samples:
+            return "pending_samples";
+        case MemorySubsystem::schemas_and_channels:
+            return "schemas_and_channels";
+        case MemorySubsystem::dynamic_types:
+            return "dynamic_types";
+        case MemorySubsystem::mcap_chunks:
+            return "mcap_chunks";
+        case MemorySubsystem::stream_frames:
+            return "stream_frames";
+        case MemorySubsystem::keyframes:
+            return "keyframes";
+        default:
+            return "unknown";
+    }
+}
+
+const char* to_string(
+        const ChunkCloseReason reason) noexcept
+{
+    switch (reason)
+    {
+        case ChunkCloseReason::size:
+            return "size";
+        case ChunkCloseReason::duration:
+            return "duration";
+        case ChunkCloseReason::rate_change:
+            return "rate_change";
+        case ChunkCloseReason::flush:
+            return "flush";
+        default:
+            return "unknown";
+    }
+}
+
+const char* to_string(
+        const DiskFullAction action) noexcept
+{
+    switch (action)
+    {
+        case DiskFullAction::warning:
+            return "warning";
+        case DiskFullAction::compression:
+            return "compression";
+        case DiskFullAction::drop:
+            return "drop";
+        default:
+            return "unknown";
+    }
+}
+
+RecorderMetrics::RecorderMetrics()
+    : message_size_({64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216})
+    , buffer_dump_duration_({0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5})
+    , chunk_size_({16384, 65536, 262144, 1048576, 4194304, 16777216, 67108864})
+    , chunk_duration_({0.001, 0.01, 0.1, 0.5, 1, 5, 10, 60})
+{
+}
+
+RecorderMetrics& RecorderMetrics::get_instance() noexcept
+{
+    static RecorderMetrics instance;
+    return instance;
+}
+
+void RecorderMetrics::message_received() noexcept
+{
+    messages_received_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::message_dropped(
+        const std::uint64_t samples /* = 1 */) noexcept
+{
+    messages_dropped_.fetch_add(samples, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::message_written(
+        const std::uint64_t size) noexcept
+{
+    messages_written_.fetch_add(1, std::memory_order_relaxed);
+    bytes_written_.fetch_add(size, std::memory_order_relaxed);
+    message_size_.observe(static_cast<double>(size));
+}
+
+void RecorderMetrics::buffer_dumped(
+        const std::chrono::nanoseconds& duration) noexcept
+{
+    buffer_dump_duration_.observe(std::chrono::duration<double>(duration).count());
+}
+
+void RecorderMetrics::chunk_written(
+        const ChunkCloseReason reason,
+        const std::uint64_t size,
+        const std::chrono::nanoseconds& duration) noexcept
+{
+    chunks_written_[static_cast<std::size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    chunk_size_.observe(static_cast<double>(size));
+    chunk_duration_.observe(std::chrono::duration<double>(duration).count());
+}
+
+void RecorderMetrics::blob_written(
+        const std::uint64_t size) noexcept
+{
+    blobs_written_.fetch_add(1, std::memory_order_relaxed);
+    blob_bytes_written_.fetch_add(size, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::blob_deduplicated(
+        const std::uint64_t size) noexcept
+{
+    blobs_deduplicated_.fetch_add(1, std::memory_order_relaxed);
+    deduplicated_bytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::file_opened() noexcept
+{
+    files_opened_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::file_closed() noexcept
+{
+    files_closed_.fetch_add(1, std::memory_order_relaxed);
+    current_file_size_.store(0, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::file_creation_failed() noexcept
+{
+    file_creation_failures_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::disk_full() noexcept
+{
+    disk_full_events_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::file_migrated() noexcept
+{
+    files_migrated_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::migration_failed() noexcept
+{
+    migration_failures_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_buffered_samples(
+        const std::uint64_t samples) noexcept
+{
+    buffered_samples_.store(samples, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_pending_samples(
+        const std::uint64_t samples) noexcept
+{
+    pending_samples_.store(samples, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_current_file_size(
+        const std::uint64_t size) noexcept
+{
+    current_file_size_.store(size, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_migration_backlog(
+        const std::uint64_t files,
+        const std::uint64_t bytes) noexcept
+{
+    migration_backlog_files_.store(files, std::memory_order_relaxed);
+    migration_backlog_bytes_.store(bytes, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_disk_full_forecast(
+        const double write_rate,
+        const double time_to_full) noexcept
+{
+    write_rate_.store(write_rate, std::memory_order_relaxed);
+    time_to_full_.store(time_to_full, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_disk_full_action(
+        const DiskFullAction action,
+        const bool active) noexcept
+{
+    disk_full_actions_[static_cast<std::size_t>(action)].store(active ? 1 : 0, std::memory_order_relaxed);
+}
+
+void RecorderMetrics::set_memory_usage(
+        const MemorySubsystem subsystem,
+        const std::uint64_t bytes) noexcept
+{
+    memory_usage_[static_cast<std::size_t>(subsystem)].store(bytes, std::memory_order_relaxed);
+}
+
+std::uint64_t RecorderMetrics::total_memory_usage() const noexcept
+{
+    std::uint64_t total = 0;
+
+    for (const auto& bytes : memory_usage_)
+    {
+        total += bytes.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+RecorderMetricsSnapshot RecorderMetrics::snapshot() const
+{
+    RecorderMetricsSnapshot snapshot;
+
+    snapshot.messages_received = messages_received_.load(std::memory_order_relaxed);
+    snapshot.messages_written = messages_written_.load(std::memory_order_relaxed);
+    snapshot.messages_dropped = messages_dropped_.load(std::memory_order_relaxed);
+    snapshot.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    snapshot.files_opened = files_opened_.load(std::memory_order_relaxed);
+    snapshot.files_closed = files_closed_.load(std::memory_order_relaxed);
+    snapshot.file_creation_failures = file_creation_failures_.load(std::memory_order_relaxed);
+    snapshot.disk_full_events = disk_full_events_.load(std::memory_order_relaxed);
+    snapshot.blobs_written = blobs_written_.load(std::memory_order_relaxed);
+    snapshot.blob_bytes_written = blob_bytes_written_.load(std::memory_order_relaxed);
+    snapshot.blobs_deduplicated = blobs_deduplicated_.load(std::memory_order_relaxed);
+    snapshot.deduplicated_bytes = deduplicated_bytes_.load(std::memory_order_relaxed);
+    snapshot.files_migrated = files_migrated_.load(std::memory_order_relaxed);
+    snapshot.migration_failures = migration_failures_.load(std::memory_order_relaxed);
+    snapshot.buffered_samples = buffered_samples_.load(std::memory_order_relaxed);
+    snapshot.pending_samples = pending_samples_.load(std::memory_order_relaxed);
+    snapshot.current_file_size = current_file_size_.load(std::memory_order_relaxed);
+    snapshot.migration_backlog_files = migration_backlog_files_.load(std::memory_order_relaxed);
+    snapshot.migration_backlog_bytes = migration_backlog_bytes_.load(std::memory_order_relaxed);
+    snapshot.write_rate = write_rate_.load(std::memory_order_relaxed);
+    snapshot.time_to_full = time_to_full_.load(std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < DISK_FULL_ACTIONS; i++)
+    {
+        snapshot.disk_full_actions[i] = disk_full_actions_[i].load(std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0; i < MEMORY_SUBSYSTEMS; i++)
+    {
+        snapshot.memory_usage[i] = memory_usage_[i].load(std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0; i < CHUNK_CLOSE_REASONS; i++)
+    {
+        snapshot.chunks_written[i] = chunks_written_[i].load(std::memory_order_relaxed);
+    }
+
+    snapshot.message_size = message_size_.snapshot();
+    snapshot.buffer_dump_duration = buffer_dump_duration_.snapshot();
+    snapshot.chunk_size = chunk_size_.snapshot();
+    snapshot.chunk_duration = chunk_duration_.snapshot();
+
+    return snapshot;
+}
+
+void RecorderMetrics::reset() noexcept
+{
+    messages_received_.store(0, std::memory_order_relaxed);
+    messages_written_.store(0, std::memory_order_relaxed);
+    messages_dropped_.store(0, std::memory_order_relaxed);
+    bytes_written_.store(0, std::memory_order_relaxed);
+    files_opened_.store(0, std::memory_order_relaxed);
+    files_closed_.store(0, std::memory_order_relaxed);
+    file_creation_failures_.store(0, std::memory_order_relaxed);
+    disk_full_events_.store(0, std::memory_order_relaxed);
+    blobs_written_.store(0, std::memory_order_relaxed);
+    blob_bytes_written_.store(0, std::memory_order_relaxed);
+    blobs_deduplicated_.store(0, std::memory_order_relaxed);
+    deduplicated_bytes_.store(0, std::memory_order_relaxed);
+    files_migrated_.store(0, std::memory_order_relaxed);
+    migration_failures_.store(0, std::memory_order_relaxed);
+    buffered_samples_.store(0, std::memory_order_relaxed);
+    pending_samples_.store(0, std::memory_order_relaxed);
+    current_file_size_.store(0, std::memory_order_relaxed);
+    migration_backlog_files_.store(0, std::memory_order_relaxed);
+    migration_backlog_bytes_.store(0, std::memory_order_relaxed);
+    write_rate_.store(0, std::memory_order_relaxed);
+    time_to_full_.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+
+    for (auto& active : disk_full_actions_)
+    {
+        active.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& bytes : memory_usage_)
+    {
+        bytes.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& chunks : chunks_written_)
+    {
+        chunks.store(0, std::memory_order_relaxed);
+    }
+
+    message_size_.reset();
+    buffer_dump_duration_.reset();
+    chunk_size_.reset();
+    chunk_duration_.reset();
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
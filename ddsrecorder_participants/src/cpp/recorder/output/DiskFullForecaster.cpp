@@ -0,0 +1,147 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiskFullForecaster.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <ddsrecorder_participants/recorder/output/DiskFullForecaster.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+DiskFullForecaster::DiskFullForecaster(
+        const DiskFullForecastConfiguration& configuration)
+    : configuration_(configuration)
+    , time_to_full_(std::numeric_limits<double>::infinity())
+{
+}
+
+std::uint64_t DiskFullForecaster::remaining(
+        const std::uint64_t used,
+        const std::uint64_t max_size,
+        const std::uint64_t available,
+        const bool file_rotation) noexcept
+{
+    const auto growth_left = max_size > used ? max_size - used : 0;
+
+    if (!file_rotation)
+    {
+        return std::min(growth_left, available);
+    }
+
+    return available < growth_left ? available : NEVER_FULL;
+}
+
+bool DiskFullForecaster::update(
+        const std::chrono::steady_clock::time_point& now,
+        const std::uint64_t written,
+        const std::uint64_t remaining) noexcept
+{
+    if (!initialized_)
+    {
+        last_update_ = now;
+        last_written_ = written;
+        initialized_ = true;
+        return false;
+    }
+
+    const auto elapsed = std::chrono::duration<double>(now - last_update_).count();
+
+    if (elapsed <= 0)
+    {
+        return false;
+    }
+
+    const auto instant_rate = written > last_written_ ? (written - last_written_) / elapsed : 0.0;
+
+    if (write_rate_ == 0)
+    {
+        // Start from the first observed rate instead of ramping up from zero
+        write_rate_ = instant_rate;
+    }
+    else
+    {
+        const auto alpha = configuration_.rate_window > 0 ?
+                1 - std::exp(-elapsed / configuration_.rate_window) : 1.0;
+
+        write_rate_ += alpha * (instant_rate - write_rate_);
+    }
+
+    last_update_ = now;
+    last_written_ = written;
+
+    time_to_full_ = write_rate_ > 0 && remaining != NEVER_FULL ?
+            remaining / write_rate_ : std::numeric_limits<double>::infinity();
+
+    bool changed = false;
+
+    for (std::size_t i = 0; i < DISK_FULL_ACTIONS; i++)
+    {
+        const auto threshold = threshold_(static_cast<DiskFullAction>(i));
+
+        bool active = false;
+
+        if (threshold > 0)
+        {
+            active = time_to_full_ < (active_[i] ? HYSTERESIS * threshold : threshold);
+        }
+
+        changed |= active != active_[i];
+        active_[i] = active;
+    }
+
+    return changed;
+}
+
+double DiskFullForecaster::write_rate() const noexcept
+{
+    return write_rate_;
+}
+
+double DiskFullForecaster::time_to_full() const noexcept
+{
+    return time_to_full_;
+}
+
+bool DiskFullForecaster::active(
+        const DiskFullAction action) const noexcept
+{
+    return active_[static_cast<std::size_t>(action)];
+}
+
+std::uint64_t DiskFullForecaster::threshold_(
+        const DiskFullAction action) const noexcept
+{
+    switch (action)
+    {
+        case DiskFullAction::warning:
+            return configuration_.warning_threshold;
+        case DiskFullAction::compression:
+            return configuration_.compression_threshold;
+        case DiskFullAction::drop:
+            return configuration_.drop_threshold;
+        default:
+            return 0;
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
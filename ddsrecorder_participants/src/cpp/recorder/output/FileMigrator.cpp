@@ -0,0 +1,384 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file FileMigrator.cpp
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ifndef _WIN32
+
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+#include <ddsrecorder_participants/recorder/output/FileMigrator.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Suffix of the files being copied to their final location
+const std::string MIGRATION_TMP_SUFFIX = ".tmp~";
+
+#ifndef _WIN32
+//! Size of the buffer used to copy a file to a different filesystem
+constexpr std::size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+//! Closes a file descriptor when going out of scope
+struct FileDescriptor
+{
+    ~FileDescriptor()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+
+    int fd{-1};
+};
+
+[[noreturn]] void throw_errno(
+        const std::string& action,
+        const std::string& path)
+{
+    throw std::runtime_error("Failed to " + action + " " + path + ": " + std::strerror(errno));
+}
+
+#endif // ifndef _WIN32
+
+} /* namespace */
+
+FileMigrator::FileMigrator()
+{
+    thread_ = std::thread(&FileMigrator::run_, this);
+}
+
+FileMigrator::~FileMigrator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!pending_.empty() || !current_.empty())
+        {
+            EPROSIMA_LOG_INFO(DDSRECORDER_FILE_MIGRATOR,
+                    "Waiting for " << pending_.size() + (current_.empty() ? 0 : 1) << " files (" <<
+                    utils::from_bytes(backlog_size_) << ") to be moved out of the staging directory.");
+        }
+
+        stop_ = true;
+    }
+
+    cv_.notify_all();
+    thread_.join();
+}
+
+void FileMigrator::migrate(
+        const std::string& source,
+        const std::string& destination,
+        const std::uint64_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        pending_.push_back({source, destination, size});
+        backlog_size_ += size;
+        update_metrics_nts_();
+    }
+
+    cv_.notify_all();
+}
+
+bool FileMigrator::discard(
+        const std::string& destination) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (current_ == destination)
+    {
+        // The file is removed once moved
+        current_discarded_ = true;
+        return true;
+    }
+
+    const auto it = std::find_if(pending_.begin(), pending_.end(), [&](const Migration& migration)
+                    {
+                        return migration.destination == destination;
+                    });
+
+    if (it == pending_.end())
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(it->source, ec);
+
+    if (ec)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_FILE_MIGRATOR,
+                "Failed to remove staged file " << it->source << ": " << ec.message());
+    }
+
+    backlog_size_ -= it->size;
+    pending_.erase(it);
+    update_metrics_nts_();
+
+    return true;
+}
+
+std::uint64_t FileMigrator::staged_size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return backlog_size_ + stranded_size_;
+}
+
+void FileMigrator::run_() noexcept
+{
+    ThreadPlacement::get_instance().place_current_thread(ThreadKind::io, "ddsrec.migrate");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        cv_.wait(lock, [&]
+                {
+                    return stop_ || !pending_.empty();
+                });
+
+        if (pending_.empty())
+        {
+            // Stopped and every file has been moved
+            break;
+        }
+
+        const auto migration = pending_.front();
+        pending_.pop_front();
+
+        current_ = migration.destination;
+        current_discarded_ = false;
+
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        bool moved = true;
+
+        try
+        {
+            move_(migration.source, migration.destination);
+        }
+        catch (const std::exception& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER_FILE_MIGRATOR,
+                    "Failed to move " << migration.source << " to " << migration.destination << ": " << e.what() <<
+                    ". The file is left in the staging directory.");
+            moved = false;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        lock.lock();
+
+        backlog_size_ -= migration.size;
+
+        const auto discarded_path = moved ? migration.destination : migration.source;
+
+        if (current_discarded_)
+        {
+            // The file was removed from the tracker while being moved
+            std::error_code ec;
+            std::filesystem::remove(discarded_path, ec);
+        }
+        else if (!moved)
+        {
+            stranded_size_ += migration.size;
+        }
+
+        if (moved)
+        {
+            RecorderMetrics::get_instance().file_migrated();
+
+            EPROSIMA_LOG_INFO(DDSRECORDER_FILE_MIGRATOR,
+                    "Moved " << migration.source << " (" << utils::from_bytes(migration.size) << ") to " <<
+                    migration.destination << " in " << elapsed.count() << " ms.");
+        }
+        else
+        {
+            RecorderMetrics::get_instance().migration_failed();
+        }
+
+        current_.clear();
+        update_metrics_nts_();
+    }
+}
+
+void FileMigrator::move_(
+        const std::string& source,
+        const std::string& destination)
+{
+    const auto directory = std::filesystem::path(destination).parent_path().string();
+
+    std::error_code ec;
+    std::filesystem::rename(source, destination, ec);
+
+    if (!ec)
+    {
+        // Same filesystem: the rename is enough, but the data may not have reached the disk yet
+        sync_(destination);
+        sync_(directory);
+        return;
+    }
+
+    if (ec != std::errc::cross_device_link)
+    {
+        throw std::filesystem::filesystem_error("Failed to rename", source, destination, ec);
+    }
+
+    const auto tmp_destination = destination + MIGRATION_TMP_SUFFIX;
+
+    try
+    {
+        copy_and_sync_(source, tmp_destination);
+        std::filesystem::rename(tmp_destination, destination);
+    }
+    catch (...)
+    {
+        std::filesystem::remove(tmp_destination, ec);
+        throw;
+    }
+
+    sync_(directory);
+
+    // Only remove the staged file once the copy is safe on disk
+    std::filesystem::remove(source, ec);
+
+    if (ec)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_FILE_MIGRATOR,
+                "Failed to remove staged file " << source << " after moving it: " << ec.message());
+    }
+}
+
+void FileMigrator::copy_and_sync_(
+        const std::string& source,
+        const std::string& destination)
+{
+#ifdef _WIN32
+    std::filesystem::copy_file(source, destination, std::filesystem::copy_options::overwrite_existing);
+#else
+    FileDescriptor in;
+    in.fd = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (in.fd < 0)
+    {
+        throw_errno("open", source);
+    }
+
+    FileDescriptor out;
+    out.fd = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (out.fd < 0)
+    {
+        throw_errno("create", destination);
+    }
+
+    std::vector<char> buffer(COPY_BUFFER_SIZE);
+
+    while (true)
+    {
+        const auto read = ::read(in.fd, buffer.data(), buffer.size());
+
+        if (read < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw_errno("read", source);
+        }
+
+        if (read == 0)
+        {
+            break;
+        }
+
+        std::size_t written = 0;
+
+        while (written < static_cast<std::size_t>(read))
+        {
+            const auto ret = ::write(out.fd, buffer.data() + written, read - written);
+
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                throw_errno("write", destination);
+            }
+
+            written += ret;
+        }
+    }
+
+    if (::fsync(out.fd) != 0)
+    {
+        throw_errno("sync", destination);
+    }
+#endif // ifdef _WIN32
+}
+
+void FileMigrator::sync_(
+        const std::string& path)
+{
+#ifndef _WIN32
+    FileDescriptor file;
+    file.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (file.fd >= 0)
+    {
+        ::fsync(file.fd);
+    }
+#endif // ifndef _WIN32
+}
+
+void FileMigrator::update_metrics_nts_() const noexcept
+{
+    RecorderMetrics::get_instance().set_migration_backlog(
+        pending_.size() + (current_.empty() ? 0 : 1),
+        backlog_size_);
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
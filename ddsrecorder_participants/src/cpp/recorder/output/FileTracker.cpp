@@ -17,9 +17,12 @@
  */
 
 #include <filesystem>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 #include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/exception/InitializationException.hpp>
 #include <cpp_utils/Formatter.hpp>
 #include <cpp_utils/Log.hpp>
 #include <cpp_utils/time/time_utils.hpp>
@@ -41,6 +44,33 @@ FileTracker::FileTracker(
         const OutputSettings& configuration)
     : configuration_(configuration)
 {
+    if (configuration_.sink != OutputSinkKind::file || configuration_.staging_path.empty())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(configuration_.staging_path, ec);
+
+    if (ec)
+    {
+        throw utils::InitializationException(utils::Formatter() <<
+                      "Failed to create the staging directory " << configuration_.staging_path << ": " <<
+                      ec.message());
+    }
+
+    staging_max_size_ = configuration_.staging_max_size;
+
+    if (staging_max_size_ == 0)
+    {
+        staging_max_size_ = std::filesystem::space(configuration_.staging_path, ec).available;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_FILE_TRACKER,
+            "Staging the files in " << configuration_.staging_path << " (up to " <<
+            utils::from_bytes(staging_max_size_) << ").");
+
+    migrator_ = std::make_unique<FileMigrator>();
 }
 
 FileTracker::~FileTracker()
@@ -98,9 +128,32 @@ void FileTracker::new_file(
 
     // Generate the new file's name
     const auto name = generate_filename_(id);
-    const auto tmp_name = make_filename_tmp_(name);
+    current_staged_name_.clear();
+
+    if (migrator_)
+    {
+        // NOTE: The file is only staged if it fits even if it grows up to the max file size.
+        const auto staged_size = migrator_->staged_size();
+
+        if (staged_size + configuration_.max_file_size <= staging_max_size_)
+        {
+            current_staged_name_ = configuration_.staging_path + "/" + std::filesystem::path(name).filename().string();
+        }
+        else
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_FILE_TRACKER,
+                    "The staging directory is full (" << utils::from_bytes(staged_size) << " waiting to be moved). " <<
+                    "Writing " << name << " straight to the output directory.");
+        }
+    }
 
-    if (std::filesystem::exists(name))
+    const auto tmp_name = make_filename_tmp_(current_staged_name_.empty() ? name : current_staged_name_);
+
+    if (configuration_.sink != OutputSinkKind::file)
+    {
+        // The file is never written to disk
+    }
+    else if (std::filesystem::exists(name))
     {
         EPROSIMA_LOG_ERROR(DDSRECORDER_FILE_TRACKER, "File " + name + " already exists.");
     }
@@ -136,9 +189,22 @@ void FileTracker::close_file() noexcept
     closed_files_.push_back(current_file_);
     size_ += current_file_.size;
 
+    if (configuration_.sink != OutputSinkKind::file)
+    {
+        current_file_ = File();
+        return;
+    }
+
+    const auto& closed_name = current_staged_name_.empty() ? current_file_.name : current_staged_name_;
+
     try
     {
-        std::filesystem::rename(get_current_filename(), current_file_.name);
+        std::filesystem::rename(get_current_filename(), closed_name);
+
+        if (!current_staged_name_.empty())
+        {
+            migrator_->migrate(current_staged_name_, current_file_.name, current_file_.size);
+        }
     }
     catch (const std::filesystem::filesystem_error& e)
     {
@@ -147,6 +213,7 @@ void FileTracker::close_file() noexcept
     }
 
     current_file_ = File();
+    current_staged_name_.clear();
 }
 
 std::uint64_t FileTracker::get_total_size() const noexcept
@@ -156,7 +223,7 @@ std::uint64_t FileTracker::get_total_size() const noexcept
 
 std::string FileTracker::get_current_filename() const noexcept
 {
-    return make_filename_tmp_(current_file_.name);
+    return make_filename_tmp_(current_staged_name_.empty() ? current_file_.name : current_staged_name_);
 }
 
 void FileTracker::set_current_file_size(
@@ -182,6 +249,33 @@ void FileTracker::set_current_file_size(
     current_file_.size = file_size;
 }
 
+void FileTracker::set_current_file_contents(
+        std::vector<std::byte>&& contents) noexcept
+{
+    current_file_.contents = std::make_shared<const std::vector<std::byte>>(std::move(contents));
+}
+
+void FileTracker::set_current_file_sidecar(
+        const std::string& sidecar,
+        const bool created) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    current_file_.sidecar = sidecar;
+
+    if (created)
+    {
+        created_sidecars_.insert(sidecar);
+    }
+}
+
+std::vector<File> FileTracker::get_closed_files()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return closed_files_;
+}
+
 std::uint64_t FileTracker::remove_oldest_file_nts_() noexcept
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_FILE_TRACKER, "Removing the oldest file.");
@@ -198,9 +292,27 @@ std::uint64_t FileTracker::remove_oldest_file_nts_() noexcept
     // Remove the oldest file from the list
     closed_files_.erase(closed_files_.begin());
 
+    if (configuration_.sink != OutputSinkKind::file)
+    {
+        // Its contents (if any) are released once no copy of the file references them
+        EPROSIMA_LOG_INFO(DDSRECORDER_FILE_TRACKER, "File " << oldest_file.to_str() << " removed from memory.");
+        return oldest_file.size;
+    }
+
+    if (migrator_ && migrator_->discard(oldest_file.name))
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_FILE_TRACKER,
+                "File " << oldest_file.to_str() << " removed before being moved out of the staging directory.");
+        remove_unreferenced_sidecar_nts_(oldest_file.sidecar);
+        return oldest_file.size;
+    }
+
     // Remove the oldest file
     const auto ret = std::filesystem::remove(oldest_file.name);
 
+    // The sidecar is not needed anymore if no other file references it
+    remove_unreferenced_sidecar_nts_(oldest_file.sidecar);
+
     if (!ret)
     {
         EPROSIMA_LOG_WARNING(DDSRECORDER_FILE_TRACKER,
@@ -212,6 +324,36 @@ std::uint64_t FileTracker::remove_oldest_file_nts_() noexcept
     return oldest_file.size;
 }
 
+void FileTracker::remove_unreferenced_sidecar_nts_(
+        const std::string& sidecar) noexcept
+{
+    if (sidecar.empty() || created_sidecars_.count(sidecar) == 0 || current_file_.sidecar == sidecar)
+    {
+        return;
+    }
+
+    for (const auto& file : closed_files_)
+    {
+        if (file.sidecar == sidecar)
+        {
+            return;
+        }
+    }
+
+    created_sidecars_.erase(sidecar);
+
+    std::error_code ec;
+
+    if (!std::filesystem::remove(sidecar, ec))
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_FILE_TRACKER,
+                "Dynamic types sidecar " << sidecar << " could not be deleted: " << ec.message());
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_FILE_TRACKER, "Dynamic types sidecar " << sidecar << " removed.");
+}
+
 std::string FileTracker::generate_filename_(
         const std::uint64_t id) const noexcept
 {
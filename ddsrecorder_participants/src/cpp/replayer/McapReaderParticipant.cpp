@@ -16,6 +16,11 @@
  * @file McapReaderParticipant.cpp
  */
 
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+
 #include <mcap/reader.hpp>
 
 #include <fastdds/rtps/common/Time_t.hpp>
@@ -33,6 +38,7 @@
 #include <ddspipe_participants/reader/auxiliar/BlankReader.hpp>
 #include <ddspipe_participants/writer/auxiliar/BlankWriter.hpp>
 
+#include <ddsrecorder_participants/common/mcap/McapBlob.hpp>
 #include <ddsrecorder_participants/constants.hpp>
 #include <ddsrecorder_participants/replayer/McapReaderParticipant.hpp>
 
@@ -114,6 +120,13 @@ void McapReaderParticipant::process_mcap()
                   );
     }
 
+    // Files recorded with lazy channels do not repeat their channels in the summary section: scan them instead
+    status = mcap_reader.readSummary(mcap::ReadSummaryMethod::AllowFallbackScan);
+    if (status.ok() && mcap_reader.channels().empty())
+    {
+        status = mcap_reader.readSummary(mcap::ReadSummaryMethod::ForceScan);
+    }
+
     // NOTE: begin_time < end_time assertion already done in YAML module
     mcap::Timestamp begin_time = 0;
     mcap::Timestamp end_time = mcap::MaxTime;
@@ -173,22 +186,112 @@ void McapReaderParticipant::process_mcap()
         initial_ts = now;
     }
 
+    // The payloads written out of the chunks (blobs) are read through their own file handle, so reading them does not
+    // invalidate the messages being iterated
+    std::unique_ptr<std::FILE, decltype(& std::fclose)> blobs_file(nullptr, &std::fclose);
+    std::unique_ptr<mcap::FileReader> blobs_source;
+    mcap::ByteArray blob_payload;
+
+    // The last blob read in each channel, kept in the payload pool so the messages repeating it share its payload
+    // NOTE: A recorder deduplicating blobs references the same blob from every message repeating its payload.
+    std::map<mcap::ChannelId, std::pair<std::uint64_t, Payload>> channel_blobs;
+
+    // A recorder recording several domains writes the domain of every channel in its metadata
+    const std::string recorded_domain = configuration_->recorded_domain.is_set() ?
+            std::to_string(configuration_->recorded_domain.get_reference().domain_id) : "";
+
     // Schedule messages to be replayed
     utils::Timestamp scheduled_write_ts;
     for (auto it = messages.begin(); it != messages_end; it++)
     {
+        if (!recorded_domain.empty())
+        {
+            const auto domain_it = it->channel->metadata.find(DOMAIN_ID_METADATA);
+
+            if (domain_it != it->channel->metadata.end() && domain_it->second != recorded_domain)
+            {
+                continue;
+            }
+        }
+
+        const std::byte* payload_data = it->message.data;
+        std::uint64_t payload_size = it->message.dataSize;
+
+        std::uint64_t blob_offset;
+        std::uint64_t blob_size;
+        const Payload* shared_payload = nullptr;
+
+        if (McapBlob::parse_reference(payload_data, payload_size, blob_offset, blob_size))
+        {
+            auto& channel_blob = channel_blobs[it->channel->id];
+
+            if (channel_blob.second.length == 0 || channel_blob.first != blob_offset)
+            {
+                if (blobs_source == nullptr)
+                {
+                    blobs_file.reset(std::fopen(file_path_.c_str(), "rb"));
+
+                    if (blobs_file == nullptr)
+                    {
+                        throw utils::InconsistencyException(
+                                  STR_ENTRY << "Failed to open " << file_path_ << " to read its blobs.");
+                    }
+
+                    blobs_source = std::make_unique<mcap::FileReader>(blobs_file.get());
+                }
+
+                try
+                {
+                    McapBlob::read(*blobs_source, blob_offset, blob_size, blob_payload);
+                }
+                catch (const utils::InconsistencyException& e)
+                {
+                    EPROSIMA_LOG_WARNING(DDSREPLAYER_MCAP_READER_PARTICIPANT,
+                            "Failed to read the payload of a message in topic " << it->channel->topic << ": " <<
+                            e.what() << " Skipping...");
+                    continue;
+                }
+
+                if (channel_blob.second.length > 0)
+                {
+                    payload_pool_->release_payload(channel_blob.second);
+                }
+
+                // Copy the payload of the blob to the payload pool once
+                Payload blob;
+                blob.length = blob_payload.size();
+                blob.max_size = blob_payload.size();
+                blob.data = reinterpret_cast<unsigned char*>(blob_payload.data());
+
+                payload_pool_->get_payload(blob, channel_blob.second); // this reserves and copies payload
+                blob.data = nullptr; // Set to nullptr after copy to avoid free on destruction
+
+                channel_blob.first = blob_offset;
+            }
+
+            shared_payload = &channel_blob.second;
+        }
+
         // Create RTPS data
         auto data = std::make_unique<RtpsPayloadData>();
 
-        // Create data payload
-        Payload mcap_payload;
-        mcap_payload.length = it->message.dataSize;
-        mcap_payload.max_size = it->message.dataSize;
-        mcap_payload.data = (unsigned char*)reinterpret_cast<const unsigned char*>(it->message.data);
-
-        // Copy payload from MCAP file to RTPS data through payload pool
-        payload_pool_->get_payload(mcap_payload, data->payload); // this reserves and copies payload
-        mcap_payload.data = nullptr; // Set to nullptr after copy to avoid free on destruction
+        if (shared_payload != nullptr)
+        {
+            // Reference the payload of the blob, shared by every message repeating it
+            payload_pool_->get_payload(*shared_payload, data->payload);
+        }
+        else
+        {
+            // Create data payload
+            Payload mcap_payload;
+            mcap_payload.length = payload_size;
+            mcap_payload.max_size = payload_size;
+            mcap_payload.data = (unsigned char*)reinterpret_cast<const unsigned char*>(payload_data);
+
+            // Copy payload from MCAP file to RTPS data through payload pool
+            payload_pool_->get_payload(mcap_payload, data->payload); // this reserves and copies payload
+            mcap_payload.data = nullptr; // Set to nullptr after copy to avoid free on destruction
+        }
 
         // Set publication delay from original log time and configured playback rate
         auto delay = mcap_timestamp_to_std_timepoint(it->message.logTime) - initial_ts_origin;
@@ -244,6 +347,15 @@ void McapReaderParticipant::process_mcap()
         readers_it->second->simulate_data_reception(std::move(data));
     }
 
+    // Release the payloads of the blobs (those shared with messages not yet replayed are kept until replayed)
+    for (auto& channel_blob : channel_blobs)
+    {
+        if (channel_blob.second.second.length > 0)
+        {
+            payload_pool_->release_payload(channel_blob.second.second);
+        }
+    }
+
     mcap_reader.close();
 }
 
@@ -0,0 +1,881 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file McapVerifier.cpp
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <mcap/reader.hpp>
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicPubSubType.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilder.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilderFactory.hpp>
+#include <fastdds/dds/xtypes/type_representation/TypeObject.hpp>
+#include <fastdds/rtps/common/CdrSerialization.hpp>
+#include <fastdds/rtps/common/SerializedPayload.hpp>
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/ros2_mangling.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/common/mcap/Crc32.hpp>
+#include <ddsrecorder_participants/common/mcap/McapBlob.hpp>
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollectionPubSubTypes.hpp>
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesSidecar.hpp>
+#include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/verifier/McapVerifier.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+using FilePtr = std::unique_ptr<std::FILE, decltype(& std::fclose)>;
+
+/**
+ * State of a file shared by the tasks verifying its chunks.
+ */
+struct FileContext
+{
+    //! Result of the file, protected by \c mutex
+    FileVerification* result{nullptr};
+
+    //! Whether the summary of the file has been read (i.e. whether its chunks can be verified)
+    bool valid{false};
+
+    //! Chunk indexes of the summary
+    std::vector<mcap::ChunkIndex> chunk_indexes;
+
+    //! Topic name of every channel of the summary
+    std::unordered_map<mcap::ChannelId, std::string> topics;
+
+    //! Type of every channel whose messages can be deserialized
+    std::unordered_map<mcap::ChannelId, std::shared_ptr<fastdds::dds::TypeSupport>> decoders;
+
+    //! Statistics of the summary (if any)
+    std::optional<mcap::Statistics> statistics;
+
+    //! Messages counted per channel, protected by \c mutex
+    std::unordered_map<mcap::ChannelId, std::uint64_t> channel_messages;
+
+    //! Messages sampled per channel, protected by \c mutex
+    std::unordered_map<mcap::ChannelId, std::uint32_t> channel_samples;
+
+    //! Protects \c result and the per-channel counters
+    std::mutex mutex;
+};
+
+/**
+ * Result of verifying a chunk, merged into its \c FileContext once the chunk is done.
+ */
+struct ChunkVerification
+{
+    bool without_crc{false};
+    bool crc_error{false};
+    bool chunk_error{false};
+    std::uint64_t index_errors{0};
+    std::unordered_map<mcap::ChannelId, TopicVerification> channels;
+    std::vector<std::string> errors;
+};
+
+//! Run \c task for every index in [0, n_tasks) from \c n_threads threads (the calling one included)
+void parallel_for(
+        const std::size_t n_threads,
+        const std::size_t n_tasks,
+        const std::function<void(std::size_t)>& task)
+{
+    std::atomic<std::size_t> next_task{0};
+
+    const auto worker = [&]()
+            {
+                for (auto i = next_task++; i < n_tasks; i = next_task++)
+                {
+                    task(i);
+                }
+            };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < std::min(n_threads, n_tasks); i++)
+    {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+//! Open \c path for reading
+FilePtr open_file(
+        const std::string& path)
+{
+    return FilePtr(std::fopen(path.c_str(), "rb"), &std::fclose);
+}
+
+/**
+ * @brief Read the record at \c offset of \c source , and check its opcode.
+ *
+ * @throws \c InconsistencyException if the record cannot be read or its opcode is not \c opcode .
+ */
+mcap::Record read_record(
+        mcap::IReadable& source,
+        const mcap::ByteOffset offset,
+        const mcap::OpCode opcode)
+{
+    mcap::RecordReader reader(source, offset);
+    const auto record = reader.next();
+
+    if (!record)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "cannot read the record at offset " << offset << ": " << reader.status().message);
+    }
+
+    if (record->opcode != opcode)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "unexpected record with opcode " << static_cast<int>(record->opcode) <<
+                      " at offset " << offset << " (expected " << static_cast<int>(opcode) << ")");
+    }
+
+    return *record;
+}
+
+//! Deserialize a \c TypeIdentifier or a \c TypeObject serialized by the \c McapHandler
+template<class DynamicTypeData>
+DynamicTypeData deserialize_type_data(
+        const std::string& typedata_str)
+{
+    fastcdr::FastBuffer fastbuffer(const_cast<char*>(typedata_str.data()), typedata_str.size());
+    fastcdr::Cdr deser(fastbuffer, fastcdr::Cdr::DEFAULT_ENDIAN, fastcdr::CdrVersion::XCDRv2);
+
+    DynamicTypeData type_data;
+    fastcdr::deserialize(deser, type_data);
+
+    return type_data;
+}
+
+/**
+ * @brief Read the serialized \c DynamicTypesCollection of a file, from its sidecar or its attachment.
+ *
+ * @return The serialized collection, or an empty vector if the file holds no types.
+ * @throws \c InconsistencyException if the types are referenced but cannot be read.
+ */
+std::vector<unsigned char> read_dynamic_types(
+        const std::string& path,
+        mcap::McapReader& reader)
+{
+    mcap::IReadable& source = *reader.dataSource();
+
+    const auto metadata_indexes = reader.metadataIndexes();
+    const auto sidecar_index = metadata_indexes.find(DYNAMIC_TYPES_SIDECAR_METADATA_NAME);
+
+    if (sidecar_index != metadata_indexes.end())
+    {
+        mcap::Metadata sidecar;
+        const auto status = mcap::McapReader::ParseMetadata(
+            read_record(source, sidecar_index->second.offset, mcap::OpCode::Metadata), &sidecar);
+
+        if (!status.ok())
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "cannot parse the dynamic types sidecar reference: " << status.message);
+        }
+
+        return DynamicTypesSidecar::read(std::filesystem::path(path).parent_path().string(), sidecar);
+    }
+
+    const auto attachment_indexes = reader.attachmentIndexes();
+    const auto attachment_index = attachment_indexes.find(DYNAMIC_TYPES_ATTACHMENT_NAME);
+
+    if (attachment_index == attachment_indexes.end())
+    {
+        return {};
+    }
+
+    mcap::Attachment attachment;
+    const auto status = mcap::McapReader::ParseAttachment(
+        read_record(source, attachment_index->second.offset, mcap::OpCode::Attachment), &attachment);
+
+    if (!status.ok())
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "cannot parse the dynamic types attachment: " << status.message);
+    }
+
+    const auto data = reinterpret_cast<const unsigned char*>(attachment.data);
+    return std::vector<unsigned char>(data, data + attachment.dataSize);
+}
+
+/**
+ * @brief Build a \c TypeSupport for every type of a serialized \c DynamicTypesCollection .
+ *
+ * Types that cannot be built are left out (so the messages of their channels are not sampled).
+ *
+ * @return The \c TypeSupport of every type, by type name.
+ */
+std::unordered_map<std::string, std::shared_ptr<fastdds::dds::TypeSupport>> build_decoders(
+        const std::vector<unsigned char>& dynamic_types_data)
+{
+    // The type registry and the type builder factory are process-wide
+    static std::mutex types_mutex;
+    std::lock_guard<std::mutex> lock(types_mutex);
+
+    DynamicTypesCollection dynamic_types;
+    fastdds::dds::TypeSupport collection_type_support(new DynamicTypesCollectionPubSubType());
+    fastdds::rtps::SerializedPayload_t serialized_payload(static_cast<std::uint32_t>(dynamic_types_data.size()));
+    serialized_payload.length = static_cast<std::uint32_t>(dynamic_types_data.size());
+    std::memcpy(serialized_payload.data, dynamic_types_data.data(), dynamic_types_data.size());
+
+    if (!collection_type_support.deserialize(serialized_payload, &dynamic_types))
+    {
+        throw utils::InconsistencyException("cannot deserialize the dynamic types collection");
+    }
+
+    // Register every type first, so the types that depend on others can be built
+    std::vector<std::pair<std::string, fastdds::dds::xtypes::TypeObject>> type_objects;
+
+    for (const auto& dynamic_type : dynamic_types.dynamic_types())
+    {
+        try
+        {
+            const auto type_identifier = deserialize_type_data<fastdds::dds::xtypes::TypeIdentifier>(
+                utils::base64_decode(dynamic_type.type_information()));
+            const auto type_object = deserialize_type_data<fastdds::dds::xtypes::TypeObject>(
+                utils::base64_decode(dynamic_type.type_object()));
+
+            fastdds::dds::xtypes::TypeIdentifierPair type_identifiers;
+            type_identifiers.type_identifier1(type_identifier);
+
+            fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().register_type_object(
+                type_object, type_identifiers);
+
+            type_objects.emplace_back(dynamic_type.type_name(), type_object);
+        }
+        catch (const std::exception& e)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_VERIFIER,
+                    "MCAP_VERIFIER | Failed to deserialize " << dynamic_type.type_name() << " DynamicType: " <<
+                    e.what());
+        }
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<fastdds::dds::TypeSupport>> decoders;
+
+    for (const auto& type_object : type_objects)
+    {
+        const auto builder =
+                fastdds::dds::DynamicTypeBuilderFactory::get_instance()->create_type_w_type_object(
+            type_object.second);
+
+        if (!builder)
+        {
+            continue;
+        }
+
+        const auto type = builder->build();
+
+        if (!type)
+        {
+            continue;
+        }
+
+        decoders[type_object.first] = std::make_shared<fastdds::dds::TypeSupport>(
+            new fastdds::dds::DynamicPubSubType(type));
+    }
+
+    return decoders;
+}
+
+//! Whether \c data is a valid serialized sample of \c type_support
+bool deserialize_message(
+        fastdds::dds::TypeSupport& type_support,
+        const mcap::Message& message)
+{
+    fastdds::rtps::SerializedPayload_t payload(static_cast<std::uint32_t>(message.dataSize));
+    payload.length = static_cast<std::uint32_t>(message.dataSize);
+    std::memcpy(payload.data, message.data, message.dataSize);
+
+    void* data = type_support.create_data();
+    bool deserialized = false;
+
+    try
+    {
+        deserialized = type_support.deserialize(payload, data);
+    }
+    catch (const std::exception&)
+    {
+        deserialized = false;
+    }
+
+    type_support.delete_data(data);
+
+    return deserialized;
+}
+
+//! Claim one of the \c max_samples messages of \c channel to be deserialized
+bool claim_sample(
+        FileContext& context,
+        const mcap::ChannelId channel,
+        const std::uint32_t max_samples)
+{
+    std::lock_guard<std::mutex> lock(context.mutex);
+
+    auto& samples = context.channel_samples[channel];
+
+    if (samples >= max_samples)
+    {
+        return false;
+    }
+
+    samples++;
+    return true;
+}
+
+/**
+ * @brief Read the summary of a file and prepare the verification of its chunks.
+ *
+ * Errors are reported in the result of the file.
+ */
+void open_file_context(
+        const McapVerifierConfiguration& configuration,
+        const std::string& path,
+        FileContext& context)
+{
+    auto& result = *context.result;
+
+    mcap::McapReader reader;
+
+    auto status = reader.open(path);
+
+    if (!status.ok())
+    {
+        result.errors.push_back(STR_ENTRY << "Cannot open the file: " << status.message);
+        return;
+    }
+
+    // Do not scan the whole file if the summary is missing: a file without summary was not closed properly
+    status = reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan);
+
+    if (!status.ok())
+    {
+        result.errors.push_back(STR_ENTRY << "Cannot read the summary: " << status.message);
+        return;
+    }
+
+    context.chunk_indexes = reader.chunkIndexes();
+    context.statistics = reader.statistics();
+    result.chunks = context.chunk_indexes.size();
+
+    std::unordered_map<std::string, std::shared_ptr<fastdds::dds::TypeSupport>> decoders;
+
+    if (configuration.sampled_messages > 0)
+    {
+        try
+        {
+            const auto dynamic_types_data = read_dynamic_types(path, reader);
+
+            if (!dynamic_types_data.empty())
+            {
+                decoders = build_decoders(dynamic_types_data);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            result.errors.push_back(STR_ENTRY << "Cannot read the recorded types: " << e.what());
+        }
+    }
+
+    const auto schemas = reader.schemas();
+
+    for (const auto& it : reader.channels())
+    {
+        const auto& channel = it.second;
+        const auto schema = schemas.find(channel->schemaId);
+        const std::string schema_name = schema != schemas.end() ? schema->second->name : "";
+
+        context.topics[channel->id] = channel->topic;
+
+        auto& topic = result.topics[channel->topic];
+        topic.type_name = schema_name;
+
+        if (configuration.sampled_messages == 0)
+        {
+            continue;
+        }
+
+        const auto ros2_types = channel->metadata.find(ROS2_TYPES);
+        const std::string type_name = (ros2_types != channel->metadata.end() && ros2_types->second == "true") ?
+                utils::mangle_if_ros_type(schema_name) : schema_name;
+
+        const auto decoder = decoders.find(type_name);
+
+        if (decoder != decoders.end())
+        {
+            context.decoders[channel->id] = decoder->second;
+        }
+        else
+        {
+            topic.missing_type = true;
+        }
+    }
+
+    reader.close();
+
+    context.valid = true;
+}
+
+/**
+ * @brief Verify the chunk \c chunk_index of a file.
+ *
+ * @throws \c InconsistencyException if the chunk cannot be read, decompressed or parsed.
+ */
+void verify_chunk(
+        const McapVerifierConfiguration& configuration,
+        const std::string& path,
+        FileContext& context,
+        const mcap::ChunkIndex& chunk_index,
+        ChunkVerification& result)
+{
+    const auto file = open_file(path);
+
+    if (!file)
+    {
+        throw utils::InconsistencyException("cannot open the file");
+    }
+
+    mcap::FileReader source(file.get());
+
+    // Check the chunk against its chunk index
+    const auto record = read_record(source, chunk_index.chunkStartOffset, mcap::OpCode::Chunk);
+
+    if (record.recordSize() != chunk_index.chunkLength)
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "length " << record.recordSize() << " does not match its chunk index (" <<
+                      chunk_index.chunkLength << ")");
+    }
+
+    mcap::Chunk chunk;
+    const auto status = mcap::McapReader::ParseChunk(record, &chunk);
+
+    if (!status.ok())
+    {
+        throw utils::InconsistencyException(STR_ENTRY << "cannot be parsed: " << status.message);
+    }
+
+    if (chunk.compression != chunk_index.compression ||
+            chunk.compressedSize != chunk_index.compressedSize ||
+            chunk.uncompressedSize != chunk_index.uncompressedSize ||
+            chunk.messageStartTime != chunk_index.messageStartTime ||
+            chunk.messageEndTime != chunk_index.messageEndTime)
+    {
+        throw utils::InconsistencyException("does not match its chunk index");
+    }
+
+    // Decompress the records
+    std::unique_ptr<mcap::ICompressedReader> decompressor;
+
+    if (chunk.compression.empty())
+    {
+        decompressor = std::make_unique<mcap::BufferReader>();
+    }
+    else if (chunk.compression == "lz4")
+    {
+        decompressor = std::make_unique<mcap::LZ4Reader>();
+    }
+    else if (chunk.compression == "zstd")
+    {
+        decompressor = std::make_unique<mcap::ZStdReader>();
+    }
+    else
+    {
+        throw utils::InconsistencyException(STR_ENTRY << "unsupported compression " << chunk.compression);
+    }
+
+    decompressor->reset(chunk.records, chunk.compressedSize, chunk.uncompressedSize);
+
+    if (!decompressor->status().ok())
+    {
+        throw utils::InconsistencyException(
+                  STR_ENTRY << "cannot be decompressed: " << decompressor->status().message);
+    }
+
+    std::byte* records = nullptr;
+
+    if (decompressor->read(&records, 0, chunk.uncompressedSize) != chunk.uncompressedSize)
+    {
+        throw utils::InconsistencyException("decompressed size does not match");
+    }
+
+    // Check the CRC of the uncompressed records
+    if (configuration.check_crcs)
+    {
+        if (chunk.uncompressedCrc == 0)
+        {
+            result.without_crc = true;
+        }
+        else
+        {
+            const auto crc = Crc32::compute(records, chunk.uncompressedSize);
+
+            if (crc != chunk.uncompressedCrc)
+            {
+                result.crc_error = true;
+                result.errors.push_back(
+                    STR_ENTRY << "Chunk at offset " << chunk_index.chunkStartOffset << ": CRC " << std::hex <<
+                        std::setw(8) << std::setfill('0') << crc << " does not match the recorded one " <<
+                        std::setw(8) << chunk.uncompressedCrc);
+            }
+        }
+    }
+
+    // Parse the messages, keeping their log time and offset to check the message indexes
+    std::unordered_map<mcap::ChannelId, std::vector<std::pair<mcap::Timestamp, mcap::ByteOffset>>> entries;
+    std::unordered_set<mcap::ChannelId> sampled_channels;
+
+    mcap::RecordReader reader(*decompressor, 0, chunk.uncompressedSize);
+
+    for (auto message_record = reader.next(); message_record; message_record = reader.next())
+    {
+        if (message_record->opcode != mcap::OpCode::Message)
+        {
+            continue;
+        }
+
+        mcap::Message message;
+        const auto message_status = mcap::McapReader::ParseMessage(*message_record, &message);
+
+        if (!message_status.ok())
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "cannot parse the message at offset " << reader.curRecordOffset() << ": " <<
+                          message_status.message);
+        }
+
+        if (context.topics.count(message.channelId) == 0)
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "message at offset " << reader.curRecordOffset() << " has unknown channel " <<
+                          message.channelId);
+        }
+
+        if (message.logTime < chunk.messageStartTime || message.logTime > chunk.messageEndTime)
+        {
+            throw utils::InconsistencyException(
+                      STR_ENTRY << "message at offset " << reader.curRecordOffset() <<
+                          " is out of the time range of the chunk");
+        }
+
+        auto& channel = result.channels[message.channelId];
+        channel.messages++;
+        channel.bytes += message.dataSize;
+
+        entries[message.channelId].emplace_back(message.logTime, reader.curRecordOffset());
+
+        // The references to payloads written out of the chunks cannot be deserialized
+        std::uint64_t blob_offset;
+        std::uint64_t blob_size;
+
+        if (McapBlob::parse_reference(message.data, message.dataSize, blob_offset, blob_size))
+        {
+            continue;
+        }
+
+        // Deserialize a sample of the messages
+        const auto decoder = context.decoders.find(message.channelId);
+
+        if (decoder != context.decoders.end() && sampled_channels.count(message.channelId) == 0)
+        {
+            if (claim_sample(context, message.channelId, configuration.sampled_messages))
+            {
+                channel.sampled++;
+
+                if (!deserialize_message(*decoder->second, message))
+                {
+                    channel.decode_errors++;
+                }
+            }
+            else
+            {
+                sampled_channels.insert(message.channelId);
+            }
+        }
+    }
+
+    if (!reader.status().ok())
+    {
+        throw utils::InconsistencyException(STR_ENTRY << "cannot parse the records: " << reader.status().message);
+    }
+
+    if (!configuration.check_indexes)
+    {
+        return;
+    }
+
+    // Check the message indexes against the messages of the chunk
+    for (auto& channel_entries : entries)
+    {
+        const auto channel_id = channel_entries.first;
+        auto& expected = channel_entries.second;
+        auto& channel = result.channels[channel_id];
+
+        const auto index_offset = chunk_index.messageIndexOffsets.find(channel_id);
+
+        if (index_offset == chunk_index.messageIndexOffsets.end())
+        {
+            channel.index_errors += expected.size();
+            continue;
+        }
+
+        mcap::MessageIndex message_index;
+        const auto index_status = mcap::McapReader::ParseMessageIndex(
+            read_record(source, index_offset->second, mcap::OpCode::MessageIndex), &message_index);
+
+        if (!index_status.ok() || message_index.channelId != channel_id)
+        {
+            channel.index_errors += expected.size();
+            continue;
+        }
+
+        auto& indexed = message_index.records;
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(indexed.begin(), indexed.end());
+
+        std::vector<std::pair<mcap::Timestamp, mcap::ByteOffset>> mismatches;
+        std::set_symmetric_difference(
+            expected.begin(), expected.end(), indexed.begin(), indexed.end(), std::back_inserter(mismatches));
+
+        channel.index_errors += mismatches.size();
+    }
+
+    if (chunk_index.messageIndexOffsets.size() > entries.size())
+    {
+        result.index_errors++;
+        result.errors.push_back(
+            STR_ENTRY << "Chunk at offset " << chunk_index.chunkStartOffset <<
+                ": message indexes reference channels without messages in the chunk");
+    }
+}
+
+//! Merge the result of a chunk into the result of its file
+void merge_chunk(
+        FileContext& context,
+        const ChunkVerification& chunk)
+{
+    std::lock_guard<std::mutex> lock(context.mutex);
+
+    auto& result = *context.result;
+
+    result.chunks_without_crc += chunk.without_crc ? 1 : 0;
+    result.crc_errors += chunk.crc_error ? 1 : 0;
+    result.chunk_errors += chunk.chunk_error ? 1 : 0;
+    result.index_errors += chunk.index_errors;
+    result.errors.insert(result.errors.end(), chunk.errors.begin(), chunk.errors.end());
+
+    for (const auto& it : chunk.channels)
+    {
+        auto& topic = result.topics[context.topics[it.first]];
+        topic.messages += it.second.messages;
+        topic.bytes += it.second.bytes;
+        topic.index_errors += it.second.index_errors;
+        topic.sampled += it.second.sampled;
+        topic.decode_errors += it.second.decode_errors;
+
+        result.messages += it.second.messages;
+        result.index_errors += it.second.index_errors;
+        context.channel_messages[it.first] += it.second.messages;
+    }
+}
+
+//! Check the statistics of a file against the messages counted in its chunks, and report the errors per topic
+void close_file_context(
+        const McapVerifierConfiguration& configuration,
+        FileContext& context)
+{
+    auto& result = *context.result;
+
+    if (configuration.check_indexes && context.statistics)
+    {
+        const auto& statistics = *context.statistics;
+
+        if (statistics.chunkCount != context.chunk_indexes.size())
+        {
+            result.index_errors++;
+            result.errors.push_back(
+                STR_ENTRY << "Statistics: " << statistics.chunkCount << " chunks recorded, " <<
+                    context.chunk_indexes.size() << " indexed");
+        }
+
+        if (statistics.messageCount != result.messages)
+        {
+            result.index_errors++;
+            result.errors.push_back(
+                STR_ENTRY << "Statistics: " << statistics.messageCount << " messages recorded, " <<
+                    result.messages << " found in the chunks");
+        }
+
+        for (const auto& it : statistics.channelMessageCounts)
+        {
+            if (it.second != context.channel_messages[it.first])
+            {
+                result.index_errors++;
+                result.errors.push_back(
+                    STR_ENTRY << "Statistics: " << it.second << " messages recorded in topic " <<
+                        context.topics[it.first] << ", " << context.channel_messages[it.first] <<
+                        " found in the chunks");
+            }
+        }
+    }
+
+    for (const auto& it : result.topics)
+    {
+        if (it.second.index_errors > 0)
+        {
+            result.errors.push_back(
+                STR_ENTRY << "Topic " << it.first << ": " << it.second.index_errors <<
+                    " messages do not match the message indexes");
+        }
+
+        if (it.second.decode_errors > 0)
+        {
+            result.errors.push_back(
+                STR_ENTRY << "Topic " << it.first << ": " << it.second.decode_errors << " of " <<
+                    it.second.sampled << " sampled messages cannot be deserialized");
+        }
+    }
+}
+
+} /* namespace */
+
+McapVerifier::McapVerifier(
+        const McapVerifierConfiguration& configuration)
+    : configuration_(configuration)
+{
+}
+
+std::vector<FileVerification> McapVerifier::verify(
+        const std::vector<std::string>& paths) const
+{
+    const std::size_t n_threads = configuration_.n_threads > 0 ?
+            configuration_.n_threads : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<FileVerification> results(paths.size());
+    std::vector<std::unique_ptr<FileContext>> contexts;
+
+    for (std::size_t i = 0; i < paths.size(); i++)
+    {
+        results[i].path = paths[i];
+
+        contexts.push_back(std::make_unique<FileContext>());
+        contexts.back()->result = &results[i];
+    }
+
+    // Read the summaries of every file
+    parallel_for(n_threads, paths.size(), [&](std::size_t i)
+            {
+                try
+                {
+                    open_file_context(configuration_, paths[i], *contexts[i]);
+                }
+                catch (const std::exception& e)
+                {
+                    results[i].errors.push_back(STR_ENTRY << "Cannot read the summary: " << e.what());
+                }
+            });
+
+    // Verify the chunks of every file, as one single pool of tasks so large files do not leave threads idle
+    std::vector<std::pair<std::size_t, std::size_t>> chunk_tasks;
+
+    for (std::size_t i = 0; i < contexts.size(); i++)
+    {
+        if (!contexts[i]->valid)
+        {
+            continue;
+        }
+
+        for (std::size_t j = 0; j < contexts[i]->chunk_indexes.size(); j++)
+        {
+            chunk_tasks.emplace_back(i, j);
+        }
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_VERIFIER,
+            "MCAP_VERIFIER | Verifying " << chunk_tasks.size() << " chunks of " << paths.size() << " files with " <<
+            n_threads << " threads.");
+
+    parallel_for(n_threads, chunk_tasks.size(), [&](std::size_t task)
+            {
+                auto& context = *contexts[chunk_tasks[task].first];
+                const auto& chunk_index = context.chunk_indexes[chunk_tasks[task].second];
+
+                ChunkVerification chunk;
+
+                try
+                {
+                    verify_chunk(configuration_, paths[chunk_tasks[task].first], context, chunk_index, chunk);
+                }
+                catch (const std::exception& e)
+                {
+                    chunk.chunk_error = true;
+                    chunk.errors.push_back(
+                        STR_ENTRY << "Chunk at offset " << chunk_index.chunkStartOffset << ": " << e.what());
+                }
+
+                merge_chunk(context, chunk);
+            });
+
+    for (auto& context : contexts)
+    {
+        if (context->valid)
+        {
+            close_file_context(configuration_, *context);
+        }
+    }
+
+    return results;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,398 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/collector/McapCollector.hpp>
+#include <ddsrecorder_participants/common/mcap/McapStreamFrame.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr auto TIMEOUT = std::chrono::seconds(5);
+
+//! Suffix of the files being collected
+const std::string TMP_SUFFIX = ".tmp~";
+
+/**
+ * Minimal recorder streaming raw frames to the collector through a Unix domain socket.
+ */
+class Recorder
+{
+public:
+
+    Recorder(
+            const std::string& path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        connected_ = connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    }
+
+    ~Recorder()
+    {
+        close(fd_);
+    }
+
+    bool connected() const
+    {
+        return connected_;
+    }
+
+    /**
+     * Send a frame, split in \c pieces writes apart in time, so the collector receives it in several reads.
+     */
+    void send(
+            const McapStreamFrame::Kind kind,
+            const std::uint64_t file_id,
+            const std::uint64_t offset,
+            const std::string& payload,
+            const std::size_t pieces = 1)
+    {
+        const auto header = McapStreamFrame::make_header(kind, file_id, offset, payload.size());
+
+        std::string frame(reinterpret_cast<const char*>(header.data()), header.size());
+        frame += payload;
+
+        const auto piece_size = (frame.size() + pieces - 1) / pieces;
+
+        for (std::size_t sent = 0; sent < frame.size(); sent += piece_size)
+        {
+            if (sent > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            send_(frame.data() + sent, std::min(piece_size, frame.size() - sent));
+        }
+    }
+
+    //! Stream the whole file \c name in a single data frame
+    void send_file(
+            const std::uint64_t file_id,
+            const std::string& name,
+            const std::string& contents)
+    {
+        send(McapStreamFrame::Kind::open, file_id, 0, name);
+        send(McapStreamFrame::Kind::data, file_id, 0, contents);
+        send(McapStreamFrame::Kind::close, file_id, contents.size(), "");
+    }
+
+protected:
+
+    void send_(
+            const char* data,
+            std::size_t size)
+    {
+        while (size > 0)
+        {
+            const auto sent = ::send(fd_, data, size, MSG_NOSIGNAL);
+
+            if (sent <= 0)
+            {
+                return;
+            }
+
+            data += sent;
+            size -= static_cast<std::size_t>(sent);
+        }
+    }
+
+    int fd_{-1};
+
+    bool connected_{false};
+};
+
+//! Wait until \c predicate holds, up to \c TIMEOUT
+bool wait_for(
+        const std::function<bool()>& predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return true;
+}
+
+//! The contents of the file at \c path
+std::string contents(
+        const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+} /* namespace test */
+
+class McapCollectorTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() / "ddsrecorder_mcap_collector_test";
+        std::filesystem::remove_all(directory_);
+
+        configuration_.kind = McapStreamKind::unix_socket;
+        configuration_.path = (std::filesystem::temp_directory_path() / "ddsrecorder_collector_test.sock").string();
+        configuration_.output_directory = directory_.string();
+    }
+
+    void TearDown() override
+    {
+        collector_.reset();
+        std::filesystem::remove_all(directory_);
+    }
+
+protected:
+
+    void start_()
+    {
+        collector_ = std::make_unique<McapCollector>(configuration_);
+        collector_->start();
+    }
+
+    std::string path_(
+            const std::string& name) const
+    {
+        return (directory_ / name).string();
+    }
+
+    //! Wait until \c count files have been collected
+    bool wait_for_collected_(
+            const std::size_t count) const
+    {
+        return test::wait_for([&]()
+                       {
+                           return collector_->collected_files().size() >= count;
+                       });
+    }
+
+    //! Wait until the last file collected is \c name
+    bool wait_for_last_collected_(
+            const std::string& name) const
+    {
+        return test::wait_for([&]()
+                       {
+                           const auto files = collector_->collected_files();
+                           return !files.empty() && files.back() == path_(name);
+                       });
+    }
+
+    std::filesystem::path directory_;
+
+    McapCollectorConfiguration configuration_;
+
+    std::unique_ptr<McapCollector> collector_;
+};
+
+/**
+ * Test that the frames are reassembled into the file however they are split by the transport.
+ *
+ * CASES:
+ * - check that frames received in several reads (splitting the header and the payload) are reassembled.
+ * - check that the data frames are written at their offsets.
+ * - check that the file is renamed to its name once complete, leaving no temporary file.
+ * - check that a file is never written out of the output directory.
+ */
+TEST_F(McapCollectorTest, frame_reassembly)
+{
+    start_();
+
+    test::Recorder recorder(configuration_.path);
+    ASSERT_TRUE(recorder.connected());
+
+    recorder.send(McapStreamFrame::Kind::open, 1, 0, "first.mcap", 3);
+    recorder.send(McapStreamFrame::Kind::data, 1, 0, "MCAP header ", 4);
+    recorder.send(McapStreamFrame::Kind::data, 1, 12, "and chunks", 5);
+
+    // Not complete yet, so only the temporary file exists
+    ASSERT_TRUE(test::wait_for([&]()
+            {
+                return std::filesystem::exists(path_("first.mcap") + test::TMP_SUFFIX);
+            }));
+    ASSERT_FALSE(std::filesystem::exists(path_("first.mcap")));
+    ASSERT_TRUE(collector_->collected_files().empty());
+
+    recorder.send(McapStreamFrame::Kind::close, 1, 22, "", 2);
+
+    ASSERT_TRUE(wait_for_collected_(1));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("first.mcap")}));
+    ASSERT_EQ(test::contents(path_("first.mcap")), "MCAP header and chunks");
+    ASSERT_FALSE(std::filesystem::exists(path_("first.mcap") + test::TMP_SUFFIX));
+
+    // Only the file name is taken
+    recorder.send_file(2, "../../second.mcap", "second");
+
+    ASSERT_TRUE(wait_for_last_collected_("second.mcap"));
+    ASSERT_EQ(test::contents(path_("second.mcap")), "second");
+}
+
+/**
+ * Test that a file interrupted by a disconnection is resumed once the recorder reconnects.
+ *
+ * CASES:
+ * - check that the file is kept open while the recorder is disconnected.
+ * - check that the frames sent again after the reconnection do not change the bytes already written.
+ * - check that the file is complete once the rest of the stream is received.
+ */
+TEST_F(McapCollectorTest, resume_after_reconnection)
+{
+    start_();
+
+    {
+        test::Recorder recorder(configuration_.path);
+        ASSERT_TRUE(recorder.connected());
+
+        recorder.send(McapStreamFrame::Kind::open, 1, 0, "resumed.mcap");
+        recorder.send(McapStreamFrame::Kind::data, 1, 0, "hello ");
+        recorder.send(McapStreamFrame::Kind::data, 1, 6, "wor");
+
+        ASSERT_TRUE(test::wait_for([&]()
+                {
+                    return std::filesystem::exists(path_("resumed.mcap") + test::TMP_SUFFIX);
+                }));
+    }
+
+    test::Recorder recorder(configuration_.path);
+    ASSERT_TRUE(recorder.connected());
+
+    // The recorder sends again the open frame and the frames of the file it kept for replay
+    recorder.send(McapStreamFrame::Kind::open, 1, 0, "resumed.mcap");
+    recorder.send(McapStreamFrame::Kind::data, 1, 6, "wor");
+    recorder.send(McapStreamFrame::Kind::data, 1, 9, "ld");
+    recorder.send(McapStreamFrame::Kind::close, 1, 11, "");
+
+    ASSERT_TRUE(wait_for_collected_(1));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("resumed.mcap")}));
+    ASSERT_EQ(test::contents(path_("resumed.mcap")), "hello world");
+}
+
+/**
+ * Test that a file missing part of its stream is abandoned.
+ *
+ * CASES:
+ * - check that a data frame beyond the bytes received abandons the file.
+ * - check that a close frame with a size other than the bytes received abandons the file.
+ * - check that an abandoned file is left as a temporary file and never collected.
+ * - check that the next files are collected.
+ */
+TEST_F(McapCollectorTest, sequence_gap)
+{
+    start_();
+
+    test::Recorder recorder(configuration_.path);
+    ASSERT_TRUE(recorder.connected());
+
+    // Gap between the data frames
+    recorder.send(McapStreamFrame::Kind::open, 1, 0, "gap.mcap");
+    recorder.send(McapStreamFrame::Kind::data, 1, 0, "abc");
+    recorder.send(McapStreamFrame::Kind::data, 1, 10, "xyz");
+    recorder.send(McapStreamFrame::Kind::data, 1, 13, "more");
+    recorder.send(McapStreamFrame::Kind::close, 1, 17, "");
+
+    // Gap at the end of the file
+    recorder.send(McapStreamFrame::Kind::open, 2, 0, "truncated.mcap");
+    recorder.send(McapStreamFrame::Kind::data, 2, 0, "ab");
+    recorder.send(McapStreamFrame::Kind::close, 2, 5, "");
+
+    recorder.send_file(3, "complete.mcap", "complete");
+
+    ASSERT_TRUE(wait_for_collected_(1));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("complete.mcap")}));
+    ASSERT_EQ(test::contents(path_("complete.mcap")), "complete");
+
+    ASSERT_FALSE(std::filesystem::exists(path_("gap.mcap")));
+    ASSERT_EQ(test::contents(path_("gap.mcap") + test::TMP_SUFFIX), "abc");
+
+    ASSERT_FALSE(std::filesystem::exists(path_("truncated.mcap")));
+    ASSERT_EQ(test::contents(path_("truncated.mcap") + test::TMP_SUFFIX), "ab");
+}
+
+/**
+ * Test that the oldest collected files are removed beyond the max size.
+ *
+ * CASES:
+ * - check that the files are kept while under the max size.
+ * - check that the oldest files are removed from disk once over the max size.
+ * - check that the last file collected is kept even if larger than the max size.
+ */
+TEST_F(McapCollectorTest, rotation)
+{
+    configuration_.max_size = 10;
+    start_();
+
+    test::Recorder recorder(configuration_.path);
+    ASSERT_TRUE(recorder.connected());
+
+    recorder.send_file(1, "1.mcap", "first");
+
+    ASSERT_TRUE(wait_for_collected_(1));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("1.mcap")}));
+
+    recorder.send_file(2, "2.mcap", "secnd");
+
+    ASSERT_TRUE(wait_for_collected_(2));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("1.mcap"), path_("2.mcap")}));
+
+    recorder.send_file(3, "3.mcap", "third");
+
+    ASSERT_TRUE(wait_for_last_collected_("3.mcap"));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("2.mcap"), path_("3.mcap")}));
+    ASSERT_FALSE(std::filesystem::exists(path_("1.mcap")));
+
+    recorder.send_file(4, "4.mcap", "larger than the max size");
+
+    ASSERT_TRUE(wait_for_last_collected_("4.mcap"));
+    ASSERT_EQ(collector_->collected_files(), std::vector<std::string>({path_("4.mcap")}));
+    ASSERT_FALSE(std::filesystem::exists(path_("2.mcap")));
+    ASSERT_FALSE(std::filesystem::exists(path_("3.mcap")));
+    ASSERT_EQ(test::contents(path_("4.mcap")), "larger than the max size");
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/common/mcap/Crc32.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+//! Random bytes, larger than the biggest buffer hashed by the tests plus the max misalignment
+std::vector<unsigned char> random_bytes(
+        const std::size_t size)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 255);
+
+    std::vector<unsigned char> bytes(size);
+
+    for (auto& byte : bytes)
+    {
+        byte = static_cast<unsigned char>(distribution(generator));
+    }
+
+    return bytes;
+}
+
+} /* namespace test */
+
+/**
+ * Test that the CRC32 of the standard check string is the expected one.
+ *
+ * CASES:
+ * - check the CRC32 of "123456789".
+ * - check the CRC32 of an empty buffer.
+ */
+TEST(Crc32Test, check_value)
+{
+    const std::string check = "123456789";
+
+    ASSERT_EQ(Crc32::compute(check.data(), check.size()), 0xcbf43926u);
+    ASSERT_EQ(Crc32::compute(nullptr, 0), 0x00000000u);
+}
+
+/**
+ * Test that the implementation selected for this CPU matches the portable (table-based) one.
+ *
+ * CASES:
+ * - check every size up to a few folding blocks, with every misalignment.
+ * - check large sizes, as those of compressed chunks.
+ */
+TEST(Crc32Test, matches_portable)
+{
+    const auto bytes = test::random_bytes(1 << 20);
+
+    for (std::size_t offset = 0; offset < 16; offset++)
+    {
+        for (std::size_t size = 0; size < 512; size++)
+        {
+            ASSERT_EQ(
+                Crc32::update(Crc32::INIT, bytes.data() + offset, size),
+                Crc32::update_portable(Crc32::INIT, bytes.data() + offset, size))
+                << "implementation: " << Crc32::implementation() << ", offset: " << offset << ", size: " << size;
+        }
+    }
+
+    for (const std::size_t size : {4096, 65536, 1000003, (1 << 20) - 16})
+    {
+        ASSERT_EQ(
+            Crc32::update(Crc32::INIT, bytes.data() + 3, size),
+            Crc32::update_portable(Crc32::INIT, bytes.data() + 3, size));
+    }
+}
+
+/**
+ * Test that a CRC32 computed in several updates matches the one computed in a single update.
+ *
+ * CASES:
+ * - check splitting the data in two at every position.
+ * - check mixing the selected and the portable implementations.
+ */
+TEST(Crc32Test, streaming)
+{
+    const auto bytes = test::random_bytes(300);
+    const auto expected = Crc32::compute(bytes.data(), bytes.size());
+
+    for (std::size_t split = 0; split <= bytes.size(); split++)
+    {
+        auto crc = Crc32::update(Crc32::INIT, bytes.data(), split);
+        crc = Crc32::update(crc, bytes.data() + split, bytes.size() - split);
+
+        ASSERT_EQ(Crc32::finalize(crc), expected);
+
+        crc = Crc32::update_portable(Crc32::INIT, bytes.data(), split);
+        crc = Crc32::update(crc, bytes.data() + split, bytes.size() - split);
+
+        ASSERT_EQ(Crc32::finalize(crc), expected);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
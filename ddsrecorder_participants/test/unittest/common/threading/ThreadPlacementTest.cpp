@@ -0,0 +1,185 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif // if defined(__linux__)
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+#if defined(__linux__)
+
+std::string thread_name()
+{
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    return name;
+}
+
+std::set<unsigned int> thread_cpus()
+{
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+
+    std::set<unsigned int> cpus;
+
+    for (unsigned int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &cpu_set))
+        {
+            cpus.insert(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+#endif // if defined(__linux__)
+
+} // test
+
+class ThreadPlacementTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+#if defined(__linux__)
+        // Pin the threads to a CPU the test is allowed to run on
+        cpu_ = *test::thread_cpus().begin();
+#else
+        GTEST_SKIP() << "Thread placement is only supported on Linux.";
+#endif // if defined(__linux__)
+    }
+
+    void TearDown() override
+    {
+        ThreadPlacement::get_instance().configure({});
+    }
+
+protected:
+
+    unsigned int cpu_{0};
+};
+
+#if defined(__linux__)
+
+/**
+ * Test that a thread is named and pinned to the CPUs of its kind.
+ *
+ * CASES:
+ * - check that the name is truncated to 15 characters.
+ * - check that the thread runs only on the CPUs of its kind.
+ * - check that a thread whose kind has no CPUs keeps its CPUs.
+ */
+TEST_F(ThreadPlacementTest, name_and_pin)
+{
+    ThreadPlacementConfiguration configuration;
+    configuration.event_cpus = {cpu_};
+    ThreadPlacement::get_instance().configure(configuration);
+
+    std::thread([&]()
+            {
+                ThreadPlacement::get_instance().place_current_thread(ThreadKind::event, "ddsrec.event.thread");
+
+                ASSERT_EQ(test::thread_name(), "ddsrec.event.th");
+                ASSERT_EQ(test::thread_cpus(), std::set<unsigned int>{cpu_});
+            }).join();
+
+    std::thread([&]()
+            {
+                const auto cpus = test::thread_cpus();
+
+                ThreadPlacement::get_instance().place_current_thread(ThreadKind::io, "ddsrec.io");
+
+                ASSERT_EQ(test::thread_name(), "ddsrec.io");
+                ASSERT_EQ(test::thread_cpus(), cpus);
+            }).join();
+}
+
+/**
+ * Test that a scoped placement is undone once destroyed.
+ *
+ * CASES:
+ * - check that the thread is named and pinned within the scope.
+ * - check that the thread recovers its name and CPUs after the scope.
+ */
+TEST_F(ThreadPlacementTest, scoped_placement)
+{
+    ThreadPlacementConfiguration configuration;
+    configuration.workers_cpus = {cpu_};
+    ThreadPlacement::get_instance().configure(configuration);
+
+    std::thread([&]()
+            {
+                const auto name = test::thread_name();
+                const auto cpus = test::thread_cpus();
+
+                {
+                    ScopedThreadPlacement placement(ThreadKind::workers, "ddsrec.worker");
+
+                    ASSERT_EQ(test::thread_name(), "ddsrec.worker");
+                    ASSERT_EQ(test::thread_cpus(), std::set<unsigned int>{cpu_});
+                }
+
+                ASSERT_EQ(test::thread_name(), name);
+                ASSERT_EQ(test::thread_cpus(), cpus);
+            }).join();
+}
+
+/**
+ * Test that the threads created within a scoped placement inherit it.
+ *
+ * CASES:
+ * - check that a thread created within the scope has the name and the CPUs of the scope.
+ */
+TEST_F(ThreadPlacementTest, inherited_placement)
+{
+    ThreadPlacementConfiguration configuration;
+    configuration.dds_cpus = {cpu_};
+    ThreadPlacement::get_instance().configure(configuration);
+
+    std::thread([&]()
+            {
+                ScopedThreadPlacement placement(ThreadKind::dds, "ddsrec.dds");
+
+                std::thread([&]()
+                {
+                    ASSERT_EQ(test::thread_name(), "ddsrec.dds");
+                    ASSERT_EQ(test::thread_cpus(), std::set<unsigned int>{cpu_});
+                }).join();
+            }).join();
+}
+
+#endif // if defined(__linux__)
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
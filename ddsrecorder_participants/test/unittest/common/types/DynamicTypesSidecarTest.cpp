@@ -0,0 +1,230 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesSidecar.hpp>
+#include <ddsrecorder_participants/constants.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+//! Bytes standing for a serialized \c DynamicTypesCollection
+std::vector<unsigned char> types_data(
+        const std::string& contents)
+{
+    return std::vector<unsigned char>(contents.begin(), contents.end());
+}
+
+} /* namespace test */
+
+class DynamicTypesSidecarTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() / "ddsrecorder_dynamic_types_sidecar_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory_);
+    }
+
+protected:
+
+    std::string write_(
+            const std::vector<unsigned char>& data) const
+    {
+        return DynamicTypesSidecar::write(directory_.string(), data.data(), data.size());
+    }
+
+    std::filesystem::path path_(
+            const std::string& hash) const
+    {
+        return directory_ / DynamicTypesSidecar::filename(hash);
+    }
+
+    std::filesystem::path directory_;
+};
+
+/**
+ * Test that the sidecars are addressed by the hash of their contents.
+ *
+ * CASES:
+ * - check the FNV-1a hash of known inputs.
+ * - check that the same contents have the same hash and different contents a different one.
+ * - check that the file name and the reference are derived from the hash.
+ */
+TEST_F(DynamicTypesSidecarTest, content_hash)
+{
+    ASSERT_EQ(DynamicTypesSidecar::hash(nullptr, 0), "cbf29ce484222325");
+
+    const auto a = test::types_data("a");
+    ASSERT_EQ(DynamicTypesSidecar::hash(a.data(), a.size()), "af63dc4c8601ec8c");
+
+    const auto types = test::types_data("types");
+    const auto same_types = test::types_data("types");
+    const auto other_types = test::types_data("typez");
+
+    const auto hash = DynamicTypesSidecar::hash(types.data(), types.size());
+    ASSERT_EQ(hash.size(), 16u);
+    ASSERT_EQ(DynamicTypesSidecar::hash(same_types.data(), same_types.size()), hash);
+    ASSERT_NE(DynamicTypesSidecar::hash(other_types.data(), other_types.size()), hash);
+
+    ASSERT_EQ(DynamicTypesSidecar::filename(hash),
+            DYNAMIC_TYPES_SIDECAR_PREFIX + hash + DYNAMIC_TYPES_SIDECAR_EXTENSION);
+
+    const auto reference = DynamicTypesSidecar::reference(hash);
+    ASSERT_EQ(reference.name, DYNAMIC_TYPES_SIDECAR_METADATA_NAME);
+    ASSERT_EQ(reference.metadata.at(DYNAMIC_TYPES_SIDECAR_FILE), DynamicTypesSidecar::filename(hash));
+    ASSERT_EQ(reference.metadata.at(DYNAMIC_TYPES_SIDECAR_HASH), hash);
+}
+
+/**
+ * Test that a written sidecar is read back through its reference.
+ *
+ * CASES:
+ * - check that the contents read are the contents written.
+ * - check that no temporary file is left behind.
+ * - check that writing the same contents again does not rewrite the existing sidecar.
+ * - check that a reference can only point inside the directory.
+ */
+TEST_F(DynamicTypesSidecarTest, write_and_read)
+{
+    const auto types = test::types_data("serialized dynamic types");
+
+    const auto hash = write_(types);
+    ASSERT_EQ(hash, DynamicTypesSidecar::hash(types.data(), types.size()));
+    ASSERT_TRUE(std::filesystem::exists(path_(hash)));
+
+    ASSERT_EQ(DynamicTypesSidecar::read(directory_.string(), DynamicTypesSidecar::reference(hash)), types);
+
+    std::size_t files = 0;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory_))
+    {
+        ASSERT_EQ(entry.path().extension(), DYNAMIC_TYPES_SIDECAR_EXTENSION);
+        files++;
+    }
+
+    ASSERT_EQ(files, 1u);
+
+    // Content-addressed: an existing sidecar is never rewritten
+    const auto last_write = std::filesystem::last_write_time(path_(hash));
+    ASSERT_EQ(write_(types), hash);
+    ASSERT_EQ(std::filesystem::last_write_time(path_(hash)), last_write);
+
+    // Only the file name of the reference is used
+    auto reference = DynamicTypesSidecar::reference(hash);
+    reference.metadata[DYNAMIC_TYPES_SIDECAR_FILE] = "../../" + DynamicTypesSidecar::filename(hash);
+    ASSERT_EQ(DynamicTypesSidecar::read(directory_.string(), reference), types);
+}
+
+/**
+ * Test that the sidecars that cannot be trusted are rejected.
+ *
+ * CASES:
+ * - check that a sidecar whose contents do not match its hash is rejected.
+ * - check that a missing sidecar is rejected.
+ * - check that a malformed reference is rejected.
+ */
+TEST_F(DynamicTypesSidecarTest, hash_mismatch)
+{
+    const auto types = test::types_data("serialized dynamic types");
+    const auto hash = write_(types);
+
+    std::ofstream(path_(hash), std::ios::binary | std::ios::trunc) << "corrupted dynamic types";
+
+    ASSERT_THROW(
+        DynamicTypesSidecar::read(directory_.string(), DynamicTypesSidecar::reference(hash)),
+        utils::InconsistencyException);
+
+    ASSERT_THROW(
+        DynamicTypesSidecar::read(directory_.string(), DynamicTypesSidecar::reference("0123456789abcdef")),
+        utils::InconsistencyException);
+
+    auto malformed = DynamicTypesSidecar::reference(hash);
+    malformed.metadata.erase(DYNAMIC_TYPES_SIDECAR_HASH);
+
+    ASSERT_THROW(
+        DynamicTypesSidecar::read(directory_.string(), malformed),
+        utils::InconsistencyException);
+}
+
+/**
+ * Test that the types of an MCAP file are read from its sidecar, or from its attachment as the replayer does.
+ *
+ * CASES:
+ * - check that the types are read from the sidecar when it is valid.
+ * - check that the types embedded in the attachment are read when the sidecar is missing.
+ * - check that the types embedded in the attachment are read when the sidecar does not match its hash.
+ * - check that the types embedded in the attachment are read when the file references no sidecar.
+ * - check that no types are read when the file has neither.
+ */
+TEST_F(DynamicTypesSidecarTest, read_collection)
+{
+    const auto sidecar_types = test::types_data("types in the sidecar");
+    const auto embedded_types = test::types_data("types in the attachment");
+
+    const auto hash = write_(sidecar_types);
+
+    mcap::Attachment attachment;
+    attachment.name = DYNAMIC_TYPES_ATTACHMENT_NAME;
+    attachment.data = reinterpret_cast<const std::byte*>(embedded_types.data());
+    attachment.dataSize = embedded_types.size();
+
+    std::map<std::string, mcap::Metadata> metadatas = {
+        {DYNAMIC_TYPES_SIDECAR_METADATA_NAME, DynamicTypesSidecar::reference(hash)}};
+    const std::map<std::string, mcap::Attachment> attachments = {{DYNAMIC_TYPES_ATTACHMENT_NAME, attachment}};
+
+    ASSERT_EQ(DynamicTypesSidecar::read_collection(directory_.string(), metadatas, attachments), sidecar_types);
+
+    // Corrupt sidecar
+    std::ofstream(path_(hash), std::ios::binary | std::ios::trunc) << "corrupted dynamic types";
+    ASSERT_EQ(DynamicTypesSidecar::read_collection(directory_.string(), metadatas, attachments), embedded_types);
+
+    // Missing sidecar
+    std::filesystem::remove(path_(hash));
+    ASSERT_EQ(DynamicTypesSidecar::read_collection(directory_.string(), metadatas, attachments), embedded_types);
+
+    // No sidecar
+    metadatas.clear();
+    ASSERT_EQ(DynamicTypesSidecar::read_collection(directory_.string(), metadatas, attachments), embedded_types);
+
+    // No types at all
+    ASSERT_TRUE(DynamicTypesSidecar::read_collection(directory_.string(), metadatas, {}).empty());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,462 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+
+#include <ddsrecorder_participants/recorder/efficiency/payload/SlabPayloadPool.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+using Payload = ddspipe::core::types::Payload;
+
+namespace test {
+
+/**
+ * Reserve, fill and release payloads of \c pool from several threads, as the reception and write threads do.
+ *
+ * Each thread keeps a window of payloads alive, releasing the oldest one when reserving a new one.
+ *
+ * @return Seconds taken by the slowest thread.
+ */
+double reserve_fill_release(
+        ddspipe::core::PayloadPool& pool,
+        std::uint32_t min_size,
+        std::uint32_t max_size,
+        std::size_t iterations)
+{
+    constexpr std::size_t N_THREADS = 4;
+    constexpr std::size_t WINDOW = 16;
+
+    std::vector<double> seconds(N_THREADS);
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < N_THREADS; t++)
+    {
+        threads.emplace_back([&, t]()
+                {
+                    std::vector<Payload> window(WINDOW);
+                    const auto start = std::chrono::steady_clock::now();
+
+                    for (std::size_t i = 0; i < iterations; i++)
+                    {
+                        auto& payload = window[i % WINDOW];
+
+                        if (payload.data != nullptr)
+                        {
+                            ASSERT_TRUE(pool.release_payload(payload));
+                        }
+
+                        const auto size = static_cast<std::uint32_t>(
+                            min_size + (i * 7919 + t * 104729) % (max_size - min_size + 1));
+                        ASSERT_TRUE(pool.get_payload(size, payload));
+                        std::memset(payload.data, static_cast<int>(i), size);
+                        payload.length = size;
+                    }
+
+                    for (auto& payload : window)
+                    {
+                        if (payload.data != nullptr)
+                        {
+                            ASSERT_TRUE(pool.release_payload(payload));
+                        }
+                    }
+
+                    seconds[t] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return *std::max_element(seconds.begin(), seconds.end());
+}
+
+} /* namespace test */
+
+/**
+ * Test that payloads of every size can be reserved, filled and released.
+ *
+ * CASES:
+ * - check that every payload has (at least) the requested size and that they do not overlap.
+ * - check that payloads bigger than the largest size class are allocated individually.
+ * - check that the pool is clean after releasing every payload.
+ * - check that the payloads allocated individually are returned to the system when released.
+ */
+TEST(SlabPayloadPoolTest, reserve_and_release)
+{
+    SlabPayloadPool pool;
+
+    const std::vector<std::uint32_t> sizes = {
+        0, 1, 64, 65, 100, 1000, 4096, 50000, SlabPayloadPool::MAX_CLASS_SIZE, SlabPayloadPool::MAX_CLASS_SIZE + 1,
+        8 * 1024 * 1024};
+
+    std::vector<Payload> payloads(sizes.size());
+
+    for (std::size_t i = 0; i < sizes.size(); i++)
+    {
+        ASSERT_TRUE(pool.get_payload(sizes[i], payloads[i]));
+        ASSERT_NE(payloads[i].data, nullptr);
+        ASSERT_EQ(payloads[i].max_size, sizes[i]);
+        ASSERT_EQ(payloads[i].payload_owner, &pool);
+
+        std::memset(payloads[i].data, static_cast<int>(i), sizes[i]);
+        payloads[i].length = sizes[i];
+    }
+
+    for (std::size_t i = 0; i < sizes.size(); i++)
+    {
+        for (std::uint32_t j = 0; j < sizes[i]; j++)
+        {
+            ASSERT_EQ(payloads[i].data[j], static_cast<unsigned char>(i));
+        }
+    }
+
+    const auto reserved_bytes = pool.reserved_bytes();
+    ASSERT_GE(reserved_bytes, SlabPayloadPool::SLAB_SIZE + 8 * 1024 * 1024);
+
+    for (auto& payload : payloads)
+    {
+        ASSERT_TRUE(pool.release_payload(payload));
+        ASSERT_EQ(payload.data, nullptr);
+        ASSERT_EQ(payload.payload_owner, nullptr);
+    }
+
+    // Only the payloads allocated individually are returned to the system
+    ASSERT_TRUE(pool.is_clean());
+    ASSERT_LE(pool.reserved_bytes(), reserved_bytes - 8 * 1024 * 1024 - SlabPayloadPool::MAX_CLASS_SIZE);
+}
+
+/**
+ * Test that payloads of the same pool are shared and payloads of other pools are copied.
+ *
+ * CASES:
+ * - check that a payload got from another payload of the same pool points to the same data.
+ * - check that the data outlives the release of the original payload.
+ * - check that a payload got from a payload of another pool is a copy.
+ */
+TEST(SlabPayloadPoolTest, share_payload)
+{
+    SlabPayloadPool pool;
+    SlabPayloadPool other_pool;
+
+    Payload original;
+    ASSERT_TRUE(pool.get_payload(16, original));
+    std::memcpy(original.data, "0123456789abcdef", 16);
+    original.length = 16;
+
+    Payload shared;
+    ASSERT_TRUE(pool.get_payload(original, shared));
+    ASSERT_EQ(shared.data, original.data);
+    ASSERT_EQ(shared.length, 16u);
+
+    Payload copied;
+    ASSERT_TRUE(other_pool.get_payload(original, copied));
+    ASSERT_NE(copied.data, original.data);
+    ASSERT_EQ(copied.payload_owner, &other_pool);
+    ASSERT_EQ(std::memcmp(copied.data, original.data, 16), 0);
+
+    ASSERT_TRUE(pool.release_payload(original));
+    ASSERT_EQ(std::memcmp(shared.data, "0123456789abcdef", 16), 0);
+
+    // The block is still referenced, so it cannot be handed out again
+    Payload another;
+    ASSERT_TRUE(pool.get_payload(16, another));
+    ASSERT_NE(another.data, shared.data);
+
+    ASSERT_TRUE(pool.release_payload(another));
+    ASSERT_TRUE(pool.release_payload(shared));
+    ASSERT_TRUE(other_pool.release_payload(copied));
+
+    // A payload cannot be released in a pool that does not own it
+    Payload foreign;
+    ASSERT_TRUE(other_pool.get_payload(16, foreign));
+    ASSERT_FALSE(pool.release_payload(foreign));
+    ASSERT_TRUE(other_pool.release_payload(foreign));
+
+    ASSERT_TRUE(pool.is_clean());
+    ASSERT_TRUE(other_pool.is_clean());
+}
+
+/**
+ * Test that released blocks are reused instead of reserving more memory.
+ *
+ * CASES:
+ * - check that the last released block of a size class is the next one handed out.
+ * - check that no new slab is reserved when reserving and releasing many payloads in a loop.
+ */
+TEST(SlabPayloadPoolTest, reuse_blocks)
+{
+    SlabPayloadPool pool;
+
+    Payload payload;
+    ASSERT_TRUE(pool.get_payload(1000, payload));
+    const auto data = payload.data;
+    ASSERT_TRUE(pool.release_payload(payload));
+
+    ASSERT_TRUE(pool.get_payload(1000, payload));
+    ASSERT_EQ(payload.data, data);
+    ASSERT_TRUE(pool.release_payload(payload));
+
+    const auto reserved_bytes = pool.reserved_bytes();
+
+    for (int i = 0; i < 100000; i++)
+    {
+        ASSERT_TRUE(pool.get_payload(1000, payload));
+        ASSERT_TRUE(pool.release_payload(payload));
+    }
+
+    ASSERT_EQ(pool.reserved_bytes(), reserved_bytes);
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Test that the payloads bigger than the largest size class are reused with huge pages, up to the cache limit.
+ *
+ * CASES:
+ * - check that a released large block is handed out again for a payload of similar size.
+ * - check that a released large block is not handed out for a payload much smaller or bigger.
+ * - check that no memory is reserved when reserving and releasing large payloads in a loop.
+ * - check that the cached large blocks never exceed the cache limit.
+ * - check that the large blocks bigger than the cache limit are returned to the system when released.
+ */
+TEST(SlabPayloadPoolTest, reuse_large_blocks)
+{
+    constexpr std::uint32_t LARGE_SIZE = 1024 * 1024;
+
+    PayloadPoolConfiguration configuration;
+    configuration.huge_pages = true;
+
+    {
+        SlabPayloadPool pool(configuration);
+
+        Payload payload;
+        ASSERT_TRUE(pool.get_payload(LARGE_SIZE, payload));
+        const auto data = payload.data;
+        ASSERT_TRUE(pool.release_payload(payload));
+
+        const auto reserved_bytes = pool.reserved_bytes();
+        ASSERT_EQ(reserved_bytes, SlabPayloadPool::SLAB_SIZE);
+
+        ASSERT_TRUE(pool.get_payload(LARGE_SIZE - 1000, payload));
+        ASSERT_EQ(payload.data, data);
+
+        // Too big to fit in the cached block (which is in use anyway)
+        Payload bigger;
+        ASSERT_TRUE(pool.get_payload(3 * LARGE_SIZE, bigger));
+        ASSERT_NE(bigger.data, data);
+
+        ASSERT_TRUE(pool.release_payload(payload));
+        ASSERT_TRUE(pool.release_payload(bigger));
+
+        const auto cached_bytes = pool.reserved_bytes();
+
+        for (int i = 0; i < 1000; i++)
+        {
+            ASSERT_TRUE(pool.get_payload(LARGE_SIZE + (i % 10) * 100000, payload));
+            ASSERT_TRUE(pool.release_payload(payload));
+        }
+
+        ASSERT_EQ(pool.reserved_bytes(), cached_bytes);
+
+        // Release more large payloads than the cache can keep
+        std::vector<Payload> payloads(2 * SlabPayloadPool::MAX_CACHED_LARGE_BYTES / SlabPayloadPool::SLAB_SIZE);
+
+        for (auto& large_payload : payloads)
+        {
+            ASSERT_TRUE(pool.get_payload(LARGE_SIZE, large_payload));
+        }
+
+        for (auto& large_payload : payloads)
+        {
+            ASSERT_TRUE(pool.release_payload(large_payload));
+        }
+
+        ASSERT_LE(pool.reserved_bytes(), SlabPayloadPool::MAX_CACHED_LARGE_BYTES);
+
+        // Too big to be cached
+        const auto before_huge = pool.reserved_bytes();
+        ASSERT_TRUE(pool.get_payload(SlabPayloadPool::MAX_CACHED_LARGE_BYTES, payload));
+        ASSERT_GT(pool.reserved_bytes(), before_huge + SlabPayloadPool::MAX_CACHED_LARGE_BYTES);
+        ASSERT_TRUE(pool.release_payload(payload));
+        ASSERT_EQ(pool.reserved_bytes(), before_huge);
+
+        ASSERT_TRUE(pool.is_clean());
+    }
+
+    {
+        SlabPayloadPool pool(configuration);
+
+        Payload payload;
+        ASSERT_TRUE(pool.get_payload(5 * LARGE_SIZE, payload));
+        const auto data = payload.data;
+        ASSERT_TRUE(pool.release_payload(payload));
+
+        // Too small to take the cached block
+        ASSERT_TRUE(pool.get_payload(LARGE_SIZE, payload));
+        ASSERT_NE(payload.data, data);
+        ASSERT_TRUE(pool.release_payload(payload));
+
+        ASSERT_TRUE(pool.is_clean());
+    }
+}
+
+/**
+ * Test that payloads reserved in some threads can be released in others.
+ *
+ * CASES:
+ * - check that no block is handed out twice while referenced.
+ * - check that the memory reserved stays bounded when blocks flow from the reserving to the releasing threads.
+ * - check that the pool is clean when every thread is done.
+ */
+TEST(SlabPayloadPoolTest, release_in_other_thread)
+{
+    constexpr std::size_t N_THREADS = 4;
+    constexpr std::size_t N_ROUNDS = 50;
+    constexpr std::size_t N_PAYLOADS = 1000;
+
+    SlabPayloadPool pool;
+
+    for (std::size_t round = 0; round < N_ROUNDS; round++)
+    {
+        std::vector<std::vector<Payload>> payloads(N_THREADS, std::vector<Payload>(N_PAYLOADS));
+
+        // Reserve in some threads
+        std::vector<std::thread> threads;
+
+        for (std::size_t t = 0; t < N_THREADS; t++)
+        {
+            threads.emplace_back([&pool, &payloads, t]()
+                    {
+                        for (std::size_t i = 0; i < N_PAYLOADS; i++)
+                        {
+                            const auto size = static_cast<std::uint32_t>(64 + (i * 37) % 4096);
+                            ASSERT_TRUE(pool.get_payload(size, payloads[t][i]));
+                            payloads[t][i].length = size;
+                        }
+                    });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::set<unsigned char*> addresses;
+
+        for (const auto& thread_payloads : payloads)
+        {
+            for (const auto& payload : thread_payloads)
+            {
+                ASSERT_TRUE(addresses.insert(payload.data).second);
+            }
+        }
+
+        // Release in other threads
+        threads.clear();
+
+        for (std::size_t t = 0; t < N_THREADS; t++)
+        {
+            threads.emplace_back([&pool, &payloads, t]()
+                    {
+                        for (auto& payload : payloads[(t + 1) % N_THREADS])
+                        {
+                            ASSERT_TRUE(pool.release_payload(payload));
+                        }
+                    });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // The blocks released by the exited threads must have been returned to the pool and reused
+    ASSERT_LT(pool.reserved_bytes(), 8 * N_THREADS * N_PAYLOADS * 4096);
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Compare the \c SlabPayloadPool with the \c FastPayloadPool of the DDS Pipe (the default pool of the recorder).
+ *
+ * The times are recorded as properties of the test (in its XML report) so they can be tracked, but not asserted on,
+ * as they depend on the load of the machine running the test.
+ *
+ * CASES:
+ * - small payloads (64 B to 4 KiB).
+ * - payloads bigger than the largest size class (300 KiB to 2 MiB), from the heap and in huge pages.
+ */
+TEST(SlabPayloadPoolTest, compare_with_fast_payload_pool)
+{
+    struct Workload
+    {
+        const char* name;
+        std::uint32_t min_size;
+        std::uint32_t max_size;
+        std::size_t iterations;
+        bool huge_pages;
+    };
+
+    const std::vector<Workload> workloads = {
+        {"small", 64, 4096, 200000, false},
+        {"large", 300 * 1024, 2 * 1024 * 1024, 500, false},
+        {"large_huge_pages", 300 * 1024, 2 * 1024 * 1024, 500, true}};
+
+    for (const auto& workload : workloads)
+    {
+        PayloadPoolConfiguration configuration;
+        configuration.huge_pages = workload.huge_pages;
+
+        ddspipe::core::FastPayloadPool fast_pool;
+        SlabPayloadPool slab_pool(configuration);
+
+        // Warm up both pools (and the process heap) before measuring
+        test::reserve_fill_release(fast_pool, workload.min_size, workload.max_size, workload.iterations / 10);
+        test::reserve_fill_release(slab_pool, workload.min_size, workload.max_size, workload.iterations / 10);
+
+        const auto fast_seconds =
+                test::reserve_fill_release(fast_pool, workload.min_size, workload.max_size, workload.iterations);
+        const auto slab_seconds =
+                test::reserve_fill_release(slab_pool, workload.min_size, workload.max_size, workload.iterations);
+
+        RecordProperty(std::string(workload.name) + "_fast_ms", static_cast<int>(fast_seconds * 1e3));
+        RecordProperty(std::string(workload.name) + "_slab_ms", static_cast<int>(slab_seconds * 1e3));
+
+        ASSERT_TRUE(fast_pool.is_clean());
+        ASSERT_TRUE(slab_pool.is_clean());
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
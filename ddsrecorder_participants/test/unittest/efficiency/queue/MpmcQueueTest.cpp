@@ -0,0 +1,182 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/efficiency/queue/MpmcQueue.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+/**
+ * Test that the elements are extracted in the order they were inserted.
+ *
+ * CASES:
+ * - check that the elements of several laps of the ring keep their order.
+ * - check that elements that can only be moved are moved in and out of the queue.
+ */
+TEST(MpmcQueueTest, fifo_order)
+{
+    MpmcQueue<std::unique_ptr<int>> queue(4);
+
+    int next_in = 0;
+    int next_out = 0;
+
+    for (int lap = 0; lap < 10; lap++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            auto value = std::make_unique<int>(next_in++);
+            ASSERT_TRUE(queue.try_push(std::move(value)));
+            ASSERT_EQ(value, nullptr);
+        }
+
+        std::unique_ptr<int> value;
+
+        while (queue.try_pop(value))
+        {
+            ASSERT_NE(value, nullptr);
+            ASSERT_EQ(*value, next_out++);
+        }
+    }
+
+    ASSERT_EQ(next_out, next_in);
+}
+
+/**
+ * Test the limits of the queue.
+ *
+ * CASES:
+ * - check that the capacity is rounded up to a power of two.
+ * - check that no element is inserted in a full queue, and the element is left untouched.
+ * - check that no element is extracted from an empty queue.
+ */
+TEST(MpmcQueueTest, full_and_empty)
+{
+    MpmcQueue<std::unique_ptr<int>> queue(5);
+
+    ASSERT_EQ(queue.capacity(), 8u);
+    ASSERT_TRUE(queue.empty());
+
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(queue.try_push(std::make_unique<int>(i)));
+    }
+
+    ASSERT_FALSE(queue.empty());
+
+    auto value = std::make_unique<int>(8);
+    ASSERT_FALSE(queue.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);
+
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(*value, i);
+    }
+
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.try_pop(value));
+}
+
+/**
+ * Test that no element is lost nor duplicated with several producers and consumers.
+ *
+ * CASES:
+ * - check that every inserted element is extracted exactly once.
+ * - check that the elements of each producer are extracted in order by each consumer.
+ */
+TEST(MpmcQueueTest, concurrent_producers_and_consumers)
+{
+    constexpr unsigned int PRODUCERS = 4;
+    constexpr unsigned int CONSUMERS = 4;
+    constexpr unsigned int ELEMENTS = 100000;
+
+    // Each element holds its producer and its index within the producer
+    MpmcQueue<std::pair<unsigned int, unsigned int>> queue(64);
+
+    std::vector<std::atomic<unsigned int>> extracted(PRODUCERS * ELEMENTS);
+    std::atomic<unsigned int> total_extracted{0};
+    std::atomic<bool> in_order{true};
+
+    std::vector<std::thread> threads;
+
+    for (unsigned int producer = 0; producer < PRODUCERS; producer++)
+    {
+        threads.emplace_back([&, producer]()
+                {
+                    for (unsigned int i = 0; i < ELEMENTS; i++)
+                    {
+                        while (!queue.try_push({producer, i}))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+    }
+
+    for (unsigned int consumer = 0; consumer < CONSUMERS; consumer++)
+    {
+        threads.emplace_back([&]()
+                {
+                    std::vector<int> last_index(PRODUCERS, -1);
+                    std::pair<unsigned int, unsigned int> element;
+
+                    while (total_extracted.load() < PRODUCERS * ELEMENTS)
+                    {
+                        if (!queue.try_pop(element))
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        if (static_cast<int>(element.second) <= last_index[element.first])
+                        {
+                            in_order = false;
+                        }
+
+                        last_index[element.first] = element.second;
+                        extracted[element.first * ELEMENTS + element.second]++;
+                        total_extracted++;
+                    }
+                });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_TRUE(in_order.load());
+    ASSERT_TRUE(queue.empty());
+
+    for (const auto& count : extracted)
+    {
+        ASSERT_EQ(count.load(), 1u);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
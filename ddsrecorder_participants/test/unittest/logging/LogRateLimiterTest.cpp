@@ -0,0 +1,231 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/recorder/logging/LogRateLimiter.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::int64_t PERIOD = 1000000000;
+
+//! Time [ns] returned by the injected clock
+std::atomic<std::int64_t> now{0};
+
+std::int64_t clock()
+{
+    return now.load();
+}
+
+//! Number of times a logged message has been formatted
+std::uint64_t formatted{0};
+
+std::string format(
+        const std::string& msg)
+{
+    formatted++;
+    return msg;
+}
+
+/**
+ * Log consumer keeping the messages of the entries it consumes.
+ */
+class CaptureLogConsumer : public fastdds::dds::LogConsumer
+{
+public:
+
+    CaptureLogConsumer(
+            std::shared_ptr<std::vector<std::string>> messages,
+            std::shared_ptr<std::mutex> mtx)
+        : messages_(messages)
+        , mtx_(mtx)
+    {
+    }
+
+    void Consume(
+            const fastdds::dds::Log::Entry& entry) override
+    {
+        std::lock_guard<std::mutex> lock(*mtx_);
+        messages_->push_back(entry.message);
+    }
+
+protected:
+
+    std::shared_ptr<std::vector<std::string>> messages_;
+    std::shared_ptr<std::mutex> mtx_;
+};
+
+} // namespace test
+
+class LogRateLimiterTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        test::now = 0;
+        test::formatted = 0;
+
+        utils::Log::ClearConsumers();
+        utils::Log::SetVerbosity(utils::Log::Kind::Warning);
+        utils::Log::RegisterConsumer(std::make_unique<test::CaptureLogConsumer>(messages_, mtx_));
+    }
+
+    void TearDown() override
+    {
+        utils::Log::ClearConsumers();
+    }
+
+protected:
+
+    std::vector<std::string> logged_messages_()
+    {
+        utils::Log::Flush();
+
+        std::lock_guard<std::mutex> lock(*mtx_);
+        return *messages_;
+    }
+
+    std::shared_ptr<std::vector<std::string>> messages_ = std::make_shared<std::vector<std::string>>();
+    std::shared_ptr<std::mutex> mtx_ = std::make_shared<std::mutex>();
+};
+
+/**
+ * Test that a limiter lets through a single entry per period.
+ *
+ * CASES:
+ * - check that the first entry is let through.
+ * - check that the entries within the period are discarded.
+ * - check that the first entry after the period is let through, with the number of entries discarded.
+ * - check that the count of discarded entries starts again after each entry let through.
+ */
+TEST_F(LogRateLimiterTest, one_entry_per_period)
+{
+    LogRateLimiter limiter(std::chrono::nanoseconds(test::PERIOD), test::clock);
+    std::uint64_t suppressed = 0;
+
+    ASSERT_TRUE(limiter.acquire(suppressed));
+    ASSERT_EQ(suppressed, 0u);
+
+    for (int i = 0; i < 5; i++)
+    {
+        test::now += test::PERIOD / 10;
+        ASSERT_FALSE(limiter.acquire(suppressed));
+    }
+
+    test::now = test::PERIOD;
+    ASSERT_TRUE(limiter.acquire(suppressed));
+    ASSERT_EQ(suppressed, 5u);
+
+    test::now += test::PERIOD - 1;
+    ASSERT_FALSE(limiter.acquire(suppressed));
+
+    test::now += 1;
+    ASSERT_TRUE(limiter.acquire(suppressed));
+    ASSERT_EQ(suppressed, 1u);
+
+    test::now += test::PERIOD;
+    ASSERT_TRUE(limiter.acquire(suppressed));
+    ASSERT_EQ(suppressed, 0u);
+}
+
+/**
+ * Test that the entries let through report the occurrences discarded since the previous one.
+ *
+ * CASES:
+ * - check that the first entry is logged as is.
+ * - check that the entries within the period are not logged.
+ * - check that the next entry reports the number of occurrences discarded.
+ */
+TEST_F(LogRateLimiterTest, report_suppressed_occurrences)
+{
+    LogRateLimiter limiter(std::chrono::nanoseconds(test::PERIOD), test::clock);
+
+    for (int i = 0; i < 4; i++)
+    {
+        DDSRECORDER_LOG_WITH_RATE_LIMITER_(limiter, EPROSIMA_LOG_WARNING, DDSRECORDER_TEST, "Sample lost");
+    }
+
+    test::now = test::PERIOD;
+    DDSRECORDER_LOG_WITH_RATE_LIMITER_(limiter, EPROSIMA_LOG_WARNING, DDSRECORDER_TEST, "Sample lost");
+
+    const auto messages = logged_messages_();
+
+    ASSERT_EQ(messages.size(), 2u);
+    ASSERT_EQ(messages[0], "Sample lost");
+    ASSERT_EQ(messages[1], "Sample lost [3 more occurrences since last report]");
+}
+
+/**
+ * Test that every call site is rate-limited on its own.
+ *
+ * CASES:
+ * - check that repeated entries from a call site are logged once.
+ * - check that the entries of a call site do not discard the ones of another.
+ */
+TEST_F(LogRateLimiterTest, separate_call_sites)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_TEST, "First call site");
+        DDSRECORDER_LOG_WARNING_RATE_LIMITED(DDSRECORDER_TEST, "Second call site");
+    }
+
+    const auto messages = logged_messages_();
+
+    ASSERT_EQ(messages.size(), 2u);
+    ASSERT_EQ(messages[0], "First call site");
+    ASSERT_EQ(messages[1], "Second call site");
+}
+
+/**
+ * Test that the message is only formatted if the entry is logged.
+ *
+ * CASES:
+ * - check that the discarded entries are not formatted.
+ */
+TEST_F(LogRateLimiterTest, format_only_emitted_entries)
+{
+    LogRateLimiter limiter(std::chrono::nanoseconds(test::PERIOD), test::clock);
+
+    for (int i = 0; i < 10; i++)
+    {
+        DDSRECORDER_LOG_WITH_RATE_LIMITER_(limiter, EPROSIMA_LOG_WARNING, DDSRECORDER_TEST, test::format("Entry"));
+    }
+
+    ASSERT_EQ(test::formatted, 1u);
+    ASSERT_EQ(logged_messages_().size(), 1u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
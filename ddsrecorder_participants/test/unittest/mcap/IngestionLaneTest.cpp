@@ -0,0 +1,399 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+
+#include <ddsrecorder_participants/recorder/mcap/IngestionLane.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+using namespace eprosima::ddspipe::core::types;
+
+namespace test {
+
+//! Samples handed over by a lane, in the order they were received
+class Collector
+{
+public:
+
+    void add(
+            std::vector<IngestionSample>& samples)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        cv_.wait(
+            lock,
+            [&]
+            {
+                return !blocked_;
+            });
+
+        for (const auto& sample : samples)
+        {
+            sequences_.push_back(sample.message.sequence);
+        }
+
+        batches_++;
+    }
+
+    void block(
+            const bool blocked)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = blocked;
+        }
+
+        cv_.notify_all();
+    }
+
+    std::vector<std::uint32_t> sequences()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sequences_;
+    }
+
+    unsigned int batches()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+    IngestionLane::BatchHandler handler()
+    {
+        return [this](std::vector<IngestionSample>& samples)
+               {
+                   add(samples);
+                   return true;
+               };
+    }
+
+protected:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool blocked_{false};
+    std::vector<std::uint32_t> sequences_;
+    unsigned int batches_{0};
+};
+
+//! Samples handed over by a lane and only added when a lock is free, as the \c McapHandler does
+class BusyHandler
+{
+public:
+
+    bool add(
+            std::vector<IngestionSample>& samples)
+    {
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+
+            for (auto& sample : samples)
+            {
+                buffered_.push_back(sample.message.sequence);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(busy_mutex, std::try_to_lock);
+
+        if (!lock.owns_lock())
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+        added_.insert(added_.end(), buffered_.begin(), buffered_.end());
+        buffered_.clear();
+
+        return true;
+    }
+
+    std::vector<std::uint32_t> added()
+    {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        return added_;
+    }
+
+    IngestionLane::BatchHandler handler()
+    {
+        return [this](std::vector<IngestionSample>& samples)
+               {
+                   return add(samples);
+               };
+    }
+
+    //! Held while the handler is busy (e.g. writing to disk)
+    std::mutex busy_mutex;
+
+protected:
+
+    std::mutex buffer_mutex_;
+    std::vector<std::uint32_t> buffered_;
+    std::vector<std::uint32_t> added_;
+};
+
+IngestionLaneConfiguration configuration(
+        const std::uint32_t queue_size = 4096)
+{
+    IngestionLaneConfiguration configuration;
+    configuration.name = "test_lane";
+    configuration.topics = {"*"};
+    configuration.queue_size = queue_size;
+
+    return configuration;
+}
+
+IngestionSample sample(
+        const std::shared_ptr<const DdsTopic>& topic,
+        const std::uint32_t sequence)
+{
+    IngestionSample sample;
+    sample.topic = topic;
+    sample.message.sequence = sequence;
+
+    return sample;
+}
+
+} // test
+
+/**
+ * Test that the samples of a lane are handed over in order and in batches.
+ *
+ * CASES:
+ * - check that every sample inserted before a flush has been handed over when it returns.
+ * - check that the samples are handed over in the order they were inserted.
+ * - check that the samples are handed over in fewer batches when the lane thread is busy.
+ */
+TEST(IngestionLaneTest, add_in_batches)
+{
+    constexpr std::uint32_t SAMPLES = 1000;
+
+    test::Collector collector;
+    IngestionLane lane(test::configuration(), collector.handler());
+
+    const auto topic = std::make_shared<const DdsTopic>();
+
+    // Keep the lane thread busy so the samples accumulate
+    collector.block(true);
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        ASSERT_TRUE(lane.push(test::sample(topic, i)));
+    }
+
+    collector.block(false);
+    lane.flush();
+
+    const auto sequences = collector.sequences();
+    ASSERT_EQ(sequences.size(), SAMPLES);
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        ASSERT_EQ(sequences[i], i);
+    }
+
+    ASSERT_LT(collector.batches(), SAMPLES / 2);
+}
+
+/**
+ * Test that no sample is inserted in a full lane.
+ *
+ * CASES:
+ * - check that samples are rejected once the lane is full, and the rejected sample is left untouched.
+ * - check that every accepted sample is handed over once the lane thread is free.
+ */
+TEST(IngestionLaneTest, full_lane)
+{
+    constexpr std::uint32_t QUEUE_SIZE = 64;
+
+    test::Collector collector;
+    IngestionLane lane(test::configuration(QUEUE_SIZE), collector.handler());
+
+    const auto topic = std::make_shared<const DdsTopic>();
+
+    collector.block(true);
+
+    // The lane thread may have taken a first batch out of the queue before blocking
+    std::uint32_t accepted = 0;
+
+    while (accepted <= 2 * QUEUE_SIZE)
+    {
+        auto rejected = test::sample(topic, accepted);
+
+        if (!lane.push(std::move(rejected)))
+        {
+            ASSERT_EQ(rejected.topic, topic);
+            ASSERT_EQ(rejected.message.sequence, accepted);
+            break;
+        }
+
+        accepted++;
+    }
+
+    ASSERT_GE(accepted, QUEUE_SIZE);
+    ASSERT_LE(accepted, 2 * QUEUE_SIZE);
+
+    collector.block(false);
+    lane.flush();
+
+    ASSERT_EQ(collector.sequences().size(), accepted);
+}
+
+/**
+ * Test that the samples left in a lane are handed over when it is destroyed.
+ *
+ * CASES:
+ * - check that every sample inserted before the destruction is handed over.
+ */
+TEST(IngestionLaneTest, drain_on_destruction)
+{
+    constexpr std::uint32_t SAMPLES = 500;
+
+    test::Collector collector;
+
+    {
+        IngestionLane lane(test::configuration(), collector.handler());
+
+        const auto topic = std::make_shared<const DdsTopic>();
+
+        for (std::uint32_t i = 0; i < SAMPLES; i++)
+        {
+            ASSERT_TRUE(lane.push(test::sample(topic, i)));
+        }
+    }
+
+    ASSERT_EQ(collector.sequences().size(), SAMPLES);
+}
+
+/**
+ * Test that the samples handed over while the handler is busy are added once it is free, with no further samples.
+ *
+ * CASES:
+ * - check that no sample is added while the handler is busy, although every sample has been handed over.
+ * - check that every sample is added, in order, once the handler is free, without inserting more samples.
+ */
+TEST(IngestionLaneTest, busy_handler)
+{
+    constexpr std::uint32_t SAMPLES = 100;
+
+    test::BusyHandler handler;
+    IngestionLane lane(test::configuration(), handler.handler());
+
+    const auto topic = std::make_shared<const DdsTopic>();
+
+    {
+        std::lock_guard<std::mutex> busy_lock(handler.busy_mutex);
+
+        for (std::uint32_t i = 0; i < SAMPLES; i++)
+        {
+            ASSERT_TRUE(lane.push(test::sample(topic, i)));
+        }
+
+        lane.flush();
+
+        ASSERT_TRUE(handler.added().empty());
+    }
+
+    // No more samples: the lane retries the handover by itself
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (handler.added().size() < SAMPLES && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto added = handler.added();
+    ASSERT_EQ(added.size(), SAMPLES);
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        ASSERT_EQ(added[i], i);
+    }
+}
+
+/**
+ * Test that the payloads of the samples are released once, however many times the samples are moved.
+ *
+ * CASES:
+ * - check that the payload of a sample is the one it was inserted with when handed over.
+ * - check that every payload is released once the samples have been handed over, reusing the slots of the lane.
+ */
+TEST(IngestionLaneTest, payload_ownership)
+{
+    constexpr std::uint32_t QUEUE_SIZE = 64;
+    constexpr std::uint32_t SAMPLES = 1000;
+    constexpr std::uint32_t PAYLOAD_SIZE = 16;
+
+    eprosima::ddspipe::core::FastPayloadPool pool;
+    std::vector<eprosima::fastdds::rtps::octet*> received;
+
+    {
+        IngestionLane lane(
+            test::configuration(QUEUE_SIZE),
+            [&](std::vector<IngestionSample>& samples)
+            {
+                for (const auto& sample : samples)
+                {
+                    EXPECT_EQ(sample.message.data, reinterpret_cast<const std::byte*>(sample.message.payload.data));
+                    received.push_back(sample.message.payload.data);
+                }
+
+                return true;
+            });
+
+        const auto topic = std::make_shared<const DdsTopic>();
+
+        for (std::uint32_t i = 0; i < SAMPLES; i++)
+        {
+            auto sample = test::sample(topic, i);
+
+            ASSERT_TRUE(pool.get_payload(PAYLOAD_SIZE, sample.message.payload));
+            sample.message.payload.length = PAYLOAD_SIZE;
+            sample.message.payload_owner = &pool;
+            sample.message.data = reinterpret_cast<std::byte*>(sample.message.payload.data);
+            sample.message.dataSize = PAYLOAD_SIZE;
+
+            // Wrap around the slots of the lane several times
+            if (!lane.push(std::move(sample)))
+            {
+                lane.flush();
+                ASSERT_TRUE(lane.push(std::move(sample)));
+            }
+        }
+
+        lane.flush();
+    }
+
+    ASSERT_EQ(received.size(), SAMPLES);
+    ASSERT_TRUE(pool.is_clean());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
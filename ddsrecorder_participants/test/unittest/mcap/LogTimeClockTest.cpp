@@ -0,0 +1,167 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClock.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::uint64_t MS = 1000 * 1000;
+
+constexpr int READS = 1000;
+
+//! Extra lag allowed to the coarse clock, whose ticks may be delayed on tickless kernels
+constexpr std::uint64_t COARSE_TOLERANCE = 100 * MS;
+
+//! Current system time [ns]
+std::uint64_t system_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+LogTimeClock clock(
+        const LogTimeClockKind kind,
+        const std::uint64_t precision = 1)
+{
+    LogTimeClockConfiguration configuration;
+    configuration.kind = kind;
+    configuration.precision = precision;
+
+    return LogTimeClock(configuration);
+}
+
+} /* namespace test */
+
+/**
+ * Test that the system clock timestamps are the system time.
+ *
+ * CASES:
+ * - check that every timestamp is between two reads of the system clock.
+ * - check that the resolution of the system clock is reported.
+ */
+TEST(LogTimeClockTest, system_clock)
+{
+    const auto clock = test::clock(LogTimeClockKind::system);
+
+    ASSERT_GE(clock.resolution(), 1u);
+    ASSERT_LE(clock.resolution(), test::MS);
+
+    for (int i = 0; i < test::READS; i++)
+    {
+        const auto before = test::system_ns();
+        const auto now = clock.now();
+        const auto after = test::system_ns();
+
+        ASSERT_GE(now, before);
+        ASSERT_LE(now, after);
+    }
+}
+
+/**
+ * Test that the coarse clock timestamps are the system time, to the resolution of the coarse clock.
+ *
+ * Where the coarse clock is not available, it falls back to the system clock, so the same bounds hold.
+ *
+ * CASES:
+ * - check that the resolution of the coarse clock is at least the resolution of the system clock.
+ * - check that every timestamp lags the system time by less than the coarse resolution (plus a tolerance).
+ * - check that the timestamps never go back.
+ */
+TEST(LogTimeClockTest, coarse_clock)
+{
+    const auto clock = test::clock(LogTimeClockKind::coarse);
+    const auto resolution = clock.resolution();
+
+    ASSERT_GE(resolution, test::clock(LogTimeClockKind::system).resolution());
+
+    std::uint64_t previous = 0;
+
+    for (int i = 0; i < test::READS; i++)
+    {
+        const auto before = test::system_ns();
+        const auto now = clock.now();
+        const auto after = test::system_ns();
+
+        ASSERT_GE(now + resolution + test::COARSE_TOLERANCE, before);
+        ASSERT_LE(now, after);
+        ASSERT_GE(now, previous);
+
+        previous = now;
+    }
+}
+
+/**
+ * Test that the timestamps are truncated to the configured precision.
+ *
+ * CASES:
+ * - check that every timestamp is a multiple of the precision, for both clocks.
+ * - check that the truncation only drops the time below the precision.
+ * - check that a precision of 1 ns keeps the full resolution.
+ */
+TEST(LogTimeClockTest, precision)
+{
+    for (const auto kind : {LogTimeClockKind::system, LogTimeClockKind::coarse})
+    {
+        for (const std::uint64_t precision : {std::uint64_t{1000}, test::MS, 1000 * test::MS})
+        {
+            const auto clock = test::clock(kind, precision);
+            const auto max_lag =
+                    precision + (kind == LogTimeClockKind::coarse ? clock.resolution() + test::COARSE_TOLERANCE : 0);
+
+            for (int i = 0; i < test::READS; i++)
+            {
+                const auto before = test::system_ns();
+                const auto now = clock.now();
+                const auto after = test::system_ns();
+
+                ASSERT_EQ(now % precision, 0u);
+                ASSERT_GE(now + max_lag, before);
+                ASSERT_LE(now, after);
+            }
+        }
+    }
+
+    // Full resolution: at least one of many consecutive timestamps is not a multiple of 1 us
+    const auto clock = test::clock(LogTimeClockKind::system, 1);
+
+    if (clock.resolution() >= 1000)
+    {
+        GTEST_SKIP() << "The system clock is not precise enough to check the full resolution.";
+    }
+
+    bool truncated = true;
+
+    for (int i = 0; i < test::READS && truncated; i++)
+    {
+        truncated = clock.now() % 1000 == 0;
+    }
+
+    ASSERT_FALSE(truncated);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChannelStatistics.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::uint64_t DATA_SIZE = 100;
+
+mcap::Channel channel()
+{
+    mcap::Channel channel("topic", "cdr", 1);
+    channel.id = 1;
+
+    return channel;
+}
+
+std::string value(
+        const McapChannelStatistics& statistics,
+        const std::string& key)
+{
+    return statistics.to_metadata(channel()).metadata.at(key);
+}
+
+} // namespace test
+
+/**
+ * Test the statistics of a channel with regular messages.
+ *
+ * CASES:
+ * - check the message count and bytes.
+ * - check the first and last logTimes.
+ * - check the minimum, maximum and mean inter-arrival times.
+ * - check that no gap is found.
+ */
+TEST(McapChannelStatisticsTest, regular_messages)
+{
+    McapChannelStatistics statistics;
+
+    for (std::uint64_t i = 0; i < 10; i++)
+    {
+        statistics.add_message(1000 + i * 10, test::DATA_SIZE);
+    }
+
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_MESSAGES), "10");
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_BYTES), std::to_string(10 * test::DATA_SIZE));
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_FIRST_LOG_TIME), "1000");
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_LAST_LOG_TIME), "1090");
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_MIN_INTER_ARRIVAL), "10");
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_MAX_INTER_ARRIVAL), "10");
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_MEAN_INTER_ARRIVAL), "10");
+    ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_GAPS), "0");
+}
+
+/**
+ * Test that the gaps are found.
+ *
+ * CASES:
+ * - check that an inter-arrival time longer than twice the mean is a gap.
+ * - check that an inter-arrival time that long, but multiplied by the number of inter-arrivals overflowing 64 bits,
+ *   is still a gap.
+ */
+TEST(McapChannelStatisticsTest, gaps)
+{
+    // Short gap
+    {
+        McapChannelStatistics statistics;
+
+        for (std::uint64_t i = 0; i < 10; i++)
+        {
+            statistics.add_message(i * 10, test::DATA_SIZE);
+        }
+
+        statistics.add_message(200, test::DATA_SIZE);
+
+        ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_GAPS), "1");
+    }
+
+    // Long gap
+    {
+        McapChannelStatistics statistics;
+
+        // 19 inter-arrival times of 1 ns
+        for (std::uint64_t i = 0; i < 20; i++)
+        {
+            statistics.add_message(i, test::DATA_SIZE);
+        }
+
+        // 19 times this inter-arrival time wraps around to 2 ns
+        const std::uint64_t long_gap = std::numeric_limits<std::uint64_t>::max() / 19 + 1;
+        statistics.add_message(19 + long_gap, test::DATA_SIZE);
+
+        ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_GAPS), "1");
+        ASSERT_EQ(test::value(statistics, CHANNEL_STATISTICS_MAX_INTER_ARRIVAL), std::to_string(long_gap));
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/mcap/McapChunkPolicy.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::uint64_t MS = 1000000;
+constexpr std::uint64_t START = 1000 * MS;
+constexpr std::uint64_t DATA_SIZE = 1024 - McapChunkPolicy::MESSAGE_RECORD_OVERHEAD;
+
+McapChunkingConfiguration adaptive_configuration()
+{
+    McapChunkingConfiguration configuration;
+    configuration.kind = McapChunkingKind::adaptive;
+    configuration.target_duration = 100;
+    configuration.min_size = 4 * 1024;
+    configuration.max_size = 64 * 1024;
+    configuration.rate_change_factor = 4;
+
+    return configuration;
+}
+
+/**
+ * Write messages of 1 KB every \c interval nanoseconds from \c start until the policy closes the chunk.
+ *
+ * Return the number of messages written, or 0 if the chunk was not closed after \c max_messages .
+ */
+std::uint64_t write_until_closed(
+        McapChunkPolicy& policy,
+        std::uint64_t& log_time,
+        const std::uint64_t interval,
+        ChunkCloseReason& reason,
+        const std::uint64_t max_messages = 1000)
+{
+    for (std::uint64_t i = 1; i <= max_messages; i++)
+    {
+        policy.message_written(log_time, DATA_SIZE);
+        log_time += interval;
+
+        if (policy.should_close(reason))
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace test
+
+/**
+ * Test that fixed chunking leaves the chunks to the MCAP library.
+ *
+ * CASES:
+ * - check that the MCAP library closes the chunks at the configured size.
+ * - check that the policy never closes a chunk.
+ */
+TEST(McapChunkPolicyTest, fixed_chunking)
+{
+    McapChunkingConfiguration configuration;
+    configuration.size = 128 * 1024;
+
+    ASSERT_EQ(McapChunkPolicy::library_chunk_size(configuration), configuration.size);
+
+    McapChunkPolicy policy(configuration);
+
+    auto log_time = test::START;
+    ChunkCloseReason reason;
+
+    ASSERT_EQ(test::write_until_closed(policy, log_time, 1000 * test::MS, reason), 0u);
+}
+
+/**
+ * Test that adaptive chunking closes a chunk once its messages span the target duration.
+ *
+ * CASES:
+ * - check that the MCAP library only closes the chunks at the maximum size.
+ * - check that the chunk is closed by duration once the target duration is reached.
+ */
+TEST(McapChunkPolicyTest, adaptive_duration)
+{
+    const auto configuration = test::adaptive_configuration();
+
+    ASSERT_EQ(McapChunkPolicy::library_chunk_size(configuration), configuration.max_size);
+
+    McapChunkPolicy policy(configuration);
+
+    auto log_time = test::START;
+    ChunkCloseReason reason;
+
+    // 10 ms between messages: the 11th message spans 100 ms
+    ASSERT_EQ(test::write_until_closed(policy, log_time, 10 * test::MS, reason), 11u);
+    ASSERT_EQ(reason, ChunkCloseReason::duration);
+    ASSERT_EQ(policy.current_duration(), 100 * test::MS);
+    ASSERT_EQ(policy.current_size(), 11u * 1024);
+}
+
+/**
+ * Test that adaptive chunking keeps the chunks between the minimum and maximum sizes.
+ *
+ * CASES:
+ * - check that a chunk spanning the target duration is not closed below the minimum size.
+ * - check that a chunk is closed by size once it reaches the maximum size.
+ */
+TEST(McapChunkPolicyTest, adaptive_size_bounds)
+{
+    const auto configuration = test::adaptive_configuration();
+
+    {
+        McapChunkPolicy policy(configuration);
+
+        auto log_time = test::START;
+        ChunkCloseReason reason;
+
+        // 1 s between messages: the target duration is exceeded on the second message, but not the minimum size
+        ASSERT_EQ(test::write_until_closed(policy, log_time, 1000 * test::MS, reason), 4u);
+        ASSERT_EQ(reason, ChunkCloseReason::duration);
+        ASSERT_EQ(policy.current_size(), configuration.min_size);
+    }
+
+    {
+        McapChunkPolicy policy(configuration);
+
+        auto log_time = test::START;
+        ChunkCloseReason reason;
+
+        // 1 us between messages: the maximum size is reached long before the target duration
+        ASSERT_EQ(test::write_until_closed(policy, log_time, 1000, reason), 64u);
+        ASSERT_EQ(reason, ChunkCloseReason::size);
+        ASSERT_EQ(policy.current_size(), configuration.max_size);
+    }
+}
+
+/**
+ * Test that adaptive chunking closes a chunk early when the message rate changes.
+ *
+ * CASES:
+ * - check that the chunk is closed by rate change when a burst starts.
+ * - check that the chunk is closed by rate change when the burst ends.
+ * - check that a steady rate does not close the chunk by rate change.
+ */
+TEST(McapChunkPolicyTest, adaptive_rate_change)
+{
+    McapChunkPolicy policy(test::adaptive_configuration());
+
+    auto log_time = test::START;
+    ChunkCloseReason reason;
+
+    // Steady rate of 1 message every 5 ms
+    ASSERT_GT(test::write_until_closed(policy, log_time, 5 * test::MS, reason), 0u);
+    ASSERT_EQ(reason, ChunkCloseReason::duration);
+    policy.chunk_closed(reason, 0);
+
+    ASSERT_GT(test::write_until_closed(policy, log_time, 5 * test::MS, reason), 0u);
+    ASSERT_EQ(reason, ChunkCloseReason::duration);
+    policy.chunk_closed(reason, 0);
+
+    // Burst of 1 message every 100 us
+    ASSERT_GT(test::write_until_closed(policy, log_time, test::MS / 10, reason), 0u);
+    ASSERT_EQ(reason, ChunkCloseReason::rate_change);
+    ASSERT_LT(policy.current_size(), test::adaptive_configuration().max_size);
+    policy.chunk_closed(reason, 0);
+
+    // Back to 1 message every 5 ms
+    ASSERT_GT(test::write_until_closed(policy, log_time, 5 * test::MS, reason), 0u);
+    ASSERT_EQ(reason, ChunkCloseReason::rate_change);
+}
+
+/**
+ * Test that the statistics account the closed chunks.
+ *
+ * CASES:
+ * - check the number of chunks per reason, messages and sizes.
+ * - check that the statistics are cleared on reset.
+ */
+TEST(McapChunkPolicyTest, statistics)
+{
+    McapChunkPolicy policy(test::adaptive_configuration());
+
+    ASSERT_TRUE(policy.empty());
+
+    policy.message_written(test::START, test::DATA_SIZE);
+    policy.message_written(test::START + 20 * test::MS, test::DATA_SIZE);
+
+    ASSERT_FALSE(policy.empty());
+
+    policy.chunk_closed(ChunkCloseReason::duration, 1500);
+
+    policy.message_written(test::START + 30 * test::MS, test::DATA_SIZE);
+    policy.chunk_closed(ChunkCloseReason::flush, 800);
+
+    ASSERT_TRUE(policy.empty());
+
+    const auto& statistics = policy.statistics();
+
+    ASSERT_EQ(statistics.chunks, 2u);
+    ASSERT_EQ(statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::duration)], 1u);
+    ASSERT_EQ(statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::flush)], 1u);
+    ASSERT_EQ(statistics.chunks_per_reason[static_cast<std::size_t>(ChunkCloseReason::size)], 0u);
+    ASSERT_EQ(statistics.messages, 3u);
+    ASSERT_EQ(statistics.uncompressed_size, 3u * 1024);
+    ASSERT_EQ(statistics.written_size, 2300u);
+    ASSERT_EQ(statistics.min_uncompressed_size, 1024u);
+    ASSERT_EQ(statistics.max_uncompressed_size, 2048u);
+    ASSERT_EQ(statistics.duration, 20 * test::MS);
+
+    policy.reset_statistics();
+
+    ASSERT_EQ(policy.statistics().chunks, 0u);
+    ASSERT_EQ(policy.statistics().messages, 0u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define MCAP_IMPLEMENTATION  // Define this in exactly one .cpp file
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <mcap/mcap.hpp>
+
+namespace test {
+
+//! More messages than buffers fit in a single gather write
+constexpr std::size_t MESSAGES = 3000;
+
+//! A chunk size that splits the messages in several chunks
+constexpr std::uint64_t CHUNK_SIZE = 64 * 1024;
+
+//! The payloads of the messages, of varying sizes (some empty and some larger than a chunk)
+std::vector<std::vector<std::byte>> payloads()
+{
+    std::vector<std::vector<std::byte>> payloads;
+
+    for (std::size_t i = 0; i < MESSAGES; i++)
+    {
+        const auto size = i % 500 == 0 ? 2 * CHUNK_SIZE : i % 97;
+        payloads.emplace_back(size, static_cast<std::byte>(i));
+    }
+
+    return payloads;
+}
+
+//! Writes the \c payloads to \c filename and returns the status of the output before closing it
+mcap::Status write(
+        const std::string& filename,
+        const std::vector<std::vector<std::byte>>& payloads,
+        const bool reference_payloads)
+{
+    mcap::McapWriterOptions options("ros2msg");
+    options.compression = mcap::Compression::None;
+    options.chunkSize = CHUNK_SIZE;
+    options.referencePayloads = reference_payloads;
+
+    mcap::McapWriter writer;
+    const auto open_status = writer.open(filename, options);
+
+    if (!open_status.ok())
+    {
+        return open_status;
+    }
+
+    mcap::Schema schema("schema", "ros2msg", "");
+    writer.addSchema(schema);
+
+    mcap::Channel channel("topic", "cdr", schema.id);
+    writer.addChannel(channel);
+
+    for (std::size_t i = 0; i < payloads.size(); i++)
+    {
+        mcap::Message message;
+        message.channelId = channel.id;
+        message.sequence = static_cast<std::uint32_t>(i);
+        message.logTime = i;
+        message.publishTime = i;
+        message.data = payloads[i].data();
+        message.dataSize = payloads[i].size();
+
+        const auto status = writer.write(message);
+
+        if (!status.ok())
+        {
+            return status;
+        }
+    }
+
+    writer.closeLastChunk();
+
+    const auto status = writer.dataSink()->status();
+    writer.close();
+
+    return status;
+}
+
+//! The contents of \c filename
+std::string contents(
+        const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+} /* namespace test */
+
+class McapFileWriterTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() / "ddsrecorder_mcap_file_writer_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory_);
+    }
+
+protected:
+
+    std::filesystem::path directory_;
+};
+
+/**
+ * Test that writing the payloads by reference (gathered in a single write per chunk) does not change the output.
+ *
+ * CASES:
+ * - check that the file written by reference is byte-identical to the file written by copy.
+ * - check that no write fails in either case.
+ * - check that empty payloads do not corrupt the records after them.
+ */
+TEST_F(McapFileWriterTest, reference_payloads)
+{
+    const auto payloads = test::payloads();
+
+    const auto copied = (directory_ / "copied.mcap").string();
+    const auto referenced = (directory_ / "referenced.mcap").string();
+
+    ASSERT_TRUE(test::write(copied, payloads, false).ok());
+    ASSERT_TRUE(test::write(referenced, payloads, true).ok());
+
+    const auto copied_contents = test::contents(copied);
+    const auto referenced_contents = test::contents(referenced);
+
+    ASSERT_GT(copied_contents.size(), test::MESSAGES * sizeof(std::uint64_t));
+
+    // NOTE: The contents are not compared with ASSERT_EQ so a mismatch does not print whole files.
+    ASSERT_EQ(referenced_contents.size(), copied_contents.size());
+    ASSERT_TRUE(referenced_contents == copied_contents);
+}
+
+/**
+ * Test that a failed write is reported by the output instead of being silently dropped.
+ *
+ * CASES:
+ * - check that writing by copy to a full device reports the failure.
+ * - check that writing by reference to a full device reports the failure.
+ */
+TEST_F(McapFileWriterTest, write_failure)
+{
+    const std::string full_device = "/dev/full";
+
+    if (!std::filesystem::exists(full_device))
+    {
+        GTEST_SKIP() << "No full device to write to.";
+    }
+
+    const auto payloads = test::payloads();
+
+    for (const auto reference_payloads : {false, true})
+    {
+        const auto status = test::write(full_device, payloads, reference_payloads);
+
+        ASSERT_EQ(status.code, mcap::StatusCode::WriteFailed);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,321 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define MCAP_IMPLEMENTATION  // Define this in exactly one .cpp file
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/common/mcap/McapStreamFrame.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamWriter.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr int TIMEOUT_MS = 2000;
+
+//! A frame as received by the collector
+struct Frame
+{
+    McapStreamFrame::Kind kind;
+    std::uint64_t file_id{0};
+    std::uint64_t offset{0};
+    std::string payload;
+};
+
+/**
+ * Minimal collector listening on a Unix domain socket.
+ */
+class Collector
+{
+public:
+
+    Collector(
+            const std::string& path)
+        : path_(path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path_.c_str(), sizeof(address.sun_path) - 1);
+
+        unlink(path_.c_str());
+
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(listen_fd_, 1);
+    }
+
+    ~Collector()
+    {
+        disconnect();
+        close(listen_fd_);
+        unlink(path_.c_str());
+    }
+
+    bool accept()
+    {
+        pollfd listen_poll{listen_fd_, POLLIN, 0};
+
+        if (poll(&listen_poll, 1, TIMEOUT_MS) <= 0)
+        {
+            return false;
+        }
+
+        connection_ = ::accept(listen_fd_, nullptr, nullptr);
+        return connection_ >= 0;
+    }
+
+    void disconnect()
+    {
+        if (connection_ >= 0)
+        {
+            close(connection_);
+            connection_ = -1;
+        }
+    }
+
+    bool read_frame(
+            Frame& frame)
+    {
+        McapStreamFrame::Header header;
+        std::uint64_t length;
+
+        if (!read_(header.data(), header.size()) ||
+                !McapStreamFrame::parse_header(header.data(), frame.kind, frame.file_id, frame.offset, length))
+        {
+            return false;
+        }
+
+        frame.payload.resize(length);
+
+        return read_(reinterpret_cast<std::byte*>(&frame.payload[0]), length);
+    }
+
+protected:
+
+    bool read_(
+            std::byte* data,
+            std::size_t size)
+    {
+        while (size > 0)
+        {
+            pollfd connection_poll{connection_, POLLIN, 0};
+
+            if (poll(&connection_poll, 1, TIMEOUT_MS) <= 0)
+            {
+                return false;
+            }
+
+            const auto received = recv(connection_, data, size, 0);
+
+            if (received <= 0)
+            {
+                return false;
+            }
+
+            data += received;
+            size -= static_cast<std::size_t>(received);
+        }
+
+        return true;
+    }
+
+    std::string path_;
+
+    int listen_fd_{-1};
+
+    int connection_{-1};
+};
+
+std::string socket_path()
+{
+    return (std::filesystem::temp_directory_path() / "ddsrecorder_stream_test.sock").string();
+}
+
+McapStreamConfiguration stream_configuration()
+{
+    McapStreamConfiguration configuration;
+    configuration.kind = McapStreamKind::unix_socket;
+    configuration.path = socket_path();
+    configuration.reconnection_period = 20;
+
+    return configuration;
+}
+
+void write(
+        mcap::IWritable& writer,
+        const std::string& data)
+{
+    writer.write(reinterpret_cast<const std::byte*>(data.data()), data.size());
+}
+
+void expect_frame(
+        Collector& collector,
+        const McapStreamFrame::Kind kind,
+        const std::uint64_t offset,
+        const std::string& payload)
+{
+    Frame frame;
+    ASSERT_TRUE(collector.read_frame(frame));
+    ASSERT_EQ(frame.kind, kind);
+    ASSERT_EQ(frame.offset, offset);
+    ASSERT_EQ(frame.payload, payload);
+}
+
+} // namespace test
+
+/**
+ * Test that a file is streamed as an open frame, data frames with their offsets, and a close frame.
+ *
+ * CASES:
+ * - check that the open frame holds the name of the file.
+ * - check that each flush frames the bytes written since the previous one.
+ * - check that the close frame holds the size of the file.
+ */
+TEST(McapStreamWriterTest, stream_file)
+{
+    test::Collector collector(test::socket_path());
+    McapStreamWriter writer(test::stream_configuration());
+
+    ASSERT_TRUE(collector.accept());
+
+    writer.open("output.mcap");
+    test::write(writer, "0123456789");
+    writer.flush();
+    test::write(writer, "abc");
+    writer.end();
+
+    ASSERT_EQ(writer.size(), 13u);
+
+    test::expect_frame(collector, McapStreamFrame::Kind::open, 0, "output.mcap");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 0, "0123456789");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 10, "abc");
+    test::expect_frame(collector, McapStreamFrame::Kind::close, 13, "");
+}
+
+/**
+ * Test that the frames of the open file are sent again after a reconnection.
+ *
+ * CASES:
+ * - check that the open frame is sent again.
+ * - check that the frames already sent are sent again, followed by the new ones.
+ */
+TEST(McapStreamWriterTest, resume_after_reconnection)
+{
+    test::Collector collector(test::socket_path());
+    McapStreamWriter writer(test::stream_configuration());
+
+    ASSERT_TRUE(collector.accept());
+
+    writer.open("output.mcap");
+    test::write(writer, "first");
+    writer.flush();
+
+    test::expect_frame(collector, McapStreamFrame::Kind::open, 0, "output.mcap");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 0, "first");
+
+    collector.disconnect();
+
+    test::write(writer, "second");
+    writer.flush();
+
+    ASSERT_TRUE(collector.accept());
+
+    test::expect_frame(collector, McapStreamFrame::Kind::open, 0, "output.mcap");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 0, "first");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 5, "second");
+}
+
+/**
+ * Test that only the frames in the replay buffer are sent again after a reconnection.
+ *
+ * CASES:
+ * - check that the oldest frames are left out of the replay buffer once it is full.
+ */
+TEST(McapStreamWriterTest, replay_buffer_limit)
+{
+    auto configuration = test::stream_configuration();
+    configuration.replay_buffer_size = 2 * McapStreamFrame::HEADER_SIZE + 8;
+
+    test::Collector collector(test::socket_path());
+    McapStreamWriter writer(configuration);
+
+    ASSERT_TRUE(collector.accept());
+
+    writer.open("output.mcap");
+    test::write(writer, "first");
+    writer.flush();
+    test::write(writer, "second");
+    writer.flush();
+
+    test::expect_frame(collector, McapStreamFrame::Kind::open, 0, "output.mcap");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 0, "first");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 5, "second");
+
+    collector.disconnect();
+
+    test::write(writer, "third");
+    writer.flush();
+
+    ASSERT_TRUE(collector.accept());
+
+    test::expect_frame(collector, McapStreamFrame::Kind::open, 0, "output.mcap");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 5, "second");
+    test::expect_frame(collector, McapStreamFrame::Kind::data, 11, "third");
+}
+
+/**
+ * Test that the stream is congested when the frames waiting to be sent exceed the limit.
+ *
+ * CASES:
+ * - check that the stream is not congested below the limit.
+ * - check that the stream is congested without a collector once the limit is exceeded.
+ */
+TEST(McapStreamWriterTest, congestion)
+{
+    auto configuration = test::stream_configuration();
+    configuration.path = configuration.path + ".none";
+    configuration.max_unsent_size = 1024;
+
+    McapStreamWriter writer(configuration);
+
+    writer.open("output.mcap");
+    writer.flush();
+
+    ASSERT_FALSE(writer.congested());
+
+    test::write(writer, std::string(2048, 'x'));
+    writer.flush();
+
+    ASSERT_TRUE(writer.congested());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/monitoring/metrics/PrometheusExporter.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+class PrometheusExporterTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        RecorderMetrics::get_instance().reset();
+    }
+
+    void TearDown() override
+    {
+        RecorderMetrics::get_instance().reset();
+    }
+
+protected:
+
+    bool contains_(
+            const std::string& str,
+            const std::string& substr)
+    {
+        return str.find(substr) != std::string::npos;
+    }
+};
+
+/**
+ * Test that the counters and gauges are serialized in the Prometheus text format.
+ *
+ * CASES:
+ * - check that every counter is declared as a counter and holds its value.
+ * - check that every gauge is declared as a gauge and holds its value.
+ * - check that the memory usage is exported per subsystem.
+ * - check that the disk full forecast is exported, with an infinite time to full until forecast.
+ * - check that the deduplicated blobs are exported.
+ */
+TEST_F(PrometheusExporterTest, serialize_counters)
+{
+    auto& metrics = RecorderMetrics::get_instance();
+
+    metrics.message_received();
+    metrics.message_received();
+    metrics.message_dropped();
+    metrics.message_written(100);
+    metrics.file_opened();
+    metrics.disk_full();
+    metrics.set_pending_samples(7);
+    metrics.set_memory_usage(MemorySubsystem::payloads, 1024);
+    metrics.set_disk_full_action(DiskFullAction::compression, true);
+    metrics.blob_deduplicated(2048);
+
+    const auto text = PrometheusExporter::serialize(metrics.snapshot());
+
+    ASSERT_TRUE(contains_(text, "# TYPE ddsrecorder_messages_received_total counter\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_messages_received_total 2\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_messages_dropped_total 1\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_messages_written_total 1\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_written_bytes_total 100\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_files_opened_total 1\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_disk_full_total 1\n"));
+    ASSERT_TRUE(contains_(text, "# TYPE ddsrecorder_pending_samples gauge\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_pending_samples 7\n"));
+    ASSERT_TRUE(contains_(text, "# TYPE ddsrecorder_memory_bytes gauge\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_memory_bytes{subsystem=\"payloads\"} 1024\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_memory_bytes{subsystem=\"mcap_chunks\"} 0\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_time_to_full_seconds +Inf\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_disk_full_action{action=\"compression\"} 1\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_disk_full_action{action=\"drop\"} 0\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_blobs_deduplicated_total 1\n"));
+    ASSERT_TRUE(contains_(text, "\nddsrecorder_deduplicated_bytes_total 2048\n"));
+}
+
+/**
+ * Test that the histograms are serialized in the Prometheus text format.
+ *
+ * CASES:
+ * - check that the buckets are cumulative.
+ * - check that the +Inf bucket, the sum and the count match the observations.
+ */
+TEST_F(PrometheusExporterTest, serialize_histogram)
+{
+    auto& metrics = RecorderMetrics::get_instance();
+
+    metrics.message_written(10);
+    metrics.message_written(200);
+    metrics.message_written(100000000);
+
+    const auto text = PrometheusExporter::serialize(metrics.snapshot());
+
+    ASSERT_TRUE(contains_(text, "# TYPE ddsrecorder_message_size_bytes histogram\n"));
+    ASSERT_TRUE(contains_(text, "ddsrecorder_message_size_bytes_bucket{le=\"64\"} 1\n"));
+    ASSERT_TRUE(contains_(text, "ddsrecorder_message_size_bytes_bucket{le=\"256\"} 2\n"));
+    ASSERT_TRUE(contains_(text, "ddsrecorder_message_size_bytes_bucket{le=\"16777216\"} 2\n"));
+    ASSERT_TRUE(contains_(text, "ddsrecorder_message_size_bytes_bucket{le=\"+Inf\"} 3\n"));
+    ASSERT_TRUE(contains_(text, "ddsrecorder_message_size_bytes_sum 100000210\n"));
+    ASSERT_TRUE(contains_(text, "ddsrecorder_message_size_bytes_count 3\n"));
+}
+
+/**
+ * Test that the exporter writes the metrics to a text file.
+ *
+ * CASES:
+ * - check that the file holds the metrics after the first period.
+ * - check that no temporary file is left behind.
+ */
+TEST_F(PrometheusExporterTest, export_to_file)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "ddsrecorder_metrics_test.prom").string();
+    std::filesystem::remove(path);
+
+    RecorderMetrics::get_instance().message_received();
+
+    MetricsExporterConfiguration configuration;
+    configuration.enabled = true;
+    configuration.kind = MetricsExporterKind::file;
+    configuration.path = path;
+    configuration.period = 50;
+
+    {
+        PrometheusExporter exporter(configuration);
+        exporter.start();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(configuration.period * 3));
+    }
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.good());
+
+    std::stringstream text;
+    text << file.rdbuf();
+
+    ASSERT_TRUE(contains_(text.str(), "\nddsrecorder_messages_received_total 1\n"));
+    ASSERT_FALSE(std::filesystem::exists(path + ".tmp~"));
+
+    std::filesystem::remove(path);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
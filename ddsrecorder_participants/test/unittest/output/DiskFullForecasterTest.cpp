@@ -0,0 +1,209 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cmath>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/output/DiskFullForecaster.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::uint64_t RATE = 1000;
+
+DiskFullForecastConfiguration configuration()
+{
+    DiskFullForecastConfiguration configuration;
+    configuration.enabled = true;
+    configuration.rate_window = 10;
+    configuration.warning_threshold = 100;
+    configuration.compression_threshold = 50;
+    configuration.drop_threshold = 10;
+    configuration.drop_topics = {"*"};
+    return configuration;
+}
+
+} // test
+
+/**
+ * Test that the time to full is the remaining budget divided by the write rate.
+ *
+ * CASES:
+ * - check that nothing is forecast before the second update.
+ * - check that the rate starts at the first observed rate.
+ * - check that the time to full is infinite when nothing is written.
+ */
+TEST(DiskFullForecasterTest, forecast_time_to_full)
+{
+    DiskFullForecaster forecaster(test::configuration());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    ASSERT_FALSE(forecaster.update(start, 0, 1000000));
+    ASSERT_TRUE(std::isinf(forecaster.time_to_full()));
+
+    forecaster.update(start + std::chrono::seconds(1), test::RATE, 1000000);
+    ASSERT_DOUBLE_EQ(forecaster.write_rate(), test::RATE);
+    ASSERT_DOUBLE_EQ(forecaster.time_to_full(), 1000);
+
+    // The rate decays towards zero while nothing is written, so the time to full grows
+    forecaster.update(start + std::chrono::seconds(2), test::RATE, 1000000);
+    ASSERT_LT(forecaster.write_rate(), test::RATE);
+    ASSERT_GT(forecaster.time_to_full(), 1000);
+
+    DiskFullForecaster idle_forecaster(test::configuration());
+    idle_forecaster.update(start, 0, 1000000);
+    idle_forecaster.update(start + std::chrono::seconds(1), 0, 1000000);
+    ASSERT_TRUE(std::isinf(idle_forecaster.time_to_full()));
+}
+
+/**
+ * Test that the actions are taken in order as the time to full drops, and released with hysteresis.
+ *
+ * CASES:
+ * - check that each action is activated below its threshold.
+ * - check that an action stays active between its threshold and the hysteresis factor times its threshold.
+ * - check that an action is released above the hysteresis factor times its threshold.
+ */
+TEST(DiskFullForecasterTest, actions_with_hysteresis)
+{
+    DiskFullForecaster forecaster(test::configuration());
+
+    auto now = std::chrono::steady_clock::now();
+    std::uint64_t written = 0;
+
+    const auto update = [&](
+        const std::uint64_t remaining)
+            {
+                now += std::chrono::seconds(1);
+                written += test::RATE;
+                return forecaster.update(now, written, remaining);
+            };
+
+    forecaster.update(now, written, 0);
+
+    // 200 s to full
+    ASSERT_FALSE(update(200 * test::RATE));
+    ASSERT_FALSE(forecaster.active(DiskFullAction::warning));
+
+    // 80 s to full
+    ASSERT_TRUE(update(80 * test::RATE));
+    ASSERT_TRUE(forecaster.active(DiskFullAction::warning));
+    ASSERT_FALSE(forecaster.active(DiskFullAction::compression));
+
+    // 40 s to full
+    ASSERT_TRUE(update(40 * test::RATE));
+    ASSERT_TRUE(forecaster.active(DiskFullAction::compression));
+    ASSERT_FALSE(forecaster.active(DiskFullAction::drop));
+
+    // 5 s to full
+    ASSERT_TRUE(update(5 * test::RATE));
+    ASSERT_TRUE(forecaster.active(DiskFullAction::drop));
+
+    // 12 s to full: above the drop threshold, but within its hysteresis
+    ASSERT_FALSE(update(12 * test::RATE));
+    ASSERT_TRUE(forecaster.active(DiskFullAction::drop));
+
+    // 20 s to full: beyond the hysteresis of the drop threshold
+    ASSERT_TRUE(update(20 * test::RATE));
+    ASSERT_FALSE(forecaster.active(DiskFullAction::drop));
+    ASSERT_TRUE(forecaster.active(DiskFullAction::compression));
+    ASSERT_TRUE(forecaster.active(DiskFullAction::warning));
+
+    // 1000 s to full
+    ASSERT_TRUE(update(1000 * test::RATE));
+    ASSERT_FALSE(forecaster.active(DiskFullAction::compression));
+    ASSERT_FALSE(forecaster.active(DiskFullAction::warning));
+}
+
+/**
+ * Test that the actions whose threshold is zero are never taken.
+ *
+ * CASES:
+ * - check that no action is activated even when the output is about to be full.
+ */
+TEST(DiskFullForecasterTest, disabled_actions)
+{
+    auto configuration = test::configuration();
+    configuration.warning_threshold = 0;
+    configuration.compression_threshold = 0;
+    configuration.drop_threshold = 0;
+
+    DiskFullForecaster forecaster(configuration);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    forecaster.update(start, 0, 0);
+    ASSERT_FALSE(forecaster.update(start + std::chrono::seconds(1), test::RATE, 1));
+
+    for (std::size_t i = 0; i < DISK_FULL_ACTIONS; i++)
+    {
+        ASSERT_FALSE(forecaster.active(static_cast<DiskFullAction>(i)));
+    }
+}
+
+/**
+ * Test that the space left accounts for the files removed when rotating.
+ *
+ * CASES:
+ * - check that the space left is the lowest of the max size left and the disk space when not rotating.
+ * - check that the output cannot be full when rotating with enough disk space for the max size left.
+ * - check that the space left is the disk space when rotating without enough disk space for the max size left.
+ * - check that nothing is forecast for an output that cannot be full, however fast it is written.
+ */
+TEST(DiskFullForecasterTest, file_rotation)
+{
+    constexpr std::uint64_t MAX_SIZE = 1000000;
+
+    // Not rotating
+    ASSERT_EQ(DiskFullForecaster::remaining(400000, MAX_SIZE, 10000000, false), 600000u);
+    ASSERT_EQ(DiskFullForecaster::remaining(400000, MAX_SIZE, 200000, false), 200000u);
+    ASSERT_EQ(DiskFullForecaster::remaining(MAX_SIZE, MAX_SIZE, 10000000, false), 0u);
+
+    // Rotating: the output stops growing at the max size
+    ASSERT_EQ(DiskFullForecaster::remaining(400000, MAX_SIZE, 10000000, true), DiskFullForecaster::NEVER_FULL);
+    ASSERT_EQ(DiskFullForecaster::remaining(MAX_SIZE, MAX_SIZE, 0, true), DiskFullForecaster::NEVER_FULL);
+    ASSERT_EQ(DiskFullForecaster::remaining(400000, MAX_SIZE, 200000, true), 200000u);
+
+    DiskFullForecaster forecaster(test::configuration());
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto remaining = DiskFullForecaster::remaining(MAX_SIZE, MAX_SIZE, test::RATE, true);
+
+    // Writing the whole disk space every second would activate every action if the output could be full
+    for (unsigned int i = 0; i <= 10; i++)
+    {
+        ASSERT_FALSE(forecaster.update(start + std::chrono::seconds(i), i * test::RATE, remaining));
+    }
+
+    ASSERT_DOUBLE_EQ(forecaster.write_rate(), test::RATE);
+    ASSERT_TRUE(std::isinf(forecaster.time_to_full()));
+
+    for (const auto action : {DiskFullAction::warning, DiskFullAction::compression, DiskFullAction::drop})
+    {
+        ASSERT_FALSE(forecaster.active(action));
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,278 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/monitoring/metrics/RecorderMetrics.hpp>
+#include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::uint64_t FILE_SIZE = 1024;
+
+} // test
+
+class FileTrackerTest : public testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        RecorderMetrics::get_instance().reset();
+
+        root_ = std::filesystem::temp_directory_path() / "ddsrecorder_file_tracker_test";
+        std::filesystem::remove_all(root_);
+        std::filesystem::create_directories(output_path_());
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root_);
+        RecorderMetrics::get_instance().reset();
+    }
+
+protected:
+
+    std::string output_path_() const
+    {
+        return (root_ / "output").string();
+    }
+
+    std::string staging_path_() const
+    {
+        return (root_ / "staging").string();
+    }
+
+    OutputSettings settings_(
+            const std::uint64_t staging_max_size) const
+    {
+        OutputSettings settings;
+        settings.filepath = output_path_();
+        settings.filename = "output";
+        settings.extension = ".mcap";
+        settings.prepend_timestamp = false;
+        settings.local_timestamp = false;
+        settings.safety_margin = 0;
+        settings.max_file_size = test::FILE_SIZE;
+        settings.max_size = 10 * test::FILE_SIZE;
+        settings.staging_path = staging_path_();
+        settings.staging_max_size = staging_max_size;
+
+        return settings;
+    }
+
+    // Write a file as the McapWriter would and close it, returning its temporary filename
+    std::string write_file_(
+            FileTracker& tracker) const
+    {
+        tracker.new_file(test::FILE_SIZE);
+
+        const auto filename = tracker.get_current_filename();
+
+        std::ofstream(filename, std::ios::binary) << std::string(test::FILE_SIZE, 'x');
+        tracker.set_current_file_size(test::FILE_SIZE);
+        tracker.close_file();
+
+        return filename;
+    }
+
+    // Write a file referencing a dynamic types sidecar and close it
+    void write_file_(
+            FileTracker& tracker,
+            const std::string& sidecar,
+            const bool created) const
+    {
+        tracker.new_file(test::FILE_SIZE);
+
+        std::ofstream(tracker.get_current_filename(), std::ios::binary) << std::string(test::FILE_SIZE, 'x');
+        tracker.set_current_file_size(test::FILE_SIZE);
+        tracker.set_current_file_sidecar(sidecar, created);
+        tracker.close_file();
+    }
+
+    std::size_t count_files_(
+            const std::string& directory) const
+    {
+        std::size_t count = 0;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            if (entry.is_regular_file())
+            {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    std::filesystem::path root_;
+};
+
+/**
+ * Test that the files are written in the staging directory and moved to the output path once closed.
+ *
+ * CASES:
+ * - check that the files are written in the staging directory.
+ * - check that every file ends up in the output path, with its contents, once the tracker is destroyed.
+ * - check that the staging directory is left empty.
+ * - check that the migrations are reported in the metrics.
+ */
+TEST_F(FileTrackerTest, stage_and_migrate)
+{
+    constexpr std::size_t FILES = 3;
+
+    {
+        FileTracker tracker(settings_(10 * test::FILE_SIZE));
+
+        for (std::size_t i = 0; i < FILES; i++)
+        {
+            const auto filename = write_file_(tracker);
+            ASSERT_EQ(std::filesystem::path(filename).parent_path(), std::filesystem::path(staging_path_()));
+        }
+    }
+
+    ASSERT_EQ(count_files_(output_path_()), FILES);
+    ASSERT_EQ(count_files_(staging_path_()), 0u);
+
+    for (const auto& entry : std::filesystem::directory_iterator(output_path_()))
+    {
+        ASSERT_EQ(entry.path().extension(), ".mcap");
+        ASSERT_EQ(entry.file_size(), test::FILE_SIZE);
+    }
+
+    const auto snapshot = RecorderMetrics::get_instance().snapshot();
+    ASSERT_EQ(snapshot.files_migrated, FILES);
+    ASSERT_EQ(snapshot.migration_failures, 0u);
+    ASSERT_EQ(snapshot.migration_backlog_files, 0u);
+    ASSERT_EQ(snapshot.migration_backlog_bytes, 0u);
+}
+
+/**
+ * Test that the files are written straight to the output path when they do not fit in the staging directory.
+ *
+ * CASES:
+ * - check that the file is written in the output path.
+ * - check that nothing is moved.
+ */
+TEST_F(FileTrackerTest, staging_full)
+{
+    {
+        FileTracker tracker(settings_(test::FILE_SIZE - 1));
+
+        const auto filename = write_file_(tracker);
+        ASSERT_EQ(std::filesystem::path(filename).parent_path(), std::filesystem::path(output_path_()));
+    }
+
+    ASSERT_EQ(count_files_(output_path_()), 1u);
+    ASSERT_EQ(count_files_(staging_path_()), 0u);
+    ASSERT_EQ(RecorderMetrics::get_instance().snapshot().files_migrated, 0u);
+}
+
+/**
+ * Test that the rotation removes the oldest files wherever they are.
+ *
+ * CASES:
+ * - check that only the files within the max size remain once the tracker is destroyed.
+ */
+TEST_F(FileTrackerTest, rotation)
+{
+    auto settings = settings_(10 * test::FILE_SIZE);
+    settings.max_size = 2 * test::FILE_SIZE;
+    settings.file_rotation = true;
+
+    {
+        FileTracker tracker(settings);
+
+        for (std::size_t i = 0; i < 5; i++)
+        {
+            write_file_(tracker);
+        }
+    }
+
+    ASSERT_EQ(count_files_(output_path_()), 2u);
+    ASSERT_EQ(count_files_(staging_path_()), 0u);
+}
+
+/**
+ * Test that the rotation removes the dynamic types sidecars along with the last file referencing them.
+ *
+ * CASES:
+ * - check that a sidecar is kept while a file references it.
+ * - check that a sidecar is removed with the last file referencing it.
+ * - check that a sidecar that existed beforehand is never removed.
+ */
+TEST_F(FileTrackerTest, rotation_removes_sidecars)
+{
+    auto settings = settings_(10 * test::FILE_SIZE);
+    settings.max_size = 2 * test::FILE_SIZE;
+    settings.file_rotation = true;
+
+    const auto sidecar = [this](const std::string& name)
+            {
+                const auto path = output_path_() + "/" + name;
+                std::ofstream(path, std::ios::binary) << name;
+                return path;
+            };
+
+    const auto previous_sidecar = sidecar("dynamic_types_previous.cdr");
+    const auto first_sidecar = sidecar("dynamic_types_first.cdr");
+    const auto second_sidecar = sidecar("dynamic_types_second.cdr");
+
+    {
+        FileTracker tracker(settings);
+
+        // File 0 references a sidecar written by a previous recording
+        write_file_(tracker, previous_sidecar, false);
+
+        // Files 1 and 2 reference the first sidecar
+        write_file_(tracker, first_sidecar, true);
+        write_file_(tracker, first_sidecar, false);
+
+        // File 0 was removed to make room for file 2
+        ASSERT_TRUE(std::filesystem::exists(previous_sidecar));
+        ASSERT_TRUE(std::filesystem::exists(first_sidecar));
+
+        // Files 3 and 4 reference the second sidecar
+        write_file_(tracker, second_sidecar, true);
+
+        // File 1 was removed, but file 2 still references the first sidecar
+        ASSERT_TRUE(std::filesystem::exists(first_sidecar));
+
+        write_file_(tracker, second_sidecar, false);
+
+        // File 2 was removed, and no other file references the first sidecar
+        ASSERT_FALSE(std::filesystem::exists(first_sidecar));
+        ASSERT_TRUE(std::filesystem::exists(second_sidecar));
+    }
+
+    ASSERT_TRUE(std::filesystem::exists(previous_sidecar));
+    ASSERT_TRUE(std::filesystem::exists(second_sidecar));
+    ASSERT_EQ(count_files_(output_path_()), 4u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
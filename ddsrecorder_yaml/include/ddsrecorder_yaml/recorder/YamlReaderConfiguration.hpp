@@ -35,6 +35,17 @@
 #include <ddspipe_yaml/Yaml.hpp>
 #include <ddspipe_yaml/YamlReader.hpp>
 
+#include <ddsrecorder_participants/common/threading/ThreadPlacementConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/efficiency/payload/PayloadPoolConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/IngestionLaneConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClockConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapBlobsConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkingConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/MetricsExporterConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/DiskFullForecastConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
+
 #include <ddsrecorder_yaml/library/library_dll.h>
 #include <ddsrecorder_yaml/recorder/CommandlineArgsRecorder.hpp>
 
@@ -69,18 +80,30 @@ public:
     std::shared_ptr<ddspipe::participants::SimpleParticipantConfiguration> simple_configuration;
     std::shared_ptr<ddspipe::participants::ParticipantConfiguration> recorder_configuration;
 
+    // Domains recorded along with the one of simple_configuration, each with a participant of its own
+    std::vector<ddspipe::core::types::DomainId> extra_domains;
+
     // Output file params
     std::string output_filepath = ".";
     std::string output_filename = "output";
     std::string output_timestamp_format = "%Y-%m-%d_%H-%M-%S_%Z";
     bool output_local_timestamp = true;
     uint64_t safety_margin = 0;
+    participants::OutputSinkKind output_sink = participants::OutputSinkKind::file;
+    participants::McapStreamConfiguration output_stream{};
 
     // Output resource limits
     bool output_resource_limits_file_rotation = false;
     std::uint64_t output_resource_limits_max_size = 0;
     std::uint64_t output_resource_limits_max_file_size = 0;
 
+    // Output staging
+    std::string output_staging_path = "";
+    std::uint64_t output_staging_max_size = 0;
+
+    // Output disk full forecast
+    participants::DiskFullForecastConfiguration output_disk_full_forecast{};
+
     // Recording params
     unsigned int buffer_size = 100;
     unsigned int event_window = 20;
@@ -89,6 +112,13 @@ public:
     mcap::McapWriterOptions mcap_writer_options{"ros2"};
     bool record_types = true;
     bool ros2_types = false;
+    bool record_statistics = false;
+    bool lazy_channels = false;
+    bool types_sidecar = false;
+    bool keyframes = false;
+    participants::LogTimeClockConfiguration log_time_clock_configuration{};
+    participants::McapChunkingConfiguration chunking_configuration{};
+    participants::McapBlobsConfiguration blobs_configuration{};
 
     // Remote controller configuration
     bool enable_remote_controller = true;
@@ -101,8 +131,13 @@ public:
     unsigned int n_threads = 12;
     int max_pending_samples = 5000;  // -1 <-> no limit || 0 <-> no pending samples
     unsigned int cleanup_period;
+    std::uint64_t memory_budget = 0;  // 0 <-> no limit
     ddspipe::core::types::TopicQoS topic_qos{};
     ddspipe::core::MonitorConfiguration monitor_configuration{};
+    participants::MetricsExporterConfiguration metrics_configuration{};
+    participants::PayloadPoolConfiguration payload_pool_configuration{};
+    participants::ThreadPlacementConfiguration thread_placement_configuration{};
+    std::vector<participants::IngestionLaneConfiguration> ingestion_lanes{};
 
 protected:
 
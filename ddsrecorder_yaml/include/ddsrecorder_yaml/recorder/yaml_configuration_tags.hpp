@@ -29,6 +29,7 @@ namespace yaml {
 // DDS related tags //
 //////////////////////
 constexpr const char* RECORDER_DDS_TAG("dds");
+constexpr const char* RECORDER_DDS_DOMAINS_TAG("domains");
 
 ///////////////////////////
 // Recorder related tags //
@@ -42,18 +43,75 @@ constexpr const char* RECORDER_OUTPUT_FILE_NAME_TAG("filename");
 constexpr const char* RECORDER_OUTPUT_TIMESTAMP_FORMAT_TAG("timestamp-format");
 constexpr const char* RECORDER_OUTPUT_LOCAL_TIMESTAMP_TAG("local-timestamp");
 constexpr const char* RECORDER_OUTPUT_SAFETY_MARGIN_TAG("safety-margin");
+constexpr const char* RECORDER_OUTPUT_SINK_TAG("sink");
+constexpr const char* RECORDER_OUTPUT_SINK_FILE_TAG("file");
+constexpr const char* RECORDER_OUTPUT_SINK_MEMORY_TAG("memory");
+constexpr const char* RECORDER_OUTPUT_SINK_DISCARD_TAG("discard");
+constexpr const char* RECORDER_OUTPUT_SINK_STREAM_TAG("stream");
+constexpr const char* RECORDER_OUTPUT_STREAM_TAG("stream");
+constexpr const char* RECORDER_OUTPUT_STREAM_TYPE_TAG("type");
+constexpr const char* RECORDER_OUTPUT_STREAM_TYPE_TCP_TAG("tcp");
+constexpr const char* RECORDER_OUTPUT_STREAM_TYPE_UNIX_TAG("unix");
+constexpr const char* RECORDER_OUTPUT_STREAM_TYPE_PIPE_TAG("pipe");
+constexpr const char* RECORDER_OUTPUT_STREAM_ADDRESS_TAG("address");
+constexpr const char* RECORDER_OUTPUT_STREAM_PORT_TAG("port");
+constexpr const char* RECORDER_OUTPUT_STREAM_PATH_TAG("path");
+constexpr const char* RECORDER_OUTPUT_STREAM_RECONNECTION_PERIOD_TAG("reconnection-period");
+constexpr const char* RECORDER_OUTPUT_STREAM_REPLAY_BUFFER_SIZE_TAG("replay-buffer-size");
+constexpr const char* RECORDER_OUTPUT_STREAM_MAX_UNSENT_SIZE_TAG("max-unsent-size");
 constexpr const char* RECORDER_OUTPUT_RESOURCE_LIMITS_TAG("resource-limits");
 constexpr const char* RECORDER_OUTPUT_RESOURCE_LIMITS_FILE_ROTATION_TAG("file-rotation");
 constexpr const char* RECORDER_OUTPUT_RESOURCE_LIMITS_MAX_SIZE_TAG("max-size");
 constexpr const char* RECORDER_OUTPUT_RESOURCE_LIMITS_MAX_FILE_SIZE_TAG("max-file-size");
+constexpr const char* RECORDER_OUTPUT_STAGING_TAG("staging");
+constexpr const char* RECORDER_OUTPUT_STAGING_PATH_TAG("path");
+constexpr const char* RECORDER_OUTPUT_STAGING_MAX_SIZE_TAG("max-size");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_TAG("disk-full-forecast");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_ENABLE_TAG("enable");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_PERIOD_TAG("period");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_RATE_WINDOW_TAG("rate-window");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_WARNING_THRESHOLD_TAG("warning-threshold");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_COMPRESSION_THRESHOLD_TAG("compression-threshold");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_COMPRESSION_TAG("compression");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_THRESHOLD_TAG("drop-threshold");
+constexpr const char* RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_TOPICS_TAG("drop-topics");
 
 // Advanced recorder configuration options
 constexpr const char* RECORDER_BUFFER_SIZE_TAG("buffer-size");
 constexpr const char* RECORDER_EVENT_WINDOW_TAG("event-window");
 constexpr const char* RECORDER_LOG_PUBLISH_TIME_TAG("log-publish-time");
+constexpr const char* RECORDER_LOG_TIME_CLOCK_TAG("log-time-clock");
 constexpr const char* RECORDER_ONLY_WITH_TYPE_TAG("only-with-type");
 constexpr const char* RECORDER_RECORD_TYPES_TAG("record-types");
 constexpr const char* RECORDER_ROS2_TYPES_TAG("ros2-types");
+constexpr const char* RECORDER_RECORD_STATISTICS_TAG("record-statistics");
+constexpr const char* RECORDER_LAZY_CHANNELS_TAG("lazy-channels");
+constexpr const char* RECORDER_TYPES_SIDECAR_TAG("types-sidecar");
+constexpr const char* RECORDER_KEYFRAMES_TAG("keyframes");
+constexpr const char* RECORDER_CHUNKING_TAG("chunking");
+constexpr const char* RECORDER_BLOBS_TAG("blobs");
+
+// Log time clock settings
+constexpr const char* RECORDER_LOG_TIME_CLOCK_TYPE_TAG("type");
+constexpr const char* RECORDER_LOG_TIME_CLOCK_TYPE_SYSTEM_TAG("system");
+constexpr const char* RECORDER_LOG_TIME_CLOCK_TYPE_COARSE_TAG("coarse");
+constexpr const char* RECORDER_LOG_TIME_CLOCK_PRECISION_TAG("precision");
+
+// Chunking settings
+constexpr const char* RECORDER_CHUNKING_TYPE_TAG("type");
+constexpr const char* RECORDER_CHUNKING_TYPE_FIXED_TAG("fixed");
+constexpr const char* RECORDER_CHUNKING_TYPE_ADAPTIVE_TAG("adaptive");
+constexpr const char* RECORDER_CHUNKING_SIZE_TAG("size");
+constexpr const char* RECORDER_CHUNKING_TARGET_DURATION_TAG("target-duration");
+constexpr const char* RECORDER_CHUNKING_MIN_SIZE_TAG("min-size");
+constexpr const char* RECORDER_CHUNKING_MAX_SIZE_TAG("max-size");
+constexpr const char* RECORDER_CHUNKING_RATE_CHANGE_FACTOR_TAG("rate-change-factor");
+
+// Blobs settings
+constexpr const char* RECORDER_BLOBS_ENABLE_TAG("enable");
+constexpr const char* RECORDER_BLOBS_THRESHOLD_TAG("threshold");
+constexpr const char* RECORDER_BLOBS_COMPRESSION_TAG("compression");
+constexpr const char* RECORDER_BLOBS_DEDUPLICATE_TAG("deduplicate");
 
 // Compression settings
 constexpr const char* RECORDER_COMPRESSION_SETTINGS_TAG("compression");
@@ -83,6 +141,41 @@ constexpr const char* RECORDER_REMOTE_CONTROLLER_STATUS_TOPIC_NAME_TAG("status-t
 ////////////////
 constexpr const char* RECORDER_SPECS_MAX_PENDING_SAMPLES_TAG("max-pending-samples");
 constexpr const char* RECORDER_SPECS_CLEANUP_PERIOD_TAG("cleanup-period");
+constexpr const char* RECORDER_SPECS_MEMORY_BUDGET_TAG("memory-budget");
+
+// Metrics exporter tags
+constexpr const char* RECORDER_SPECS_METRICS_TAG("metrics");
+constexpr const char* RECORDER_SPECS_METRICS_ENABLE_TAG("enable");
+constexpr const char* RECORDER_SPECS_METRICS_TYPE_TAG("type");
+constexpr const char* RECORDER_SPECS_METRICS_TYPE_HTTP_TAG("http");
+constexpr const char* RECORDER_SPECS_METRICS_TYPE_UNIX_TAG("unix");
+constexpr const char* RECORDER_SPECS_METRICS_TYPE_FILE_TAG("file");
+constexpr const char* RECORDER_SPECS_METRICS_ADDRESS_TAG("address");
+constexpr const char* RECORDER_SPECS_METRICS_PORT_TAG("port");
+constexpr const char* RECORDER_SPECS_METRICS_PATH_TAG("path");
+constexpr const char* RECORDER_SPECS_METRICS_PERIOD_TAG("period");
+
+// Payload pool tags
+constexpr const char* RECORDER_SPECS_PAYLOAD_POOL_TAG("payload-pool");
+constexpr const char* RECORDER_SPECS_PAYLOAD_POOL_TYPE_TAG("type");
+constexpr const char* RECORDER_SPECS_PAYLOAD_POOL_TYPE_FAST_TAG("fast");
+constexpr const char* RECORDER_SPECS_PAYLOAD_POOL_TYPE_SLAB_TAG("slab");
+constexpr const char* RECORDER_SPECS_PAYLOAD_POOL_HUGE_PAGES_TAG("huge-pages");
+constexpr const char* RECORDER_SPECS_PAYLOAD_POOL_THREAD_CACHE_SIZE_TAG("thread-cache-size");
+
+// Thread placement tags
+constexpr const char* RECORDER_SPECS_THREAD_PLACEMENT_TAG("thread-placement");
+constexpr const char* RECORDER_SPECS_THREAD_PLACEMENT_DDS_TAG("dds");
+constexpr const char* RECORDER_SPECS_THREAD_PLACEMENT_WORKERS_TAG("workers");
+constexpr const char* RECORDER_SPECS_THREAD_PLACEMENT_EVENT_TAG("event");
+constexpr const char* RECORDER_SPECS_THREAD_PLACEMENT_IO_TAG("io");
+constexpr const char* RECORDER_SPECS_THREAD_PLACEMENT_NUMA_LOCAL_TAG("numa-local");
+
+// Ingestion lanes tags
+constexpr const char* RECORDER_SPECS_INGESTION_LANES_TAG("ingestion-lanes");
+constexpr const char* RECORDER_SPECS_INGESTION_LANES_NAME_TAG("name");
+constexpr const char* RECORDER_SPECS_INGESTION_LANES_TOPICS_TAG("topics");
+constexpr const char* RECORDER_SPECS_INGESTION_LANES_QUEUE_SIZE_TAG("queue-size");
 
 } /* namespace yaml */
 } /* namespace ddsrecorder */
@@ -23,6 +23,7 @@
 #include <cpp_utils/types/Fuzzy.hpp>
 
 #include <ddspipe_core/configuration/DdsPipeConfiguration.hpp>
+#include <ddspipe_core/types/dds/DomainId.hpp>
 #include <ddspipe_core/types/dds/TopicQoS.hpp>
 #include <ddspipe_core/types/topic/dds/DistributedTopic.hpp>
 #include <ddspipe_core/types/topic/filter/IFilterTopic.hpp>
@@ -32,6 +33,7 @@
 #include <ddspipe_yaml/Yaml.hpp>
 #include <ddspipe_yaml/YamlReader.hpp>
 
+#include <ddsrecorder_participants/common/threading/ThreadPlacementConfiguration.hpp>
 #include <ddsrecorder_participants/replayer/McapReaderParticipantConfiguration.hpp>
 #include <ddsrecorder_yaml/library/library_dll.h>
 #include <ddsrecorder_yaml/replayer/CommandlineArgsReplayer.hpp>
@@ -70,11 +72,13 @@ public:
     utils::Fuzzy<utils::Timestamp> end_time{};
     float rate{1};
     utils::Fuzzy<utils::Timestamp> start_replay_time{};
+    utils::Fuzzy<ddspipe::core::types::DomainId> recorded_domain{};
     bool replay_types = true;
 
     // Specs
     unsigned int n_threads = 12;
     ddspipe::core::types::TopicQoS topic_qos{};
+    ddsrecorder::participants::ThreadPlacementConfiguration thread_placement_configuration{};
 
 protected:
 
@@ -40,6 +40,12 @@ constexpr const char* REPLAYER_REPLAY_END_TAG("end-time");
 constexpr const char* REPLAYER_REPLAY_RATE_TAG("rate");
 constexpr const char* REPLAYER_REPLAY_START_TIME_TAG("start-replay-time");
 constexpr const char* REPLAYER_REPLAY_TYPES_TAG("replay-types");
+constexpr const char* REPLAYER_REPLAY_RECORDED_DOMAIN_TAG("recorded-domain");
+
+////////////////////////
+// Specs related tags //
+////////////////////////
+constexpr const char* REPLAYER_SPECS_THREAD_PLACEMENT_TAG("thread-placement");
 
 } /* namespace yaml */
 } /* namespace ddsrecorder */
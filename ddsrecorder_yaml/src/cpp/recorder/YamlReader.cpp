@@ -12,10 +12,31 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <mcap/mcap.hpp>
 
+#include <cpp_utils/exception/ConfigurationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/utils.hpp>
+
 #include <ddspipe_yaml/YamlReader.hpp>
 
+#include <ddsrecorder_participants/recorder/efficiency/payload/PayloadPoolConfiguration.hpp>
+#include <ddsrecorder_participants/common/mcap/McapBlob.hpp>
+#include <ddsrecorder_participants/common/threading/ThreadPlacementConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/IngestionLaneConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/LogTimeClockConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapBlobsConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapChunkingConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/mcap/McapStreamConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/metrics/MetricsExporterConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/DiskFullForecastConfiguration.hpp>
+
 #include <ddsrecorder_yaml/recorder/yaml_configuration_tags.hpp>
 
 namespace eprosima {
@@ -24,6 +45,49 @@ namespace yaml {
 
 using namespace eprosima::ddsrecorder::yaml;
 
+namespace {
+
+//! Parse a list of CPUs in the Linux cpuset format (e.g. "0-3,8")
+std::set<unsigned int> get_cpu_list(
+        const Yaml& yml,
+        const TagType& tag,
+        const YamlReaderVersion version)
+{
+    const auto cpu_list = YamlReader::get<std::string>(yml, tag, version);
+
+    // A CPU or a range of CPUs (e.g. 8 or 0-3)
+    static const std::regex range_regex("\\s*(\\d{1,4})\\s*(?:-\\s*(\\d{1,4})\\s*)?");
+
+    std::set<unsigned int> cpus;
+    std::stringstream ranges(cpu_list);
+    std::string range;
+
+    while (std::getline(ranges, range, ','))
+    {
+        std::smatch match;
+
+        const bool valid = std::regex_match(range, match, range_regex);
+        const auto first = valid ? std::stoul(match[1].str()) : 0;
+        const auto last = valid && match[2].matched ? std::stoul(match[2].str()) : first;
+
+        if (!valid || last < first)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << tag << "> : <" << cpu_list <<
+                          "> is not a list of CPUs (e.g. 0-3,8).");
+        }
+
+        for (auto cpu = first; cpu <= last; cpu++)
+        {
+            cpus.insert(static_cast<unsigned int>(cpu));
+        }
+    }
+
+    return cpus;
+}
+
+} /* namespace */
+
 template <>
 mcap::McapWriterOptions
 YamlReader::get<mcap::McapWriterOptions>(
@@ -68,6 +132,508 @@ YamlReader::get<mcap::McapWriterOptions>(
     return mcap_writer_options;
 }
 
+template <>
+ddsrecorder::participants::MetricsExporterConfiguration
+YamlReader::get<ddsrecorder::participants::MetricsExporterConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    using ddsrecorder::participants::MetricsExporterKind;
+
+    ddsrecorder::participants::MetricsExporterConfiguration metrics_configuration;
+
+    // Parse optional enable
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_ENABLE_TAG))
+    {
+        metrics_configuration.enabled = YamlReader::get<bool>(yml, RECORDER_SPECS_METRICS_ENABLE_TAG, version);
+    }
+
+    // Parse optional type
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_TYPE_TAG))
+    {
+        auto type_yml = YamlReader::get_value_in_tag(yml, RECORDER_SPECS_METRICS_TYPE_TAG);
+        metrics_configuration.kind = YamlReader::get_enumeration<MetricsExporterKind>(type_yml,
+                    {
+                        {RECORDER_SPECS_METRICS_TYPE_HTTP_TAG, MetricsExporterKind::http},
+                        {RECORDER_SPECS_METRICS_TYPE_UNIX_TAG, MetricsExporterKind::unix_socket},
+                        {RECORDER_SPECS_METRICS_TYPE_FILE_TAG, MetricsExporterKind::file},
+                    });
+    }
+
+    // Parse optional address
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_ADDRESS_TAG))
+    {
+        metrics_configuration.address = YamlReader::get<std::string>(yml, RECORDER_SPECS_METRICS_ADDRESS_TAG,
+                        version);
+    }
+
+    // Parse optional port
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_PORT_TAG))
+    {
+        const auto port = YamlReader::get_positive_int(yml, RECORDER_SPECS_METRICS_PORT_TAG);
+
+        if (port > 65535)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_SPECS_METRICS_PORT_TAG <<
+                          "> : value cannot be greater than 65535.");
+        }
+
+        metrics_configuration.port = static_cast<std::uint16_t>(port);
+    }
+
+    // Parse optional path
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_PATH_TAG))
+    {
+        metrics_configuration.path = YamlReader::get<std::string>(yml, RECORDER_SPECS_METRICS_PATH_TAG, version);
+    }
+
+    // Parse optional period
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_PERIOD_TAG))
+    {
+        metrics_configuration.period = YamlReader::get_positive_int(yml, RECORDER_SPECS_METRICS_PERIOD_TAG);
+    }
+
+    if (metrics_configuration.kind != MetricsExporterKind::http && metrics_configuration.path.empty())
+    {
+        throw eprosima::utils::ConfigurationException(
+                  utils::Formatter() << "Error reading tag <" << RECORDER_SPECS_METRICS_TAG << "> : a <" <<
+                      RECORDER_SPECS_METRICS_PATH_TAG << "> is required when exporting to a Unix socket or a file.");
+    }
+
+    return metrics_configuration;
+}
+
+template <>
+ddsrecorder::participants::DiskFullForecastConfiguration
+YamlReader::get<ddsrecorder::participants::DiskFullForecastConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    ddsrecorder::participants::DiskFullForecastConfiguration forecast_configuration;
+
+    // Parse optional enable
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_ENABLE_TAG))
+    {
+        forecast_configuration.enabled = YamlReader::get<bool>(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_ENABLE_TAG,
+                        version);
+    }
+
+    // Parse optional period
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_PERIOD_TAG))
+    {
+        forecast_configuration.period = YamlReader::get_positive_int(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_PERIOD_TAG);
+    }
+
+    // Parse optional rate window
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_RATE_WINDOW_TAG))
+    {
+        forecast_configuration.rate_window = YamlReader::get_positive_int(yml,
+                        RECORDER_OUTPUT_DISK_FULL_FORECAST_RATE_WINDOW_TAG);
+    }
+
+    // Parse optional warning threshold
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_WARNING_THRESHOLD_TAG))
+    {
+        forecast_configuration.warning_threshold = YamlReader::get_nonnegative_int(yml,
+                        RECORDER_OUTPUT_DISK_FULL_FORECAST_WARNING_THRESHOLD_TAG);
+    }
+
+    // Parse optional compression threshold
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_COMPRESSION_THRESHOLD_TAG))
+    {
+        forecast_configuration.compression_threshold = YamlReader::get_nonnegative_int(yml,
+                        RECORDER_OUTPUT_DISK_FULL_FORECAST_COMPRESSION_THRESHOLD_TAG);
+    }
+
+    // Parse optional compression (same algorithm and level tags as the compression settings)
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_COMPRESSION_TAG))
+    {
+        const auto compression_yml = YamlReader::get_value_in_tag(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_COMPRESSION_TAG);
+        const auto compression_options = YamlReader::get<mcap::McapWriterOptions>(compression_yml, version);
+
+        // Keep the defaults of the forecast (rather than those of the MCAP library) for the missing tags
+        if (YamlReader::is_tag_present(compression_yml, RECORDER_COMPRESSION_SETTINGS_ALGORITHM_TAG))
+        {
+            forecast_configuration.compression = compression_options.compression;
+        }
+
+        if (YamlReader::is_tag_present(compression_yml, RECORDER_COMPRESSION_SETTINGS_LEVEL_TAG))
+        {
+            forecast_configuration.compression_level = compression_options.compressionLevel;
+        }
+    }
+
+    // Parse optional drop threshold
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_THRESHOLD_TAG))
+    {
+        forecast_configuration.drop_threshold = YamlReader::get_nonnegative_int(yml,
+                        RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_THRESHOLD_TAG);
+    }
+
+    // Parse optional drop topics
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_TOPICS_TAG))
+    {
+        const auto& drop_topics = YamlReader::get_list<std::string>(yml,
+                        RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_TOPICS_TAG, version);
+        forecast_configuration.drop_topics = std::vector<std::string>(drop_topics.begin(), drop_topics.end());
+    }
+
+    if (forecast_configuration.drop_threshold > 0 && forecast_configuration.drop_topics.empty())
+    {
+        throw eprosima::utils::ConfigurationException(
+                  utils::Formatter() << "Error reading tag <" << RECORDER_OUTPUT_DISK_FULL_FORECAST_TAG << "> : a <" <<
+                      RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_TOPICS_TAG << "> list is required when a <" <<
+                      RECORDER_OUTPUT_DISK_FULL_FORECAST_DROP_THRESHOLD_TAG << "> is set.");
+    }
+
+    return forecast_configuration;
+}
+
+template <>
+ddsrecorder::participants::PayloadPoolConfiguration
+YamlReader::get<ddsrecorder::participants::PayloadPoolConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    using ddsrecorder::participants::PayloadPoolKind;
+
+    ddsrecorder::participants::PayloadPoolConfiguration payload_pool_configuration;
+
+    // Parse optional type
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_PAYLOAD_POOL_TYPE_TAG))
+    {
+        auto type_yml = YamlReader::get_value_in_tag(yml, RECORDER_SPECS_PAYLOAD_POOL_TYPE_TAG);
+        payload_pool_configuration.kind = YamlReader::get_enumeration<PayloadPoolKind>(type_yml,
+                    {
+                        {RECORDER_SPECS_PAYLOAD_POOL_TYPE_FAST_TAG, PayloadPoolKind::fast},
+                        {RECORDER_SPECS_PAYLOAD_POOL_TYPE_SLAB_TAG, PayloadPoolKind::slab},
+                    });
+    }
+
+    // Parse optional huge pages
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_PAYLOAD_POOL_HUGE_PAGES_TAG))
+    {
+        payload_pool_configuration.huge_pages = YamlReader::get<bool>(yml, RECORDER_SPECS_PAYLOAD_POOL_HUGE_PAGES_TAG,
+                        version);
+    }
+
+    // Parse optional thread cache size
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_PAYLOAD_POOL_THREAD_CACHE_SIZE_TAG))
+    {
+        const auto& thread_cache_size_str = YamlReader::get<std::string>(yml,
+                        RECORDER_SPECS_PAYLOAD_POOL_THREAD_CACHE_SIZE_TAG, version);
+        payload_pool_configuration.thread_cache_size = eprosima::utils::to_bytes(thread_cache_size_str);
+    }
+
+    return payload_pool_configuration;
+}
+
+template <>
+ddsrecorder::participants::LogTimeClockConfiguration
+YamlReader::get<ddsrecorder::participants::LogTimeClockConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion /* version */)
+{
+    using ddsrecorder::participants::LogTimeClockKind;
+
+    ddsrecorder::participants::LogTimeClockConfiguration log_time_clock_configuration;
+
+    // Parse optional type
+    if (YamlReader::is_tag_present(yml, RECORDER_LOG_TIME_CLOCK_TYPE_TAG))
+    {
+        auto type_yml = YamlReader::get_value_in_tag(yml, RECORDER_LOG_TIME_CLOCK_TYPE_TAG);
+        log_time_clock_configuration.kind = YamlReader::get_enumeration<LogTimeClockKind>(type_yml,
+                    {
+                        {RECORDER_LOG_TIME_CLOCK_TYPE_SYSTEM_TAG, LogTimeClockKind::system},
+                        {RECORDER_LOG_TIME_CLOCK_TYPE_COARSE_TAG, LogTimeClockKind::coarse},
+                    });
+    }
+
+    // Parse optional precision
+    if (YamlReader::is_tag_present(yml, RECORDER_LOG_TIME_CLOCK_PRECISION_TAG))
+    {
+        log_time_clock_configuration.precision = YamlReader::get_positive_int(yml,
+                        RECORDER_LOG_TIME_CLOCK_PRECISION_TAG);
+    }
+
+    return log_time_clock_configuration;
+}
+
+template <>
+ddsrecorder::participants::McapChunkingConfiguration
+YamlReader::get<ddsrecorder::participants::McapChunkingConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    using ddsrecorder::participants::McapChunkingKind;
+
+    ddsrecorder::participants::McapChunkingConfiguration chunking_configuration;
+
+    // Parse optional type
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_TYPE_TAG))
+    {
+        auto type_yml = YamlReader::get_value_in_tag(yml, RECORDER_CHUNKING_TYPE_TAG);
+        chunking_configuration.kind = YamlReader::get_enumeration<McapChunkingKind>(type_yml,
+                    {
+                        {RECORDER_CHUNKING_TYPE_FIXED_TAG, McapChunkingKind::fixed},
+                        {RECORDER_CHUNKING_TYPE_ADAPTIVE_TAG, McapChunkingKind::adaptive},
+                    });
+    }
+
+    // Parse optional size
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_SIZE_TAG))
+    {
+        const auto& size_str = YamlReader::get<std::string>(yml, RECORDER_CHUNKING_SIZE_TAG, version);
+        chunking_configuration.size = eprosima::utils::to_bytes(size_str);
+    }
+
+    // Parse optional target duration
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_TARGET_DURATION_TAG))
+    {
+        chunking_configuration.target_duration = YamlReader::get_positive_int(yml,
+                        RECORDER_CHUNKING_TARGET_DURATION_TAG);
+    }
+
+    // Parse optional min size
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_MIN_SIZE_TAG))
+    {
+        const auto& min_size_str = YamlReader::get<std::string>(yml, RECORDER_CHUNKING_MIN_SIZE_TAG, version);
+        chunking_configuration.min_size = eprosima::utils::to_bytes(min_size_str);
+    }
+
+    // Parse optional max size
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_MAX_SIZE_TAG))
+    {
+        const auto& max_size_str = YamlReader::get<std::string>(yml, RECORDER_CHUNKING_MAX_SIZE_TAG, version);
+        chunking_configuration.max_size = eprosima::utils::to_bytes(max_size_str);
+    }
+
+    // Parse optional rate change factor
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_RATE_CHANGE_FACTOR_TAG))
+    {
+        chunking_configuration.rate_change_factor = YamlReader::get_positive_float(yml,
+                        RECORDER_CHUNKING_RATE_CHANGE_FACTOR_TAG);
+    }
+
+    if (chunking_configuration.min_size > chunking_configuration.max_size)
+    {
+        throw eprosima::utils::ConfigurationException(
+                  utils::Formatter() << "The chunking " << RECORDER_CHUNKING_MIN_SIZE_TAG << " (" <<
+                      chunking_configuration.min_size << ") cannot be greater than its " <<
+                      RECORDER_CHUNKING_MAX_SIZE_TAG << " (" << chunking_configuration.max_size << ").");
+    }
+
+    return chunking_configuration;
+}
+
+template <>
+ddsrecorder::participants::McapBlobsConfiguration
+YamlReader::get<ddsrecorder::participants::McapBlobsConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    ddsrecorder::participants::McapBlobsConfiguration blobs_configuration;
+
+    // Parse optional enable
+    if (YamlReader::is_tag_present(yml, RECORDER_BLOBS_ENABLE_TAG))
+    {
+        blobs_configuration.enabled = YamlReader::get<bool>(yml, RECORDER_BLOBS_ENABLE_TAG, version);
+    }
+
+    // Parse optional threshold
+    if (YamlReader::is_tag_present(yml, RECORDER_BLOBS_THRESHOLD_TAG))
+    {
+        const auto& threshold_str = YamlReader::get<std::string>(yml, RECORDER_BLOBS_THRESHOLD_TAG, version);
+        blobs_configuration.threshold = eprosima::utils::to_bytes(threshold_str);
+
+        if (blobs_configuration.threshold <= ddsrecorder::participants::McapBlob::REFERENCE_SIZE)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_BLOBS_THRESHOLD_TAG <<
+                          "> : value must be greater than " << ddsrecorder::participants::McapBlob::REFERENCE_SIZE <<
+                          " bytes.");
+        }
+    }
+
+    // Parse optional compression
+    if (YamlReader::is_tag_present(yml, RECORDER_BLOBS_COMPRESSION_TAG))
+    {
+        auto compression_yml = YamlReader::get_value_in_tag(yml, RECORDER_BLOBS_COMPRESSION_TAG);
+        blobs_configuration.compression = YamlReader::get_enumeration<mcap::Compression>(compression_yml,
+                    {
+                        {RECORDER_COMPRESSION_SETTINGS_ALGORITHM_NONE_TAG, mcap::Compression::None},
+                        {RECORDER_COMPRESSION_SETTINGS_ALGORITHM_LZ4_TAG, mcap::Compression::Lz4},
+                        {RECORDER_COMPRESSION_SETTINGS_ALGORITHM_ZSTD_TAG, mcap::Compression::Zstd},
+                    });
+    }
+
+    // Parse optional deduplication
+    if (YamlReader::is_tag_present(yml, RECORDER_BLOBS_DEDUPLICATE_TAG))
+    {
+        blobs_configuration.deduplicate = YamlReader::get<bool>(yml, RECORDER_BLOBS_DEDUPLICATE_TAG, version);
+    }
+
+    return blobs_configuration;
+}
+
+template <>
+ddsrecorder::participants::McapStreamConfiguration
+YamlReader::get<ddsrecorder::participants::McapStreamConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    using ddsrecorder::participants::McapStreamKind;
+
+    ddsrecorder::participants::McapStreamConfiguration stream_configuration;
+
+    // Parse optional type
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_TYPE_TAG))
+    {
+        auto type_yml = YamlReader::get_value_in_tag(yml, RECORDER_OUTPUT_STREAM_TYPE_TAG);
+        stream_configuration.kind = YamlReader::get_enumeration<McapStreamKind>(type_yml,
+                    {
+                        {RECORDER_OUTPUT_STREAM_TYPE_TCP_TAG, McapStreamKind::tcp},
+                        {RECORDER_OUTPUT_STREAM_TYPE_UNIX_TAG, McapStreamKind::unix_socket},
+                        {RECORDER_OUTPUT_STREAM_TYPE_PIPE_TAG, McapStreamKind::pipe},
+                    });
+    }
+
+    // Parse optional address
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_ADDRESS_TAG))
+    {
+        stream_configuration.address = YamlReader::get<std::string>(yml, RECORDER_OUTPUT_STREAM_ADDRESS_TAG,
+                        version);
+    }
+
+    // Parse optional port
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_PORT_TAG))
+    {
+        const auto port = YamlReader::get_positive_int(yml, RECORDER_OUTPUT_STREAM_PORT_TAG);
+
+        if (port > 65535)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_OUTPUT_STREAM_PORT_TAG <<
+                          "> : value cannot be greater than 65535.");
+        }
+
+        stream_configuration.port = static_cast<std::uint16_t>(port);
+    }
+
+    // Parse optional path
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_PATH_TAG))
+    {
+        stream_configuration.path = YamlReader::get<std::string>(yml, RECORDER_OUTPUT_STREAM_PATH_TAG, version);
+    }
+
+    // Parse optional reconnection period
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_RECONNECTION_PERIOD_TAG))
+    {
+        stream_configuration.reconnection_period = YamlReader::get_positive_int(yml,
+                        RECORDER_OUTPUT_STREAM_RECONNECTION_PERIOD_TAG);
+    }
+
+    // Parse optional replay buffer size
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_REPLAY_BUFFER_SIZE_TAG))
+    {
+        const auto& replay_buffer_size_str = YamlReader::get<std::string>(yml,
+                        RECORDER_OUTPUT_STREAM_REPLAY_BUFFER_SIZE_TAG, version);
+        stream_configuration.replay_buffer_size = eprosima::utils::to_bytes(replay_buffer_size_str);
+    }
+
+    // Parse optional max unsent size
+    if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_STREAM_MAX_UNSENT_SIZE_TAG))
+    {
+        const auto& max_unsent_size_str = YamlReader::get<std::string>(yml,
+                        RECORDER_OUTPUT_STREAM_MAX_UNSENT_SIZE_TAG, version);
+        stream_configuration.max_unsent_size = eprosima::utils::to_bytes(max_unsent_size_str);
+    }
+
+    if (stream_configuration.kind == McapStreamKind::unix_socket && stream_configuration.path.empty())
+    {
+        throw eprosima::utils::ConfigurationException(
+                  utils::Formatter() << "Error reading tag <" << RECORDER_OUTPUT_STREAM_TAG << "> : a <" <<
+                      RECORDER_OUTPUT_STREAM_PATH_TAG << "> is required when streaming to a Unix socket.");
+    }
+
+    return stream_configuration;
+}
+
+template <>
+ddsrecorder::participants::ThreadPlacementConfiguration
+YamlReader::get<ddsrecorder::participants::ThreadPlacementConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    ddsrecorder::participants::ThreadPlacementConfiguration placement_configuration;
+
+    // Parse optional DDS threads CPUs
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_THREAD_PLACEMENT_DDS_TAG))
+    {
+        placement_configuration.dds_cpus = get_cpu_list(yml, RECORDER_SPECS_THREAD_PLACEMENT_DDS_TAG, version);
+    }
+
+    // Parse optional workers CPUs
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_THREAD_PLACEMENT_WORKERS_TAG))
+    {
+        placement_configuration.workers_cpus = get_cpu_list(yml, RECORDER_SPECS_THREAD_PLACEMENT_WORKERS_TAG, version);
+    }
+
+    // Parse optional event threads CPUs
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_THREAD_PLACEMENT_EVENT_TAG))
+    {
+        placement_configuration.event_cpus = get_cpu_list(yml, RECORDER_SPECS_THREAD_PLACEMENT_EVENT_TAG, version);
+    }
+
+    // Parse optional input/output threads CPUs
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_THREAD_PLACEMENT_IO_TAG))
+    {
+        placement_configuration.io_cpus = get_cpu_list(yml, RECORDER_SPECS_THREAD_PLACEMENT_IO_TAG, version);
+    }
+
+    // Parse optional NUMA placement
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_THREAD_PLACEMENT_NUMA_LOCAL_TAG))
+    {
+        placement_configuration.numa_local = YamlReader::get<bool>(yml, RECORDER_SPECS_THREAD_PLACEMENT_NUMA_LOCAL_TAG,
+                        version);
+    }
+
+    return placement_configuration;
+}
+
+template <>
+ddsrecorder::participants::IngestionLaneConfiguration
+YamlReader::get<ddsrecorder::participants::IngestionLaneConfiguration>(
+        const Yaml& yml,
+        const YamlReaderVersion version)
+{
+    ddsrecorder::participants::IngestionLaneConfiguration lane_configuration;
+
+    // Parse required name
+    lane_configuration.name = YamlReader::get<std::string>(yml, RECORDER_SPECS_INGESTION_LANES_NAME_TAG, version);
+
+    // Parse required topics
+    const auto& topics = YamlReader::get_list<std::string>(yml, RECORDER_SPECS_INGESTION_LANES_TOPICS_TAG, version);
+    lane_configuration.topics = std::vector<std::string>(topics.begin(), topics.end());
+
+    if (lane_configuration.topics.empty())
+    {
+        throw eprosima::utils::ConfigurationException(
+                  utils::Formatter() << "Error reading ingestion lane " << lane_configuration.name << ": its <" <<
+                      RECORDER_SPECS_INGESTION_LANES_TOPICS_TAG << "> list must not be empty.");
+    }
+
+    // Parse optional queue size
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_INGESTION_LANES_QUEUE_SIZE_TAG))
+    {
+        lane_configuration.queue_size = YamlReader::get_positive_int(yml,
+                        RECORDER_SPECS_INGESTION_LANES_QUEUE_SIZE_TAG);
+    }
+
+    return lane_configuration;
+}
+
 } /* namespace yaml */
 } /* namespace ddspipe */
 } /* namespace eprosima */
@@ -17,6 +17,9 @@
  *
  */
 
+#include <iterator>
+#include <set>
+
 #include <cpp_utils/Log.hpp>
 #include <cpp_utils/utils.hpp>
 
@@ -90,6 +93,21 @@ bool RecorderConfiguration::is_valid(
         }
     }
 
+    if (!output_staging_path.empty())
+    {
+        if (output_resource_limits_max_file_size == 0)
+        {
+            error_msg << "The max file size cannot be unlimited when a staging directory is set.";
+            return false;
+        }
+
+        if (output_staging_max_size > 0 && output_staging_max_size < output_resource_limits_max_file_size)
+        {
+            error_msg << "The staging max size cannot be lower than the max file size.";
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -252,6 +270,30 @@ void RecorderConfiguration::load_recorder_configuration_(
                     RECORDER_OUTPUT_SAFETY_MARGIN_TAG));
         }
 
+        /////
+        // Get optional sink
+        if (YamlReader::is_tag_present(output_yml, RECORDER_OUTPUT_SINK_TAG))
+        {
+            using participants::OutputSinkKind;
+
+            auto sink_yml = YamlReader::get_value_in_tag(output_yml, RECORDER_OUTPUT_SINK_TAG);
+            output_sink = YamlReader::get_enumeration<OutputSinkKind>(sink_yml,
+                            {
+                                {RECORDER_OUTPUT_SINK_FILE_TAG, OutputSinkKind::file},
+                                {RECORDER_OUTPUT_SINK_MEMORY_TAG, OutputSinkKind::memory},
+                                {RECORDER_OUTPUT_SINK_DISCARD_TAG, OutputSinkKind::null},
+                                {RECORDER_OUTPUT_SINK_STREAM_TAG, OutputSinkKind::stream},
+                            });
+        }
+
+        /////
+        // Get optional stream settings
+        if (YamlReader::is_tag_present(output_yml, RECORDER_OUTPUT_STREAM_TAG))
+        {
+            output_stream = YamlReader::get<participants::McapStreamConfiguration>(output_yml,
+                            RECORDER_OUTPUT_STREAM_TAG, version);
+        }
+
         // Get optional resource limits
         if (YamlReader::is_tag_present(output_yml, RECORDER_OUTPUT_RESOURCE_LIMITS_TAG))
         {
@@ -285,6 +327,33 @@ void RecorderConfiguration::load_recorder_configuration_(
                 output_resource_limits_max_size = eprosima::utils::to_bytes(max_size);
             }
         }
+
+        /////
+        // Get optional staging directory
+        if (YamlReader::is_tag_present(output_yml, RECORDER_OUTPUT_STAGING_TAG))
+        {
+            auto staging_yml = YamlReader::get_value_in_tag(output_yml, RECORDER_OUTPUT_STAGING_TAG);
+
+            output_staging_path = YamlReader::get<std::string>(staging_yml, RECORDER_OUTPUT_STAGING_PATH_TAG, version);
+
+            /////
+            // Get optional staging max size
+            if (YamlReader::is_tag_present(staging_yml, RECORDER_OUTPUT_STAGING_MAX_SIZE_TAG))
+            {
+                const auto& max_size = YamlReader::get<std::string>(staging_yml,
+                                RECORDER_OUTPUT_STAGING_MAX_SIZE_TAG,
+                                version);
+                output_staging_max_size = eprosima::utils::to_bytes(max_size);
+            }
+        }
+
+        /////
+        // Get optional disk full forecast
+        if (YamlReader::is_tag_present(output_yml, RECORDER_OUTPUT_DISK_FULL_FORECAST_TAG))
+        {
+            output_disk_full_forecast = YamlReader::get<participants::DiskFullForecastConfiguration>(output_yml,
+                            RECORDER_OUTPUT_DISK_FULL_FORECAST_TAG, version);
+        }
     }
 
     /////
@@ -308,6 +377,30 @@ void RecorderConfiguration::load_recorder_configuration_(
         log_publish_time = YamlReader::get<bool>(yml, RECORDER_LOG_PUBLISH_TIME_TAG, version);
     }
 
+    /////
+    // Get optional log time clock
+    if (YamlReader::is_tag_present(yml, RECORDER_LOG_TIME_CLOCK_TAG))
+    {
+        log_time_clock_configuration = YamlReader::get<participants::LogTimeClockConfiguration>(yml,
+                        RECORDER_LOG_TIME_CLOCK_TAG, version);
+    }
+
+    /////
+    // Get optional chunking
+    if (YamlReader::is_tag_present(yml, RECORDER_CHUNKING_TAG))
+    {
+        chunking_configuration = YamlReader::get<participants::McapChunkingConfiguration>(yml,
+                        RECORDER_CHUNKING_TAG, version);
+    }
+
+    /////
+    // Get optional blobs
+    if (YamlReader::is_tag_present(yml, RECORDER_BLOBS_TAG))
+    {
+        blobs_configuration = YamlReader::get<participants::McapBlobsConfiguration>(yml,
+                        RECORDER_BLOBS_TAG, version);
+    }
+
     /////
     // Get optional only_with_type
     if (YamlReader::is_tag_present(yml, RECORDER_ONLY_WITH_TYPE_TAG))
@@ -335,6 +428,34 @@ void RecorderConfiguration::load_recorder_configuration_(
     {
         ros2_types = YamlReader::get<bool>(yml, RECORDER_ROS2_TYPES_TAG, version);
     }
+
+    /////
+    // Get optional record_statistics
+    if (YamlReader::is_tag_present(yml, RECORDER_RECORD_STATISTICS_TAG))
+    {
+        record_statistics = YamlReader::get<bool>(yml, RECORDER_RECORD_STATISTICS_TAG, version);
+    }
+
+    /////
+    // Get optional lazy_channels
+    if (YamlReader::is_tag_present(yml, RECORDER_LAZY_CHANNELS_TAG))
+    {
+        lazy_channels = YamlReader::get<bool>(yml, RECORDER_LAZY_CHANNELS_TAG, version);
+    }
+
+    /////
+    // Get optional types_sidecar
+    if (YamlReader::is_tag_present(yml, RECORDER_TYPES_SIDECAR_TAG))
+    {
+        types_sidecar = YamlReader::get<bool>(yml, RECORDER_TYPES_SIDECAR_TAG, version);
+    }
+
+    /////
+    // Get optional keyframes
+    if (YamlReader::is_tag_present(yml, RECORDER_KEYFRAMES_TAG))
+    {
+        keyframes = YamlReader::get<bool>(yml, RECORDER_KEYFRAMES_TAG, version);
+    }
 }
 
 void RecorderConfiguration::load_controller_configuration_(
@@ -415,6 +536,13 @@ void RecorderConfiguration::load_specs_configuration_(
         cleanup_period = YamlReader::get_positive_int(yml, RECORDER_SPECS_CLEANUP_PERIOD_TAG);
     }
 
+    // Get optional memory budget
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_MEMORY_BUDGET_TAG))
+    {
+        const auto& memory_budget_str = YamlReader::get<std::string>(yml, RECORDER_SPECS_MEMORY_BUDGET_TAG, version);
+        memory_budget = eprosima::utils::to_bytes(memory_budget_str);
+    }
+
     /////
     // Get optional Log Configuration
     if (YamlReader::is_tag_present(yml, LOG_CONFIGURATION_TAG))
@@ -428,6 +556,35 @@ void RecorderConfiguration::load_specs_configuration_(
     {
         monitor_configuration = YamlReader::get<MonitorConfiguration>(yml, MONITOR_TAG, version);
     }
+
+    // Get optional metrics exporter
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_METRICS_TAG))
+    {
+        metrics_configuration = YamlReader::get<participants::MetricsExporterConfiguration>(yml,
+                        RECORDER_SPECS_METRICS_TAG, version);
+    }
+
+    // Get optional payload pool
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_PAYLOAD_POOL_TAG))
+    {
+        payload_pool_configuration = YamlReader::get<participants::PayloadPoolConfiguration>(yml,
+                        RECORDER_SPECS_PAYLOAD_POOL_TAG, version);
+    }
+
+    // Get optional thread placement
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_THREAD_PLACEMENT_TAG))
+    {
+        thread_placement_configuration = YamlReader::get<participants::ThreadPlacementConfiguration>(yml,
+                        RECORDER_SPECS_THREAD_PLACEMENT_TAG, version);
+    }
+
+    // Get optional ingestion lanes
+    if (YamlReader::is_tag_present(yml, RECORDER_SPECS_INGESTION_LANES_TAG))
+    {
+        const auto& lanes = YamlReader::get_list<participants::IngestionLaneConfiguration>(yml,
+                        RECORDER_SPECS_INGESTION_LANES_TAG, version);
+        ingestion_lanes = std::vector<participants::IngestionLaneConfiguration>(lanes.begin(), lanes.end());
+    }
 }
 
 void RecorderConfiguration::load_dds_configuration_(
@@ -440,6 +597,42 @@ void RecorderConfiguration::load_dds_configuration_(
         simple_configuration->domain = YamlReader::get<DomainId>(yml, DOMAIN_ID_TAG, version);
     }
 
+    // Get optional DDS domains (recorded by the same recorder)
+    if (YamlReader::is_tag_present(yml, RECORDER_DDS_DOMAINS_TAG))
+    {
+        if (YamlReader::is_tag_present(yml, DOMAIN_ID_TAG))
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Tags <" << DOMAIN_ID_TAG << "> and <" << RECORDER_DDS_DOMAINS_TAG <<
+                          "> cannot be set at the same time.");
+        }
+
+        const auto domains = YamlReader::get_list<DomainId>(yml, RECORDER_DDS_DOMAINS_TAG, version);
+
+        if (domains.empty())
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_DDS_DOMAINS_TAG <<
+                          "> : at least one domain is required.");
+        }
+
+        std::set<DomainIdType> unique_domains;
+
+        for (const auto& domain : domains)
+        {
+            if (!unique_domains.insert(domain.domain_id).second)
+            {
+                throw eprosima::utils::ConfigurationException(
+                          utils::Formatter() << "Error reading value under tag <" << RECORDER_DDS_DOMAINS_TAG <<
+                              "> : domain " << domain.domain_id << " is repeated.");
+            }
+        }
+
+        // The first domain is recorded by the simple participant, and every other one by a copy of it
+        simple_configuration->domain = domains.front();
+        extra_domains = std::vector<DomainId>(std::next(domains.begin()), domains.end());
+    }
+
     /////
     // Get optional whitelist interfaces
     if (YamlReader::is_tag_present(yml, WHITELIST_INTERFACES_TAG))
@@ -99,6 +99,7 @@ void ReplayerConfiguration::load_ddsreplayer_configuration_(
         mcap_reader_configuration->end_time = end_time;
         mcap_reader_configuration->rate = rate;
         mcap_reader_configuration->start_replay_time = start_replay_time;
+        mcap_reader_configuration->recorded_domain = recorded_domain;
 
         /////
         // Create Replayer Participant Configuration
@@ -208,6 +209,12 @@ void ReplayerConfiguration::load_replay_configuration_(
     {
         replay_types = YamlReader::get<bool>(yml, REPLAYER_REPLAY_TYPES_TAG, version);
     }
+
+    // Get optional recorded_domain
+    if (YamlReader::is_tag_present(yml, REPLAYER_REPLAY_RECORDED_DOMAIN_TAG))
+    {
+        recorded_domain = YamlReader::get<DomainId>(yml, REPLAYER_REPLAY_RECORDED_DOMAIN_TAG, version);
+    }
 }
 
 void ReplayerConfiguration::load_specs_configuration_(
@@ -235,6 +242,13 @@ void ReplayerConfiguration::load_specs_configuration_(
         CommonWriter::wait_all_acked_timeout.store(YamlReader::get_nonnegative_int(yml, WAIT_ALL_ACKED_TIMEOUT_TAG));
     }
 
+    // Get optional thread placement
+    if (YamlReader::is_tag_present(yml, REPLAYER_SPECS_THREAD_PLACEMENT_TAG))
+    {
+        thread_placement_configuration = YamlReader::get<ddsrecorder::participants::ThreadPlacementConfiguration>(yml,
+                        REPLAYER_SPECS_THREAD_PLACEMENT_TAG, version);
+    }
+
     /////
     // Get optional Log Configuration
     if (YamlReader::is_tag_present(yml, LOG_CONFIGURATION_TAG))
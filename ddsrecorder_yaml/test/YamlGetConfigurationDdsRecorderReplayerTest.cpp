@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cpp_utils/exception/ConfigurationException.hpp>
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
 
@@ -119,6 +120,118 @@ TEST(YamlGetConfigurationDdsRecorderReplayerTest, get_ddsreplayer_configuration_
         "DDSREPLAYER");
 }
 
+/**
+ * Check the domains recorded by a RecorderConfiguration.
+ *
+ * CASES:
+ *  - A single domain set under <domain> is recorded by the simple participant, with no extra domains.
+ *  - The first domain under <domains> is recorded by the simple participant, and the rest are extra domains in order.
+ */
+TEST(YamlGetConfigurationDdsRecorderReplayerTest, get_ddsrecorder_configuration_domains)
+{
+    {
+        const char* yml_str =
+                R"(
+                dds:
+                  domain: 7
+            )";
+
+        RecorderConfiguration configuration(YAML::Load(yml_str));
+
+        ASSERT_EQ(configuration.simple_configuration->domain.domain_id, 7u);
+        ASSERT_TRUE(configuration.extra_domains.empty());
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                dds:
+                  domains: [3, 1, 5]
+            )";
+
+        RecorderConfiguration configuration(YAML::Load(yml_str));
+
+        ASSERT_EQ(configuration.simple_configuration->domain.domain_id, 3u);
+        ASSERT_EQ(configuration.extra_domains.size(), 2u);
+        ASSERT_EQ(configuration.extra_domains[0].domain_id, 1u);
+        ASSERT_EQ(configuration.extra_domains[1].domain_id, 5u);
+    }
+}
+
+/**
+ * Check that the invalid domains of a RecorderConfiguration are rejected.
+ *
+ * CASES:
+ *  - <domain> and <domains> set at the same time.
+ *  - A domain repeated under <domains>.
+ *  - No domain under <domains>.
+ */
+TEST(YamlGetConfigurationDdsRecorderReplayerTest, get_ddsrecorder_configuration_invalid_domains)
+{
+    const char* domain_and_domains =
+            R"(
+            dds:
+              domain: 0
+              domains: [1, 2]
+        )";
+
+    ASSERT_THROW(RecorderConfiguration(YAML::Load(domain_and_domains)), utils::ConfigurationException);
+
+    const char* repeated_domain =
+            R"(
+            dds:
+              domains: [1, 2, 1]
+        )";
+
+    ASSERT_THROW(RecorderConfiguration(YAML::Load(repeated_domain)), utils::ConfigurationException);
+
+    const char* no_domains =
+            R"(
+            dds:
+              domains: []
+        )";
+
+    ASSERT_THROW(RecorderConfiguration(YAML::Load(no_domains)), utils::ConfigurationException);
+}
+
+/**
+ * Check the recorded domain replayed by a ReplayerConfiguration.
+ *
+ * CASES:
+ *  - No recorded domain is set by default, so every domain is replayed.
+ *  - The recorded domain set under <recorded-domain> is passed to the MCAP reader participant.
+ */
+TEST(YamlGetConfigurationDdsRecorderReplayerTest, get_ddsreplayer_configuration_recorded_domain)
+{
+    {
+        const char* yml_str =
+                R"(
+                replay:
+                  rate: 1
+            )";
+
+        ReplayerConfiguration configuration(YAML::Load(yml_str));
+
+        ASSERT_FALSE(configuration.recorded_domain.is_set());
+        ASSERT_FALSE(configuration.mcap_reader_configuration->recorded_domain.is_set());
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                replay:
+                  recorded-domain: 4
+            )";
+
+        ReplayerConfiguration configuration(YAML::Load(yml_str));
+
+        ASSERT_TRUE(configuration.recorded_domain.is_set());
+        ASSERT_EQ(configuration.recorded_domain.get_reference().domain_id, 4u);
+        ASSERT_TRUE(configuration.mcap_reader_configuration->recorded_domain.is_set());
+        ASSERT_EQ(configuration.mcap_reader_configuration->recorded_domain.get_reference().domain_id, 4u);
+    }
+}
+
 int main(
         int argc,
         char** argv)
@@ -34,6 +34,8 @@
 
 #include <ddspipe_core/logging/DdsLogConsumer.hpp>
 
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
+
 #include <ddsrecorder_yaml/replayer/CommandlineArgsReplayer.hpp>
 #include <ddsrecorder_yaml/replayer/YamlReaderConfiguration.hpp>
 
@@ -257,6 +259,9 @@ int main(
         bool read_success;
         std::thread process_mcap_thread([&]
                 {
+                    eprosima::ddsrecorder::participants::ThreadPlacement::get_instance().place_current_thread(
+                        eprosima::ddsrecorder::participants::ThreadKind::io, "ddsrep.reader");
+
                     try
                     {
                         replayer->process_mcap();
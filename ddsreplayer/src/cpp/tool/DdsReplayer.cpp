@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <filesystem>
+#include <vector>
+
 #include <mcap/reader.hpp>
 #include <yaml-cpp/yaml.h>
 
@@ -37,8 +40,10 @@
 
 #include <ddspipe_core/types/dynamic_types/types.hpp>
 
+#include <ddsrecorder_participants/common/threading/ThreadPlacement.hpp>
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollectionPubSubTypes.hpp>
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesSidecar.hpp>
 
 #include <ddsrecorder_participants/constants.hpp>
 
@@ -61,6 +66,9 @@ DdsReplayer::DdsReplayer(
         yaml::ReplayerConfiguration& configuration,
         std::string& input_file)
 {
+    // Set where the replayer threads run
+    ThreadPlacement::get_instance().configure(configuration.thread_placement_configuration);
+
     // Create Discovery Database
     discovery_database_ = std::make_shared<DiscoveryDatabase>();
 
@@ -68,7 +76,11 @@ DdsReplayer::DdsReplayer(
     payload_pool_ = std::make_shared<FastPayloadPool>();
 
     // Create Thread Pool
-    thread_pool_ = std::make_shared<SlotThreadPool>(configuration.n_threads);
+    {
+        // The thread pool threads inherit the placement of the thread creating them
+        ScopedThreadPlacement placement(ThreadKind::workers, "ddsrep.worker");
+        thread_pool_ = std::make_shared<SlotThreadPool>(configuration.n_threads);
+    }
 
     // Create MCAP Reader Participant
     mcap_reader_participant_ = std::make_shared<McapReaderParticipant>(
@@ -77,12 +89,17 @@ DdsReplayer::DdsReplayer(
         input_file);
 
     // Create Replayer Participant
-    replayer_participant_ = std::make_shared<ReplayerParticipant>(
-        configuration.replayer_configuration,
-        payload_pool_,
-        discovery_database_,
-        configuration.replay_types);
-    replayer_participant_->init();
+    {
+        // The Fast DDS threads inherit the placement of the thread creating them
+        ScopedThreadPlacement placement(ThreadKind::dds, "ddsrep.dds");
+
+        replayer_participant_ = std::make_shared<ReplayerParticipant>(
+            configuration.replayer_configuration,
+            payload_pool_,
+            discovery_database_,
+            configuration.replay_types);
+        replayer_participant_->init();
+    }
 
     // Create and populate Participants Database
     participants_database_ =
@@ -102,12 +119,17 @@ DdsReplayer::DdsReplayer(
     configuration.ddspipe_configuration.builtin_topics = generate_builtin_topics_(configuration, input_file);
 
     // Create DDS Pipe
-    pipe_ = std::make_unique<DdsPipe>(
-        configuration.ddspipe_configuration,
-        discovery_database_,
-        payload_pool_,
-        participants_database_,
-        thread_pool_);
+    {
+        // The DDS Pipe enables the thread pool when created
+        ScopedThreadPlacement placement(ThreadKind::workers, "ddsrep.worker");
+
+        pipe_ = std::make_unique<DdsPipe>(
+            configuration.ddspipe_configuration,
+            discovery_database_,
+            payload_pool_,
+            participants_database_,
+            thread_pool_);
+    }
 }
 
 utils::ReturnCode DdsReplayer::reload_configuration(
@@ -185,20 +207,22 @@ std::set<utils::Heritable<DistributedTopic>> DdsReplayer::generate_builtin_topic
                 ", current is " << DDSRECORDER_PARTICIPANTS_VERSION_STRING << "), incompatibilities might arise...");
     }
 
-    // Fetch dynamic types attachment
-    auto attachments = mcap_reader.attachments();
-    mcap::Attachment dynamic_attachment = attachments[DYNAMIC_TYPES_ATTACHMENT_NAME];
+    // Fetch dynamic types from their sidecar file, or from the dynamic types attachment
+    const auto dynamic_types_data = DynamicTypesSidecar::read_collection(
+        std::filesystem::path(input_file).parent_path().string(),
+        metadatas,
+        mcap_reader.attachments());
 
     // Deserialize dynamic types collection using CDR
     DynamicTypesCollection dynamic_types;
     eprosima::fastdds::dds::TypeSupport type_support(new DynamicTypesCollectionPubSubType());
     eprosima::fastdds::rtps::SerializedPayload_t serialized_payload =
-            eprosima::fastdds::rtps::SerializedPayload_t(dynamic_attachment.dataSize);
-    serialized_payload.length = dynamic_attachment.dataSize;
+            eprosima::fastdds::rtps::SerializedPayload_t(dynamic_types_data.size());
+    serialized_payload.length = dynamic_types_data.size();
     std::memcpy(
         serialized_payload.data,
-        reinterpret_cast<const unsigned char*>(dynamic_attachment.data),
-        dynamic_attachment.dataSize);
+        dynamic_types_data.data(),
+        dynamic_types_data.size());
     type_support.deserialize(serialized_payload, &dynamic_types);
 
     if (configuration.replay_types)
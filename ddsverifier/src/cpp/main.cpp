@@ -0,0 +1,129 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file main.cpp
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/logging/StdLogConsumer.hpp>
+#include <cpp_utils/Log.hpp>
+
+#include <ddspipe_core/configuration/DdsPipeLogConfiguration.hpp>
+
+#include <ddsrecorder_participants/verifier/McapVerifier.hpp>
+
+#include "user_interface/arguments_configuration.hpp"
+#include "user_interface/CommandlineArgsVerifier.hpp"
+#include "user_interface/ProcessReturnCode.hpp"
+
+using namespace eprosima::ddsrecorder::participants;
+using namespace eprosima::ddsrecorder::verifier;
+
+void print_report(
+        const FileVerification& file)
+{
+    std::cout << file.path << ": " << (file.ok() ? "OK" : "FAILED") << "\n";
+    std::cout << "  chunks: " << file.chunks << " (" << file.chunks_without_crc << " without CRC)"
+              << ", CRC errors: " << file.crc_errors
+              << ", chunk errors: " << file.chunk_errors
+              << ", index errors: " << file.index_errors
+              << ", messages: " << file.messages << "\n";
+
+    for (const auto& it : file.topics)
+    {
+        const auto& topic = it.second;
+
+        std::cout << "  topic " << it.first << " [" << topic.type_name << "]"
+                  << ": messages: " << topic.messages
+                  << ", bytes: " << topic.bytes
+                  << ", index errors: " << topic.index_errors
+                  << ", sampled: " << topic.sampled
+                  << ", decode errors: " << topic.decode_errors
+                  << (topic.missing_type ? " (type not recorded)" : "") << "\n";
+    }
+
+    for (const auto& error : file.errors)
+    {
+        std::cout << "  error: " << error << "\n";
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    // Initialize CommandlineArgsVerifier
+    CommandlineArgsVerifier commandline_args;
+
+    // Parse arguments
+    ProcessReturnCode arg_parse_result =
+            parse_arguments(argc, argv, commandline_args);
+
+    if (arg_parse_result == ProcessReturnCode::help_argument)
+    {
+        return static_cast<int>(ProcessReturnCode::success);
+    }
+    else if (arg_parse_result == ProcessReturnCode::version_argument)
+    {
+        return static_cast<int>(ProcessReturnCode::success);
+    }
+    else if (arg_parse_result != ProcessReturnCode::success)
+    {
+        return static_cast<int>(arg_parse_result);
+    }
+
+    /////
+    // Logging
+    eprosima::ddspipe::core::DdsPipeLogConfiguration log_configuration;
+    log_configuration.set(commandline_args.log_verbosity);
+    log_configuration.set(commandline_args.log_filter);
+
+    eprosima::utils::Log::ClearConsumers();
+    eprosima::utils::Log::SetVerbosity(log_configuration.verbosity);
+    eprosima::utils::Log::RegisterConsumer(std::make_unique<eprosima::utils::StdLogConsumer>(&log_configuration));
+
+    /////
+    // Verification
+    McapVerifier verifier(commandline_args.verifier_configuration);
+    const auto results = verifier.verify(commandline_args.input_paths);
+
+    std::size_t failed_files = 0;
+
+    for (const auto& file : results)
+    {
+        print_report(file);
+
+        if (!file.ok())
+        {
+            failed_files++;
+        }
+    }
+
+    std::cout << "\n" << (results.size() - failed_files) << " of " << results.size() << " files verified correctly."
+              << std::endl;
+
+    // Force print every log before closing
+    eprosima::utils::Log::Flush();
+
+    // Delete the consumers before closing
+    eprosima::utils::Log::ClearConsumers();
+
+    return static_cast<int>(failed_files == 0 ? ProcessReturnCode::success : ProcessReturnCode::verification_failed);
+}
@@ -0,0 +1,56 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file CommandlineArgsVerifier.hpp
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ddspipe_core/configuration/CommandlineArgs.hpp>
+
+#include <ddsrecorder_participants/verifier/McapVerifierConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace verifier {
+
+/*
+ * Struct to parse the executable arguments
+ */
+struct CommandlineArgsVerifier : public ddspipe::core::CommandlineArgs
+{
+    CommandlineArgsVerifier()
+    {
+        log_filter[utils::VerbosityKind::Info].set_value("DDSRECORDER", utils::FuzzyLevelValues::fuzzy_level_default);
+        log_filter[utils::VerbosityKind::Warning].set_value("DDSRECORDER",
+                utils::FuzzyLevelValues::fuzzy_level_default);
+        log_filter[utils::VerbosityKind::Error].set_value("", utils::FuzzyLevelValues::fuzzy_level_default);
+    }
+
+    // MCAP files (or directories holding them) to verify
+    std::vector<std::string> input_paths{};
+
+    // What to verify and with how many threads
+    participants::McapVerifierConfiguration verifier_configuration{};
+};
+
+} /* namespace verifier */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
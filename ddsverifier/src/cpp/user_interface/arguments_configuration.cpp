@@ -0,0 +1,476 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file arguments_configuration.cpp
+ *
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/library/config.h>
+
+#include "arguments_configuration.hpp"
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace verifier {
+
+const option::Descriptor usage[] = {
+    {
+        optionIndex::UNKNOWN_OPT,
+        0,
+        "",
+        "",
+        Arg::None,
+        "Usage: DDS Verifier [options] <MCAP files or directories>\n" \
+        "Verify the integrity of the MCAP files recorded by eProsima DDS Recorder.\n" \
+        "Directories are expanded to the MCAP files they hold.\n" \
+        "General options:"
+    },
+
+    ////////////////////
+    // Help options
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\nApplication help and information."
+    },
+
+    {
+        optionIndex::HELP,
+        0,
+        "h",
+        "help",
+        Arg::None,
+        "  -h \t--help\t  \t" \
+        "Print this help message."
+    },
+
+    {
+        optionIndex::VERSION,
+        0,
+        "v",
+        "version",
+        Arg::None,
+        "  -v \t--version\t  \t" \
+        "Print version, branch and commit hash." \
+    },
+
+    ////////////////////
+    // Application options
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\nApplication parameters"
+    },
+
+    {
+        optionIndex::THREADS,
+        0,
+        "j",
+        "threads",
+        Arg::Numeric,
+        "  -j \t--threads\t  \t" \
+        "Number of threads verifying files and chunks in parallel. " \
+        "Value 0 uses one thread per hardware thread. [Default: 0]."
+    },
+
+    {
+        optionIndex::SAMPLED_MESSAGES,
+        0,
+        "s",
+        "sample",
+        Arg::Numeric,
+        "  -s \t--sample\t  \t" \
+        "Max number of messages per topic and file to deserialize with the recorded types. " \
+        "Value 0 does not deserialize any message. [Default: 0]."
+    },
+
+    {
+        optionIndex::NO_CRC,
+        0,
+        "",
+        "no-crc",
+        Arg::None,
+        "  \t--no-crc\t  \t" \
+        "Do not check the CRC of the chunks."
+    },
+
+    {
+        optionIndex::NO_INDEX,
+        0,
+        "",
+        "no-index",
+        Arg::None,
+        "  \t--no-index\t  \t" \
+        "Do not check the message indexes and the statistics."
+    },
+
+    ////////////////////
+    // Debug options
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\nDebug parameters"
+    },
+
+    {
+        optionIndex::ACTIVATE_DEBUG,
+        0,
+        "d",
+        "debug",
+        Arg::None,
+        "  -d \t--debug\t  \t" \
+        "Set log verbosity to Info \t" \
+        "(Using this option with --log-filter and/or --log-verbosity will head to undefined behaviour)."
+    },
+
+    {
+        optionIndex::LOG_FILTER,
+        0,
+        "",
+        "log-filter",
+        Arg::String,
+        "  \t--log-filter\t  \t" \
+        "Set a Regex Filter to filter by category the info and warning log entries. " \
+        "[Default = \"DDSRECORDER\"]. "
+    },
+
+    {
+        optionIndex::LOG_VERBOSITY,
+        0,
+        "",
+        "log-verbosity",
+        Arg::Log_Kind_Correct_Argument,
+        "  \t--log-verbosity\t  \t" \
+        "Set a Log Verbosity Level higher or equal the one given. " \
+        "(Values accepted: \"info\",\"warning\",\"error\" no Case Sensitive) " \
+        "[Default = \"warning\"]. "
+    },
+
+    {
+        optionIndex::UNKNOWN_OPT, 0, "", "", Arg::None,
+        "\n"
+    },
+
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+void print_version()
+{
+    std::cout
+        << "DDS Record & Replay "
+        << DDSRECORDER_PARTICIPANTS_VERSION_STRING
+        << "\ncommit hash: "
+        << DDSRECORDER_PARTICIPANTS_COMMIT_HASH
+        << std::endl;
+}
+
+ProcessReturnCode parse_arguments(
+        int argc,
+        char** argv,
+        CommandlineArgsVerifier& commandline_args)
+{
+    // Variable to pretty print usage help
+    int columns;
+#if defined(_WIN32)
+    char* buf = nullptr;
+    size_t sz = 0;
+    if (_dupenv_s(&buf, &sz, "COLUMNS") == 0 && buf != nullptr)
+    {
+        columns = std::strtol(buf, nullptr, 10);
+        free(buf);
+    }
+    else
+    {
+        columns = 80;
+    }
+#else
+    columns = getenv("COLUMNS") ? atoi(getenv("COLUMNS")) : 180;
+#endif // if defined(_WIN32)
+
+    // Parse arguments
+    // No required arguments
+    if (argc > 0)
+    {
+        argc -= (argc > 0); // reduce arg count of program name if present
+        argv += (argc > 0); // skip program name argv[0] if present
+
+        option::Stats stats(usage, argc, argv);
+        std::vector<option::Option> options(stats.options_max);
+        std::vector<option::Option> buffer(stats.buffer_max);
+        option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+        // Parsing error
+        if (parse.error())
+        {
+            option::printUsage(fwrite, stdout, usage, columns);
+            return ProcessReturnCode::incorrect_argument;
+        }
+
+        // Adding Help before every other check to show help in case an argument is incorrect
+        if (options[optionIndex::HELP])
+        {
+            option::printUsage(fwrite, stdout, usage, columns);
+            return ProcessReturnCode::help_argument;
+        }
+
+        if (options[optionIndex::VERSION])
+        {
+            print_version();
+            return ProcessReturnCode::version_argument;
+        }
+
+        for (int i = 0; i < parse.optionsCount(); ++i)
+        {
+            option::Option& opt = buffer[i];
+            switch (opt.index())
+            {
+                case optionIndex::THREADS:
+                    commandline_args.verifier_configuration.n_threads = std::stoul(opt.arg);
+                    break;
+
+                case optionIndex::SAMPLED_MESSAGES:
+                    commandline_args.verifier_configuration.sampled_messages = std::stoul(opt.arg);
+                    break;
+
+                case optionIndex::NO_CRC:
+                    commandline_args.verifier_configuration.check_crcs = false;
+                    break;
+
+                case optionIndex::NO_INDEX:
+                    commandline_args.verifier_configuration.check_indexes = false;
+                    break;
+
+                case optionIndex::ACTIVATE_DEBUG:
+                    commandline_args.log_filter[utils::VerbosityKind::Error].set_value("");
+                    commandline_args.log_filter[utils::VerbosityKind::Warning].set_value("DDSRECORDER");
+                    commandline_args.log_filter[utils::VerbosityKind::Info].set_value("DDSRECORDER");
+                    commandline_args.log_verbosity = utils::VerbosityKind::Info;
+                    break;
+
+                case optionIndex::LOG_FILTER:
+                    commandline_args.log_filter[utils::VerbosityKind::Error].set_value(opt.arg);
+                    commandline_args.log_filter[utils::VerbosityKind::Warning].set_value(opt.arg);
+                    commandline_args.log_filter[utils::VerbosityKind::Info].set_value(opt.arg);
+                    break;
+
+                case optionIndex::LOG_VERBOSITY:
+                    commandline_args.log_verbosity =
+                            utils::VerbosityKind(static_cast<int>(from_string_LogKind(opt.arg)));
+                    break;
+
+                case optionIndex::UNKNOWN_OPT:
+                    EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, opt << " is not a valid argument.");
+                    option::printUsage(fwrite, stdout, usage, columns);
+                    return ProcessReturnCode::incorrect_argument;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        // Every non-option argument is an MCAP file, or a directory whose MCAP files are verified in name order
+        for (int i = 0; i < parse.nonOptionsCount(); ++i)
+        {
+            const std::filesystem::path path(parse.nonOption(i));
+            std::error_code error;
+
+            if (std::filesystem::is_directory(path, error))
+            {
+                std::vector<std::string> directory_files;
+
+                for (const auto& entry : std::filesystem::directory_iterator(path, error))
+                {
+                    if (entry.is_regular_file(error) && entry.path().extension() == ".mcap")
+                    {
+                        directory_files.push_back(entry.path().string());
+                    }
+                }
+
+                std::sort(directory_files.begin(), directory_files.end());
+                commandline_args.input_paths.insert(
+                    commandline_args.input_paths.end(), directory_files.begin(), directory_files.end());
+            }
+            else if (is_file_accessible(path.string().c_str(), utils::FileAccessMode::read))
+            {
+                commandline_args.input_paths.push_back(path.string());
+            }
+            else
+            {
+                EPROSIMA_LOG_ERROR(
+                    DDSVERIFIER_ARGS,
+                    "File '" << path.string() << "' does not exist or it is not accessible.");
+                return ProcessReturnCode::required_argument_failed;
+            }
+        }
+
+        if (commandline_args.input_paths.empty())
+        {
+            EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, "At least one MCAP file must be provided.");
+            option::printUsage(fwrite, stdout, usage, columns);
+            return ProcessReturnCode::required_argument_failed;
+        }
+    }
+    else
+    {
+        option::printUsage(fwrite, stdout, usage, columns);
+        return ProcessReturnCode::incorrect_argument;
+    }
+
+    return ProcessReturnCode::success;
+}
+
+option::ArgStatus Arg::Unknown(
+        const option::Option& option,
+        bool msg)
+{
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(
+            DDSVERIFIER_ARGS,
+            "Unknown option '" << option << "'. Use -h to see this executable possible arguments.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Required(
+        const option::Option& option,
+        bool msg)
+{
+    if (option.arg != 0 && option.arg[0] != 0)
+    {
+        return option::ARG_OK;
+    }
+
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, "Option '" << option << "' required.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Numeric(
+        const option::Option& option,
+        bool msg)
+{
+    char* endptr = 0;
+    if (option.arg != 0 && std::strtol(option.arg, &endptr, 10))
+    {
+    }
+    if (endptr != option.arg && *endptr == 0)
+    {
+        return option::ARG_OK;
+    }
+
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, "Option '" << option << "' requires a numeric argument.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Float(
+        const option::Option& option,
+        bool msg)
+{
+    char* endptr = 0;
+    if (option.arg != 0 && std::strtof(option.arg, &endptr))
+    {
+    }
+    if (endptr != option.arg && *endptr == 0)
+    {
+        return option::ARG_OK;
+    }
+
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, "Option '" << option << "' requires a float argument.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::String(
+        const option::Option& option,
+        bool msg)
+{
+    if (option.arg != 0)
+    {
+        return option::ARG_OK;
+    }
+    if (msg)
+    {
+        EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, "Option '" << option << "' requires a text argument.");
+    }
+    return option::ARG_ILLEGAL;
+}
+
+option::ArgStatus Arg::Log_Kind_Correct_Argument(
+        const option::Option& option,
+        bool msg)
+{
+    return Arg::Valid_Options(string_vector_LogKind(), option, msg);
+}
+
+option::ArgStatus Arg::Valid_Options(
+        const std::vector<std::string>& valid_options,
+        const option::Option& option,
+        bool msg)
+{
+    if (nullptr == option.arg)
+    {
+        if (msg)
+        {
+            EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, "Option '" << option.name << "' requires a text argument.");
+        }
+        return option::ARG_ILLEGAL;
+    }
+
+    if (std::find(valid_options.begin(), valid_options.end(), std::string(option.arg)) != valid_options.end())
+    {
+        return option::ARG_OK;
+    }
+    else if (msg)
+    {
+        utils::Formatter error_msg;
+        error_msg << "Option '" << option.name << "' requires a one of this values: {";
+        for (const auto& valid_option : valid_options)
+        {
+            error_msg << "\"" << valid_option << "\";";
+        }
+        error_msg << "}.";
+
+        EPROSIMA_LOG_ERROR(DDSVERIFIER_ARGS, error_msg);
+    }
+
+    return option::ARG_ILLEGAL;
+}
+
+std::ostream& operator <<(
+        std::ostream& output,
+        const option::Option& option)
+{
+    output << std::string(option.name, option.name + option.namelen);
+    return output;
+}
+
+} /* namespace verifier */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -27,6 +27,7 @@ enum class StatusCode {
   MissingStatistics,
   InvalidMessageReadOptions,
   NoMessageIndexesAvailable,
+  WriteFailed,
 };
 
 /**
@@ -98,6 +99,9 @@ struct [[nodiscard]] Status {
       case StatusCode::NoMessageIndexesAvailable:
         message = "file has no message indices";
         break;
+      case StatusCode::WriteFailed:
+        message = "write failed";
+        break;
       default:
         message = "unknown";
         break;
@@ -77,6 +77,14 @@ struct MCAP_PUBLIC McapWriterOptions {
    * Chunks. This option is ignored if `noChunking=true`.
    */
   bool forceCompression = false;
+  /**
+   * @brief Keep references to the message payloads in uncompressed Chunks
+   * instead of copying them, and write each Chunk with a single gather write.
+   * The payload of every message must remain valid until its Chunk has been
+   * written (i.e. until `statistics().chunkCount` increases, or the writer is
+   * closed). This option only applies when `compression=Compression::None`.
+   */
+  bool referencePayloads = false;
   /**
    * @brief The recording profile. See
    * <https://github.com/foxglove/mcap/tree/main/docs/specification/profiles>
@@ -104,6 +112,14 @@ struct MCAP_PUBLIC McapWriterOptions {
       : profile(profile) {}
 };
 
+/**
+ * @brief A contiguous range of bytes to be written, as part of a gather write.
+ */
+struct MCAP_PUBLIC ConstBuffer {
+  const std::byte* data = nullptr;
+  uint64_t size = 0;
+};
+
 /**
  * @brief An abstract interface for writing MCAP data.
  */
@@ -122,6 +138,23 @@ public:
    * @param size Size of the data in bytes.
    */
   void write(const std::byte* data, uint64_t size);
+  /**
+   * @brief Called whenever the writer needs to write data that remains valid
+   * until this writer is done with it (e.g. the payload of a message, which an
+   * IChunkWriter may reference instead of copying until the Chunk is written).
+   *
+   * @param data A pointer to the data to write.
+   * @param size Size of the data in bytes.
+   */
+  void writeReference(const std::byte* data, uint64_t size);
+  /**
+   * @brief Called whenever the writer needs to write several ranges of bytes
+   * in a row.
+   *
+   * @param buffers Ranges of bytes to write, in order.
+   * @param count Number of ranges in `buffers`.
+   */
+  void write(const ConstBuffer* buffers, size_t count);
   /**
    * @brief Called when the writer is finished writing data to the output MCAP
    * file.
@@ -132,6 +165,12 @@ public:
    * the sum of all `size` parameters passed to `write()`.
    */
   virtual uint64_t size() const = 0;
+  /**
+   * @brief Returns the first error writing to the output since it was opened,
+   * if any. Writes cannot report errors themselves, so this must be checked
+   * to detect e.g. a full disk.
+   */
+  virtual Status status() const;
   /**
    * @brief Returns the CRC32 of the uncompressed data.
    */
@@ -143,6 +182,14 @@ public:
 
 protected:
   virtual void handleWrite(const std::byte* data, uint64_t size) = 0;
+  /**
+   * @brief Write data that outlives this writer. Copies it by default.
+   */
+  virtual void handleWriteReference(const std::byte* data, uint64_t size);
+  /**
+   * @brief Write several ranges of bytes. Writes them one by one by default.
+   */
+  virtual void handleWrite(const ConstBuffer* buffers, size_t count);
 
 private:
   uint32_t crc_;
@@ -159,12 +206,15 @@ public:
   Status open(std::string_view filename);
 
   void handleWrite(const std::byte* data, uint64_t size) override;
+  void handleWrite(const ConstBuffer* buffers, size_t count) override;
   void end() override;
   uint64_t size() const override;
+  Status status() const override;
 
 private:
   std::FILE* file_ = nullptr;
   uint64_t size_ = 0;
+  Status status_;
 };
 
 /**
@@ -251,6 +301,47 @@ private:
   std::vector<std::byte> buffer_;
 };
 
+/**
+ * @brief An uncompressed IChunkWriter implementation that copies the record
+ * headers into a growable buffer, and only keeps references to the data
+ * written with `writeReference()` (i.e. the message payloads). The Chunk is
+ * written with a single gather write of `buffers()`.
+ */
+class MCAP_PUBLIC ScatterGatherWriter final : public IChunkWriter {
+public:
+  void handleWrite(const std::byte* data, uint64_t size) override;
+  void handleWriteReference(const std::byte* data, uint64_t size) override;
+  void end() override;
+  uint64_t size() const override;
+  uint64_t compressedSize() const override;
+  bool empty() const override;
+  void handleClear() override;
+  /**
+   * @brief Returns a pointer to a contiguous copy of the data. This copies the
+   * whole Chunk, so `buffers()` should be used instead.
+   */
+  const std::byte* data() const override;
+  const std::byte* compressedData() const override;
+  /**
+   * @brief Returns the ranges of bytes of the Chunk, in order. They remain
+   * valid until the next call to a non-const method.
+   */
+  const std::vector<ConstBuffer>& buffers() const;
+
+private:
+  struct Segment {
+    const std::byte* reference = nullptr;  // nullptr <-> copied in buffer_ at offset
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  std::vector<std::byte> buffer_;
+  std::vector<Segment> segments_;
+  uint64_t size_ = 0;
+  mutable std::vector<ConstBuffer> buffers_;
+  mutable std::vector<std::byte> flattened_;
+};
+
 /**
  * @brief An in-memory IChunkWriter implementation that holds data in a
  * temporary buffer before flushing to an LZ4-compressed buffer.
@@ -376,9 +467,12 @@ public:
    *
    * @param attachment Attachment to add. The `attachment.crc` will be
    * calculated and set if configuration options allow CRC calculation.
+   * @param closeChunk Whether to write the current Chunk before the
+   * attachment. If false, the attachment is written right away and the Chunk
+   * keeps growing (it is written after the attachment).
    * @return A non-zero error code on failure.
    */
-  Status write(Attachment& attachment);
+  Status write(Attachment& attachment, bool closeChunk = true);
 
   /**
    * @brief Write a metadata record to the output stream.
@@ -420,6 +514,8 @@ public:
   static uint64_t write(IWritable& output, const Attachment& attachment);
   static uint64_t write(IWritable& output, const Metadata& metadata);
   static uint64_t write(IWritable& output, const Chunk& chunk);
+  static uint64_t write(IWritable& output, const Chunk& chunk,
+                        const std::vector<ConstBuffer>& records);
   static uint64_t write(IWritable& output, const MessageIndex& index);
   static uint64_t write(IWritable& output, const ChunkIndex& index);
   static uint64_t write(IWritable& output, const AttachmentIndex& index);
@@ -445,6 +541,7 @@ private:
   std::unique_ptr<FileWriter> fileOutput_;
   std::unique_ptr<StreamWriter> streamOutput_;
   std::unique_ptr<BufferWriter> uncompressedChunk_;
+  std::unique_ptr<ScatterGatherWriter> scatterGatherChunk_;
   std::unique_ptr<LZ4Writer> lz4Chunk_;
   std::unique_ptr<ZStdWriter> zstdChunk_;
   std::vector<Schema> schemas_;
@@ -1,12 +1,26 @@
 #include "crc32.hpp"
+
+// Allow the embedding application to provide a faster implementation with the same semantics as crc32Update
+#ifndef MCAP_CRC32_UPDATE
+#define MCAP_CRC32_UPDATE internal::crc32Update
+#endif
+
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <lz4frame.h>
 #include <lz4hc.h>
 #include <zstd.h>
 #include <zstd_errors.h>
 
+#ifndef _WIN32
+#  include <cerrno>
+#  include <climits>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
 namespace mcap {
 
 // IWritable ///////////////////////////////////////////////////////////////////
@@ -16,11 +30,41 @@ IWritable::IWritable() noexcept
 
 void IWritable::write(const std::byte* data, uint64_t size) {
   if (crcEnabled) {
-    crc_ = internal::crc32Update(crc_, data, size);
+    crc_ = MCAP_CRC32_UPDATE(crc_, data, size);
+  }
+  handleWrite(data, size);
+}
+
+void IWritable::writeReference(const std::byte* data, uint64_t size) {
+  if (crcEnabled) {
+    crc_ = MCAP_CRC32_UPDATE(crc_, data, size);
+  }
+  handleWriteReference(data, size);
+}
+
+void IWritable::write(const ConstBuffer* buffers, size_t count) {
+  if (crcEnabled) {
+    for (size_t i = 0; i < count; ++i) {
+      crc_ = MCAP_CRC32_UPDATE(crc_, buffers[i].data, buffers[i].size);
+    }
   }
+  handleWrite(buffers, count);
+}
+
+Status IWritable::status() const {
+  return StatusCode::Success;
+}
+
+void IWritable::handleWriteReference(const std::byte* data, uint64_t size) {
   handleWrite(data, size);
 }
 
+void IWritable::handleWrite(const ConstBuffer* buffers, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    handleWrite(buffers[i].data, buffers[i].size);
+  }
+}
+
 uint32_t IWritable::crc() {
   uint32_t crc32 = 0;
   if (crcEnabled) {
@@ -52,23 +96,88 @@ Status FileWriter::open(std::string_view filename) {
 void FileWriter::handleWrite(const std::byte* data, uint64_t size) {
   assert(file_);
   const size_t written = std::fwrite(data, 1, size, file_);
-  (void)written;
-  assert(written == size);
+  if (written != size && status_.ok()) {
+    status_ = Status(StatusCode::WriteFailed, internal::StrCat("write failed: ", std::strerror(errno)));
+  }
   size_ += size;
 }
 
+void FileWriter::handleWrite(const ConstBuffer* buffers, size_t count) {
+  assert(file_);
+#ifndef _WIN32
+  // Flush the buffered bytes first, so the gather write lands after them
+  if (std::fflush(file_) != 0 && status_.ok()) {
+    status_ = Status(StatusCode::WriteFailed, internal::StrCat("write failed: ", std::strerror(errno)));
+  }
+  const int fd = fileno(file_);
+
+  std::vector<iovec> iov;
+  iov.reserve(std::min<size_t>(count, IOV_MAX));
+
+  size_t next = 0;
+  while (next < count) {
+    iov.clear();
+    for (; next < count && iov.size() < IOV_MAX; ++next) {
+      if (buffers[next].size > 0) {
+        iov.push_back(iovec{const_cast<std::byte*>(buffers[next].data), buffers[next].size});
+      }
+    }
+
+    size_t first = 0;
+    while (first < iov.size()) {
+      const ssize_t written = ::writev(fd, iov.data() + first, int(iov.size() - first));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (status_.ok()) {
+          status_ = Status(StatusCode::WriteFailed, internal::StrCat("writev failed: ", std::strerror(errno)));
+        }
+        // Account for the lost bytes as the copying path does, so the offsets stay consistent
+        for (size_t i = first; i < iov.size(); ++i) {
+          size_ += uint64_t(iov[i].iov_len);
+        }
+        for (; next < count; ++next) {
+          size_ += uint64_t(buffers[next].size);
+        }
+        return;
+      }
+      size_ += uint64_t(written);
+
+      // Skip the fully written buffers and advance into the partially written one
+      size_t remaining = size_t(written);
+      while (first < iov.size() && remaining >= iov[first].iov_len) {
+        remaining -= iov[first].iov_len;
+        ++first;
+      }
+      if (first < iov.size()) {
+        iov[first].iov_base = static_cast<std::byte*>(iov[first].iov_base) + remaining;
+        iov[first].iov_len -= remaining;
+      }
+    }
+  }
+#else
+  IWritable::handleWrite(buffers, count);
+#endif
+}
+
 void FileWriter::end() {
   if (file_) {
     std::fclose(file_);
     file_ = nullptr;
   }
   size_ = 0;
+  status_ = StatusCode::Success;
 }
 
 uint64_t FileWriter::size() const {
   return size_;
 }
 
+Status FileWriter::status() const {
+  return status_;
+}
+
 // StreamWriter ////////////////////////////////////////////////////////////////
 
 StreamWriter::StreamWriter(std::ostream& stream)
@@ -129,6 +238,75 @@ const std::byte* BufferWriter::compressedData() const {
   return buffer_.data();
 }
 
+// ScatterGatherWriter /////////////////////////////////////////////////////////
+
+void ScatterGatherWriter::handleWrite(const std::byte* data, uint64_t size) {
+  if (segments_.empty() || segments_.back().reference != nullptr) {
+    segments_.push_back(Segment{nullptr, buffer_.size(), 0});
+  }
+  buffer_.insert(buffer_.end(), data, data + size);
+  segments_.back().size += size;
+  size_ += size;
+}
+
+void ScatterGatherWriter::handleWriteReference(const std::byte* data, uint64_t size) {
+  if (size == 0) {
+    // An empty payload may have no address, and would be taken for a copied segment
+    return;
+  }
+  segments_.push_back(Segment{data, 0, size});
+  size_ += size;
+}
+
+void ScatterGatherWriter::end() {
+  // no-op
+}
+
+uint64_t ScatterGatherWriter::size() const {
+  return size_;
+}
+
+uint64_t ScatterGatherWriter::compressedSize() const {
+  return size_;
+}
+
+bool ScatterGatherWriter::empty() const {
+  return size_ == 0;
+}
+
+void ScatterGatherWriter::handleClear() {
+  buffer_.clear();
+  segments_.clear();
+  buffers_.clear();
+  flattened_.clear();
+  size_ = 0;
+}
+
+const std::byte* ScatterGatherWriter::data() const {
+  flattened_.clear();
+  flattened_.reserve(size_);
+  for (const auto& buffer : buffers()) {
+    flattened_.insert(flattened_.end(), buffer.data, buffer.data + buffer.size);
+  }
+  return flattened_.data();
+}
+
+const std::byte* ScatterGatherWriter::compressedData() const {
+  return data();
+}
+
+const std::vector<ConstBuffer>& ScatterGatherWriter::buffers() const {
+  // NOTE: The buffer may have been reallocated since the segments were written, so their addresses are resolved here
+  buffers_.clear();
+  buffers_.reserve(segments_.size());
+  for (const auto& segment : segments_) {
+    const std::byte* data =
+      segment.reference != nullptr ? segment.reference : buffer_.data() + segment.offset;
+    buffers_.push_back(ConstBuffer{data, segment.size});
+  }
+  return buffers_;
+}
+
 // LZ4Writer ///////////////////////////////////////////////////////////////////
 
 namespace internal {
@@ -293,7 +471,11 @@ void McapWriter::open(IWritable& writer, const McapWriterOptions& options) {
   switch (compression_) {
     case Compression::None:
     default:
-      uncompressedChunk_ = std::make_unique<BufferWriter>();
+      if (options.referencePayloads) {
+        scatterGatherChunk_ = std::make_unique<ScatterGatherWriter>();
+      } else {
+        uncompressedChunk_ = std::make_unique<BufferWriter>();
+      }
       break;
     case Compression::Lz4:
       lz4Chunk_ = std::make_unique<LZ4Writer>(options.compressionLevel, chunkSize_);
@@ -457,6 +639,7 @@ void McapWriter::terminate() {
   fileOutput_.reset();
   streamOutput_.reset();
   uncompressedChunk_.reset();
+  scatterGatherChunk_.reset();
   zstdChunk_.reset();
 
   channels_.clear();
@@ -565,7 +748,7 @@ Status McapWriter::write(const Message& message) {
   return StatusCode::Success;
 }
 
-Status McapWriter::write(Attachment& attachment) {
+Status McapWriter::write(Attachment& attachment, bool closeChunk) {
   if (!output_) {
     return StatusCode::NotOpen;
   }
@@ -573,7 +756,7 @@ Status McapWriter::write(Attachment& attachment) {
 
   // Check if we have an open chunk that needs to be closed
   auto* chunkWriter = getChunkWriter();
-  if (chunkWriter && !chunkWriter->empty()) {
+  if (closeChunk && chunkWriter && !chunkWriter->empty()) {
     writeChunk(fileOutput, *chunkWriter);
   }
 
@@ -581,18 +764,18 @@ Status McapWriter::write(Attachment& attachment) {
     // Calculate the CRC32 of the attachment
     uint32_t sizePrefix = 0;
     uint32_t crc = internal::CRC32_INIT;
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(&attachment.logTime), 8);
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(&attachment.createTime), 8);
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(&attachment.logTime), 8);
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(&attachment.createTime), 8);
     sizePrefix = uint32_t(attachment.name.size());
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(&sizePrefix), 4);
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(attachment.name.data()),
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(&sizePrefix), 4);
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(attachment.name.data()),
                                 sizePrefix);
     sizePrefix = uint32_t(attachment.mediaType.size());
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(&sizePrefix), 4);
-    crc = internal::crc32Update(
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(&sizePrefix), 4);
+    crc = MCAP_CRC32_UPDATE(
       crc, reinterpret_cast<const std::byte*>(attachment.mediaType.data()), sizePrefix);
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(&attachment.dataSize), 8);
-    crc = internal::crc32Update(crc, reinterpret_cast<const std::byte*>(attachment.data),
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(&attachment.dataSize), 8);
+    crc = MCAP_CRC32_UPDATE(crc, reinterpret_cast<const std::byte*>(attachment.data),
                                 attachment.dataSize);
     attachment.crc = internal::crc32Final(crc);
   }
@@ -658,6 +841,9 @@ IWritable& McapWriter::getOutput() {
   switch (compression_) {
     default:
     case Compression::None:
+      if (scatterGatherChunk_) {
+        return *scatterGatherChunk_;
+      }
       return *uncompressedChunk_;
     case Compression::Zstd:
       return *zstdChunk_;
@@ -674,6 +860,9 @@ IChunkWriter* McapWriter::getChunkWriter() {
   switch (compression_) {
     case Compression::None:
     default:
+      if (scatterGatherChunk_) {
+        return scatterGatherChunk_.get();
+      }
       return uncompressedChunk_.get();
     case Compression::Lz4:
       return lz4Chunk_.get();
@@ -691,9 +880,11 @@ void McapWriter::writeChunk(IWritable& output, IChunkWriter& chunkData) {
   Compression compression = Compression::None;
   const uint64_t uncompressedSize = uncompressedSize_;
   uint64_t compressedSize = uncompressedSize;
-  const std::byte* compressedData = chunkData.data();
+  // NOTE: A scatter-gather chunk is never compressed, and it is written from its buffers below
+  const std::byte* compressedData = scatterGatherChunk_ ? nullptr : chunkData.data();
 
-  if (options_.forceCompression || uncompressedSize >= MIN_COMPRESSION_SIZE) {
+  if (!scatterGatherChunk_ &&
+      (options_.forceCompression || uncompressedSize >= MIN_COMPRESSION_SIZE)) {
     // Flush any in-progress compression stream
     chunkData.end();
 
@@ -712,8 +903,15 @@ void McapWriter::writeChunk(IWritable& output, IChunkWriter& chunkData) {
 
   // Write the chunk
   const uint64_t chunkStartOffset = output.size();
-  write(output, Chunk{currentChunkStart_, currentChunkEnd_, uncompressedSize, uncompressedCrc,
-                      compressionStr, compressedSize, compressedData});
+  if (scatterGatherChunk_) {
+    write(output,
+          Chunk{currentChunkStart_, currentChunkEnd_, uncompressedSize, uncompressedCrc,
+                compressionStr, compressedSize, nullptr},
+          scatterGatherChunk_->buffers());
+  } else {
+    write(output, Chunk{currentChunkStart_, currentChunkEnd_, uncompressedSize, uncompressedCrc,
+                        compressionStr, compressedSize, compressedData});
+  }
 
   const uint64_t chunkLength = output.size() - chunkStartOffset;
 
@@ -839,7 +1037,7 @@ uint64_t McapWriter::write(IWritable& output, const Message& message) {
   write(output, message.sequence);
   write(output, message.logTime);
   write(output, message.publishTime);
-  write(output, message.data, message.dataSize);
+  output.writeReference(message.data, message.dataSize);
 
   return 9 + recordSize;
 }
@@ -890,6 +1088,24 @@ uint64_t McapWriter::write(IWritable& output, const Chunk& chunk) {
   return 9 + recordSize;
 }
 
+uint64_t McapWriter::write(IWritable& output, const Chunk& chunk,
+                           const std::vector<ConstBuffer>& records) {
+  const uint64_t recordSize =
+    8 + 8 + 8 + 4 + 4 + chunk.compression.size() + 8 + chunk.compressedSize;
+
+  write(output, OpCode::Chunk);
+  write(output, recordSize);
+  write(output, chunk.messageStartTime);
+  write(output, chunk.messageEndTime);
+  write(output, chunk.uncompressedSize);
+  write(output, chunk.uncompressedCrc);
+  write(output, chunk.compression);
+  write(output, chunk.compressedSize);
+  output.write(records.data(), records.size());
+
+  return 9 + recordSize;
+}
+
 uint64_t McapWriter::write(IWritable& output, const MessageIndex& index) {
   const uint32_t recordsSize = (uint32_t)(index.records.size()) * 16;
   const uint64_t recordSize = 2 + 4 + recordsSize;